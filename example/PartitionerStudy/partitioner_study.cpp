@@ -0,0 +1,242 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file partitioner_study.cpp
+ * \author Stuart R. Slattery
+ * \brief Partitioner study. Partitioning time and search imbalance.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <ctime>
+#include <cstdlib>
+
+#include <DTK_Partitioner.hpp>
+#include <DTK_PartitionerFactory.hpp>
+#include <DTK_MeshTypes.hpp>
+#include <DTK_MeshManager.hpp>
+#include <DTK_MeshContainer.hpp>
+
+#include <Teuchos_GlobalMPISession.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_DefaultMpiComm.hpp>
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_ArrayRCP.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_TypeTraits.hpp>
+
+//---------------------------------------------------------------------------//
+// Mesh create function.
+//---------------------------------------------------------------------------//
+// Each process owns a block of a structured grid of vertices. The blocks are
+// stacked along the x axis.
+Teuchos::RCP<DataTransferKit::MeshContainer<int> > 
+buildMesh( int my_rank, int edge_length )
+{
+    using namespace DataTransferKit;
+
+    int vertex_dim = 3;
+    int num_vertices = edge_length*edge_length*edge_length;
+    Teuchos::ArrayRCP<int> vertex_handles( num_vertices );
+    Teuchos::ArrayRCP<double> coords( vertex_dim*num_vertices );
+    int idx;
+    for ( int k = 0; k < edge_length; ++k )
+    {
+	for ( int j = 0; j < edge_length; ++j )
+	{
+	    for ( int i = 0; i < edge_length; ++i )
+	    {
+		idx = i + j*edge_length + k*edge_length*edge_length;
+		vertex_handles[ idx ] = num_vertices*my_rank + idx;
+		coords[ idx ] = i + my_rank*edge_length;
+		coords[ num_vertices + idx ] = j;
+		coords[ 2*num_vertices + idx ] = k;
+	    }
+	}
+    }
+
+    // Only the vertices are partitioned.
+    Teuchos::ArrayRCP<int> element_handles;
+    Teuchos::ArrayRCP<int> element_connectivity;
+    Teuchos::ArrayRCP<int> permutation_list( 8 );
+    for ( int i = 0; i < permutation_list.size(); ++i )
+    {
+	permutation_list[i] = i;
+    }
+
+    return Teuchos::rcp( 
+	new MeshContainer<int>( vertex_dim, vertex_handles, coords, 
+				DTK_HEXAHEDRON, 8,
+				element_handles, element_connectivity,
+				permutation_list ) );
+}
+
+//---------------------------------------------------------------------------//
+// Target point create function.
+//---------------------------------------------------------------------------//
+// Most of the target points are clustered in a small corner of the global
+// domain such that the search work is not proportional to the number of
+// source vertices on each process.
+Teuchos::Array<double> buildTargetPoints( int my_rank, int my_size, 
+					  int num_points, int edge_length )
+{
+    std::srand( my_rank*num_points*2 + 1 );
+    double x_length = my_size*edge_length - 1;
+    double yz_length = edge_length - 1;
+    double cluster_size = 0.2;
+    double scale = 1.0;
+    Teuchos::Array<double> coords( 3*num_points );
+    for ( int i = 0; i < num_points; ++i )
+    {
+	scale = ( i % 10 ) ? cluster_size : 1.0;
+	coords[ i ] = scale * x_length * std::rand() / RAND_MAX;
+	coords[ num_points + i ] = scale * yz_length * std::rand() / RAND_MAX;
+	coords[ 2*num_points + i ] = scale * yz_length * std::rand() / RAND_MAX;
+    }
+    return coords;
+}
+
+//---------------------------------------------------------------------------//
+// Get the ratio of the maximum to the average of the global sums of a local
+// count per process.
+//---------------------------------------------------------------------------//
+double computeImbalance( const Teuchos::RCP<const Teuchos::Comm<int> >& comm,
+			 const Teuchos::Array<int>& procs )
+{
+    int my_size = comm->getSize();
+    Teuchos::Array<int> local_counts( my_size, 0 );
+    for ( int i = 0; i < procs.size(); ++i )
+    {
+	++local_counts[ procs[i] ];
+    }
+    Teuchos::Array<int> global_counts( my_size, 0 );
+    Teuchos::reduceAll<int,int>( *comm, Teuchos::REDUCE_SUM, my_size,
+				 local_counts.getRawPtr(),
+				 global_counts.getRawPtr() );
+
+    double max_count = *std::max_element( global_counts.begin(), 
+					  global_counts.end() );
+    double sum_count = 0.0;
+    for ( int p = 0; p < my_size; ++p )
+    {
+	sum_count += global_counts[p];
+    }
+    return ( sum_count > 0.0 ) ? max_count * my_size / sum_count : 1.0;
+}
+
+//---------------------------------------------------------------------------//
+// Partitioner study driver.
+//---------------------------------------------------------------------------//
+int main(int argc, char* argv[])
+{
+    using namespace DataTransferKit;
+
+    typedef MeshContainer<int> MeshType;
+
+    // Setup communication.
+    Teuchos::GlobalMPISession mpiSession(&argc,&argv);
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = 
+	Teuchos::DefaultComm<int>::getComm();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    // Setup source mesh.
+    int edge_length = 20;
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 1 );
+    mesh_blocks[0] = buildMesh( my_rank, edge_length );
+    Teuchos::RCP< MeshManager<MeshType> > mesh_manager = Teuchos::rcp( 
+	new MeshManager<MeshType>( mesh_blocks, comm, 3 ) );
+    int num_vertices = edge_length*edge_length*edge_length;
+    Teuchos::Array<short int> active_vertices( num_vertices, 1 );
+    mesh_manager->setActiveVertices( active_vertices, 0 );
+    Teuchos::ArrayRCP<const double> source_coords = 
+	MeshTools<MeshType>::coordsView( *mesh_blocks[0] );
+
+    // Setup target points.
+    int num_points = num_vertices;
+    Teuchos::Array<double> target_coords = 
+	buildTargetPoints( my_rank, my_size, num_points, edge_length );
+
+    if ( my_rank == 0 )
+    {
+	std::cout << "==================================================" 
+		  << std::endl;
+	std::cout << "DTK partitioner study" << std::endl;
+	std::cout << "Number of processors:      " << my_size << std::endl;
+	std::cout << "Global number of vertices: " << num_vertices*my_size
+		  << std::endl;
+	std::cout << "Global number of points:   " << num_points*my_size
+		  << std::endl;
+	std::cout << "--------------------------------------------------"
+		  << std::endl;
+	std::cout << std::setw(10) << "type" 
+		  << std::setw(14) << "max time (s)"
+		  << std::setw(13) << "vertex imb."
+		  << std::setw(13) << "search imb." << std::endl;
+    }
+
+    DTK_PartitionerType types[4] = { DTK_RCB_PARTITIONER,
+				     DTK_RIB_PARTITIONER,
+				     DTK_HSFC_PARTITIONER,
+				     DTK_HILBERT_PARTITIONER };
+    std::string names[4] = { "RCB", "RIB", "HSFC", "Hilbert" };
+    for ( int t = 0; t < 4; ++t )
+    {
+	// Time the partitioning.
+	comm->barrier();
+	std::clock_t partition_start = clock();
+	Teuchos::RCP<Partitioner> partitioner = 
+	    PartitionerFactory::createMeshPartitioner( 
+		comm, mesh_manager, 3, Teuchos::null, types[t] );
+	partitioner->partition();
+	std::clock_t partition_end = clock();
+
+	double local_partition_time = 
+	    (double)(partition_end - partition_start) / CLOCKS_PER_SEC;
+	double global_max_partition_time;
+	Teuchos::reduceAll<int,double>( *comm,
+					Teuchos::REDUCE_MAX,
+					1,
+					&local_partition_time,
+					&global_max_partition_time );
+
+	// The source vertex imbalance is the storage imbalance and the target
+	// point imbalance is the search imbalance.
+	Teuchos::Array<int> vertex_procs;
+	partitioner->getPointDestinationProcs( source_coords(), vertex_procs );
+	double vertex_imbalance = computeImbalance( comm, vertex_procs );
+
+	Teuchos::Array<int> point_procs;
+	partitioner->getPointDestinationProcs( target_coords(), point_procs );
+	double search_imbalance = computeImbalance( comm, point_procs );
+
+	if ( my_rank == 0 )
+	{
+	    std::cout << std::setw(10) << names[t] 
+		      << std::setw(14) << global_max_partition_time
+		      << std::setw(13) << vertex_imbalance
+		      << std::setw(13) << search_imbalance << std::endl;
+	}
+    }
+
+    if ( my_rank == 0 )
+    {
+	std::cout << "==================================================" 
+		  << std::endl;
+    }
+
+    comm->barrier();
+
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// end partitioner_study.cpp
+//---------------------------------------------------------------------------//
@@ -464,6 +464,24 @@ int main(int argc, char* argv[])
     shared_domain_map.apply( source_evaluator, target_space_manager );
     std::clock_t apply_end = clock();
 
+    // Apply the shared domain map repeatedly with the persistent transfer
+    // plan and then with Tpetra moving the data to compare the two.
+    int num_repeat_applies = 10;
+    std::clock_t plan_apply_start = clock();
+    for ( int i = 0; i < num_repeat_applies; ++i )
+    {
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+    }
+    std::clock_t plan_apply_end = clock();
+
+    shared_domain_map.setPersistentTransfer( false );
+    std::clock_t tpetra_apply_start = clock();
+    for ( int i = 0; i < num_repeat_applies; ++i )
+    {
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+    }
+    std::clock_t tpetra_apply_end = clock();
+
     // Check the data transfer. Each target point should have been assigned
     // its source rank + 1 as data. Count the number of target points that
     // failed the test.
@@ -553,6 +571,30 @@ int main(int argc, char* argv[])
     				    &global_average_apply_time );
     global_average_apply_time /= my_size;
 
+    double local_repeat_apply_times[2];
+    local_repeat_apply_times[0] = 
+	(double)(plan_apply_end - plan_apply_start) / 
+	(CLOCKS_PER_SEC * num_repeat_applies);
+    local_repeat_apply_times[1] = 
+	(double)(tpetra_apply_end - tpetra_apply_start) / 
+	(CLOCKS_PER_SEC * num_repeat_applies);
+
+    double global_max_repeat_apply_times[2];
+    Teuchos::reduceAll<int,double>( *comm,
+				    Teuchos::REDUCE_MAX,
+				    2,
+				    local_repeat_apply_times,
+				    global_max_repeat_apply_times );
+
+    double global_average_repeat_apply_times[2];
+    Teuchos::reduceAll<int,double>( *comm,
+				    Teuchos::REDUCE_SUM,
+				    2,
+				    local_repeat_apply_times,
+				    global_average_repeat_apply_times );
+    global_average_repeat_apply_times[0] /= my_size;
+    global_average_repeat_apply_times[1] /= my_size;
+
     comm->barrier();
 
     if ( my_rank == 0 )
@@ -585,6 +627,18 @@ int main(int argc, char* argv[])
     		  << global_max_apply_time << std::endl;
     	std::cout << "Global average apply time (s): " 
     		  << global_average_apply_time << std::endl;
+	std::cout << "--------------------------------------------------"
+		  << std::endl;
+	std::cout << "Repeated applies:              " 
+		  << num_repeat_applies << std::endl;
+	std::cout << "Plan max apply time (s):       " 
+		  << global_max_repeat_apply_times[0] << std::endl;
+	std::cout << "Plan average apply time (s):   " 
+		  << global_average_repeat_apply_times[0] << std::endl;
+	std::cout << "Tpetra max apply time (s):     " 
+		  << global_max_repeat_apply_times[1] << std::endl;
+	std::cout << "Tpetra average apply time (s): " 
+		  << global_average_repeat_apply_times[1] << std::endl;
     	std::cout << "==================================================" 
     		  << std::endl;
     }
@@ -0,0 +1,291 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_BoxRouter.cpp
+ * \author Stuart R. Slattery
+ * \brief BoxRouter definition.
+ */
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "DTK_BoxRouter.hpp"
+#include "DTK_Assertion.hpp"
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_ScalarTraits.hpp>
+#include <Teuchos_Tuple.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor. This is a collective operation over the communicator.
+ *
+ * \param comm The communicator over which the points are routed.
+ *
+ * \param dimension The dimension of the routing space.
+ *
+ * \param local_box The bounding box of the local source objects.
+ *
+ * \param has_box True if this process has source objects. The local box of a
+ * process without source objects is not published.
+ *
+ * \param tolerance Absolute tolerance by which the published boxes are
+ * expanded in each dimension.
+ */
+BoxRouter::BoxRouter( const RCP_Comm& comm, const int dimension, 
+		      const BoundingBox& local_box, const bool has_box,
+		      const double tolerance )
+    : d_comm( comm )
+    , d_dimension( dimension )
+{
+    testPrecondition( 0 < dimension && dimension <= 3 );
+    testPrecondition( 0.0 <= tolerance );
+
+    // Gather the local boxes. The last entry flags if the process has a box.
+    Teuchos::Tuple<double,6> local_bounds = local_box.getBounds();
+    double send_bounds[7];
+    for ( int i = 0; i < 6; ++i )
+    {
+	send_bounds[i] = local_bounds[i];
+    }
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	send_bounds[d] -= tolerance;
+	send_bounds[d+3] += tolerance;
+    }
+    send_bounds[6] = ( has_box ) ? 1.0 : 0.0;
+
+    int comm_size = d_comm->getSize();
+    Teuchos::Array<double> all_bounds( 7*comm_size );
+    Teuchos::gatherAll<int,double>( *d_comm, 7, send_bounds, 
+				    7*comm_size, all_bounds.getRawPtr() );
+
+    // Extract the published boxes and their union.
+    double grid_upper[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+	d_grid_lower[d] = Teuchos::ScalarTraits<double>::rmax();
+	grid_upper[d] = -Teuchos::ScalarTraits<double>::rmax();
+    }
+    for ( int p = 0; p < comm_size; ++p )
+    {
+	if ( all_bounds[7*p + 6] > 0.5 )
+	{
+	    d_box_procs.push_back( p );
+	    d_box_bounds.insert( d_box_bounds.end(), 
+				 all_bounds.begin() + 7*p,
+				 all_bounds.begin() + 7*p + 6 );
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		d_grid_lower[d] = std::min( d_grid_lower[d], all_bounds[7*p+d] );
+		grid_upper[d] = std::max( grid_upper[d], all_bounds[7*p+d+3] );
+	    }
+	}
+    }
+
+    // Size a uniform grid over the union of the boxes with about one grid
+    // cell per box.
+    int num_boxes = d_box_procs.size();
+    int cells_per_dim = 1;
+    if ( num_boxes > 0 )
+    {
+	cells_per_dim = static_cast<int>( std::ceil( std::pow( 
+	    static_cast<double>(num_boxes), 1.0 / d_dimension ) ) );
+    }
+    int num_cells = 1;
+    for ( int d = 0; d < 3; ++d )
+    {
+	d_num_cells[d] = 1;
+	d_grid_width[d] = 0.0;
+	if ( d < d_dimension && d_grid_lower[d] < grid_upper[d] )
+	{
+	    d_num_cells[d] = cells_per_dim;
+	    d_grid_width[d] = 
+		( grid_upper[d] - d_grid_lower[d] ) / cells_per_dim;
+	}
+	else
+	{
+	    d_grid_lower[d] = 0.0;
+	}
+	num_cells *= d_num_cells[d];
+    }
+
+    // Get the range of grid cells overlapped by each box.
+    Teuchos::Array<int> box_cells( 6*num_boxes, 0 );
+    for ( int b = 0; b < num_boxes; ++b )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    box_cells[6*b + d] = cellIndex( d_box_bounds[6*b + d], d );
+	    box_cells[6*b + d + 3] = cellIndex( d_box_bounds[6*b + d + 3], d );
+	}
+    }
+
+    // Count the boxes in each cell and then fill the cell box lists.
+    d_cell_offsets.assign( num_cells + 1, 0 );
+    for ( int b = 0; b < num_boxes; ++b )
+    {
+	for ( int k = box_cells[6*b + 2]; k <= box_cells[6*b + 5]; ++k )
+	{
+	    for ( int j = box_cells[6*b + 1]; j <= box_cells[6*b + 4]; ++j )
+	    {
+		for ( int i = box_cells[6*b]; i <= box_cells[6*b + 3]; ++i )
+		{
+		    ++d_cell_offsets[ 
+			i + d_num_cells[0]*(j + d_num_cells[1]*k) + 1 ];
+		}
+	    }
+	}
+    }
+    std::partial_sum( d_cell_offsets.begin(), d_cell_offsets.end(),
+		      d_cell_offsets.begin() );
+
+    d_cell_boxes.resize( d_cell_offsets.back() );
+    Teuchos::Array<int> cell_fill( d_cell_offsets.begin(), 
+				   d_cell_offsets.end() - 1 );
+    for ( int b = 0; b < num_boxes; ++b )
+    {
+	for ( int k = box_cells[6*b + 2]; k <= box_cells[6*b + 5]; ++k )
+	{
+	    for ( int j = box_cells[6*b + 1]; j <= box_cells[6*b + 4]; ++j )
+	    {
+		for ( int i = box_cells[6*b]; i <= box_cells[6*b + 3]; ++i )
+		{
+		    d_cell_boxes[ cell_fill[ 
+			i + d_num_cells[0]*(j + d_num_cells[1]*k) ]++ ] = b;
+		}
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor.
+ */
+BoxRouter::~BoxRouter()
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a blocked list of points. A point
+ * is routed to every process whose box contains it. The destinations of each
+ * point are listed in increasing process order.
+ *
+ * \param coords The blocked point coordinates.
+ *
+ * \param point_indices The local index of the point for each destination.
+ *
+ * \param procs The destination process for each destination.
+ */
+void BoxRouter::routePoints( const Teuchos::ArrayView<const double>& coords,
+			     Teuchos::Array<int>& point_indices,
+			     Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( 0 == coords.size() % d_dimension );
+
+    point_indices.clear();
+    procs.clear();
+
+    int num_points = coords.size() / d_dimension;
+    double point[3] = { 0.0, 0.0, 0.0 };
+    int cell_ijk[3] = { 0, 0, 0 };
+    int cell = 0;
+    int box = 0;
+    bool in_box = false;
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	    cell_ijk[d] = cellIndex( point[d], d );
+	}
+	cell = cell_ijk[0] + 
+	       d_num_cells[0]*( cell_ijk[1] + d_num_cells[1]*cell_ijk[2] );
+
+	for ( int c = d_cell_offsets[cell]; c < d_cell_offsets[cell+1]; ++c )
+	{
+	    box = d_cell_boxes[c];
+	    in_box = true;
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		in_box = in_box && 
+			 d_box_bounds[6*box + d] <= point[d] &&
+			 point[d] <= d_box_bounds[6*box + d + 3];
+	    }
+
+	    if ( in_box )
+	    {
+		point_indices.push_back( n );
+		procs.push_back( d_box_procs[box] );
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the grid cell index of a coordinate in a given dimension.
+ * Coordinates outside of the grid are clamped to the boundary cells.
+ */
+int BoxRouter::cellIndex( const double coord, const int dim ) const
+{
+    if ( d_grid_width[dim] <= 0.0 )
+    {
+	return 0;
+    }
+
+    double cell = std::floor( (coord - d_grid_lower[dim]) / d_grid_width[dim] );
+    if ( cell < 0.0 )
+    {
+	return 0;
+    }
+    else if ( cell >= d_num_cells[dim] )
+    {
+	return d_num_cells[dim] - 1;
+    }
+    return static_cast<int>( cell );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// end DTK_BoxRouter.cpp
+//---------------------------------------------------------------------------//
@@ -0,0 +1,139 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_BoxRouter.hpp
+ * \author Stuart R. Slattery
+ * \brief BoxRouter declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_BOXROUTER_HPP
+#define DTK_BOXROUTER_HPP
+
+#include "DTK_BoundingBox.hpp"
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class BoxRouter
+ * \brief Route points directly to the processes whose local source bounding
+ * box contains them.
+
+ Each process publishes the bounding box of its local source objects and all
+ of the boxes are gathered on all processes. A point is routed to every
+ process whose box contains it such that the point can be searched for in
+ the local source objects of those processes. This avoids moving the source
+ to a rendezvous decomposition and is intended for moderate process counts
+ with compact source subdomains.
+
+ The boxes are binned into a uniform grid over their union such that routing
+ a point only tests the boxes overlapping its grid cell.
+ */
+//---------------------------------------------------------------------------//
+class BoxRouter
+{
+  public:
+
+    //@{
+    //! Typedefs.
+    typedef Teuchos::Comm<int>                   CommType;
+    typedef Teuchos::RCP<const CommType>         RCP_Comm;
+    //@}
+
+    // Constructor.
+    BoxRouter( const RCP_Comm& comm, const int dimension, 
+	       const BoundingBox& local_box, const bool has_box,
+	       const double tolerance = 0.0 );
+
+    // Destructor.
+    ~BoxRouter();
+
+    // Get the destination processes for a blocked list of points.
+    void routePoints( const Teuchos::ArrayView<const double>& coords,
+		      Teuchos::Array<int>& point_indices,
+		      Teuchos::Array<int>& procs ) const;
+
+    //! Get the number of processes that published a box.
+    int numBoxes() const
+    { return d_box_procs.size(); }
+
+  private:
+
+    // Get the grid cell index of a coordinate in a given dimension.
+    int cellIndex( const double coord, const int dim ) const;
+
+  private:
+
+    // Communicator.
+    RCP_Comm d_comm;
+
+    // Routing dimension.
+    int d_dimension;
+
+    // Process owning each box.
+    Teuchos::Array<int> d_box_procs;
+
+    // Box bounds blocked by box { x_min, y_min, z_min, x_max, y_max, z_max }.
+    Teuchos::Array<double> d_box_bounds;
+
+    // Grid lower bounds.
+    double d_grid_lower[3];
+
+    // Grid cell widths.
+    double d_grid_width[3];
+
+    // Number of grid cells in each dimension.
+    int d_num_cells[3];
+
+    // Grid cell offsets into the cell box list.
+    Teuchos::Array<int> d_cell_offsets;
+
+    // Indices of the boxes overlapping each grid cell.
+    Teuchos::Array<int> d_cell_boxes;
+};
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_BOXROUTER_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_BoxRouter.hpp
+//---------------------------------------------------------------------------//
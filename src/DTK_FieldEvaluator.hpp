@@ -129,6 +129,38 @@ class FieldEvaluator
      */
     virtual Field evaluate( const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
 			    const Teuchos::ArrayRCP<double>& coords ) = 0;
+
+    /*!
+     * \brief Evaluate the function in the given geometric objects at the
+     * given coordinates with the coordinates already mapped to the reference
+     * frame of each object. Maps that locate the points in mesh elements
+     * call this instead of evaluate() such that evaluators that override it
+     * do not have to map the coordinates to the reference frame again. The
+     * default implementation ignores the reference coordinates and calls
+     * evaluate().
+     *
+     * \param elements an array of valid geometric object global ordinals in
+     * which to evaluate the field.
+     *
+     * \param coords an array of blocked physical coordinates at which to
+     * evaluate the field as for evaluate().
+     *
+     * \param reference_coords an array of blocked coordinates { r0, r1, ...,
+     * rN, s0, s1, ..., sN, t0, t1, ..., tN } of the same dimension as the
+     * physical coordinates. Coordinates { rN, sN, tN } are the Nth point in
+     * the reference frame of the Nth element. The reference frames are those
+     * of the Intrepid reference cells. Elements without a reference frame of
+     * their own, such as pyramids, have NaN reference coordinates and their
+     * points must be located by the evaluator.
+     *
+     * \return A FieldTraits container containing the evaluated function
+     * values as for evaluate().
+     */
+    virtual Field evaluateReference( 
+	const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+	const Teuchos::ArrayRCP<double>& coords,
+	const Teuchos::ArrayRCP<double>& reference_coords )
+    { return evaluate( elements, coords ); }
 };
 
 } // end namespace DataTransferKit
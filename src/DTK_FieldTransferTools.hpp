@@ -0,0 +1,160 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+ * \file DTK_FieldTransferTools.hpp
+ * \author Stuart R. Slattery
+ * \brief FieldTransferTools declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_FIELDTRANSFERTOOLS_HPP
+#define DTK_FIELDTRANSFERTOOLS_HPP
+
+#include "DTK_FieldTraits.hpp"
+#include "DTK_FieldEvaluator.hpp"
+#include "DTK_FieldManager.hpp"
+#include "DTK_TransferPlan.hpp"
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayRCP.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class FieldTransferTools
+ * \brief A stateless class for moving function evaluations from the source
+ * decomposition of a map to its target spaces.
+ *
+ * The maps evaluate the source functions at the mapped points and move the
+ * evaluations to the target decomposition in the same way. These tools
+ * hold the parts that do not depend on the map: evaluating the source
+ * functions and packing the evaluations of several fields into the columns
+ * of a single block of data, unpacking the columns of the moved block
+ * into the target spaces, and the two phases of a split-phase apply with a
+ * TransferPlan.
+ */
+//---------------------------------------------------------------------------//
+class FieldTransferTools
+{
+  public:
+
+    //@{
+    //! Typedefs.
+    typedef Teuchos::Comm<int>                           CommType;
+    typedef Teuchos::RCP<const CommType>                 RCP_Comm;
+    //@}
+
+    //! Constructor.
+    FieldTransferTools()
+    { /* ... */ }
+
+    //! Destructor.
+    ~FieldTransferTools()
+    { /* ... */ }
+
+    // Evaluate a source function at the mapped points.
+    template<class GlobalOrdinal, class SourceField>
+    static SourceField evaluate( 
+	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& 
+	source_evaluator,
+	const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+	const Teuchos::ArrayRCP<double>& coords,
+	const Teuchos::ArrayRCP<double>& reference_coords );
+
+    // Evaluate several source functions at the mapped points and pack the
+    // evaluations into the columns of a single block of data.
+    template<class GlobalOrdinal, class SourceField>
+    static void packFields( 
+	const RCP_Comm& comm,
+	const int source_root,
+	const Teuchos::Array<Teuchos::RCP<
+	FieldEvaluator<GlobalOrdinal,SourceField> > >& source_evaluators,
+	const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+	const Teuchos::ArrayRCP<double>& coords,
+	const Teuchos::ArrayRCP<double>& reference_coords,
+	const GlobalOrdinal source_size,
+	Teuchos::ArrayRCP<typename FieldTraits<SourceField>::value_type>& 
+	source_data,
+	Teuchos::Array<int>& field_dims );
+
+    // Unpack the columns of a block of data into several target spaces.
+    template<class GlobalOrdinal, class TargetField>
+    static void unpackFields( 
+	const RCP_Comm& comm,
+	const int target_root,
+	const Teuchos::Array<int>& field_dims,
+	const Teuchos::ArrayRCP<
+	const typename FieldTraits<TargetField>::value_type>& target_data,
+	const GlobalOrdinal target_size,
+	const Teuchos::Array<Teuchos::RCP<FieldManager<TargetField> > >& 
+	target_space_managers );
+
+    // Evaluate a source function at the mapped points and post the
+    // evaluations to the target decomposition.
+    template<class GlobalOrdinal, class SourceField, class TargetField>
+    static void postField( 
+	TransferPlan& transfer_plan,
+	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& 
+	source_evaluator,
+	const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+	const Teuchos::ArrayRCP<double>& coords,
+	const Teuchos::ArrayRCP<double>& reference_coords,
+	const Teuchos::RCP<FieldManager<TargetField> >& target_space_manager,
+	const GlobalOrdinal target_size );
+
+    // Complete the posted evaluations and write them into the target space.
+    template<class TargetField>
+    static void waitField( 
+	TransferPlan& transfer_plan,
+	const Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
+};
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// Template includes.
+//---------------------------------------------------------------------------//
+
+#include "DTK_FieldTransferTools_def.hpp"
+
+//---------------------------------------------------------------------------//
+
+#endif // end DTK_FIELDTRANSFERTOOLS_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_FieldTransferTools.hpp
+//---------------------------------------------------------------------------//
@@ -0,0 +1,382 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+ * \file DTK_FieldTransferTools_def.hpp
+ * \author Stuart R. Slattery
+ * \brief FieldTransferTools template definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_FIELDTRANSFERTOOLS_DEF_HPP
+#define DTK_FIELDTRANSFERTOOLS_DEF_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+#include "DTK_FieldTools.hpp"
+#include "DTK_Assertion.hpp"
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_as.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Evaluate a source function at the mapped points.
+ *
+ * \param source_evaluator The function evaluator.
+ *
+ * \param elements The source objects the points were mapped to.
+ *
+ * \param coords The blocked coordinates of the points.
+ *
+ * \param reference_coords The blocked coordinates of the points in the
+ * reference frame of their source object. If null the points are evaluated
+ * with evaluate() instead of evaluateReference().
+ *
+ * \return The function evaluations.
+ */
+template<class GlobalOrdinal, class SourceField>
+SourceField FieldTransferTools::evaluate( 
+    const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& 
+    source_evaluator,
+    const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+    const Teuchos::ArrayRCP<double>& coords,
+    const Teuchos::ArrayRCP<double>& reference_coords )
+{
+    testPrecondition( !source_evaluator.is_null() );
+
+    if ( reference_coords.is_null() )
+    {
+	return source_evaluator->evaluate( elements, coords );
+    }
+    return source_evaluator->evaluateReference( 
+	elements, coords, reference_coords );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Evaluate several source functions at the mapped points and pack the
+ * evaluations into the columns of a single block of data such that all of
+ * the fields can be moved to the target decomposition at once. This is a
+ * collective operation.
+ *
+ * \param comm The communicator of the map.
+ *
+ * \param source_root A process with source. The field dimensions are
+ * broadcast from it.
+ *
+ * \param source_evaluators The function evaluators, one for each field. An
+ * evaluator may be null on processes without source.
+ *
+ * \param elements The source objects the points were mapped to.
+ *
+ * \param coords The blocked coordinates of the points.
+ *
+ * \param reference_coords The blocked coordinates of the points in the
+ * reference frame of their source object or null.
+ *
+ * \param source_size The number of mapped points.
+ *
+ * \param source_data The evaluations of all of the fields blocked by field
+ * and then by dimension.
+ *
+ * \param field_dims The dimension of each field.
+ */
+template<class GlobalOrdinal, class SourceField>
+void FieldTransferTools::packFields( 
+    const RCP_Comm& comm,
+    const int source_root,
+    const Teuchos::Array<Teuchos::RCP<
+    FieldEvaluator<GlobalOrdinal,SourceField> > >& source_evaluators,
+    const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+    const Teuchos::ArrayRCP<double>& coords,
+    const Teuchos::ArrayRCP<double>& reference_coords,
+    const GlobalOrdinal source_size,
+    Teuchos::ArrayRCP<typename FieldTraits<SourceField>::value_type>& 
+    source_data,
+    Teuchos::Array<int>& field_dims )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef typename SFT::value_type source_value_type;
+
+    int num_fields = source_evaluators.size();
+
+    // Evaluate all of the source functions at the target points.
+    field_dims.assign( num_fields, 0 );
+    Teuchos::Array<Teuchos::ArrayRCP<source_value_type> > 
+	source_field_copies( num_fields );
+    for ( int f = 0; f < num_fields; ++f )
+    {
+	if ( !source_evaluators[f].is_null() )
+	{
+	    SourceField function_evaluations = evaluate( 
+		source_evaluators[f], elements, coords, reference_coords );
+
+	    field_dims[f] = SFT::dim( function_evaluations );
+
+	    source_field_copies[f] = 
+		FieldTools<SourceField>::copy( function_evaluations );
+	}
+    }
+    comm->barrier();
+    if ( num_fields > 0 )
+    {
+	Teuchos::broadcast<int,int>( *comm, source_root,
+				     num_fields, &field_dims[0] );
+    }
+
+    // Pack the function evaluations into the columns of a single block.
+    int num_columns = std::accumulate( field_dims.begin(), 
+				       field_dims.end(), 0 );
+    source_data = Teuchos::ArrayRCP<source_value_type>( 
+	num_columns*source_size, 0 );
+    int column = 0;
+    for ( int f = 0; f < num_fields; ++f )
+    {
+	if ( !source_evaluators[f].is_null() )
+	{
+	    testInvariant( Teuchos::as<GlobalOrdinal>(
+			       source_field_copies[f].size()) == 
+			   field_dims[f]*source_size );
+	    std::copy( source_field_copies[f].begin(),
+		       source_field_copies[f].end(),
+		       source_data.begin() + column*source_size );
+	}
+	column += field_dims[f];
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Unpack the columns of a block of data moved to the target
+ * decomposition into several target spaces. This is a collective operation.
+ *
+ * \param comm The communicator of the map.
+ *
+ * \param target_root A process with target points. The target space
+ * dimensions are broadcast from it.
+ *
+ * \param field_dims The dimension of each field as given by packFields().
+ * The target spaces must have the same dimensions.
+ *
+ * \param target_data The moved data blocked by field and then by
+ * dimension.
+ *
+ * \param target_size The number of target points.
+ *
+ * \param target_space_managers The target spaces, one for each field. Enough
+ * space must be allocated to hold evaluations at all points in all
+ * dimensions of each field. A target space may be null on processes without
+ * target points.
+ */
+template<class GlobalOrdinal, class TargetField>
+void FieldTransferTools::unpackFields( 
+    const RCP_Comm& comm,
+    const int target_root,
+    const Teuchos::Array<int>& field_dims,
+    const Teuchos::ArrayRCP<
+    const typename FieldTraits<TargetField>::value_type>& target_data,
+    const GlobalOrdinal target_size,
+    const Teuchos::Array<Teuchos::RCP<FieldManager<TargetField> > >& 
+    target_space_managers )
+{
+    typedef FieldTraits<TargetField> TFT;
+
+    int num_fields = target_space_managers.size();
+    testPrecondition( Teuchos::as<int>(field_dims.size()) == num_fields );
+
+    // Get the dimensions of the target spaces.
+    Teuchos::Array<int> target_dims( num_fields, 0 );
+    for ( int f = 0; f < num_fields; ++f )
+    {
+	if ( !target_space_managers[f].is_null() )
+	{
+	    target_dims[f] = TFT::dim( *target_space_managers[f]->field() );
+	}
+    }
+    comm->barrier();
+    if ( num_fields > 0 )
+    {
+	Teuchos::broadcast<int,int>( *comm, target_root,
+				     num_fields, &target_dims[0] );
+    }
+
+    // Check that the source and target have the same field dimensions.
+    testPrecondition( field_dims == target_dims );
+
+    // Unpack the columns into the target spaces.
+    int column = 0;
+    for ( int f = 0; f < num_fields; ++f )
+    {
+	if ( !target_space_managers[f].is_null() )
+	{
+	    testPrecondition( 
+		Teuchos::as<GlobalOrdinal>( std::distance(
+		    TFT::begin( *target_space_managers[f]->field() ),
+		    TFT::end( *target_space_managers[f]->field() ) ) ) ==
+		target_dims[f]*target_size );
+	    std::copy( target_data.begin() + column*target_size,
+		       target_data.begin() + 
+		       (column + target_dims[f])*target_size,
+		       TFT::begin( *target_space_managers[f]->field() ) );
+	}
+	column += target_dims[f];
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Evaluate a source function at the mapped points and post the
+ * evaluations to the target decomposition without waiting for the
+ * communication to complete. Processes without a source post the receives
+ * for the target space. This does not synchronize the processes.
+ *
+ * \param transfer_plan The communication plan of the map. No messages may
+ * be posted.
+ *
+ * \param source_evaluator The function evaluator. May be null on processes
+ * without source.
+ *
+ * \param elements The source objects the points were mapped to.
+ *
+ * \param coords The blocked coordinates of the points.
+ *
+ * \param reference_coords The blocked coordinates of the points in the
+ * reference frame of their source object or null.
+ *
+ * \param target_space_manager The target space. Enough space must be
+ * allocated to hold evaluations at all points in all dimensions of the
+ * field. The field must have the same dimension as the function
+ * evaluations. May be null on processes without target points.
+ *
+ * \param target_size The number of target points.
+ */
+template<class GlobalOrdinal, class SourceField, class TargetField>
+void FieldTransferTools::postField( 
+    TransferPlan& transfer_plan,
+    const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& 
+    source_evaluator,
+    const Teuchos::ArrayRCP<GlobalOrdinal>& elements,
+    const Teuchos::ArrayRCP<double>& coords,
+    const Teuchos::ArrayRCP<double>& reference_coords,
+    const Teuchos::RCP<FieldManager<TargetField> >& target_space_manager,
+    const GlobalOrdinal target_size )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef FieldTraits<TargetField> TFT;
+
+    testPrecondition( !transfer_plan.isPosted() );
+
+    // Get the dimension of the target space and verify that it has the
+    // proper amount of memory allocated.
+    int num_columns = 0;
+    if ( !target_space_manager.is_null() )
+    {
+	num_columns = TFT::dim( *target_space_manager->field() );
+	testPrecondition( 
+	    Teuchos::as<GlobalOrdinal>( std::distance(
+		TFT::begin( *target_space_manager->field() ),
+		TFT::end( *target_space_manager->field() ) ) ) ==
+	    num_columns*target_size );
+    }
+
+    // Evaluate the source function at the target points and post the
+    // function evaluations to the target decomposition.
+    if ( !source_evaluator.is_null() )
+    {
+	SourceField function_evaluations = evaluate( 
+	    source_evaluator, elements, coords, reference_coords );
+
+	testPrecondition( target_space_manager.is_null() ||
+			  SFT::dim( function_evaluations ) == num_columns );
+	num_columns = SFT::dim( function_evaluations );
+
+	Teuchos::ArrayRCP<const typename SFT::value_type> source_data =
+	    FieldTools<SourceField>::view( function_evaluations );
+	transfer_plan.doPosts( source_data(), num_columns );
+    }
+    else
+    {
+	transfer_plan.doPosts( 
+	    Teuchos::ArrayView<const typename TFT::value_type>(), 
+	    num_columns );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Complete the evaluations posted by postField() and write them into
+ * the target space. Target points that were not mapped get zeros.
+ *
+ * \param transfer_plan The communication plan of the map. Messages must
+ * have been posted.
+ *
+ * \param target_space_manager The target space given to postField().
+ */
+template<class TargetField>
+void FieldTransferTools::waitField( 
+    TransferPlan& transfer_plan,
+    const Teuchos::RCP<FieldManager<TargetField> >& target_space_manager )
+{
+    testPrecondition( transfer_plan.isPosted() );
+
+    // Fill the target space with zeros so that points we didn't map get some
+    // data and get a view of it.
+    Teuchos::ArrayRCP<typename FieldTraits<TargetField>::value_type> 
+	target_field_view(0,0);
+    if ( !target_space_manager.is_null() )
+    {
+	FieldTools<TargetField>::putScalar( 
+	    *target_space_manager->field(), 0.0 );
+
+	target_field_view = FieldTools<TargetField>::nonConstView( 
+	    *target_space_manager->field() );
+    }
+
+    // Wait for the function evaluations and unpack them into the target
+    // space.
+    transfer_plan.doWaits( target_field_view() );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_FIELDTRANSFERTOOLS_DEF_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_FieldTransferTools_def.hpp
+//---------------------------------------------------------------------------//
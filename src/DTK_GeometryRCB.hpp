@@ -45,6 +45,7 @@
 
 #include "DTK_Partitioner.hpp"
 #include "DTK_BoundingBox.hpp"
+#include "DTK_RCBCutTree.hpp"
 #include "DTK_GeometryTraits.hpp"
 #include "DTK_GeometryManager.hpp"
 
@@ -94,11 +95,21 @@ class GeometryRCB : public Partitioner
     void partition();
 
     // Get the destination process for a point given its coordinates.
-    int getPointDestinationProc( Teuchos::Array<double> coords ) const;
+    int getPointDestinationProc( const Teuchos::Array<double>& coords ) const;
 
     // Get the destination processes for a bounding box.
     Teuchos::Array<int> getBoxDestinationProcs( const BoundingBox& box ) const;
 
+    // Get the destination processes for a blocked list of points.
+    void getPointDestinationProcs( 
+	const Teuchos::ArrayView<const double>& coords,
+	Teuchos::Array<int>& procs ) const;
+
+    // Get the destination processes for a list of bounding boxes.
+    void getBoxDestinationProcs( 
+	const Teuchos::Array<BoundingBox>& boxes,
+	Teuchos::Array<Teuchos::Array<int> >& procs ) const;
+
     //! Get the number of imported vertices.
     int getNumImport() const
     { return d_num_import; }
@@ -176,6 +187,9 @@ class GeometryRCB : public Partitioner
     // Zoltan struct.
     Zoltan_Struct *d_zz;
 
+    // Local replica of the kept RCB cuts.
+    RCBCutTree d_cut_tree;
+
     // 1 if partitioning was changed, 0 otherwise.
     int d_changes;
 
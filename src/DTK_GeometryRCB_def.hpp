@@ -167,6 +167,30 @@ void GeometryRCB<Geometry,GlobalOrdinal>::partition()
 			 &d_export_to_part );
 #endif
     testInvariant( zoltan_error == ZOLTAN_OK );
+
+    // Replicate the kept cuts locally for destination queries. The
+    // partition boxes are local to each process once the cuts are kept so no
+    // communication occurs here.
+    int num_parts = d_comm->getSize();
+    Teuchos::Array<double> part_bounds( 6*num_parts );
+    int zoltan_dim = 0;
+    rememberValue( int box_error );
+    for ( int p = 0; p < num_parts; ++p )
+    {
+#if HAVE_DTK_DBC
+	box_error = Zoltan_RCB_Box( d_zz, p, &zoltan_dim,
+				   &part_bounds[6*p], &part_bounds[6*p+1],
+				   &part_bounds[6*p+2], &part_bounds[6*p+3],
+				   &part_bounds[6*p+4], &part_bounds[6*p+5] );
+#else
+	Zoltan_RCB_Box( d_zz, p, &zoltan_dim,
+			&part_bounds[6*p], &part_bounds[6*p+1], 
+			&part_bounds[6*p+2], &part_bounds[6*p+3], 
+			&part_bounds[6*p+4], &part_bounds[6*p+5] );
+#endif
+	testInvariant( box_error == ZOLTAN_OK );
+    }
+    d_cut_tree.build( part_bounds, d_dimension );
 }
 
 //---------------------------------------------------------------------------//
@@ -174,27 +198,18 @@ void GeometryRCB<Geometry,GlobalOrdinal>::partition()
  * \brief Get the destination process for a point given its coordinates.
  *
  * \param coords Point coordinates. The dimension of the point must be equal
- * to or less than one.
+ * to the GeometryRCB dimension.
  *
  * \return The GeometryRCB destination proc for the point.
  */
 template<class Geometry, class GlobalOrdinal>
 int GeometryRCB<Geometry,GlobalOrdinal>::getPointDestinationProc( 
-    Teuchos::Array<double> coords ) const
+    const Teuchos::Array<double>& coords ) const
 {
     testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
     testPrecondition( d_dimension == Teuchos::as<int>(coords.size()) );
 
-    int proc = 0;
-    rememberValue( int zoltan_error );
-#if HAVE_DTK_DBC
-    zoltan_error = Zoltan_LB_Point_Assign( d_zz, &coords[0], &proc );
-#else
-    Zoltan_LB_Point_Assign( d_zz, &coords[0], &proc );
-#endif
-    testInvariant( zoltan_error == ZOLTAN_OK );
-
-    return proc;
+    return d_cut_tree.pointDestinationProc( coords.getRawPtr() );
 }
 
 //---------------------------------------------------------------------------//
@@ -208,32 +223,51 @@ int GeometryRCB<Geometry,GlobalOrdinal>::getPointDestinationProc(
  */
 template<class Geometry, class GlobalOrdinal>
 Teuchos::Array<int>
-GeometryRCB<Geometry,GlobalOrdinal>::getBoxDestinationProcs( 
-    const BoundingBox& box ) const
+GeometryRCB<Geometry,GlobalOrdinal>::getBoxDestinationProcs( const BoundingBox& box ) const
 {
-    Teuchos::Tuple<double,6> box_bounds = box.getBounds();
-
-    int num_procs = 0;
-    Teuchos::Array<int> procs( d_comm->getSize() );
-
-    rememberValue( int zoltan_error );
-#if HAVE_DTK_DBC
-    zoltan_error = Zoltan_LB_Box_Assign( d_zz, 
-					 box_bounds[0], box_bounds[1], 
-					 box_bounds[2], box_bounds[3], 
-					 box_bounds[4], box_bounds[5], 
-					 &procs[0], &num_procs );
-#else
-    Zoltan_LB_Box_Assign( d_zz, 
-			  box_bounds[0], box_bounds[1], box_bounds[2],
-			  box_bounds[3], box_bounds[4], box_bounds[5], 
-			  &procs[0], &num_procs );
-#endif
-    testInvariant( zoltan_error == ZOLTAN_OK );
+    Teuchos::Array<int> procs;
+    d_cut_tree.boxDestinationProcs( box, procs );
+    return procs;
+}
 
-    procs.resize( num_procs );
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a blocked list of points.
+ *
+ * \param coords Point coordinates blocked by dimension. The dimension of the
+ * points must be equal to the GeometryRCB dimension.
+ *
+ * \param procs The GeometryRCB destination proc for each point in the same order as
+ * the points.
+ */
+template<class Geometry, class GlobalOrdinal>
+void GeometryRCB<Geometry,GlobalOrdinal>::getPointDestinationProcs( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( coords.size() % d_dimension == 0 );
+    d_cut_tree.pointDestinationProcs( coords, procs );
+}
 
-    return procs;
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a list of bounding boxes.
+ *
+ * \param boxes The bounding boxes to get the destinations for.
+ *
+ * \param procs The GeometryRCB destination procs for each box in the same order as
+ * the boxes.
+ */
+template<class Geometry, class GlobalOrdinal>
+void GeometryRCB<Geometry,GlobalOrdinal>::getBoxDestinationProcs( 
+    const Teuchos::Array<BoundingBox>& boxes,
+    Teuchos::Array<Teuchos::Array<int> >& procs ) const
+{
+    procs.resize( boxes.size() );
+    for ( int i = 0; i < Teuchos::as<int>(boxes.size()); ++i )
+    {
+	d_cut_tree.boxDestinationProcs( boxes[i], procs[i] );
+    }
 }
 
 //---------------------------------------------------------------------------//
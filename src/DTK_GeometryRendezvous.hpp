@@ -96,7 +96,9 @@ class GeometryRendezvous
 
     // Constructor.
     GeometryRendezvous( const RCP_Comm& comm, const int dimension,
-			const BoundingBox& global_box );
+			const BoundingBox& global_box,
+			const DTK_PartitionerType partitioner_type = 
+			DTK_RCB_PARTITIONER );
 
     // Destructor.
     ~GeometryRendezvous();
@@ -151,6 +153,9 @@ class GeometryRendezvous
     // Bounding box in which to perform the rendezvous.
     BoundingBox d_global_box;
 
+    // Rendezvous partitioning algorithm.
+    DTK_PartitionerType d_partitioner_type;
+
     // Rendezvous partitioning.
     RCP_Partitioner d_partitioner;
 
@@ -72,15 +72,20 @@ namespace DataTransferKit
  *
  * \param global_box The global bounding box inside of which the rendezvous
  * decomposition will be generated.
+ *
+ * \param partitioner_type The algorithm used to compute the rendezvous
+ * partitioning.
  */
 template<class Geometry, class GlobalOrdinal>
 GeometryRendezvous<Geometry,GlobalOrdinal>::GeometryRendezvous( 
     const RCP_Comm& comm,
     const int dimension,
-    const BoundingBox& global_box )
+    const BoundingBox& global_box,
+    const DTK_PartitionerType partitioner_type )
     : d_comm( comm )
     , d_dimension( dimension )
     , d_global_box( global_box )
+    , d_partitioner_type( partitioner_type )
 { /* ... */ }
 
 //---------------------------------------------------------------------------//
@@ -116,7 +121,7 @@ void GeometryRendezvous<Geometry,GlobalOrdinal>::build(
     // Construct the rendezvous partitioning for the geometry using the
     // vertices that are in the box.
     d_partitioner = PartitionerFactory::createGeometryPartitioner( 
-	d_comm, geometry_manager, d_dimension );
+	d_comm, geometry_manager, d_dimension, d_partitioner_type );
     testPostcondition( !d_partitioner.is_null() );
     d_partitioner->partition();
 
@@ -141,18 +146,9 @@ Teuchos::Array<int>
 GeometryRendezvous<Geometry,GlobalOrdinal>::procsContainingPoints(
     const Teuchos::ArrayRCP<double>& coords ) const
 {
-    Teuchos::Array<double> point( d_dimension );
-    GlobalOrdinal num_points = coords.size() / d_dimension;
-    Teuchos::Array<int> destination_procs( num_points );
-    for ( GlobalOrdinal n = 0; n < num_points; ++n )
-    {
-	for ( int d = 0; d < d_dimension; ++d )
-	{
-	    point[d] = coords[ d*num_points + n ];
-	}
-	destination_procs[n] = d_partitioner->getPointDestinationProc( point );
-    }
-
+    Teuchos::Array<int> destination_procs;
+    d_partitioner->getPointDestinationProcs( coords.getConst()(), 
+					     destination_procs );
     return destination_procs;
 }
 
@@ -172,16 +168,8 @@ Teuchos::Array<Teuchos::Array<int> >
 GeometryRendezvous<Geometry,GlobalOrdinal>::procsContainingBoxes( 
     const Teuchos::Array<BoundingBox>& boxes ) const
 {
-    Teuchos::Array<Teuchos::Array<int> > box_procs( boxes.size() );
-    Teuchos::Array<Teuchos::Array<int> >::iterator proc_iterator;
-    Teuchos::Array<BoundingBox>::const_iterator box_iterator;
-    for ( box_iterator = boxes.begin(), proc_iterator = box_procs.begin();
-	  box_iterator != boxes.end();
-	  ++box_iterator, ++proc_iterator )
-    {
-	*proc_iterator = d_partitioner->getBoxDestinationProcs( *box_iterator );
-    }
-
+    Teuchos::Array<Teuchos::Array<int> > box_procs;
+    d_partitioner->getBoxDestinationProcs( boxes, box_procs );
     return box_procs;
 }
 
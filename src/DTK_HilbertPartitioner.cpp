@@ -0,0 +1,508 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_HilbertPartitioner.cpp
+ * \author Stuart R. Slattery
+ * \brief HilbertPartitioner definition.
+ */
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "DTK_HilbertPartitioner.hpp"
+#include "DTK_Assertion.hpp"
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_Tuple.hpp>
+#include <Teuchos_as.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor.
+ *
+ * \param comm The communicator over which to partition the points.
+ *
+ * \param dimension The dimension of the partitioning space.
+ */
+HilbertPartitioner::HilbertPartitioner( const RCP_Comm& comm, 
+					const int dimension )
+    : d_comm( comm )
+    , d_dimension( dimension )
+    , d_bits( (3 == dimension) ? 21 : 31 )
+{
+    testPrecondition( 0 < dimension && dimension <= 3 );
+
+    for ( int d = 0; d < 3; ++d )
+    {
+	d_lower[d] = 0.0;
+	d_scale[d] = 0.0;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor.
+ */
+HilbertPartitioner::~HilbertPartitioner()
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the local points to partition.
+ *
+ * \param coords The local point coordinates blocked by dimension.
+ *
+ * \param weights The weight of each local point. If empty, all points have
+ * unit weight.
+ */
+void HilbertPartitioner::setPoints( 
+    const Teuchos::ArrayView<const double>& coords,
+    const Teuchos::ArrayView<const float>& weights )
+{
+    testPrecondition( coords.size() % d_dimension == 0 );
+    testPrecondition( weights.size() == 0 || 
+		      weights.size() == coords.size() / d_dimension );
+
+    d_coords.assign( coords.begin(), coords.end() );
+    if ( weights.size() > 0 )
+    {
+	d_weights.assign( weights.begin(), weights.end() );
+    }
+    else
+    {
+	d_weights.assign( coords.size() / d_dimension, 1.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the partitioning of the points. This is a collective
+ * operation.
+ */
+void HilbertPartitioner::partition()
+{
+    int num_points = d_weights.size();
+
+    // Compute the global bounding box of the points.
+    Teuchos::Tuple<double,3> local_lower, local_upper, lower, upper;
+    for ( int d = 0; d < 3; ++d )
+    {
+	local_lower[d] = std::numeric_limits<double>::max();
+	local_upper[d] = -std::numeric_limits<double>::max();
+	for ( int n = 0; n < num_points && d < d_dimension; ++n )
+	{
+	    local_lower[d] = std::min( local_lower[d], 
+				       d_coords[ d*num_points + n ] );
+	    local_upper[d] = std::max( local_upper[d], 
+				       d_coords[ d*num_points + n ] );
+	}
+    }
+    Teuchos::reduceAll<int,double>( *d_comm, Teuchos::REDUCE_MIN, 3,
+				    local_lower.getRawPtr(), 
+				    lower.getRawPtr() );
+    Teuchos::reduceAll<int,double>( *d_comm, Teuchos::REDUCE_MAX, 3,
+				    local_upper.getRawPtr(), 
+				    upper.getRawPtr() );
+
+    // Build the grid over the bounding box.
+    double num_cells = std::ldexp( 1.0, d_bits );
+    for ( int d = 0; d < 3; ++d )
+    {
+	d_lower[d] = 0.0;
+	d_scale[d] = 0.0;
+	if ( d < d_dimension && lower[d] <= upper[d] )
+	{
+	    d_lower[d] = lower[d];
+	    if ( upper[d] > lower[d] )
+	    {
+		d_scale[d] = num_cells / ( upper[d] - lower[d] );
+	    }
+	}
+    }
+
+    // Sort the local keys and compute the prefix sums of their weights.
+    Teuchos::Array<std::pair<key_type,float> > local_keys( num_points );
+    double point[3];
+    unsigned int cell[3];
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = d_coords[ d*num_points + n ];
+	}
+	pointCell( point, cell );
+	local_keys[n] = std::make_pair( cellKey( cell ), d_weights[n] );
+    }
+    std::sort( local_keys.begin(), local_keys.end() );
+
+    Teuchos::Array<key_type> keys( num_points );
+    Teuchos::Array<double> prefix_weights( num_points + 1, 0.0 );
+    for ( int n = 0; n < num_points; ++n )
+    {
+	keys[n] = local_keys[n].first;
+	prefix_weights[n+1] = prefix_weights[n] + local_keys[n].second;
+    }
+    local_keys.clear();
+
+    double total_weight = 0.0;
+    Teuchos::reduceAll<int,double>( *d_comm, Teuchos::REDUCE_SUM,
+				    prefix_weights.back(),
+				    Teuchos::Ptr<double>(&total_weight) );
+
+    // Bisect the key space for all of the splitters at once. Splitter s
+    // is the smallest key with at least (s+1)/P of the total weight below
+    // it. All processes hold the same reduced weights and therefore take
+    // the same branches.
+    int num_splitters = d_comm->getSize() - 1;
+    key_type max_key = 
+	static_cast<key_type>(1) << ( d_dimension*d_bits );
+    Teuchos::Array<key_type> lower_keys( num_splitters, 0 );
+    Teuchos::Array<key_type> upper_keys( num_splitters, max_key );
+    Teuchos::Array<key_type> mid_keys( num_splitters );
+    Teuchos::Array<double> local_below( num_splitters );
+    Teuchos::Array<double> global_below( num_splitters );
+    bool converged = ( 0 == num_splitters );
+    while ( !converged )
+    {
+	for ( int s = 0; s < num_splitters; ++s )
+	{
+	    mid_keys[s] = 
+		lower_keys[s] + ( upper_keys[s] - lower_keys[s] ) / 2;
+	    local_below[s] = prefix_weights[
+		std::lower_bound( keys.begin(), keys.end(), mid_keys[s] )
+		- keys.begin() ];
+	}
+
+	Teuchos::reduceAll<int,double>( *d_comm, Teuchos::REDUCE_SUM,
+					num_splitters,
+					local_below.getRawPtr(),
+					global_below.getRawPtr() );
+
+	converged = true;
+	for ( int s = 0; s < num_splitters; ++s )
+	{
+	    if ( lower_keys[s] < upper_keys[s] )
+	    {
+		if ( global_below[s] >= 
+		     (s+1) * total_weight / (num_splitters+1) )
+		{
+		    upper_keys[s] = mid_keys[s];
+		}
+		else
+		{
+		    lower_keys[s] = mid_keys[s] + 1;
+		}
+	    }
+	    converged = converged && ( lower_keys[s] == upper_keys[s] );
+	}
+    }
+
+    d_splitters = lower_keys;
+
+    testPostcondition( std::adjacent_find( 
+			   d_splitters.begin(), d_splitters.end(),
+			   std::greater<key_type>() ) == d_splitters.end() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination process for a point given its coordinates.
+ *
+ * \param coords Point coordinates. The dimension of the point must be equal
+ * to the partitioning dimension.
+ *
+ * \return The destination proc for the point.
+ */
+int HilbertPartitioner::getPointDestinationProc( 
+    const Teuchos::Array<double>& coords ) const
+{
+    testPrecondition( d_dimension == Teuchos::as<int>(coords.size()) );
+
+    unsigned int cell[3];
+    pointCell( coords.getRawPtr(), cell );
+    return keyDestinationProc( cellKey( cell ) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a bounding box. This includes all
+ * process domains that the box intersects.
+ *
+ * \param box The bounding box to get the destinations for.
+ *
+ * \return The destination procs for the box.
+ */
+Teuchos::Array<int> 
+HilbertPartitioner::getBoxDestinationProcs( const BoundingBox& box ) const
+{
+    Teuchos::Tuple<double,6> bounds = box.getBounds();
+    unsigned int box_lo[3], box_hi[3];
+    pointCell( &bounds[0], box_lo );
+    pointCell( &bounds[3], box_hi );
+
+    Teuchos::Array<int> procs;
+    unsigned int origin[3] = { 0, 0, 0 };
+    collectBoxProcs( origin, 0, box_lo, box_hi, procs );
+
+    std::sort( procs.begin(), procs.end() );
+    procs.erase( std::unique( procs.begin(), procs.end() ), procs.end() );
+    return procs;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a blocked list of points.
+ *
+ * \param coords Point coordinates blocked by dimension. The dimension of the
+ * points must be equal to the partitioning dimension.
+ *
+ * \param procs The destination proc for each point in the same order as the
+ * points.
+ */
+void HilbertPartitioner::getPointDestinationProcs( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( coords.size() % d_dimension == 0 );
+
+    int num_points = coords.size() / d_dimension;
+    procs.resize( num_points );
+    double point[3];
+    unsigned int cell[3];
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	pointCell( point, cell );
+	procs[n] = keyDestinationProc( cellKey( cell ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a list of bounding boxes.
+ *
+ * \param boxes The bounding boxes to get the destinations for.
+ *
+ * \param procs The destination procs for each box in the same order as the
+ * boxes.
+ */
+void HilbertPartitioner::getBoxDestinationProcs( 
+    const Teuchos::Array<BoundingBox>& boxes,
+    Teuchos::Array<Teuchos::Array<int> >& procs ) const
+{
+    procs.resize( boxes.size() );
+    for ( int i = 0; i < Teuchos::as<int>(boxes.size()); ++i )
+    {
+	procs[i] = getBoxDestinationProcs( boxes[i] );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the grid cell of a point. Points outside of the grid are in
+ * the nearest cell.
+ */
+void HilbertPartitioner::pointCell( const double point[], 
+				    unsigned int cell[] ) const
+{
+    double max_index = std::ldexp( 1.0, d_bits ) - 1.0;
+    double index = 0.0;
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	index = std::floor( (point[d] - d_lower[d]) * d_scale[d] );
+	index = std::max( 0.0, std::min( index, max_index ) );
+	cell[d] = static_cast<unsigned int>( index );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the Hilbert key of a grid cell. This is the transpose
+ * algorithm of Skilling (2004), followed by interleaving the transposed bits
+ * into a single key.
+ */
+HilbertPartitioner::key_type 
+HilbertPartitioner::cellKey( const unsigned int cell[] ) const
+{
+    unsigned int x[3];
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	x[d] = cell[d];
+    }
+
+    // Undo the excess work.
+    unsigned int m = 1u << (d_bits-1);
+    unsigned int p = 0;
+    unsigned int t = 0;
+    for ( unsigned int q = m; q > 1; q >>= 1 )
+    {
+	p = q - 1;
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    if ( x[d] & q )
+	    {
+		x[0] ^= p;
+	    }
+	    else
+	    {
+		t = ( x[0] ^ x[d] ) & p;
+		x[0] ^= t;
+		x[d] ^= t;
+	    }
+	}
+    }
+
+    // Gray encode.
+    for ( int d = 1; d < d_dimension; ++d )
+    {
+	x[d] ^= x[d-1];
+    }
+    t = 0;
+    for ( unsigned int q = m; q > 1; q >>= 1 )
+    {
+	if ( x[d_dimension-1] & q )
+	{
+	    t ^= q - 1;
+	}
+    }
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	x[d] ^= t;
+    }
+
+    // Interleave the transposed bits from the most significant bit down.
+    key_type key = 0;
+    for ( int b = d_bits - 1; b >= 0; --b )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    key = ( key << 1 ) | ( (x[d] >> b) & 1u );
+	}
+    }
+    return key;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination process for a key.
+ */
+int HilbertPartitioner::keyDestinationProc( const key_type key ) const
+{
+    return std::upper_bound( d_splitters.begin(), d_splitters.end(), key )
+	- d_splitters.begin();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Recursively collect the processes owning the keys of the grid cells
+ * a box intersects. The keys of the aligned cell at the given origin and
+ * level are a single contiguous range of the curve.
+ */
+void HilbertPartitioner::collectBoxProcs( const unsigned int origin[], 
+					  const int level,
+					  const unsigned int box_lo[],
+					  const unsigned int box_hi[],
+					  Teuchos::Array<int>& procs ) const
+{
+    unsigned int size = 1u << ( d_bits - level );
+    key_type num_keys = 
+	static_cast<key_type>(1) << ( d_dimension*(d_bits - level) );
+    key_type first_key = cellKey( origin ) & ~( num_keys - 1 );
+    int first_proc = keyDestinationProc( first_key );
+    int last_proc = keyDestinationProc( first_key + num_keys - 1 );
+
+    // All of the cell is on a single process.
+    if ( first_proc == last_proc )
+    {
+	procs.push_back( first_proc );
+	return;
+    }
+
+    // The cell is entirely inside of the box. Every process between the
+    // first and the last with a nonempty key range owns part of it.
+    bool inside = true;
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	inside = inside && ( box_lo[d] <= origin[d] ) && 
+		 ( origin[d] + (size-1) <= box_hi[d] );
+    }
+    if ( inside )
+    {
+	procs.push_back( first_proc );
+	for ( int p = first_proc + 1; p <= last_proc; ++p )
+	{
+	    if ( p == last_proc || d_splitters[p-1] < d_splitters[p] )
+	    {
+		procs.push_back( p );
+	    }
+	}
+	return;
+    }
+
+    // Otherwise descend into the children that intersect the box.
+    unsigned int half = size >> 1;
+    unsigned int child[3];
+    bool intersects = true;
+    for ( int c = 0; c < (1 << d_dimension); ++c )
+    {
+	intersects = true;
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    child[d] = origin[d] + ( (c >> d) & 1 ) * half;
+	    intersects = intersects && ( child[d] <= box_hi[d] ) &&
+			 ( box_lo[d] <= child[d] + (half-1) );
+	}
+	if ( intersects )
+	{
+	    collectBoxProcs( child, level + 1, box_lo, box_hi, procs );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// end DTK_HilbertPartitioner.cpp
+//---------------------------------------------------------------------------//
@@ -0,0 +1,176 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_HilbertPartitioner.hpp
+ * \author Stuart R. Slattery
+ * \brief HilbertPartitioner declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_HILBERTPARTITIONER_HPP
+#define DTK_HILBERTPARTITIONER_HPP
+
+#include "DTK_Partitioner.hpp"
+#include "DTK_BoundingBox.hpp"
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class HilbertPartitioner
+ * \brief Hilbert space-filling curve partitioner.
+
+ The global bounding box of a set of weighted points is divided into a
+ uniform grid of \f$2^b\f$ cells in each dimension and each point is given
+ the Hilbert curve index of its cell. The curve is then cut into one
+ contiguous range of keys per process such that each process owns an equal
+ share of the total point weight. The cut keys are found by a simultaneous
+ bisection search over the key space for all processes with one sum
+ reduction per bisection step. The points themselves are never moved or
+ sorted globally.
+
+ After partitioning every process holds all of the cut keys such that a point
+ destination is the key of its cell followed by a binary search. A box is
+ assigned by recursively descending the aligned cells of the grid that it
+ intersects. The keys of an aligned cell form a single contiguous range on
+ the curve so a cell is resolved as soon as its range falls within a single
+ process or the cell is entirely inside of the box.
+
+ Points outside of the partitioned bounding box are assigned to the nearest
+ grid cell.
+ */
+//---------------------------------------------------------------------------//
+class HilbertPartitioner : public Partitioner
+{
+  public:
+
+    //@{
+    //! Typedefs.
+    typedef Teuchos::Comm<int>                  CommType;
+    typedef Teuchos::RCP<const CommType>        RCP_Comm;
+    typedef unsigned long long                  key_type;
+    //@}
+
+    // Constructor.
+    HilbertPartitioner( const RCP_Comm& comm, const int dimension );
+
+    // Destructor.
+    ~HilbertPartitioner();
+
+    // Set the local points to partition.
+    void setPoints( const Teuchos::ArrayView<const double>& coords,
+		    const Teuchos::ArrayView<const float>& weights =
+		    Teuchos::ArrayView<const float>() );
+
+    // Compute the partitioning of the points.
+    void partition();
+
+    // Get the destination process for a point given its coordinates.
+    int getPointDestinationProc( const Teuchos::Array<double>& coords ) const;
+
+    // Get the destination processes for a bounding box.
+    Teuchos::Array<int> getBoxDestinationProcs( const BoundingBox& box ) const;
+
+    // Get the destination processes for a blocked list of points.
+    void getPointDestinationProcs( 
+	const Teuchos::ArrayView<const double>& coords,
+	Teuchos::Array<int>& procs ) const;
+
+    // Get the destination processes for a list of bounding boxes.
+    void getBoxDestinationProcs( 
+	const Teuchos::Array<BoundingBox>& boxes,
+	Teuchos::Array<Teuchos::Array<int> >& procs ) const;
+
+    //! Get the curve cut keys. Process p owns the keys in [s[p-1],s[p]).
+    const Teuchos::Array<key_type>& getSplitters() const
+    { return d_splitters; }
+
+  private:
+
+    // Compute the grid cell of a point.
+    void pointCell( const double point[], unsigned int cell[] ) const;
+
+    // Compute the Hilbert key of a grid cell.
+    key_type cellKey( const unsigned int cell[] ) const;
+
+    // Get the destination process for a key.
+    int keyDestinationProc( const key_type key ) const;
+
+    // Recursively collect the processes owning the keys of the grid cells
+    // a box intersects.
+    void collectBoxProcs( const unsigned int origin[], const int level,
+			  const unsigned int box_lo[],
+			  const unsigned int box_hi[],
+			  Teuchos::Array<int>& procs ) const;
+
+  private:
+
+    // Communicator over which the points are partitioned.
+    RCP_Comm d_comm;
+
+    // Partitioning dimension.
+    int d_dimension;
+
+    // Number of bits per dimension in a grid cell index.
+    int d_bits;
+
+    // Lower bound of the grid in each dimension.
+    double d_lower[3];
+
+    // Number of grid cells per unit length in each dimension.
+    double d_scale[3];
+
+    // Local point coordinates blocked by dimension.
+    Teuchos::Array<double> d_coords;
+
+    // Local point weights.
+    Teuchos::Array<float> d_weights;
+
+    // Curve cut keys.
+    Teuchos::Array<key_type> d_splitters;
+};
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_HILBERTPARTITIONER_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_HilbertPartitioner.hpp
+//---------------------------------------------------------------------------//
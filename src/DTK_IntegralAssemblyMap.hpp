@@ -51,6 +51,7 @@
 #include "DTK_FieldIntegrator.hpp"
 #include "DTK_FieldManager.hpp"
 #include "DTK_CommIndexer.hpp"
+#include "DTK_Rendezvous.hpp"
 
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_Comm.hpp>
@@ -94,6 +95,8 @@ class IntegralAssemblyMap
     typedef GeometryTraits<Geometry>                  GT;
     typedef GeometryManager<Geometry,GlobalOrdinal>   GeometryManagerType;
     typedef Teuchos::RCP<GeometryManagerType>         RCP_GeometryManager;
+    typedef Rendezvous<Mesh>                          RendezvousType;
+    typedef Teuchos::RCP<RendezvousType>              RCP_Rendezvous;
     typedef Teuchos::Comm<int>                        CommType;
     typedef Teuchos::RCP<const CommType>              RCP_Comm;
     typedef Tpetra::Map<int,GlobalOrdinal>            TpetraMap;
@@ -110,6 +113,9 @@ class IntegralAssemblyMap
     // Destructor.
     ~IntegralAssemblyMap();
 
+    // Use a rendezvous decomposition built by the client.
+    void setRendezvous( const RCP_Rendezvous& rendezvous );
+
     // Generate the integral assembly map.
     void setup( 
 	const RCP_MeshManager& source_mesh_manager,
@@ -144,6 +150,9 @@ class IntegralAssemblyMap
     // Flag for element-in-geometry vertex inclusion requirement.
     bool d_all_vertices_for_inclusion;
 
+    // Client rendezvous decomposition of the source mesh.
+    RCP_Rendezvous d_rendezvous;
+
     // Process indexer for the source application.
     CommIndexer d_source_indexer;
 
@@ -48,7 +48,6 @@
 #include "DTK_FieldTools.hpp"
 #include "DTK_FieldTraits.hpp"
 #include "DTK_Assertion.hpp"
-#include "DTK_Rendezvous.hpp"
 #include "DTK_MeshTools.hpp"
 #include "DTK_BoundingBox.hpp"
 
@@ -105,6 +104,27 @@ template<class Mesh, class Geometry>
 IntegralAssemblyMap<Mesh,Geometry>::~IntegralAssemblyMap()
 { /* ... */ }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Use a rendezvous decomposition built by the client instead of
+ * building one in setup(). The same rendezvous decomposition may be used by
+ * several maps with the same source mesh such that it is only built
+ * once. Must be called before setup() to take effect.
+ *
+ * \param rendezvous A rendezvous decomposition built with the source mesh
+ * over the communicator of this map. Its box should bound the target
+ * geometry. A null RCP restores building the rendezvous decomposition in
+ * setup().
+ */
+template<class Mesh, class Geometry>
+void IntegralAssemblyMap<Mesh,Geometry>::setRendezvous( 
+    const RCP_Rendezvous& rendezvous )
+{
+    testPrecondition( rendezvous.is_null() || 
+		      !rendezvous->getMesh().is_null() );
+    d_rendezvous = rendezvous;
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Generate the integral map.
@@ -173,15 +193,21 @@ void IntegralAssemblyMap<Mesh,Geometry>::setup(
     Teuchos::Array<GlobalOrdinal> geometry_ordinals;
     computeGeometryOrdinals( target_geometry_manager, geometry_ordinals );
 
-    // Build a rendezvous decomposition with the source mesh.
-    BoundingBox global_box( -Teuchos::ScalarTraits<double>::rmax(),
-			    -Teuchos::ScalarTraits<double>::rmax(),
-			    -Teuchos::ScalarTraits<double>::rmax(),
-			    Teuchos::ScalarTraits<double>::rmax(),
-			    Teuchos::ScalarTraits<double>::rmax(),
-			    Teuchos::ScalarTraits<double>::rmax() );
-    Rendezvous<Mesh> rendezvous( d_comm, d_dimension, global_box );
-    rendezvous.build( source_mesh_manager );
+    // Build a rendezvous decomposition with the source mesh unless the
+    // client provided one.
+    RCP_Rendezvous rendezvous = d_rendezvous;
+    if ( rendezvous.is_null() )
+    {
+	BoundingBox global_box( -Teuchos::ScalarTraits<double>::rmax(),
+				-Teuchos::ScalarTraits<double>::rmax(),
+				-Teuchos::ScalarTraits<double>::rmax(),
+				Teuchos::ScalarTraits<double>::rmax(),
+				Teuchos::ScalarTraits<double>::rmax(),
+				Teuchos::ScalarTraits<double>::rmax() );
+	rendezvous = Teuchos::rcp( 
+	    new RendezvousType( d_comm, d_dimension, global_box ) );
+	rendezvous->build( source_mesh_manager );
+    }
 
     // Get the target geometries and their bounding boxes.
     Teuchos::ArrayRCP<Geometry> target_geometry(0);
@@ -199,7 +225,7 @@ void IntegralAssemblyMap<Mesh,Geometry>::setup(
 
     // Determine the rendezvous destination procs for the target geometries.
     Teuchos::Array<Teuchos::Array<int> > box_procs = 
-	rendezvous.procsContainingBoxes( target_boxes );
+	rendezvous->procsContainingBoxes( target_boxes );
     target_boxes.clear();
 
     // Unroll the rendezvous procs, target geometries, and ordinals to
@@ -273,9 +299,9 @@ geometry_ordinal_iterator = geometry_ordinals.begin();
     // target geometry. This is really expensive and we should rather think of
     // a way to logarithmically use the geometry bounding boxes for searching.
     Teuchos::Array<Teuchos::Array<GlobalOrdinal> > in_geom_elements;
-    rendezvous.elementsInGeometry( rendezvous_geometry, in_geom_elements,
-				   d_geometric_tolerance, 
-				   d_all_vertices_for_inclusion );
+    rendezvous->elementsInGeometry( rendezvous_geometry, in_geom_elements,
+				    d_geometric_tolerance, 
+				    d_all_vertices_for_inclusion );
 
     // Unroll the rendezvous elements and add the global target ordinal they
     // exist within.
@@ -418,7 +444,7 @@ geometry_ordinal_iterator = geometry_ordinals.begin();
     rendezvous_elements.resize( std::distance( rendezvous_elements.begin(),
 					       rendezvous_element_bound ) );
     Teuchos::Array<int> rendezvous_element_source_procs =
-	rendezvous.elementSourceProcs( rendezvous_elements );
+	rendezvous->elementSourceProcs( rendezvous_elements );
 
     // Communicate back to the source the elements we need integrals and
     // measures for.
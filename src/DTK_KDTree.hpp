@@ -47,7 +47,7 @@
 #include <Teuchos_Array.hpp>
 #include <Teuchos_ScalarTraits.hpp>
 
-#include <MBAdaptiveKDTree.hpp>
+#include <MBInterface.hpp>
 
 namespace DataTransferKit
 {
@@ -55,12 +55,44 @@ namespace DataTransferKit
 //---------------------------------------------------------------------------//
 /*!
  * \class KDTree
- * \brief A KDTree data structure for local mesh searching in the rendezvous
+ * \brief A kD-tree data structure for local mesh searching in the rendezvous
  * decomposition.
 
- A kD-tree provides n*log(n) construction time and space complexity with
- log(n) search time complexity.
-
+ The tree is built over the axis-aligned bounding boxes of the local mesh
+ elements. Elements are recursively bisected at the median of their bounding
+ box centroids along the longest centroid extent until a leaf holds no more
+ than a few elements. Each tree node stores the bounding box of all elements
+ below it so a point search only descends into nodes whose box contains the
+ point. This gives n*log(n) construction time with log(n) search time
+ complexity.
+
+ The nodes are stored depth-first in a single contiguous array such that the
+ left child of a node is always the next node in the array. The elements of
+ each leaf are stored contiguously in structure-of-arrays form (mesh cache
+ index, native ordinal, and bounding box). Element bounds and vertex
+ coordinates are taken from the rendezvous mesh cache so that neither the
+ build nor the search has to go back to the Moab database.
+
+ Triangles in 2D and tetrahedrons in 3D are affine such that their inverse
+ maps can be computed once when the tree is built. These inverse maps are
+ also stored per leaf in structure-of-arrays form and a point is tested
+ against all of the affine elements in a leaf at once. If the package is
+ configured with DataTransferKit_ENABLE_SIMD and the compiler enables AVX2
+ or AVX-512 the test evaluates 4 or 8 elements per instruction and exits as
+ soon as a lane finds the point. Other elements use the point-in-element
+ kernels in TopologyTools.
+
+ Large sets of points should be located with findPoints. The points are
+ searched in Morton order such that consecutive searches are spatially close
+ and reuse the same tree nodes and leaf elements. The leaf a point was found
+ in is checked first for the next point before the tree is traversed again.
+ The coordinates of each point in the reference frame of the element it was
+ found in are a by-product of the search and may be returned with the
+ elements.
+
+ If the mesh vertices move by a small amount the tree can be refit instead of
+ rebuilt. The elements stay in their leaves and only the bounding boxes and
+ affine maps are recomputed.
  */
 //---------------------------------------------------------------------------//
 template<typename GlobalOrdinal>
@@ -84,36 +116,130 @@ class KDTree
     // Build the kD-tree.
     void build();
 
+    // Refit the kD-tree to the moved vertices of the rendezvous mesh.
+    void refit();
+
     // Find a point in the tree.
     bool findPoint( const Teuchos::Array<double>& coords,
 		    GlobalOrdinal& element,
 		    double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
 
-    // Get all of the elements in a leaf containing a point.
+    // Find a blocked list of points in the tree.
+    void findPoints( const double* coords,
+		     const int num_points,
+		     Teuchos::Array<GlobalOrdinal>& elements,
+		     Teuchos::Array<short int>& points_found,
+		     double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Find a blocked list of points in the tree and get their coordinates in
+    // the reference frame of the elements they were found in.
+    void findPoints( const double* coords,
+		     const int num_points,
+		     Teuchos::Array<GlobalOrdinal>& elements,
+		     Teuchos::Array<short int>& points_found,
+		     Teuchos::Array<double>& reference_coords,
+		     double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Get all of the elements in the leaves containing a point.
     void findLeaf( const Teuchos::Array<double>& coords,
 		   Teuchos::Array<GlobalOrdinal>& elements );
 
   private:
 
+    // Compute the inverse affine map of a rendezvous mesh element.
+    short int computeAffineMap( const int element_index, 
+				double affine_map[12] ) const;
+
+    // Recursively build the tree nodes over a range of leaf elements.
+    int buildNode( const int begin, const int end,
+		   const Teuchos::Array<double>& centroids,
+		   Teuchos::Array<int>& permutation,
+		   const int depth );
+
+    // Traverse the tree from the root to find the leaf element containing a
+    // point.
+    bool searchTree( const double point[3],
+		     int& leaf,
+		     int& element_index,
+		     double reference_point[3],
+		     double tolerance );
+
+    // Compute the Morton key of a point relative to the tree bounds.
+    unsigned long long mortonKey( const double point[3] ) const;
+
+    // Determine if a point is in a tree node bounding box.
+    inline bool pointInNode( const double point[3], const int node,
+			     const double tolerance ) const;
+
+    // Find a point in the affine elements of a leaf.
+    int findPointInAffineElements( const double point[3],
+				   const int leaf,
+				   const double tolerance ) const;
+
     // Find a point in a leaf.
-    bool findPointInLeaf( const Teuchos::Array<double>& coords,
-			  const moab::EntityHandle leaf,
-			  moab::EntityHandle& element,
+    bool findPointInLeaf( const double point[3],
+			  const int leaf,
+			  int& element_index,
+			  double reference_point[3],
 			  double tolerance );
 
   private:
 
+    /*!
+     * \brief Tree node. A leaf node has no children and owns the range
+     * [begin,end) of the leaf element arrays. The left child of an interior
+     * node is always the node immediately following it in the node array.
+     */
+    struct Node
+    {
+	// Node bounds { x_min, y_min, z_min, x_max, y_max, z_max }.
+	double bounds[6];
+
+	// Index of the right child node. -1 if this node is a leaf.
+	int right;
+
+	// Beginning of the leaf element range.
+	int begin;
+
+	// End of the leaf element range.
+	int end;
+    };
+
+  private:
+
+    // Maximum number of elements in a leaf.
+    static const int d_max_leaf_size = 8;
+
+    // Maximum depth of the tree.
+    static const int d_max_depth = 64;
+
     // Moab Mesh.
     RCP_RendezvousMesh d_mesh;
 
     // Tree dimension.
     int d_dim;
 
-    // Adaptive kD-tree.
-    moab::AdaptiveKDTree d_tree;
+    // Tree nodes. Node 0 is the root.
+    Teuchos::Array<Node> d_nodes;
+
+    // Leaf element rendezvous mesh cache indices in leaf order.
+    Teuchos::Array<int> d_leaf_element_indices;
+
+    // Leaf element native ordinals in leaf order.
+    Teuchos::Array<GlobalOrdinal> d_leaf_ordinals;
+
+    // Leaf element bounding boxes in leaf order, blocked by bound 
+    // { x_min, y_min, z_min, x_max, y_max, z_max }.
+    Teuchos::Array<double> d_leaf_bounds;
+
+    // Leaf element affine flags in leaf order. 1 if the element is affine.
+    Teuchos::Array<short int> d_leaf_affine;
 
-    // Tree root.
-    moab::EntityHandle d_root;
+    // Leaf element inverse affine maps in leaf order, blocked by component
+    // { x_0, y_0, z_0, J^-1_00, J^-1_01, J^-1_02, ..., J^-1_22 } where x_0 is
+    // the first element vertex. Elements that are not affine have a NaN
+    // first vertex such that they never pass the inclusion test.
+    Teuchos::Array<double> d_leaf_affine_maps;
 };
 
 } // end namespace DataTransferKit
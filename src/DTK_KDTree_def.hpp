@@ -42,9 +42,13 @@
 #define DTK_KDTREE_DEF_HPP
 
 #include <vector>
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 #include "DTK_TopologyTools.hpp"
 #include "DTK_Assertion.hpp"
+#include "DTK_PointInElementKernels.hpp"
 #include "DataTransferKit_config.hpp"
 
 #include <Teuchos_ArrayView.hpp>
@@ -52,8 +56,42 @@
 
 #include <MBRange.hpp>
 
+#if HAVE_DTK_SIMD
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#endif
+
 namespace DataTransferKit
 {
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Centroid comparison functor for partitioning elements along an axis.
+ */
+class KDTreeCentroidCompare
+{
+  public:
+
+    //! Constructor.
+    KDTreeCentroidCompare( const Teuchos::Array<double>& centroids,
+			   const int axis )
+	: d_centroids( centroids )
+	, d_axis( axis )
+    { /* ... */ }
+
+    //! Compare the centroids of two elements along the axis.
+    bool operator()( const int a, const int b ) const
+    { return d_centroids[3*a + d_axis] < d_centroids[3*b + d_axis]; }
+
+  private:
+
+    // Element centroids.
+    const Teuchos::Array<double>& d_centroids;
+
+    // Comparison axis.
+    int d_axis;
+};
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Constructor.
@@ -67,7 +105,6 @@ template<typename GlobalOrdinal>
 KDTree<GlobalOrdinal>::KDTree( const RCP_RendezvousMesh& mesh, const int dim )
   : d_mesh( mesh )
   , d_dim( dim )
-  , d_tree( d_mesh->getMoab().get() )
 { /* ... */ }
 
 //---------------------------------------------------------------------------//
@@ -80,27 +117,141 @@ KDTree<GlobalOrdinal>::~KDTree()
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Build the kD-tree.
+ * \brief Build the kD-tree. Element bounding boxes and vertex coordinates
+ * come from the rendezvous mesh cache and native ordinals are extracted once
+ * here and stored in the tree.
  */
 template<typename GlobalOrdinal>
 void KDTree<GlobalOrdinal>::build()
 { 
-    rememberValue( moab::ErrorCode error );
+    testPrecondition( d_mesh->dim() == d_dim );
 
-    moab::Range elements;
-#if HAVE_DTK_DBC
-    error = d_mesh->getMoab()->get_entities_by_dimension( 0, d_dim, elements );
-#else
-    d_mesh->getMoab()->get_entities_by_dimension( 0, d_dim, elements );
-#endif
-    testInvariant( moab::MB_SUCCESS == error );
+    // Compute the element centroids and the inverse maps of the affine
+    // elements.
+    int num_elements = d_mesh->numElements();
+    Teuchos::Array<double> centroids( 3*num_elements );
+    Teuchos::Array<short int> element_affine( num_elements, 0 );
+    Teuchos::Array<double> affine_maps( 12*num_elements );
+    const double* element_bounds;
+    for ( int n = 0; n < num_elements; ++n )
+    {
+	element_bounds = d_mesh->elementBounds( n );
+	for ( int d = 0; d < 3; ++d )
+	{
+	    centroids[3*n + d] = 
+		( element_bounds[d] + element_bounds[d + 3] ) / 2.0;
+	}
+	element_affine[n] = computeAffineMap( n, &affine_maps[12*n] );
+    }
 
-#if HAVE_DTK_DBC
-    error = d_tree.build_tree( elements , d_root );
-#else
-    d_tree.build_tree( elements , d_root );
-#endif
-    testInvariant( moab::MB_SUCCESS == error );
+    // Recursively build the tree over a permutation of the elements.
+    Teuchos::Array<int> permutation( num_elements );
+    for ( int i = 0; i < num_elements; ++i )
+    {
+	permutation[i] = i;
+    }
+    d_nodes.clear();
+    if ( num_elements > 0 )
+    {
+	d_nodes.reserve( 4*(num_elements/d_max_leaf_size + 1) );
+	buildNode( 0, num_elements, centroids, permutation, 0 );
+    }
+
+    // Store the leaf element data in leaf order. Extracting the native
+    // ordinals here keeps the ordinal map out of the search.
+    d_leaf_element_indices.resize( num_elements );
+    d_leaf_ordinals.resize( num_elements );
+    d_leaf_bounds.resize( 6*num_elements );
+    d_leaf_affine.resize( num_elements );
+    d_leaf_affine_maps.resize( 12*num_elements );
+    for ( int i = 0; i < num_elements; ++i )
+    {
+	d_leaf_element_indices[i] = permutation[i];
+	d_leaf_ordinals[i] = d_mesh->elementOrdinal( permutation[i] );
+	element_bounds = d_mesh->elementBounds( permutation[i] );
+	for ( int b = 0; b < 6; ++b )
+	{
+	    d_leaf_bounds[ b*num_elements + i ] = element_bounds[b];
+	}
+	d_leaf_affine[i] = element_affine[ permutation[i] ];
+	for ( int c = 0; c < 12; ++c )
+	{
+	    d_leaf_affine_maps[ c*num_elements + i ] = 
+		affine_maps[ 12*permutation[i] + c ];
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Refit the kD-tree after the vertices of the rendezvous mesh have
+ * moved. The elements keep their leaves and the tree is not
+ * re-partitioned. The leaf element bounds and affine maps are recomputed from
+ * the rendezvous mesh cache and the node bounds are then recomputed from the
+ * leaves up. Small vertex motions leave the tree nearly as good as a rebuilt
+ * one at a fraction of the cost. Large motions will make the nodes overlap
+ * and the tree should be rebuilt instead.
+ */
+template<typename GlobalOrdinal>
+void KDTree<GlobalOrdinal>::refit()
+{
+    int num_elements = d_leaf_element_indices.size();
+    testPrecondition( d_mesh->numElements() == num_elements );
+
+    // Update the leaf element data in leaf order.
+    const double* element_bounds;
+    double affine_map[12];
+    for ( int i = 0; i < num_elements; ++i )
+    {
+	element_bounds = d_mesh->elementBounds( d_leaf_element_indices[i] );
+	for ( int b = 0; b < 6; ++b )
+	{
+	    d_leaf_bounds[ b*num_elements + i ] = element_bounds[b];
+	}
+	d_leaf_affine[i] = 
+	    computeAffineMap( d_leaf_element_indices[i], affine_map );
+	for ( int c = 0; c < 12; ++c )
+	{
+	    d_leaf_affine_maps[ c*num_elements + i ] = affine_map[c];
+	}
+    }
+
+    // Children are always stored after their parent such that the node
+    // bounds can be recomputed bottom-up in a single reverse sweep.
+    int num_nodes = d_nodes.size();
+    for ( int node = num_nodes - 1; node >= 0; --node )
+    {
+	Node& current = d_nodes[node];
+	if ( -1 == current.right )
+	{
+	    for ( int d = 0; d < 3; ++d )
+	    {
+		current.bounds[d] = std::numeric_limits<double>::max();
+		current.bounds[d+3] = -std::numeric_limits<double>::max();
+		for ( int i = current.begin; i < current.end; ++i )
+		{
+		    current.bounds[d] = std::min( 
+			current.bounds[d], 
+			d_leaf_bounds[ d*num_elements + i ] );
+		    current.bounds[d+3] = std::max( 
+			current.bounds[d+3], 
+			d_leaf_bounds[ (d+3)*num_elements + i ] );
+		}
+	    }
+	}
+	else
+	{
+	    const Node& left = d_nodes[node+1];
+	    const Node& right = d_nodes[current.right];
+	    for ( int d = 0; d < 3; ++d )
+	    {
+		current.bounds[d] = 
+		    std::min( left.bounds[d], right.bounds[d] );
+		current.bounds[d+3] = 
+		    std::max( left.bounds[d+3], right.bounds[d+3] );
+	    }
+	}
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -128,6 +279,11 @@ bool KDTree<GlobalOrdinal>::findPoint( const Teuchos::Array<double>& coords,
     testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
     testPrecondition( (int) coords.size() == d_dim );
 
+    if ( d_nodes.empty() )
+    {
+	return false;
+    }
+
     double point[3];
     for ( int d = 0; d < d_dim; ++d )
     {
@@ -138,38 +294,163 @@ bool KDTree<GlobalOrdinal>::findPoint( const Teuchos::Array<double>& coords,
 	point[d] = 0.0;
     }
 
-    rememberValue( moab::ErrorCode error );
-    moab::EntityHandle leaf;
-#if HAVE_DTK_DBC
-    error = d_tree.leaf_containing_point( d_root, point, leaf );
-#else
-    d_tree.leaf_containing_point( d_root, point, leaf );
-#endif
-    testInvariant( moab::MB_SUCCESS == error );
-
-    moab::EntityHandle mb_element = 0;
-    bool point_in_leaf = findPointInLeaf( coords, leaf, mb_element, tolerance );
-    if ( point_in_leaf )
+    int leaf = 0;
+    int element_index = 0;
+    double reference_point[3];
+    if ( searchTree( point, leaf, element_index, reference_point, tolerance ) )
     {
-	element = d_mesh->getNativeOrdinal( mb_element );
+	element = d_leaf_ordinals[ element_index ];
 	return true;
     }
-    else
+
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find a blocked list of points in the tree. 
+ *
+ * The points are searched in Morton order. Points that are consecutive in
+ * this order are usually in the same leaf so the leaf the previous point was
+ * found in is searched first before doing a full traversal from the root.
+ *
+ * \param coords Blocked point coordinates to locate in the tree ( x_0, x_1,
+ * ..., x_N, y_0, y_1, ..., y_N, z_0, z_1, ..., z_N ). The points must be the
+ * same dimension as the tree.
+ *
+ * \param num_points The number of points in the coordinate list.
+ *
+ * \param elements The global ordinal of the client element each point was
+ * found in, in the order the points were provided. An ordinal is not valid
+ * if its point was not found.
+ *
+ * \param points_found For each point, 1 if the point was found in the tree
+ * and 0 if not.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ */
+template<typename GlobalOrdinal>
+void KDTree<GlobalOrdinal>::findPoints( const double* coords,
+					const int num_points,
+					Teuchos::Array<GlobalOrdinal>& elements,
+					Teuchos::Array<short int>& points_found,
+					double tolerance )
+{
+    Teuchos::Array<double> reference_coords;
+    findPoints( coords, num_points, elements, points_found, 
+		reference_coords, tolerance );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find a blocked list of points in the tree and get the coordinates
+ * of each point in the reference frame of the element it was found in. The
+ * reference coordinates are computed by the point-in-element checks of the
+ * search so they come at no extra cost.
+ *
+ * \param coords Blocked point coordinates to locate in the tree ( x_0, x_1,
+ * ..., x_N, y_0, y_1, ..., y_N, z_0, z_1, ..., z_N ). The points must be the
+ * same dimension as the tree.
+ *
+ * \param num_points The number of points in the coordinate list.
+ *
+ * \param elements The global ordinal of the client element each point was
+ * found in, in the order the points were provided. An ordinal is not valid
+ * if its point was not found.
+ *
+ * \param points_found For each point, 1 if the point was found in the tree
+ * and 0 if not.
+ *
+ * \param reference_coords The blocked reference coordinates of each point
+ * in the element it was found in with the same dimension as the tree. The
+ * reference coordinates of a point that was not found are not valid. Those of
+ * a point found in an element without a reference frame of its own are NaN.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ */
+template<typename GlobalOrdinal>
+void KDTree<GlobalOrdinal>::findPoints( const double* coords,
+					const int num_points,
+					Teuchos::Array<GlobalOrdinal>& elements,
+					Teuchos::Array<short int>& points_found,
+					Teuchos::Array<double>& reference_coords,
+					double tolerance )
+{
+    testPrecondition( 0 <= num_points );
+    testPrecondition( 0 == num_points || 0 != coords );
+
+    elements.resize( num_points );
+    points_found.assign( num_points, 0 );
+    reference_coords.assign( d_dim*num_points, 0.0 );
+    if ( d_nodes.empty() )
     {
-	return false;
+	return;
+    }
+
+    // Sort the points by Morton key.
+    double point[3] = { 0.0, 0.0, 0.0 };
+    Teuchos::Array<std::pair<unsigned long long,int> > ordering( num_points );
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dim; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	ordering[n] = std::make_pair( mortonKey(point), n );
+    }
+    std::sort( ordering.begin(), ordering.end() );
+
+    // Search for the points in Morton order and scatter the results back to
+    // the original point order.
+    int n = 0;
+    int leaf = -1;
+    int element_index = 0;
+    double reference_point[3];
+    bool found_point = false;
+    for ( int i = 0; i < num_points; ++i )
+    {
+	n = ordering[i].second;
+	for ( int d = 0; d < d_dim; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+
+	found_point = false;
+	if ( leaf >= 0 && pointInNode(point, leaf, tolerance) )
+	{
+	    found_point = findPointInLeaf( 
+		point, leaf, element_index, reference_point, tolerance );
+	}
+	if ( !found_point )
+	{
+	    found_point = searchTree( 
+		point, leaf, element_index, reference_point, tolerance );
+	}
+
+	if ( found_point )
+	{
+	    elements[n] = d_leaf_ordinals[ element_index ];
+	    points_found[n] = 1;
+	    for ( int d = 0; d < d_dim; ++d )
+	    {
+		reference_coords[ d*num_points + n ] = reference_point[d];
+	    }
+	}
     }
 }
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Get all of the elements in the leaf containing a point. 
+ * \brief Get all of the elements in the leaves containing a point. 
  *
  * \param coords Point coordinates to locate in the tree. Point dimensions
  * less than or equal to 3 are valid but the point most be the same dimension
  * as the tree.
  *
  * \param elements The global ordinals of the local client elements in the
- * leaf that the point was found in. 
+ * leaves that the point was found in. 
  */
 template<typename GlobalOrdinal>
 void KDTree<GlobalOrdinal>::findLeaf( const Teuchos::Array<double>& coords,
@@ -178,6 +459,12 @@ void KDTree<GlobalOrdinal>::findLeaf( const Teuchos::Array<double>& coords,
     testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
     testPrecondition( Teuchos::as<int>(coords.size()) == d_dim );
 
+    elements.clear();
+    if ( d_nodes.empty() )
+    {
+	return;
+    }
+
     double point[3];
     for ( int d = 0; d < d_dim; ++d )
     {
@@ -188,88 +475,553 @@ void KDTree<GlobalOrdinal>::findLeaf( const Teuchos::Array<double>& coords,
 	point[d] = 0.0;
     }
 
-    rememberValue( moab::ErrorCode error );
-    moab::EntityHandle leaf;
-#if HAVE_DTK_DBC
-    error = d_tree.leaf_containing_point( d_root, point, leaf );
-#else
-    d_tree.leaf_containing_point( d_root, point, leaf );
+    // Collect the elements of every leaf whose box contains the point.
+    int stack[ d_max_depth ];
+    int stack_size = 0;
+    int node = 0;
+    stack[ stack_size++ ] = 0;
+    while ( stack_size > 0 )
+    {
+	node = stack[ --stack_size ];
+	if ( pointInNode( point, node, 0.0 ) )
+	{
+	    if ( d_nodes[node].right < 0 )
+	    {
+		for ( int i = d_nodes[node].begin; i < d_nodes[node].end; ++i )
+		{
+		    elements.push_back( d_leaf_ordinals[i] );
+		}
+	    }
+	    else
+	    {
+		testInvariant( stack_size + 2 <= d_max_depth );
+		stack[ stack_size++ ] = d_nodes[node].right;
+		stack[ stack_size++ ] = node + 1;
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the inverse affine map of a rendezvous mesh element.
+ *
+ * \param element_index The rendezvous mesh cache index of the element.
+ *
+ * \param affine_map The map { x_0, y_0, z_0, J^-1_00, J^-1_01, ..., J^-1_22 }
+ * padded to 3 dimensions. The first vertex is NaN if the element is not
+ * affine such that it never passes the inclusion test.
+ *
+ * \return 1 if the element is affine, 0 if not.
+ */
+template<typename GlobalOrdinal>
+short int KDTree<GlobalOrdinal>::computeAffineMap( 
+    const int element_index, double affine_map[12] ) const
+{
+    std::fill( affine_map, affine_map + 12, 
+	       std::numeric_limits<double>::quiet_NaN() );
+
+    moab::EntityType element_topology = 
+	d_mesh->elementTopology( element_index );
+    int num_element_vertices = d_mesh->numElementVertices( element_index );
+    const double* vertex_coords = d_mesh->elementVertexCoords( element_index );
+    bool is_affine = 
+	( moab::MBTRI == element_topology && 3 == num_element_vertices &&
+	  2 == d_dim ) ||
+	( moab::MBTET == element_topology && 4 == num_element_vertices &&
+	  3 == d_dim );
+    if ( !is_affine )
+    {
+	return 0;
+    }
+
+    double jacobian[3][3];
+    for ( int i = 0; i < d_dim; ++i )
+    {
+	for ( int j = 0; j < d_dim; ++j )
+	{
+	    jacobian[i][j] = vertex_coords[3*(j+1) + i] - vertex_coords[i];
+	}
+    }
+
+    // Invert the Jacobian one column at a time. Degenerate elements are left
+    // to the general kernels.
+    double unit[3];
+    double inverse_column[3];
+    for ( int j = 0; j < d_dim && is_affine; ++j )
+    {
+	for ( int i = 0; i < 3; ++i )
+	{
+	    unit[i] = ( i == j ) ? 1.0 : 0.0;
+	}
+	is_affine = ReferenceFrameTools::solve( 
+	    d_dim, jacobian, unit, inverse_column );
+	for ( int i = 0; i < d_dim; ++i )
+	{
+	    affine_map[3 + 3*i + j] = inverse_column[i];
+	}
+    }
+    if ( !is_affine )
+    {
+	std::fill( affine_map, affine_map + 12, 
+		   std::numeric_limits<double>::quiet_NaN() );
+	return 0;
+    }
+
+    for ( int d = 0; d < 3; ++d )
+    {
+	affine_map[d] = ( d < d_dim ) ? vertex_coords[d] : 0.0;
+    }
+    for ( int i = 0; i < 3; ++i )
+    {
+	for ( int j = 0; j < 3; ++j )
+	{
+	    if ( i >= d_dim || j >= d_dim )
+	    {
+		affine_map[3 + 3*i + j] = 0.0;
+	    }
+	}
+    }
+    return 1;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Recursively build the tree nodes over a range of leaf elements.
+ *
+ * \param begin The beginning of the element range in the permutation.
+ *
+ * \param end The end of the element range in the permutation.
+ *
+ * \param centroids The interleaved element bounding box centroids.
+ *
+ * \param permutation The element permutation. This will be reordered such
+ * that the elements of each leaf are contiguous.
+ *
+ * \param depth The depth of the node being built.
+ *
+ * \return The index of the node that was built.
+ */
+template<typename GlobalOrdinal>
+int KDTree<GlobalOrdinal>::buildNode( 
+    const int begin, const int end,
+    const Teuchos::Array<double>& centroids,
+    Teuchos::Array<int>& permutation,
+    const int depth )
+{
+    testPrecondition( begin < end );
+    testInvariant( depth < d_max_depth - 1 );
+
+    // Add the node and compute its bounds from its elements along with the
+    // extent of the element centroids.
+    int node = d_nodes.size();
+    d_nodes.push_back( Node() );
+    double centroid_bounds[6];
+    for ( int d = 0; d < 3; ++d )
+    {
+	d_nodes[node].bounds[d] = std::numeric_limits<double>::max();
+	d_nodes[node].bounds[d+3] = -std::numeric_limits<double>::max();
+	centroid_bounds[d] = std::numeric_limits<double>::max();
+	centroid_bounds[d+3] = -std::numeric_limits<double>::max();
+    }
+    int element = 0;
+    const double* element_bounds;
+    for ( int i = begin; i < end; ++i )
+    {
+	element = permutation[i];
+	element_bounds = d_mesh->elementBounds( element );
+	for ( int d = 0; d < 3; ++d )
+	{
+	    d_nodes[node].bounds[d] = std::min( d_nodes[node].bounds[d],
+						element_bounds[d] );
+	    d_nodes[node].bounds[d+3] = 
+		std::max( d_nodes[node].bounds[d+3], element_bounds[d+3] );
+	    centroid_bounds[d] = std::min( centroid_bounds[d],
+					   centroids[3*element + d] );
+	    centroid_bounds[d+3] = std::max( centroid_bounds[d+3],
+					     centroids[3*element + d] );
+	}
+    }
+    d_nodes[node].right = -1;
+    d_nodes[node].begin = begin;
+    d_nodes[node].end = end;
+
+    // Split along the longest centroid extent. If all of the centroids are
+    // coincident the elements can't be separated and this is a leaf.
+    int axis = 0;
+    for ( int d = 1; d < d_dim; ++d )
+    {
+	if ( centroid_bounds[d+3] - centroid_bounds[d] >
+	     centroid_bounds[axis+3] - centroid_bounds[axis] )
+	{
+	    axis = d;
+	}
+    }
+    if ( end - begin <= d_max_leaf_size ||
+	 !(centroid_bounds[axis+3] > centroid_bounds[axis]) )
+    {
+	return node;
+    }
+
+    // Partition the elements at the median centroid and build the children.
+    int mid = begin + (end - begin) / 2;
+    std::nth_element( permutation.begin() + begin,
+		      permutation.begin() + mid,
+		      permutation.begin() + end,
+		      KDTreeCentroidCompare(centroids, axis) );
+    buildNode( begin, mid, centroids, permutation, depth+1 );
+    int right = buildNode( mid, end, centroids, permutation, depth+1 );
+    d_nodes[node].right = right;
+
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Traverse the tree from the root to find the leaf element containing
+ * a point. Nodes are visited depth-first and only if their box contains the
+ * point. The left child is visited first as it is adjacent in memory.
+ *
+ * \param point The point coordinates padded to 3 dimensions.
+ *
+ * \param leaf The leaf node the point was found in. This node is not valid if
+ * this function returns false.
+ *
+ * \param element_index The leaf element array index of the element the point
+ * was found in. This index is not valid if this function returns false.
+ *
+ * \param reference_point The point in the reference frame of the element
+ * it was found in. Not valid if this function returns false.
+ *
+ * \return Return true if the point was found in the tree, false if not.
+ */
+template<typename GlobalOrdinal>
+bool KDTree<GlobalOrdinal>::searchTree( const double point[3],
+					int& leaf,
+					int& element_index,
+					double reference_point[3],
+					double tolerance )
+{
+    testPrecondition( !d_nodes.empty() );
+
+    int stack[ d_max_depth ];
+    int stack_size = 0;
+    int node = 0;
+    stack[ stack_size++ ] = 0;
+    while ( stack_size > 0 )
+    {
+	node = stack[ --stack_size ];
+	if ( pointInNode( point, node, tolerance ) )
+	{
+	    if ( d_nodes[node].right < 0 )
+	    {
+		if ( findPointInLeaf( point, node, element_index, 
+				      reference_point, tolerance ) )
+		{
+		    leaf = node;
+		    return true;
+		}
+	    }
+	    else
+	    {
+		testInvariant( stack_size + 2 <= d_max_depth );
+		stack[ stack_size++ ] = d_nodes[node].right;
+		stack[ stack_size++ ] = node + 1;
+	    }
+	}
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the Morton key of a point. The point is quantized on a grid
+ * over the root node bounds and the bits of each dimension are
+ * interleaved. Points outside of the tree bounds are clamped to the bounds.
+ */
+template<typename GlobalOrdinal>
+unsigned long long 
+KDTree<GlobalOrdinal>::mortonKey( const double point[3] ) const
+{
+    testPrecondition( !d_nodes.empty() );
+
+    int bits = 63 / d_dim;
+    double cells = (double) ( (1ULL << bits) - 1 );
+    const double* bounds = d_nodes[0].bounds;
+    unsigned long long grid[3] = { 0, 0, 0 };
+    double x = 0.0;
+    for ( int d = 0; d < d_dim; ++d )
+    {
+	x = 0.0;
+	if ( bounds[d+3] > bounds[d] )
+	{
+	    x = ( point[d] - bounds[d] ) / ( bounds[d+3] - bounds[d] );
+	    x = std::max( 0.0, std::min( 1.0, x ) );
+	}
+	grid[d] = (unsigned long long) ( x * cells );
+    }
+
+    unsigned long long key = 0;
+    for ( int b = bits - 1; b >= 0; --b )
+    {
+	for ( int d = 0; d < d_dim; ++d )
+	{
+	    key = ( key << 1 ) | ( ( grid[d] >> b ) & 1ULL );
+	}
+    }
+
+    return key;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if a point is in a tree node bounding box. The box is
+ * expanded in each direction by the tolerance relative to its length.
+ */
+template<typename GlobalOrdinal>
+inline bool KDTree<GlobalOrdinal>::pointInNode( const double point[3],
+						const int node,
+						const double tolerance ) const
+{
+    const double* bounds = d_nodes[node].bounds;
+    double pad = 0.0;
+    for ( int d = 0; d < 3; ++d )
+    {
+	pad = tolerance * ( bounds[d+3] - bounds[d] );
+	if ( point[d] < bounds[d] - pad || point[d] > bounds[d+3] + pad )
+	{
+	    return false;
+	}
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Find a point in the affine elements of a leaf. The point is mapped
+ * to the reference frame of every element in the leaf with the precomputed
+ * inverse maps and the first element whose reference simplex contains the
+ * point is returned. Elements that are not affine never contain the point.
+ *
+ * \param point The point coordinates padded to 3 dimensions.
+ *
+ * \param leaf The leaf node to search for the point in.
+ *
+ * \param tolerance Absolute tolerance for the reference simplex inclusion.
+ *
+ * \return The leaf element array index of the element containing the point
+ * or -1 if the point is not in an affine element of the leaf.
+ */
+template<typename GlobalOrdinal>
+int KDTree<GlobalOrdinal>::findPointInAffineElements( 
+    const double point[3],
+    const int leaf,
+    const double tolerance ) const
+{
+    testPrecondition( d_nodes[leaf].right < 0 );
+
+    int num_elements = d_leaf_element_indices.size();
+    const double* x0 = &d_leaf_affine_maps[0];
+    const double* y0 = x0 + num_elements;
+    const double* z0 = y0 + num_elements;
+    const double* j00 = z0 + num_elements;
+    const double* j01 = j00 + num_elements;
+    const double* j02 = j01 + num_elements;
+    const double* j10 = j02 + num_elements;
+    const double* j11 = j10 + num_elements;
+    const double* j12 = j11 + num_elements;
+    const double* j20 = j12 + num_elements;
+    const double* j21 = j20 + num_elements;
+    const double* j22 = j21 + num_elements;
+
+    int i = d_nodes[leaf].begin;
+    int end = d_nodes[leaf].end;
+
+#if HAVE_DTK_SIMD
+#if defined(__AVX512F__)
+    // 8 elements at a time. The ordered comparisons are false for the NaN
+    // vertices of non-affine elements.
+    __m512d px = _mm512_set1_pd( point[0] );
+    __m512d py = _mm512_set1_pd( point[1] );
+    __m512d pz = _mm512_set1_pd( point[2] );
+    __m512d lower = _mm512_set1_pd( -tolerance );
+    __m512d upper = _mm512_set1_pd( 1.0 + tolerance );
+    __m512d vdx, vdy, vdz, vr0, vr1, vr2;
+    __mmask8 inside;
+    for ( ; i + 8 <= end; i += 8 )
+    {
+	vdx = _mm512_sub_pd( px, _mm512_loadu_pd(x0+i) );
+	vdy = _mm512_sub_pd( py, _mm512_loadu_pd(y0+i) );
+	vdz = _mm512_sub_pd( pz, _mm512_loadu_pd(z0+i) );
+	vr0 = _mm512_fmadd_pd( _mm512_loadu_pd(j00+i), vdx,
+	     _mm512_fmadd_pd( _mm512_loadu_pd(j01+i), vdy,
+			      _mm512_mul_pd(_mm512_loadu_pd(j02+i), vdz) ) );
+	vr1 = _mm512_fmadd_pd( _mm512_loadu_pd(j10+i), vdx,
+	     _mm512_fmadd_pd( _mm512_loadu_pd(j11+i), vdy,
+			      _mm512_mul_pd(_mm512_loadu_pd(j12+i), vdz) ) );
+	vr2 = _mm512_fmadd_pd( _mm512_loadu_pd(j20+i), vdx,
+	     _mm512_fmadd_pd( _mm512_loadu_pd(j21+i), vdy,
+			      _mm512_mul_pd(_mm512_loadu_pd(j22+i), vdz) ) );
+	inside = _mm512_cmp_pd_mask( vr0, lower, _CMP_GE_OQ ) &
+		 _mm512_cmp_pd_mask( vr1, lower, _CMP_GE_OQ ) &
+		 _mm512_cmp_pd_mask( vr2, lower, _CMP_GE_OQ ) &
+		 _mm512_cmp_pd_mask( _mm512_add_pd(_mm512_add_pd(vr0,vr1),vr2),
+				     upper, _CMP_LE_OQ );
+	if ( inside )
+	{
+	    for ( int l = 0; l < 8; ++l )
+	    {
+		if ( inside & (1 << l) )
+		{
+		    return i + l;
+		}
+	    }
+	}
+    }
+#elif defined(__AVX2__)
+    // 4 elements at a time. The ordered comparisons are false for the NaN
+    // vertices of non-affine elements.
+    __m256d px = _mm256_set1_pd( point[0] );
+    __m256d py = _mm256_set1_pd( point[1] );
+    __m256d pz = _mm256_set1_pd( point[2] );
+    __m256d lower = _mm256_set1_pd( -tolerance );
+    __m256d upper = _mm256_set1_pd( 1.0 + tolerance );
+    __m256d vdx, vdy, vdz, vr0, vr1, vr2, inside;
+    int inside_lanes = 0;
+    for ( ; i + 4 <= end; i += 4 )
+    {
+	vdx = _mm256_sub_pd( px, _mm256_loadu_pd(x0+i) );
+	vdy = _mm256_sub_pd( py, _mm256_loadu_pd(y0+i) );
+	vdz = _mm256_sub_pd( pz, _mm256_loadu_pd(z0+i) );
+	vr0 = _mm256_add_pd( 
+	    _mm256_add_pd( _mm256_mul_pd(_mm256_loadu_pd(j00+i), vdx),
+			   _mm256_mul_pd(_mm256_loadu_pd(j01+i), vdy) ),
+	    _mm256_mul_pd(_mm256_loadu_pd(j02+i), vdz) );
+	vr1 = _mm256_add_pd( 
+	    _mm256_add_pd( _mm256_mul_pd(_mm256_loadu_pd(j10+i), vdx),
+			   _mm256_mul_pd(_mm256_loadu_pd(j11+i), vdy) ),
+	    _mm256_mul_pd(_mm256_loadu_pd(j12+i), vdz) );
+	vr2 = _mm256_add_pd( 
+	    _mm256_add_pd( _mm256_mul_pd(_mm256_loadu_pd(j20+i), vdx),
+			   _mm256_mul_pd(_mm256_loadu_pd(j21+i), vdy) ),
+	    _mm256_mul_pd(_mm256_loadu_pd(j22+i), vdz) );
+	inside = _mm256_and_pd( _mm256_cmp_pd(vr0, lower, _CMP_GE_OQ),
+				_mm256_cmp_pd(vr1, lower, _CMP_GE_OQ) );
+	inside = _mm256_and_pd( inside, _mm256_cmp_pd(vr2, lower, _CMP_GE_OQ) );
+	inside = _mm256_and_pd( 
+	    inside, _mm256_cmp_pd( _mm256_add_pd(_mm256_add_pd(vr0,vr1),vr2),
+				   upper, _CMP_LE_OQ ) );
+	inside_lanes = _mm256_movemask_pd( inside );
+	if ( inside_lanes )
+	{
+	    for ( int l = 0; l < 4; ++l )
+	    {
+		if ( inside_lanes & (1 << l) )
+		{
+		    return i + l;
+		}
+	    }
+	}
+    }
 #endif
-    testInvariant( moab::MB_SUCCESS == error );
-
-    // Get the elements in the leaf.
-    std::vector<moab::EntityHandle> leaf_elements;
-#if HAVE_DTK_DBC
-    error = d_mesh->getMoab()->get_entities_by_dimension( 
-	leaf, d_dim, leaf_elements );
-#else
-    d_mesh->getMoab()->get_entities_by_dimension( 
-	leaf, d_dim, leaf_elements );
 #endif
-    testInvariant( moab::MB_SUCCESS == error );
 
-    // Extract the client ordinals.
-    elements.resize( leaf_elements.size() );
-    typename Teuchos::Array<GlobalOrdinal>::iterator element_iterator;
-    std::vector<moab::EntityHandle>::const_iterator leaf_iterator;
-    for ( leaf_iterator = leaf_elements.begin(), 
-       element_iterator = elements.begin();
-	  leaf_iterator != leaf_elements.end();
-	  ++leaf_iterator, ++element_iterator )
+    // Scalar kernel for the remaining elements.
+    double dx = 0.0;
+    double dy = 0.0;
+    double dz = 0.0;
+    double r0 = 0.0;
+    double r1 = 0.0;
+    double r2 = 0.0;
+    for ( ; i < end; ++i )
     {
-	*element_iterator = d_mesh->getNativeOrdinal( *leaf_iterator );
+	dx = point[0] - x0[i];
+	dy = point[1] - y0[i];
+	dz = point[2] - z0[i];
+	r0 = j00[i]*dx + j01[i]*dy + j02[i]*dz;
+	r1 = j10[i]*dx + j11[i]*dy + j12[i]*dz;
+	r2 = j20[i]*dx + j21[i]*dy + j22[i]*dz;
+	if ( r0 >= -tolerance && r1 >= -tolerance && r2 >= -tolerance &&
+	     r0 + r1 + r2 <= 1.0 + tolerance )
+	{
+	    return i;
+	}
     }
+
+    return -1;
 }
 
 //---------------------------------------------------------------------------//
 /*!
  * \brief Find a point in a leaf by doing point-in-volume on all elements in
- * the leaf. Return if the point was not found.
+ * the leaf. Return if the point was not found. Elements whose bounding box
+ * does not contain the point are rejected before the point-in-volume check.
  *
- * \param coords Point coordinates to locate in the tree. Point dimensions
- * less than or equal to 3 are valid but the point most be the same dimension
- * as the tree.
+ * \param point The point coordinates padded to 3 dimensions.
+ *
+ * \param leaf The leaf node to search for the point in.
  *
- * \param leaf The subset of mesh elements to search for the point in.
+ * \param element_index The leaf element array index of the element the point
+ * was found in. This index is not valid if this function returns false.
  *
- * \param element The leaf element the point was found in. This element is not
- * valid if this function returns false.
+ * \param reference_point The point in the reference frame of the element
+ * it was found in. Not valid if this function returns false.
  *
  * \return Return true if the point was found in the leaf, false if not.
  */
 template<typename GlobalOrdinal>
 bool KDTree<GlobalOrdinal>::findPointInLeaf( 
-    const Teuchos::Array<double>& coords, 
-    const moab::EntityHandle leaf,
-    moab::EntityHandle& element,
+    const double point[3],
+    const int leaf,
+    int& element_index,
+    double reference_point[3],
     double tolerance )
 {
-    testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
-    testPrecondition( Teuchos::as<int>(coords.size()) == d_dim );
+    testPrecondition( d_nodes[leaf].right < 0 );
 
-    // Get the elements in the leaf.
-    rememberValue( moab::ErrorCode error );
-    std::vector<moab::EntityHandle> leaf_elements;
-#if HAVE_DTK_DBC
-    error = d_mesh->getMoab()->get_entities_by_dimension( 
-	leaf, d_dim, leaf_elements );
-#else
-    d_mesh->getMoab()->get_entities_by_dimension( 
-	leaf, d_dim, leaf_elements );
-#endif
-    testInvariant( moab::MB_SUCCESS == error );
+    // Check the affine elements in the leaf all at once. The reference
+    // point of the element found is recomputed from its inverse map.
+    int num_elements = d_leaf_element_indices.size();
+    int affine_index = findPointInAffineElements( point, leaf, tolerance );
+    if ( affine_index >= 0 )
+    {
+	element_index = affine_index;
+	const double* affine_map = &d_leaf_affine_maps[ affine_index ];
+	for ( int i = 0; i < 3; ++i )
+	{
+	    reference_point[i] = 0.0;
+	    for ( int j = 0; j < 3; ++j )
+	    {
+		reference_point[i] += 
+		    affine_map[ (3 + 3*i + j)*num_elements ] *
+		    ( point[j] - affine_map[ j*num_elements ] );
+	    }
+	}
+	return true;
+    }
 
-    // Search the leaf elements with the point.
-    Teuchos::Array<double> point( coords );
-    std::vector<moab::EntityHandle>::const_iterator leaf_iterator;
-    for ( leaf_iterator = leaf_elements.begin();
-	  leaf_iterator != leaf_elements.end();
-	  ++leaf_iterator )
+    // Check the rest of the elements one at a time.
+    const double* x_min = &d_leaf_bounds[0];
+    const double* y_min = x_min + num_elements;
+    const double* z_min = y_min + num_elements;
+    const double* x_max = z_min + num_elements;
+    const double* y_max = x_max + num_elements;
+    const double* z_max = y_max + num_elements;
+    for ( int i = d_nodes[leaf].begin; i < d_nodes[leaf].end; ++i )
     {
-	if ( TopologyTools::pointInElement( 
-		 point, *leaf_iterator, d_mesh->getMoab(), tolerance ) )
+	if ( !d_leaf_affine[i] &&
+	     point[0] >= x_min[i] - tolerance*(x_max[i] - x_min[i]) &&
+	     point[0] <= x_max[i] + tolerance*(x_max[i] - x_min[i]) &&
+	     point[1] >= y_min[i] - tolerance*(y_max[i] - y_min[i]) &&
+	     point[1] <= y_max[i] + tolerance*(y_max[i] - y_min[i]) &&
+	     point[2] >= z_min[i] - tolerance*(z_max[i] - z_min[i]) &&
+	     point[2] <= z_max[i] + tolerance*(z_max[i] - z_min[i]) &&
+	     d_mesh->pointInElement( 
+		 point, d_leaf_element_indices[i], reference_point, 
+		 tolerance ) )
 	{
-	    element = *leaf_iterator;
+	    element_index = i;
 	    return true;
 	}
     }
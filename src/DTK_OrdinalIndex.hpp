@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_OrdinalIndex.hpp
+ * \author Stuart R. Slattery
+ * \brief OrdinalIndex declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_ORDINALINDEX_HPP
+#define DTK_ORDINALINDEX_HPP
+
+#include <utility>
+
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class OrdinalIndex
+ * \brief Flat map from global ordinals to their local array index.
+
+ The ordinals are stored with their array index in a single array sorted by
+ ordinal such that a lookup is a binary search over contiguous memory. Mesh
+ ordinals are very often a contiguous range, in which case the sorted array
+ is indexed directly by the ordinal offset and a lookup is constant time.
+ */
+//---------------------------------------------------------------------------//
+template<typename GlobalOrdinal>
+class OrdinalIndex
+{
+  public:
+
+    //@{
+    //! Typedefs.
+    typedef GlobalOrdinal                                global_ordinal_type;
+    typedef std::pair<GlobalOrdinal,GlobalOrdinal>       OrdinalPair;
+    //@}
+
+    // Default constructor.
+    OrdinalIndex();
+
+    // Constructor.
+    explicit OrdinalIndex( 
+	const Teuchos::ArrayView<const GlobalOrdinal>& ordinals );
+
+    // Destructor.
+    ~OrdinalIndex();
+
+    // Build the index over a list of unique ordinals.
+    void build( const Teuchos::ArrayView<const GlobalOrdinal>& ordinals );
+
+    // Get the array index of an ordinal.
+    inline GlobalOrdinal index( const GlobalOrdinal ordinal ) const;
+
+    // Determine if an ordinal is in the index.
+    bool contains( const GlobalOrdinal ordinal ) const;
+
+    //! Get the number of ordinals in the index.
+    int size() const
+    { return d_table.size(); }
+
+    //! Return true if the ordinals are a contiguous range.
+    bool isContiguous() const
+    { return d_contiguous; }
+
+  private:
+
+    // Ordinal/index pairs sorted by ordinal.
+    Teuchos::Array<OrdinalPair> d_table;
+
+    // True if the ordinals are a contiguous range.
+    bool d_contiguous;
+};
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// Template includes.
+//---------------------------------------------------------------------------//
+
+#include "DTK_OrdinalIndex_def.hpp"
+
+#endif // end DTK_ORDINALINDEX_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_OrdinalIndex.hpp
+//---------------------------------------------------------------------------//
+
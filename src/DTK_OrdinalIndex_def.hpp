@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_OrdinalIndex_def.hpp
+ * \author Stuart R. Slattery
+ * \brief OrdinalIndex definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_ORDINALINDEX_DEF_HPP
+#define DTK_ORDINALINDEX_DEF_HPP
+
+#include <algorithm>
+
+#include "DTK_Assertion.hpp"
+
+#include <Teuchos_as.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Default constructor.
+ */
+template<typename GlobalOrdinal>
+OrdinalIndex<GlobalOrdinal>::OrdinalIndex()
+    : d_contiguous( true )
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor.
+ *
+ * \param ordinals The unique ordinals to index. The index of each ordinal is
+ * its position in this list.
+ */
+template<typename GlobalOrdinal>
+OrdinalIndex<GlobalOrdinal>::OrdinalIndex( 
+    const Teuchos::ArrayView<const GlobalOrdinal>& ordinals )
+    : d_contiguous( true )
+{
+    build( ordinals );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor.
+ */
+template<typename GlobalOrdinal>
+OrdinalIndex<GlobalOrdinal>::~OrdinalIndex()
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the index over a list of unique ordinals.
+ *
+ * \param ordinals The unique ordinals to index. The index of each ordinal is
+ * its position in this list.
+ */
+template<typename GlobalOrdinal>
+void OrdinalIndex<GlobalOrdinal>::build( 
+    const Teuchos::ArrayView<const GlobalOrdinal>& ordinals )
+{
+    int num_ordinals = ordinals.size();
+    d_table.resize( num_ordinals );
+    for ( int n = 0; n < num_ordinals; ++n )
+    {
+	d_table[n] = OrdinalPair( ordinals[n], n );
+    }
+    std::sort( d_table.begin(), d_table.end() );
+
+    // The sorted unique ordinals are contiguous if they span exactly as many
+    // values as there are ordinals.
+    d_contiguous = ( 0 == num_ordinals ) ||
+		   ( d_table.back().first - d_table.front().first == 
+		     Teuchos::as<GlobalOrdinal>(num_ordinals - 1) );
+
+    testPostcondition( Teuchos::as<int>(d_table.size()) == num_ordinals );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the array index of an ordinal. The ordinal must be in the
+ * index.
+ *
+ * \param ordinal The ordinal to get the index for.
+ *
+ * \return The position of the ordinal in the list the index was built with.
+ */
+template<typename GlobalOrdinal>
+inline GlobalOrdinal 
+OrdinalIndex<GlobalOrdinal>::index( const GlobalOrdinal ordinal ) const
+{
+    testPrecondition( contains(ordinal) );
+
+    if ( d_contiguous )
+    {
+	return d_table[ ordinal - d_table.front().first ].second;
+    }
+
+    return std::lower_bound( d_table.begin(), d_table.end(),
+			     OrdinalPair(ordinal, 0) )->second;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if an ordinal is in the index.
+ *
+ * \param ordinal The ordinal to look for.
+ *
+ * \return Return true if the ordinal is in the index.
+ */
+template<typename GlobalOrdinal>
+bool OrdinalIndex<GlobalOrdinal>::contains( const GlobalOrdinal ordinal ) const
+{
+    if ( d_table.empty() )
+    {
+	return false;
+    }
+
+    if ( d_contiguous )
+    {
+	return ( d_table.front().first <= ordinal && 
+		 ordinal <= d_table.back().first );
+    }
+
+    typename Teuchos::Array<OrdinalPair>::const_iterator table_it = 
+	std::lower_bound( d_table.begin(), d_table.end(),
+			  OrdinalPair(ordinal, 0) );
+    return ( table_it != d_table.end() && table_it->first == ordinal );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_ORDINALINDEX_DEF_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_OrdinalIndex_def.hpp
+//---------------------------------------------------------------------------//
+
@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_PartitionWeights.hpp
+ * \author Stuart R. Slattery
+ * \brief Partition weights interface declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_PARTITIONWEIGHTS_HPP
+#define DTK_PARTITIONWEIGHTS_HPP
+
+#include <Teuchos_ArrayView.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class PartitionWeights
+ * \brief Partition weights interface.
+
+ By default the rendezvous partitioning balances the number of source mesh
+ vertices on each process. A partition weight assigns a cost to each vertex
+ instead such that the partitioning balances the total cost of each process.
+ Clients may implement this interface to supply their own cost model.
+ */
+//---------------------------------------------------------------------------//
+class PartitionWeights
+{
+  public:
+
+    // Constructor.
+    PartitionWeights()
+    { /* ... */ }
+
+    // Destructor.
+    virtual ~PartitionWeights()
+    { /* ... */ }
+
+    /*!
+     * \brief Compute the weights of a blocked list of points.
+     *
+     * \param coords The point coordinates blocked by dimension { x_0, ...,
+     * x_N, y_0, ..., y_N, z_0, ..., z_N }.
+     *
+     * \param weights The weight of each point in the same order as the
+     * points. Weights must be non-negative.
+     */
+    virtual void 
+    pointWeights( const Teuchos::ArrayView<const double>& coords,
+		  const Teuchos::ArrayView<float>& weights ) const = 0;
+};
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_PARTITIONWEIGHTS_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_PartitionWeights.hpp
+//---------------------------------------------------------------------------//
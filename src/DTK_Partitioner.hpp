@@ -44,10 +44,26 @@
 #include "DTK_BoundingBox.hpp"
 
 #include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
 
 namespace DataTransferKit
 {
 
+/*!
+ * \brief Partitioning algorithm enumerations.
+ *
+ * These select the geometric partitioning used to build the rendezvous
+ * decomposition. RCB, RIB, and HSFC are computed by Zoltan. The Hilbert
+ * partitioner is native to DTK and does not require Zoltan.
+ */
+enum DTK_PartitionerType
+{
+    DTK_RCB_PARTITIONER = 0,
+    DTK_RIB_PARTITIONER,
+    DTK_HSFC_PARTITIONER,
+    DTK_HILBERT_PARTITIONER
+};
+
 //---------------------------------------------------------------------------//
 /*!
  * \class Partitioner
@@ -71,11 +87,21 @@ class Partitioner
 
     // Get the destination process for a point given its coordinates.
     virtual int 
-    getPointDestinationProc( Teuchos::Array<double> coords ) const = 0;
+    getPointDestinationProc( const Teuchos::Array<double>& coords ) const = 0;
 
     // Get the destination processes for a bounding box.
     virtual Teuchos::Array<int> 
     getBoxDestinationProcs( const BoundingBox& box ) const = 0;
+
+    // Get the destination processes for a blocked list of points.
+    virtual void getPointDestinationProcs( 
+	const Teuchos::ArrayView<const double>& coords,
+	Teuchos::Array<int>& procs ) const = 0;
+
+    // Get the destination processes for a list of bounding boxes.
+    virtual void getBoxDestinationProcs( 
+	const Teuchos::Array<BoundingBox>& boxes,
+	Teuchos::Array<Teuchos::Array<int> >& procs ) const = 0;
 };
 
 } // end namespace DataTransferKit
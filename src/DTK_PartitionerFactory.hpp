@@ -41,18 +41,29 @@
 #ifndef DTK_PARTITIONERFACTORY_HPP
 #define DTK_PARTITIONERFACTORY_HPP
 
+#include <algorithm>
+#include <iterator>
+
 #include "DTK_Partitioner.hpp"
 #include "DTK_MeshManager.hpp"
 #include "DTK_GeometryManager.hpp"
 #include "DTK_SerialPartitioner.hpp"
+#include "DTK_HilbertPartitioner.hpp"
+#include "DTK_PartitionWeights.hpp"
+#include "DTK_MeshTools.hpp"
+#include "DTK_MeshTraits.hpp"
+#include "DTK_GeometryTraits.hpp"
 
 #ifdef HAVE_DTK_MPI
 #include "DTK_RCB.hpp"
+#include "DTK_ZoltanPartitioner.hpp"
 #include "DTK_GeometryRCB.hpp"
 #endif
 
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_Comm.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_as.hpp>
 
 namespace DataTransferKit
 {
@@ -61,6 +72,12 @@ namespace DataTransferKit
 /*!
  * \class PartitionerFactory
  * \brief Factory for generating partitioners.
+ *
+ * Meshes may be partitioned with any of the partitioner types. Geometry may
+ * be partitioned with RCB or the native Hilbert partitioner. The Zoltan RIB
+ * and HSFC partitioners are not available for geometry and RCB is used
+ * instead. All types are replaced by the serial partitioner if MPI is not
+ * enabled.
  */
 //---------------------------------------------------------------------------//
 class PartitionerFactory
@@ -81,7 +98,9 @@ class PartitionerFactory
     createMeshPartitioner( 
 	const Teuchos::RCP<const Teuchos::Comm<int> > comm,
 	const Teuchos::RCP<MeshManager<Mesh> > mesh_manager,
-	const int dimension );
+	const int dimension,
+	const Teuchos::RCP<PartitionWeights>& weights = Teuchos::null,
+	const DTK_PartitionerType type = DTK_RCB_PARTITIONER );
 
     // Geometry factory method.
     template<class Geometry, class GlobalOrdinal>
@@ -89,7 +108,24 @@ class PartitionerFactory
     createGeometryPartitioner( 
 	const Teuchos::RCP<const Teuchos::Comm<int> > comm,
 	const Teuchos::RCP<GeometryManager<Geometry,GlobalOrdinal> > geometry_manager,
-	const int dimension );
+	const int dimension,
+	const DTK_PartitionerType type = DTK_RCB_PARTITIONER );
+
+  private:
+
+    // Set the active mesh vertices as the points of a Hilbert partitioner.
+    template<class Mesh>
+    static inline void setHilbertPoints( 
+	HilbertPartitioner& partitioner,
+	const Teuchos::RCP<MeshManager<Mesh> > mesh_manager,
+	const Teuchos::RCP<PartitionWeights>& weights );
+
+    // Set the active geometry centroids as the points of a Hilbert
+    // partitioner.
+    template<class Geometry, class GlobalOrdinal>
+    static inline void setHilbertPoints( 
+	HilbertPartitioner& partitioner,
+	const Teuchos::RCP<GeometryManager<Geometry,GlobalOrdinal> > geometry_manager );
 };
 
 //---------------------------------------------------------------------------//
@@ -99,12 +135,27 @@ template<class Mesh>
 Teuchos::RCP<Partitioner> PartitionerFactory::createMeshPartitioner(
     const Teuchos::RCP<const Teuchos::Comm<int> > comm,
     const Teuchos::RCP<MeshManager<Mesh> > mesh_manager,
-    const int dimension )
+    const int dimension,
+    const Teuchos::RCP<PartitionWeights>& weights,
+    const DTK_PartitionerType type )
 {
 #ifdef HAVE_DTK_MPI
-    return Teuchos::rcp( new RCB<Mesh>( comm, mesh_manager, dimension ) );
+    if ( DTK_HILBERT_PARTITIONER == type )
+    {
+	Teuchos::RCP<HilbertPartitioner> partitioner = 
+	    Teuchos::rcp( new HilbertPartitioner( comm, dimension ) );
+	setHilbertPoints( *partitioner, mesh_manager, weights );
+	return partitioner;
+    }
+    else if ( DTK_RIB_PARTITIONER == type || DTK_HSFC_PARTITIONER == type )
+    {
+	return Teuchos::rcp( new ZoltanPartitioner<Mesh>( 
+				 comm, mesh_manager, dimension, type, weights ) );
+    }
+    return Teuchos::rcp( 
+	new RCB<Mesh>( comm, mesh_manager, dimension, weights ) );
 #else
-    return Teuchos::rcp( new SerialPartitioner() );
+    return Teuchos::rcp( new SerialPartitioner( dimension ) );
 #endif
 }
 
@@ -113,16 +164,142 @@ template<class Geometry, class GlobalOrdinal>
 Teuchos::RCP<Partitioner> PartitionerFactory::createGeometryPartitioner(
     const Teuchos::RCP<const Teuchos::Comm<int> > comm,
     const Teuchos::RCP<GeometryManager<Geometry,GlobalOrdinal> > geometry_manager,
-    const int dimension )
+    const int dimension,
+    const DTK_PartitionerType type )
 {
 #ifdef HAVE_DTK_MPI
+    if ( DTK_HILBERT_PARTITIONER == type )
+    {
+	Teuchos::RCP<HilbertPartitioner> partitioner = 
+	    Teuchos::rcp( new HilbertPartitioner( comm, dimension ) );
+	setHilbertPoints( *partitioner, geometry_manager );
+	return partitioner;
+    }
     return Teuchos::rcp( new GeometryRCB<Geometry,GlobalOrdinal>( 
 			     comm, geometry_manager, dimension ) );
 #else
-    return Teuchos::rcp( new SerialPartitioner() );
+    return Teuchos::rcp( new SerialPartitioner( dimension ) );
 #endif
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the active mesh vertices as the points of a Hilbert
+ * partitioner. Vertices have unit weight if no weights were provided.
+ */
+template<class Mesh>
+void PartitionerFactory::setHilbertPoints( 
+    HilbertPartitioner& partitioner,
+    const Teuchos::RCP<MeshManager<Mesh> > mesh_manager,
+    const Teuchos::RCP<PartitionWeights>& weights )
+{
+    typedef MeshTraits<Mesh> MT;
+    typedef typename MT::global_ordinal_type GlobalOrdinal;
+    typedef typename MeshManager<Mesh>::BlockIterator BlockIterator;
+
+    Teuchos::Array<double> active_coords;
+    Teuchos::Array<float> active_weights;
+
+    // The mesh may not exist on all processes.
+    if ( !mesh_manager.is_null() )
+    {
+	int vertex_dim = mesh_manager->dim();
+	BlockIterator block_iterator;
+
+	// Count the active vertices.
+	GlobalOrdinal num_active = 0;
+	for ( int i = 0; i < mesh_manager->getNumBlocks(); ++i )
+	{
+	    Teuchos::ArrayView<short int> active_vertices = 
+		mesh_manager->getActiveVertices( i );
+	    num_active += std::count( active_vertices.begin(), 
+				      active_vertices.end(), 1 );
+	}
+
+	// Extract the active vertex coordinates.
+	active_coords.resize( vertex_dim*num_active );
+	GlobalOrdinal n = 0;
+	for ( block_iterator = mesh_manager->blocksBegin();
+	      block_iterator != mesh_manager->blocksEnd();
+	      ++block_iterator )
+	{
+	    int block_id = std::distance( mesh_manager->blocksBegin(),
+					  block_iterator );
+	    Teuchos::ArrayView<short int> active_vertices =
+		mesh_manager->getActiveVertices( block_id );
+	    Teuchos::ArrayRCP<const double> mesh_coords = 
+		MeshTools<Mesh>::coordsView( *(*block_iterator) );
+	    GlobalOrdinal num_vertices = 
+		MeshTools<Mesh>::numVertices( *(*block_iterator) );
+	    for ( GlobalOrdinal i = 0; i < num_vertices; ++i )
+	    {
+		if ( active_vertices[i] )
+		{
+		    for ( int d = 0; d < vertex_dim; ++d )
+		    {
+			active_coords[ d*num_active + n ] = 
+			    mesh_coords[ d*num_vertices + i ];
+		    }
+		    ++n;
+		}
+	    }
+	}
+
+	if ( !weights.is_null() )
+	{
+	    active_weights.resize( num_active );
+	    weights->pointWeights( active_coords(), active_weights() );
+	}
+    }
+
+    partitioner.setPoints( active_coords(), active_weights() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the active geometry centroids as the points of a Hilbert
+ * partitioner.
+ */
+template<class Geometry, class GlobalOrdinal>
+void PartitionerFactory::setHilbertPoints( 
+    HilbertPartitioner& partitioner,
+    const Teuchos::RCP<GeometryManager<Geometry,GlobalOrdinal> > geometry_manager )
+{
+    typedef GeometryTraits<Geometry> GT;
+
+    Teuchos::Array<double> active_coords;
+
+    // The geometry may not exist on all processes.
+    if ( !geometry_manager.is_null() )
+    {
+	int geom_dim = geometry_manager->dim();
+	Teuchos::ArrayRCP<Geometry> local_geometry = 
+	    geometry_manager->geometry();
+	Teuchos::ArrayView<short int> active_geom =
+	    geometry_manager->getActiveGeometry();
+	int num_active = 
+	    std::count( active_geom.begin(), active_geom.end(), 1 );
+
+	active_coords.resize( geom_dim*num_active );
+	Teuchos::Array<double> centroid;
+	int n = 0;
+	for ( int i = 0; i < Teuchos::as<int>(local_geometry.size()); ++i )
+	{
+	    if ( active_geom[i] )
+	    {
+		centroid = GT::centroid( local_geometry[i] );
+		for ( int d = 0; d < geom_dim; ++d )
+		{
+		    active_coords[ d*num_active + n ] = centroid[d];
+		}
+		++n;
+	    }
+	}
+    }
+
+    partitioner.setPoints( active_coords(), Teuchos::ArrayView<const float>() );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace DataTransferKit
@@ -0,0 +1,282 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_PointInElementKernels.hpp
+ * \author Stuart R. Slattery
+ * \brief Point-in-element kernel declarations.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_POINTINELEMENTKERNELS_HPP
+#define DTK_POINTINELEMENTKERNELS_HPP
+
+#include <MBInterface.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class PointInElementKernel
+ * \brief Analytic point-in-element kernels for linear element topologies.
+
+ Each specialization maps a physical point to the reference frame of an
+ element and checks for inclusion in the reference element without any heap
+ allocation. The reference elements are the same as those used by Intrepid
+ such that results are consistent with the general Intrepid path in
+ TopologyTools. Line segments, triangles, and tetrahedrons are inverted in
+ closed form. Quadrilaterals, hexahedrons, and wedges are inverted with a
+ bounded Newton iteration.
+
+ The element vertex coordinates are interleaved with 3 coordinates per vertex
+ ( x_0, y_0, z_0, x_1, y_1, z_1, ... ) as they are stored by Moab. The point
+ must have the same dimension as the element topology.
+
+ Each kernel also provides the values of the linear Lagrange shape functions
+ of its element at a reference point in canonical vertex order such that a
+ vertex field can be interpolated at points located by the kernel.
+
+ The primary template is not defined. Use TopologyTools::pointInElement to
+ dispatch to a kernel at runtime.
+ */
+//---------------------------------------------------------------------------//
+template<moab::EntityType Topology>
+class PointInElementKernel;
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class ReferenceFrameTools
+ * \brief Stateless tools shared by the point-in-element kernels.
+ */
+//---------------------------------------------------------------------------//
+class ReferenceFrameTools
+{
+  public:
+
+    // Solve a dense linear system of dimension 1, 2, or 3.
+    static inline bool solve( const int dim, 
+			      const double A[3][3], 
+			      const double b[3], 
+			      double x[3] );
+
+    // Map a point to the reference frame of an element with a bounded
+    // Newton iteration.
+    template<class Kernel>
+    static inline bool newtonMapToReferenceFrame( const double point[3],
+						  const double* vertices,
+						  double reference[3] );
+
+  private:
+
+    // Maximum number of Newton iterations.
+    static const int d_max_newton_iterations = 20;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Line segment kernel. The reference element is [-1,1].
+ */
+template<>
+class PointInElementKernel<moab::MBEDGE>
+{
+  public:
+
+    static const int dim = 1;
+    static const int num_vertices = 2;
+
+    static inline bool mapToReferenceFrame( const double point[3],
+					    const double* vertices,
+					    double reference[3] );
+
+    static inline bool pointInReferenceElement( const double reference[3],
+						const double tolerance );
+
+    static inline void shapeFunctions( const double reference[3],
+				       double values[] );
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Triangle kernel. The reference element has vertices (0,0), (1,0),
+ * and (0,1).
+ */
+template<>
+class PointInElementKernel<moab::MBTRI>
+{
+  public:
+
+    static const int dim = 2;
+    static const int num_vertices = 3;
+
+    static inline bool mapToReferenceFrame( const double point[3],
+					    const double* vertices,
+					    double reference[3] );
+
+    static inline bool pointInReferenceElement( const double reference[3],
+						const double tolerance );
+
+    static inline void shapeFunctions( const double reference[3],
+				       double values[] );
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Quadrilateral kernel. The reference element is [-1,1]^2.
+ */
+template<>
+class PointInElementKernel<moab::MBQUAD>
+{
+  public:
+
+    static const int dim = 2;
+    static const int num_vertices = 4;
+
+    static inline bool mapToReferenceFrame( const double point[3],
+					    const double* vertices,
+					    double reference[3] );
+
+    static inline bool pointInReferenceElement( const double reference[3],
+						const double tolerance );
+
+    static inline void shapeFunctions( const double reference[3],
+				       double values[] );
+
+    static inline void referenceCenter( double reference[3] );
+
+    static inline void mapToPhysicalFrame( const double reference[3],
+					   const double* vertices,
+					   double point[3],
+					   double jacobian[3][3] );
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Tetrahedron kernel. The reference element has vertices (0,0,0),
+ * (1,0,0), (0,1,0), and (0,0,1).
+ */
+template<>
+class PointInElementKernel<moab::MBTET>
+{
+  public:
+
+    static const int dim = 3;
+    static const int num_vertices = 4;
+
+    static inline bool mapToReferenceFrame( const double point[3],
+					    const double* vertices,
+					    double reference[3] );
+
+    static inline bool pointInReferenceElement( const double reference[3],
+						const double tolerance );
+
+    static inline void shapeFunctions( const double reference[3],
+				       double values[] );
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Wedge kernel. The reference element is the reference triangle
+ * extruded over [-1,1].
+ */
+template<>
+class PointInElementKernel<moab::MBPRISM>
+{
+  public:
+
+    static const int dim = 3;
+    static const int num_vertices = 6;
+
+    static inline bool mapToReferenceFrame( const double point[3],
+					    const double* vertices,
+					    double reference[3] );
+
+    static inline bool pointInReferenceElement( const double reference[3],
+						const double tolerance );
+
+    static inline void shapeFunctions( const double reference[3],
+				       double values[] );
+
+    static inline void referenceCenter( double reference[3] );
+
+    static inline void mapToPhysicalFrame( const double reference[3],
+					   const double* vertices,
+					   double point[3],
+					   double jacobian[3][3] );
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Hexahedron kernel. The reference element is [-1,1]^3.
+ */
+template<>
+class PointInElementKernel<moab::MBHEX>
+{
+  public:
+
+    static const int dim = 3;
+    static const int num_vertices = 8;
+
+    static inline bool mapToReferenceFrame( const double point[3],
+					    const double* vertices,
+					    double reference[3] );
+
+    static inline bool pointInReferenceElement( const double reference[3],
+						const double tolerance );
+
+    static inline void shapeFunctions( const double reference[3],
+				       double values[] );
+
+    static inline void referenceCenter( double reference[3] );
+
+    static inline void mapToPhysicalFrame( const double reference[3],
+					   const double* vertices,
+					   double point[3],
+					   double jacobian[3][3] );
+};
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// Inline includes.
+//---------------------------------------------------------------------------//
+
+#include "DTK_PointInElementKernels_def.hpp"
+
+//---------------------------------------------------------------------------//
+
+#endif // end DTK_POINTINELEMENTKERNELS_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_PointInElementKernels.hpp
+//---------------------------------------------------------------------------//
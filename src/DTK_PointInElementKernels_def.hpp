@@ -0,0 +1,503 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_PointInElementKernels_def.hpp
+ * \author Stuart R. Slattery
+ * \brief Point-in-element kernel inline definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_POINTINELEMENTKERNELS_DEF_HPP
+#define DTK_POINTINELEMENTKERNELS_DEF_HPP
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "DTK_Assertion.hpp"
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+// ReferenceFrameTools.
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Solve a dense linear system of dimension 1, 2, or 3 with Cramer's
+ * rule. Return false if the system is singular.
+ */
+inline bool ReferenceFrameTools::solve( const int dim,
+					const double A[3][3],
+					const double b[3],
+					double x[3] )
+{
+    testPrecondition( 0 < dim && dim <= 3 );
+
+    double det = 0.0;
+    if ( 1 == dim )
+    {
+	det = A[0][0];
+	if ( std::abs(det) <= std::numeric_limits<double>::min() )
+	{
+	    return false;
+	}
+	x[0] = b[0] / det;
+    }
+    else if ( 2 == dim )
+    {
+	det = A[0][0]*A[1][1] - A[0][1]*A[1][0];
+	if ( std::abs(det) <= std::numeric_limits<double>::min() )
+	{
+	    return false;
+	}
+	x[0] = ( b[0]*A[1][1] - A[0][1]*b[1] ) / det;
+	x[1] = ( A[0][0]*b[1] - b[0]*A[1][0] ) / det;
+    }
+    else
+    {
+	double c00 = A[1][1]*A[2][2] - A[1][2]*A[2][1];
+	double c01 = A[1][2]*A[2][0] - A[1][0]*A[2][2];
+	double c02 = A[1][0]*A[2][1] - A[1][1]*A[2][0];
+	det = A[0][0]*c00 + A[0][1]*c01 + A[0][2]*c02;
+	if ( std::abs(det) <= std::numeric_limits<double>::min() )
+	{
+	    return false;
+	}
+	double c10 = A[0][2]*A[2][1] - A[0][1]*A[2][2];
+	double c11 = A[0][0]*A[2][2] - A[0][2]*A[2][0];
+	double c12 = A[0][1]*A[2][0] - A[0][0]*A[2][1];
+	double c20 = A[0][1]*A[1][2] - A[0][2]*A[1][1];
+	double c21 = A[0][2]*A[1][0] - A[0][0]*A[1][2];
+	double c22 = A[0][0]*A[1][1] - A[0][1]*A[1][0];
+	x[0] = ( c00*b[0] + c10*b[1] + c20*b[2] ) / det;
+	x[1] = ( c01*b[0] + c11*b[1] + c21*b[2] ) / det;
+	x[2] = ( c02*b[0] + c12*b[1] + c22*b[2] ) / det;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Map a point to the reference frame of an element with a bounded
+ * Newton iteration starting at the reference element center. Return false
+ * if the Jacobian is singular or the iteration did not converge.
+ */
+template<class Kernel>
+inline bool ReferenceFrameTools::newtonMapToReferenceFrame( 
+    const double point[3], const double* vertices, double reference[3] )
+{
+    double x[3];
+    double jacobian[3][3];
+    double residual[3];
+    double delta[3];
+    double delta_norm = 0.0;
+    Kernel::referenceCenter( reference );
+    for ( int n = 0; n < d_max_newton_iterations; ++n )
+    {
+	Kernel::mapToPhysicalFrame( reference, vertices, x, jacobian );
+	for ( int d = 0; d < Kernel::dim; ++d )
+	{
+	    residual[d] = point[d] - x[d];
+	}
+
+	if ( !solve(Kernel::dim, jacobian, residual, delta) )
+	{
+	    return false;
+	}
+
+	delta_norm = 0.0;
+	for ( int d = 0; d < Kernel::dim; ++d )
+	{
+	    reference[d] += delta[d];
+	    delta_norm = std::max( delta_norm, std::abs(delta[d]) );
+	}
+	if ( delta_norm < 1.0e-12 )
+	{
+	    return true;
+	}
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+// Line segment.
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBEDGE>::mapToReferenceFrame(
+    const double point[3], const double* vertices, double reference[3] )
+{
+    double jacobian = ( vertices[3] - vertices[0] ) / 2.0;
+    if ( std::abs(jacobian) <= std::numeric_limits<double>::min() )
+    {
+	return false;
+    }
+    reference[0] = ( point[0] - (vertices[0] + vertices[3]) / 2.0 ) / jacobian;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBEDGE>::pointInReferenceElement(
+    const double reference[3], const double tolerance )
+{
+    return ( std::abs(reference[0]) <= 1.0 + tolerance );
+}
+
+//---------------------------------------------------------------------------//
+// Triangle.
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBTRI>::mapToReferenceFrame(
+    const double point[3], const double* vertices, double reference[3] )
+{
+    double jacobian[3][3];
+    double b[3];
+    for ( int d = 0; d < 2; ++d )
+    {
+	jacobian[d][0] = vertices[3+d] - vertices[d];
+	jacobian[d][1] = vertices[6+d] - vertices[d];
+	b[d] = point[d] - vertices[d];
+    }
+    return ReferenceFrameTools::solve( 2, jacobian, b, reference );
+}
+
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBTRI>::pointInReferenceElement(
+    const double reference[3], const double tolerance )
+{
+    return ( reference[0] >= -tolerance &&
+	     reference[1] >= -tolerance &&
+	     reference[0] + reference[1] <= 1.0 + tolerance );
+}
+
+//---------------------------------------------------------------------------//
+// Quadrilateral.
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBQUAD>::mapToReferenceFrame(
+    const double point[3], const double* vertices, double reference[3] )
+{
+    return ReferenceFrameTools::newtonMapToReferenceFrame<
+	PointInElementKernel<moab::MBQUAD> >( point, vertices, reference );
+}
+
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBQUAD>::pointInReferenceElement(
+    const double reference[3], const double tolerance )
+{
+    return ( std::abs(reference[0]) <= 1.0 + tolerance &&
+	     std::abs(reference[1]) <= 1.0 + tolerance );
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBQUAD>::referenceCenter(
+    double reference[3] )
+{
+    reference[0] = 0.0;
+    reference[1] = 0.0;
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBQUAD>::mapToPhysicalFrame(
+    const double reference[3], const double* vertices, 
+    double point[3], double jacobian[3][3] )
+{
+    static const double xi[4] = { -1.0, 1.0, 1.0, -1.0 };
+    static const double eta[4] = { -1.0, -1.0, 1.0, 1.0 };
+
+    double shape = 0.0;
+    double dshape[2];
+    for ( int d = 0; d < 2; ++d )
+    {
+	point[d] = 0.0;
+	jacobian[d][0] = 0.0;
+	jacobian[d][1] = 0.0;
+    }
+    for ( int i = 0; i < 4; ++i )
+    {
+	shape = 0.25 * (1.0 + xi[i]*reference[0]) * (1.0 + eta[i]*reference[1]);
+	dshape[0] = 0.25 * xi[i] * (1.0 + eta[i]*reference[1]);
+	dshape[1] = 0.25 * eta[i] * (1.0 + xi[i]*reference[0]);
+	for ( int d = 0; d < 2; ++d )
+	{
+	    point[d] += shape * vertices[3*i+d];
+	    jacobian[d][0] += dshape[0] * vertices[3*i+d];
+	    jacobian[d][1] += dshape[1] * vertices[3*i+d];
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Tetrahedron.
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBTET>::mapToReferenceFrame(
+    const double point[3], const double* vertices, double reference[3] )
+{
+    double jacobian[3][3];
+    double b[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+	jacobian[d][0] = vertices[3+d] - vertices[d];
+	jacobian[d][1] = vertices[6+d] - vertices[d];
+	jacobian[d][2] = vertices[9+d] - vertices[d];
+	b[d] = point[d] - vertices[d];
+    }
+    return ReferenceFrameTools::solve( 3, jacobian, b, reference );
+}
+
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBTET>::pointInReferenceElement(
+    const double reference[3], const double tolerance )
+{
+    return ( reference[0] >= -tolerance &&
+	     reference[1] >= -tolerance &&
+	     reference[2] >= -tolerance &&
+	     reference[0] + reference[1] + reference[2] <= 1.0 + tolerance );
+}
+
+//---------------------------------------------------------------------------//
+// Wedge.
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBPRISM>::mapToReferenceFrame(
+    const double point[3], const double* vertices, double reference[3] )
+{
+    return ReferenceFrameTools::newtonMapToReferenceFrame<
+	PointInElementKernel<moab::MBPRISM> >( point, vertices, reference );
+}
+
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBPRISM>::pointInReferenceElement(
+    const double reference[3], const double tolerance )
+{
+    return ( reference[0] >= -tolerance &&
+	     reference[1] >= -tolerance &&
+	     reference[0] + reference[1] <= 1.0 + tolerance &&
+	     std::abs(reference[2]) <= 1.0 + tolerance );
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBPRISM>::referenceCenter(
+    double reference[3] )
+{
+    reference[0] = 1.0 / 3.0;
+    reference[1] = 1.0 / 3.0;
+    reference[2] = 0.0;
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBPRISM>::mapToPhysicalFrame(
+    const double reference[3], const double* vertices, 
+    double point[3], double jacobian[3][3] )
+{
+    double t = 1.0 - reference[0] - reference[1];
+    double zm = ( 1.0 - reference[2] ) / 2.0;
+    double zp = ( 1.0 + reference[2] ) / 2.0;
+
+    double shape[6] = { t*zm, reference[0]*zm, reference[1]*zm,
+			t*zp, reference[0]*zp, reference[1]*zp };
+    double dshape_x[6] = { -zm, zm, 0.0, -zp, zp, 0.0 };
+    double dshape_y[6] = { -zm, 0.0, zm, -zp, 0.0, zp };
+    double dshape_z[6] = { -t/2.0, -reference[0]/2.0, -reference[1]/2.0,
+			   t/2.0, reference[0]/2.0, reference[1]/2.0 };
+
+    for ( int d = 0; d < 3; ++d )
+    {
+	point[d] = 0.0;
+	jacobian[d][0] = 0.0;
+	jacobian[d][1] = 0.0;
+	jacobian[d][2] = 0.0;
+	for ( int i = 0; i < 6; ++i )
+	{
+	    point[d] += shape[i] * vertices[3*i+d];
+	    jacobian[d][0] += dshape_x[i] * vertices[3*i+d];
+	    jacobian[d][1] += dshape_y[i] * vertices[3*i+d];
+	    jacobian[d][2] += dshape_z[i] * vertices[3*i+d];
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Hexahedron.
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBHEX>::mapToReferenceFrame(
+    const double point[3], const double* vertices, double reference[3] )
+{
+    return ReferenceFrameTools::newtonMapToReferenceFrame<
+	PointInElementKernel<moab::MBHEX> >( point, vertices, reference );
+}
+
+//---------------------------------------------------------------------------//
+inline bool PointInElementKernel<moab::MBHEX>::pointInReferenceElement(
+    const double reference[3], const double tolerance )
+{
+    return ( std::abs(reference[0]) <= 1.0 + tolerance &&
+	     std::abs(reference[1]) <= 1.0 + tolerance &&
+	     std::abs(reference[2]) <= 1.0 + tolerance );
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBHEX>::referenceCenter(
+    double reference[3] )
+{
+    reference[0] = 0.0;
+    reference[1] = 0.0;
+    reference[2] = 0.0;
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBHEX>::mapToPhysicalFrame(
+    const double reference[3], const double* vertices, 
+    double point[3], double jacobian[3][3] )
+{
+    static const double xi[8] = 
+	{ -1.0, 1.0, 1.0, -1.0, -1.0, 1.0, 1.0, -1.0 };
+    static const double eta[8] = 
+	{ -1.0, -1.0, 1.0, 1.0, -1.0, -1.0, 1.0, 1.0 };
+    static const double zeta[8] = 
+	{ -1.0, -1.0, -1.0, -1.0, 1.0, 1.0, 1.0, 1.0 };
+
+    double a = 0.0;
+    double b = 0.0;
+    double c = 0.0;
+    double shape = 0.0;
+    double dshape[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+	point[d] = 0.0;
+	jacobian[d][0] = 0.0;
+	jacobian[d][1] = 0.0;
+	jacobian[d][2] = 0.0;
+    }
+    for ( int i = 0; i < 8; ++i )
+    {
+	a = 1.0 + xi[i]*reference[0];
+	b = 1.0 + eta[i]*reference[1];
+	c = 1.0 + zeta[i]*reference[2];
+	shape = 0.125 * a * b * c;
+	dshape[0] = 0.125 * xi[i] * b * c;
+	dshape[1] = 0.125 * eta[i] * a * c;
+	dshape[2] = 0.125 * zeta[i] * a * b;
+	for ( int d = 0; d < 3; ++d )
+	{
+	    point[d] += shape * vertices[3*i+d];
+	    jacobian[d][0] += dshape[0] * vertices[3*i+d];
+	    jacobian[d][1] += dshape[1] * vertices[3*i+d];
+	    jacobian[d][2] += dshape[2] * vertices[3*i+d];
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Linear Lagrange shape functions.
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBEDGE>::shapeFunctions(
+    const double reference[3], double values[] )
+{
+    values[0] = ( 1.0 - reference[0] ) / 2.0;
+    values[1] = ( 1.0 + reference[0] ) / 2.0;
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBTRI>::shapeFunctions(
+    const double reference[3], double values[] )
+{
+    values[0] = 1.0 - reference[0] - reference[1];
+    values[1] = reference[0];
+    values[2] = reference[1];
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBQUAD>::shapeFunctions(
+    const double reference[3], double values[] )
+{
+    static const double xi[4] = { -1.0, 1.0, 1.0, -1.0 };
+    static const double eta[4] = { -1.0, -1.0, 1.0, 1.0 };
+
+    for ( int i = 0; i < 4; ++i )
+    {
+	values[i] = 
+	    0.25 * (1.0 + xi[i]*reference[0]) * (1.0 + eta[i]*reference[1]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBTET>::shapeFunctions(
+    const double reference[3], double values[] )
+{
+    values[0] = 1.0 - reference[0] - reference[1] - reference[2];
+    values[1] = reference[0];
+    values[2] = reference[1];
+    values[3] = reference[2];
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBPRISM>::shapeFunctions(
+    const double reference[3], double values[] )
+{
+    double t = 1.0 - reference[0] - reference[1];
+    double zm = ( 1.0 - reference[2] ) / 2.0;
+    double zp = ( 1.0 + reference[2] ) / 2.0;
+
+    values[0] = t*zm;
+    values[1] = reference[0]*zm;
+    values[2] = reference[1]*zm;
+    values[3] = t*zp;
+    values[4] = reference[0]*zp;
+    values[5] = reference[1]*zp;
+}
+
+//---------------------------------------------------------------------------//
+inline void PointInElementKernel<moab::MBHEX>::shapeFunctions(
+    const double reference[3], double values[] )
+{
+    static const double xi[8] = 
+	{ -1.0, 1.0, 1.0, -1.0, -1.0, 1.0, 1.0, -1.0 };
+    static const double eta[8] = 
+	{ -1.0, -1.0, 1.0, 1.0, -1.0, -1.0, 1.0, 1.0 };
+    static const double zeta[8] = 
+	{ -1.0, -1.0, -1.0, -1.0, 1.0, 1.0, 1.0, 1.0 };
+
+    for ( int i = 0; i < 8; ++i )
+    {
+	values[i] = 0.125 * (1.0 + xi[i]*reference[0]) * 
+		    (1.0 + eta[i]*reference[1]) * (1.0 + zeta[i]*reference[2]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_POINTINELEMENTKERNELS_DEF_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_PointInElementKernels_def.hpp
+//---------------------------------------------------------------------------//
@@ -41,20 +41,16 @@
 #ifndef DTK_RCB_HPP
 #define DTK_RCB_HPP
 
-#include <set>
-
-#include "DTK_Partitioner.hpp"
+#include "DTK_ZoltanPartitioner.hpp"
 #include "DTK_BoundingBox.hpp"
-#include "DTK_MeshTraits.hpp"
+#include "DTK_RCBCutTree.hpp"
+#include "DTK_PartitionWeights.hpp"
 #include "DTK_MeshManager.hpp"
 
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_Comm.hpp>
 #include <Teuchos_ArrayView.hpp>
 #include <Teuchos_Array.hpp>
-#include <Teuchos_ArrayRCP.hpp>
-
-#include <zoltan.h>
 
 namespace DataTransferKit
 {
@@ -63,29 +59,32 @@ namespace DataTransferKit
 /*!
  * \class RCB
  * \brief Recursive Coordinate Bisectioning partitioner.
+ *
+ * The partitioning is computed by Zoltan. The kept cuts are replicated
+ * locally after partitioning such that destination queries do not call back
+ * into Zoltan.
  */
 //---------------------------------------------------------------------------//
 template<class Mesh>
-class RCB : public Partitioner
+class RCB : public ZoltanPartitioner<Mesh>
 {
   public:
     
     //@{
     //! Typedefs.
-    typedef Mesh                                        mesh_type;
-    typedef MeshTraits<Mesh>                            MT;
-    typedef typename MT::global_ordinal_type            GlobalOrdinal;
-    typedef Teuchos::RCP< MeshManager<Mesh> >           RCP_MeshManager;
-    typedef typename MeshManager<Mesh>::BlockIterator   BlockIterator;          
-    typedef Teuchos::Comm<int>                          CommType;
-    typedef Teuchos::RCP<const CommType>                RCP_Comm;
-    typedef ZOLTAN_ID_TYPE                              zoltan_id_type;
-    typedef ZOLTAN_ID_PTR                               zoltan_id_ptr;
+    typedef ZoltanPartitioner<Mesh>                     Base;
+    typedef typename Base::mesh_type                    mesh_type;
+    typedef typename Base::RCP_MeshManager              RCP_MeshManager;
+    typedef typename Base::RCP_Comm                     RCP_Comm;
+    typedef typename Base::RCP_PartitionWeights         RCP_PartitionWeights;
+    typedef typename Base::zoltan_id_type               zoltan_id_type;
+    typedef typename Base::zoltan_id_ptr                zoltan_id_ptr;
     //@}
 
     // Constructor.
     RCB( const RCP_Comm& comm, const RCP_MeshManager& mesh_manager, 
-	 const int dimension );
+	 const int dimension, 
+	 const RCP_PartitionWeights& weights = Teuchos::null );
 
     // Destructor.
     ~RCB();
@@ -94,126 +93,25 @@ class RCB : public Partitioner
     void partition();
 
     // Get the destination process for a point given its coordinates.
-    int getPointDestinationProc( Teuchos::Array<double> coords ) const;
+    int getPointDestinationProc( const Teuchos::Array<double>& coords ) const;
 
     // Get the destination processes for a bounding box.
     Teuchos::Array<int> getBoxDestinationProcs( const BoundingBox& box ) const;
 
-    //! Get the number of imported vertices.
-    int getNumImport() const
-    { return d_num_import; }
-
-    //! Get the global import vertex ID's.
-    Teuchos::ArrayView<zoltan_id_type> getImportGlobalIds() const
-    { return Teuchos::ArrayView<zoltan_id_type>( d_import_global_ids, 
-						 d_num_import ); }
-
-    //! Get the local import vertex ID's.
-    Teuchos::ArrayView<zoltan_id_type> getImportLocalIds() const
-    { return Teuchos::ArrayView<zoltan_id_type>( d_import_local_ids, 
-						 d_num_import ); }
-
-    //! Get the process rank source for imported vertices.
-    Teuchos::ArrayView<int> getImportProcs() const
-    { return Teuchos::ArrayView<int>( d_import_procs, d_num_import ); }
-
-    //! Get the new partition for imported vertices.
-    Teuchos::ArrayView<int> getImportParts() const
-    { return Teuchos::ArrayView<int>( d_import_to_part, d_num_import ); }
-
-    //! Get the number of exported vertices.
-    int getNumExport() const
-    { return d_num_export; }
-
-    //! Get the global export vertex ID's.
-    Teuchos::ArrayView<zoltan_id_type> getExportGlobalIds() const
-    { return Teuchos::ArrayView<zoltan_id_type>( d_export_global_ids, 
-						 d_num_export ); }
-
-    //! Get the local export vertex ID's.
-    Teuchos::ArrayView<zoltan_id_type> getExportLocalIds() const
-    { return Teuchos::ArrayView<zoltan_id_type>( d_export_local_ids, 
-						 d_num_export ); }
-
-    //! Get the process rank target for exported vertices.
-    Teuchos::ArrayView<int> getExportProcs() const
-    { return Teuchos::ArrayView<int>( d_export_procs, d_num_export ); }
-
-    //! Get the new partition for exported vertices.
-    Teuchos::ArrayView<int> getExportParts() const
-    { return Teuchos::ArrayView<int>( d_export_to_part, d_num_export ); }
-
-  private:
-
-    // Zoltan callback for getting the number of vertices.
-    static int getNumberOfObjects( void *data, int *ierr );
-
-    // Zoltan callback for getting the local and global vertex ID's.
-    static void getObjectList( void *data, int sizeGID, int sizeLID,
-			       ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
-			       int wgt_dim, float *obj_wgts, int *ierr );
-
-    // Zoltan callback for getting the dimension of the vertices.
-    static int getNumGeometry( void *data, int *ierr );
+    // Get the destination processes for a blocked list of points.
+    void getPointDestinationProcs( 
+	const Teuchos::ArrayView<const double>& coords,
+	Teuchos::Array<int>& procs ) const;
 
-    // Zoltan callback for getting the vertex coordinates.
-    static void getGeometryList( void *data, int sizeGID, int sizeLID,
-				 int num_obj,
-				 ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
-				 int num_dim, double *geom_vec, int *ierr );
+    // Get the destination processes for a list of bounding boxes.
+    void getBoxDestinationProcs( 
+	const Teuchos::Array<BoundingBox>& boxes,
+	Teuchos::Array<Teuchos::Array<int> >& procs ) const;
 
   private:
 
-    // The communicator over which RCB is performed.
-    RCP_Comm d_comm;
-
-    // The mesh being partitioned.
-    RCP_MeshManager d_mesh_manager;
-
-    // The dimension of the RCB space.
-    int d_dimension;
-
-    // Zoltan struct.
-    Zoltan_Struct *d_zz;
-
-    // 1 if partitioning was changed, 0 otherwise.
-    int d_changes;
-
-    // Number of integers used for a global ID.
-    int d_num_gid_entries;
-
-    // Number of integers used for a local ID.
-    int d_num_lid_entries;
-
-    // Number of vertices to be sent to me.
-    int d_num_import;
-
-    // Global IDs of vertices to be sent to me.
-    ZOLTAN_ID_PTR d_import_global_ids;
-
-    // Local IDs of vertices to be sent to me.
-    ZOLTAN_ID_PTR d_import_local_ids;
-
-    // Process rank for source of each incoming vertex.
-    int *d_import_procs;
-
-    // New partition for each incoming vertex.
-    int *d_import_to_part;
-
-    // Number of vertices I must send to other processes.
-    int d_num_export;
-
-    // Global IDs of the vertices I must send.
-    ZOLTAN_ID_PTR d_export_global_ids;
-
-    // Local IDs of the vertices I must send.
-    ZOLTAN_ID_PTR d_export_local_ids;
-
-    // Process to which I send each of the vertices.
-    int *d_export_procs;
-    
-    // Partition to which each vertex will belong.
-    int *d_export_to_part;
+    // Local replica of the kept RCB cuts.
+    RCBCutTree d_cut_tree;
 };
 
 } // end namespace DataTransferKit
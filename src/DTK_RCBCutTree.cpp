@@ -0,0 +1,294 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_RCBCutTree.cpp
+ * \author Stuart R. Slattery
+ * \brief RCBCutTree definition.
+ */
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+
+#include "DTK_RCBCutTree.hpp"
+#include "DTK_Assertion.hpp"
+#include "DataTransferKit_config.hpp"
+
+#include <Teuchos_Tuple.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Partition bound comparator. Partitions are ordered by their lower
+ * bound along an axis, then by their upper bound, then by their id.
+ */
+class RCBCutTreeBoundCompare
+{
+  public:
+
+    RCBCutTreeBoundCompare( const Teuchos::Array<double>& part_bounds,
+			    const int axis )
+	: d_part_bounds( part_bounds )
+	, d_axis( axis )
+    { /* ... */ }
+
+    bool operator()( const int a, const int b ) const
+    {
+	double a_min = d_part_bounds[ 6*a + d_axis ];
+	double b_min = d_part_bounds[ 6*b + d_axis ];
+	if ( a_min != b_min )
+	{
+	    return a_min < b_min;
+	}
+
+	double a_max = d_part_bounds[ 6*a + d_axis + 3 ];
+	double b_max = d_part_bounds[ 6*b + d_axis + 3 ];
+	if ( a_max != b_max )
+	{
+	    return a_max < b_max;
+	}
+
+	return a < b;
+    }
+
+  private:
+
+    const Teuchos::Array<double>& d_part_bounds;
+    int d_axis;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor.
+ */
+RCBCutTree::RCBCutTree()
+    : d_dimension( 0 )
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor.
+ */
+RCBCutTree::~RCBCutTree()
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the tree from a set of partition boxes that tile space.
+ *
+ * \param part_bounds The partition boxes blocked by partition { x_min, y_min,
+ * z_min, x_max, y_max, z_max }. The index of a box is its partition process.
+ *
+ * \param dimension The dimension of the partitioned space.
+ */
+void RCBCutTree::build( const Teuchos::Array<double>& part_bounds, 
+			const int dimension )
+{
+    testPrecondition( 0 < dimension && dimension <= 3 );
+    testPrecondition( 0 < part_bounds.size() );
+    testPrecondition( part_bounds.size() % 6 == 0 );
+
+    d_dimension = dimension;
+
+    int num_parts = part_bounds.size() / 6;
+    Teuchos::Array<int> parts( num_parts );
+    for ( int p = 0; p < num_parts; ++p )
+    {
+	parts[p] = p;
+    }
+
+    d_nodes.clear();
+    d_nodes.reserve( 2*num_parts - 1 );
+    buildNode( 0, num_parts, part_bounds, parts );
+
+    testPostcondition( d_nodes.size() == 2*num_parts - 1 );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a blocked list of points.
+ *
+ * \param coords The point coordinates blocked by dimension { x_0, ..., x_N,
+ * y_0, ..., y_N, z_0, ..., z_N }.
+ *
+ * \param procs The destination process of each point in the same order as
+ * the points. 
+ */
+void RCBCutTree::pointDestinationProcs( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( !d_nodes.empty() );
+    testPrecondition( coords.size() % d_dimension == 0 );
+
+    int num_points = coords.size() / d_dimension;
+    procs.resize( num_points );
+
+    double point[3];
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	procs[n] = pointDestinationProc( point );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a bounding box. This includes all
+ * partitions that the box intersects.
+ *
+ * \param box The bounding box to get the destinations for.
+ *
+ * \param procs The destination processes of the box.
+ */
+void RCBCutTree::boxDestinationProcs( const BoundingBox& box,
+				      Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( !d_nodes.empty() );
+
+    Teuchos::Tuple<double,6> box_bounds = box.getBounds();
+    double bounds[6];
+    std::copy( box_bounds.begin(), box_bounds.end(), &bounds[0] );
+
+    procs.clear();
+    collectBoxProcs( 0, bounds, procs );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Recursively build the tree nodes over a range of partitions. Of all
+ * the planes that separate the partitions into two sets, the one that splits
+ * them most evenly is used.
+ *
+ * \return The index of the new node.
+ */
+int RCBCutTree::buildNode( const int begin, const int end,
+			   const Teuchos::Array<double>& part_bounds,
+			   Teuchos::Array<int>& parts )
+{
+    testPrecondition( begin < end );
+
+    int node = d_nodes.size();
+    d_nodes.push_back( Node() );
+
+    // A single partition is a leaf.
+    if ( end - begin == 1 )
+    {
+	d_nodes[node].axis = -1;
+	d_nodes[node].cut = 0.0;
+	d_nodes[node].left = parts[begin];
+	d_nodes[node].right = -1;
+	return node;
+    }
+
+    // Sweep each axis for separating planes. With the partitions sorted by
+    // their lower bound, a plane separates them if all of the partitions
+    // before it end where the next one begins.
+    int mid = (begin + end) / 2;
+    int best_axis = -1;
+    int best_split = -1;
+    double best_cut = 0.0;
+    double upper = 0.0;
+    for ( int axis = 0; axis < d_dimension; ++axis )
+    {
+	std::sort( parts.begin() + begin, parts.begin() + end,
+		   RCBCutTreeBoundCompare( part_bounds, axis ) );
+
+	upper = -std::numeric_limits<double>::max();
+	for ( int i = begin; i < end - 1; ++i )
+	{
+	    upper = std::max( upper, part_bounds[ 6*parts[i] + axis + 3 ] );
+	    if ( upper <= part_bounds[ 6*parts[i+1] + axis ] &&
+		 ( best_split < 0 || 
+		   std::abs(i+1-mid) < std::abs(best_split-mid) ) )
+	    {
+		best_axis = axis;
+		best_split = i + 1;
+		best_cut = upper;
+	    }
+	}
+    }
+
+    // Partition boxes that tile space always have a separating plane.
+    testInvariant( best_axis >= 0 );
+    std::sort( parts.begin() + begin, parts.begin() + end,
+	       RCBCutTreeBoundCompare( part_bounds, best_axis ) );
+
+    d_nodes[node].axis = best_axis;
+    d_nodes[node].cut = best_cut;
+    int left = buildNode( begin, best_split, part_bounds, parts );
+    int right = buildNode( best_split, end, part_bounds, parts );
+    d_nodes[node].left = left;
+    d_nodes[node].right = right;
+
+    return node;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Recursively collect the partitions a box intersects.
+ */
+void RCBCutTree::collectBoxProcs( const int node, const double bounds[6],
+				  Teuchos::Array<int>& procs ) const
+{
+    const Node& tree_node = d_nodes[node];
+
+    if ( tree_node.axis < 0 )
+    {
+	procs.push_back( tree_node.left );
+	return;
+    }
+
+    if ( bounds[ tree_node.axis ] <= tree_node.cut )
+    {
+	collectBoxProcs( tree_node.left, bounds, procs );
+    }
+    if ( bounds[ tree_node.axis + 3 ] >= tree_node.cut )
+    {
+	collectBoxProcs( tree_node.right, bounds, procs );
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// end DTK_RCBCutTree.cpp
+//---------------------------------------------------------------------------//
@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_RCBCutTree.hpp
+ * \author Stuart R. Slattery
+ * \brief RCBCutTree declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_RCBCUTTREE_HPP
+#define DTK_RCBCUTTREE_HPP
+
+#include "DTK_BoundingBox.hpp"
+
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class RCBCutTree
+ * \brief Local replica of the cuts of an RCB partitioning.
+
+ Zoltan keeps the RCB cuts when KEEP_CUTS is set but only exposes them
+ through a call per point or per box. This class rebuilds the binary cut tree
+ from the partition boxes (as given by Zoltan_RCB_Box) so that destination
+ queries are a simple local tree traversal. It does not depend on Zoltan
+ itself; the RCB partitioners extract the boxes and pass them in. The tree is
+ rebuilt from the boxes by recursively finding a plane that separates the
+ remaining partitions into two sets. As the partition boxes
+ tile all of space this gives the same destinations as Zoltan.
+
+ A point exactly on a cut goes to the lower partition and a box touching a cut
+ goes to the partitions on both sides of it, as in Zoltan.
+ */
+//---------------------------------------------------------------------------//
+class RCBCutTree
+{
+  public:
+
+    // Constructor.
+    RCBCutTree();
+
+    // Destructor.
+    ~RCBCutTree();
+
+    // Build the tree from a set of partition boxes that tile space.
+    void build( const Teuchos::Array<double>& part_bounds, 
+		const int dimension );
+
+    // Get the destination process for a point.
+    inline int pointDestinationProc( const double point[] ) const;
+
+    // Get the destination processes for a blocked list of points.
+    void pointDestinationProcs( const Teuchos::ArrayView<const double>& coords,
+				Teuchos::Array<int>& procs ) const;
+
+    // Get the destination processes for a bounding box.
+    void boxDestinationProcs( const BoundingBox& box,
+			      Teuchos::Array<int>& procs ) const;
+
+    //! Get the number of tree nodes.
+    int numNodes() const
+    { return d_nodes.size(); }
+
+  private:
+
+    // Recursively build the tree nodes over a range of partitions.
+    int buildNode( const int begin, const int end,
+		   const Teuchos::Array<double>& part_bounds,
+		   Teuchos::Array<int>& parts );
+
+    // Recursively collect the partitions a box intersects.
+    void collectBoxProcs( const int node, const double bounds[6],
+			  Teuchos::Array<int>& procs ) const;
+
+  private:
+
+    /*!
+     * \brief Tree node. A leaf node has a negative axis and owns a single
+     * partition. Points with a coordinate less than or equal to the cut along
+     * the axis are in the left child.
+     */
+    struct Node
+    {
+	// Cut axis. -1 if this node is a leaf.
+	int axis;
+
+	// Cut value.
+	double cut;
+
+	// Left child node, or the partition process if this node is a leaf.
+	int left;
+
+	// Right child node.
+	int right;
+    };
+
+  private:
+
+    // Tree dimension.
+    int d_dimension;
+
+    // Tree nodes. Node 0 is the root.
+    Teuchos::Array<Node> d_nodes;
+};
+
+//---------------------------------------------------------------------------//
+// Inline functions.
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination process for a point.
+ *
+ * \param point The point coordinates. Must be of the tree dimension.
+ *
+ * \return The destination process of the point.
+ */
+inline int RCBCutTree::pointDestinationProc( const double point[] ) const
+{
+    int node = 0;
+    while ( d_nodes[node].axis >= 0 )
+    {
+	node = ( point[ d_nodes[node].axis ] <= d_nodes[node].cut )
+	       ? d_nodes[node].left : d_nodes[node].right;
+    }
+    return d_nodes[node].left;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_RCBCUTTREE_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_RCBCutTree.hpp
+//---------------------------------------------------------------------------//
@@ -34,26 +34,15 @@
 /*!
  * \file DTK_RCB_def.hpp
  * \author Stuart R. Slattery
- * \brief Wrapper definition for Zoltan recursive coordinate bisectioning.
+ * \brief Recursive coordinate bisectioning partitioner definition.
  */
 //---------------------------------------------------------------------------//
 
 #ifndef DTK_RCB_DEF_HPP
 #define DTK_RCB_DEF_HPP
 
-#include <algorithm>
-
-#include "DTK_MeshTools.hpp"
 #include "DTK_Assertion.hpp"
-#include "DTK_CommIndexer.hpp"
-#include "DataTransferKit_config.hpp"
-
-#include <mpi.h>
 
-#include <Teuchos_DefaultMpiComm.hpp>
-#include <Teuchos_OpaqueWrapper.hpp>
-#include <Teuchos_CommHelpers.hpp>
-#include <Teuchos_Tuple.hpp>
 #include <Teuchos_as.hpp>
 
 namespace DataTransferKit
@@ -69,62 +58,24 @@ namespace DataTransferKit
  * to repartition it to.
  *
  * \param dimension The dimension of the RCB space.
+ *
+ * \param weights Optional vertex weights. If provided, the partitioning will
+ * balance the sum of the vertex weights on each process instead of the number
+ * of vertices. Vertices on processes without weights have unit weight.
  */
 template<class Mesh>
 RCB<Mesh>::RCB( const RCP_Comm& comm, const RCP_MeshManager& mesh_manager, 
-		const int dimension )
-    : d_comm( comm )
-    , d_mesh_manager( mesh_manager )
-    , d_dimension( dimension )
-{
-    // Get the raw MPI communicator.
-    Teuchos::RCP< const Teuchos::MpiComm<int> > mpi_comm = 
-	Teuchos::rcp_dynamic_cast< const Teuchos::MpiComm<int> >( comm );
-    Teuchos::RCP< const Teuchos::OpaqueWrapper<MPI_Comm> > opaque_comm = 
-	mpi_comm->getRawMpiComm();
-    MPI_Comm raw_comm = (*opaque_comm)();
-
-    // Create the Zoltan object.
-    d_zz = Zoltan_Create( raw_comm );
-
-    // General parameters.
-    Zoltan_Set_Param( d_zz, "DEBUG_LEVEL", "0" );
-    Zoltan_Set_Param( d_zz, "LB_METHOD", "RCB" );
-    Zoltan_Set_Param( d_zz, "NUM_GID_ENTRIES", "1" ); 
-    Zoltan_Set_Param( d_zz, "NUM_LID_ENTRIES", "1" );
-    Zoltan_Set_Param( d_zz, "DEBUG_PROCESSOR", "0" );
-    Zoltan_Set_Param( d_zz, "OBJ_WEIGHT_DIM", "0" );
-    Zoltan_Set_Param( d_zz, "EDGE_WEIGHT_DIM", "0" );
-    Zoltan_Set_Param( d_zz, "RETURN_LISTS", "ALL" );
-
-    // RCB parameters.
-    Zoltan_Set_Param( d_zz, "RCB_OUTPUT_LEVEL", "0" );
-    Zoltan_Set_Param( d_zz, "RCB_RECTILINEAR_BLOCKS", "0" );
-    Zoltan_Set_Param( d_zz, "KEEP_CUTS", "1" );
-    Zoltan_Set_Param( d_zz, "AVERAGE_CUTS", "1" );
-    Zoltan_Set_Param( d_zz, "RCB_LOCK_DIRECTIONS", "1" );
-    Zoltan_Set_Param( d_zz, "RCB_SET_DIRECTIONS", "1" );
-
-    // Register static functions.
-    Zoltan_Set_Num_Obj_Fn( d_zz, getNumberOfObjects, &d_mesh_manager );
-    Zoltan_Set_Obj_List_Fn( d_zz, getObjectList, &d_mesh_manager );
-    Zoltan_Set_Num_Geom_Fn( d_zz, getNumGeometry, &d_dimension );
-    Zoltan_Set_Geom_Multi_Fn( d_zz, getGeometryList, &d_mesh_manager );
-}
+		const int dimension, const RCP_PartitionWeights& weights )
+    : Base( comm, mesh_manager, dimension, DTK_RCB_PARTITIONER, weights )
+{ /* ... */ }
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Destructor. Zoltan memory deallocation happens here and only here.
+ * \brief Destructor.
  */
 template<class Mesh>
 RCB<Mesh>::~RCB()
-{
-    Zoltan_LB_Free_Part( &d_import_global_ids, &d_import_local_ids, 
-			 &d_import_procs, &d_import_to_part );
-    Zoltan_LB_Free_Part( &d_export_global_ids, &d_export_local_ids, 
-			 &d_export_procs, &d_export_to_part );
-    Zoltan_Destroy( &d_zz );
-}
+{ /* ... */ }
 
 //---------------------------------------------------------------------------//
 /*!
@@ -133,39 +84,31 @@ RCB<Mesh>::~RCB()
 template<class Mesh>
 void RCB<Mesh>::partition()
 {
+    Base::partition();
+
+    // Replicate the kept cuts locally for destination queries. The
+    // partition boxes are local to each process once the cuts are kept so no
+    // communication occurs here.
+    int num_parts = this->d_comm->getSize();
+    Teuchos::Array<double> part_bounds( 6*num_parts );
+    int zoltan_dim = 0;
     rememberValue( int zoltan_error );
+    for ( int p = 0; p < num_parts; ++p )
+    {
 #if HAVE_DTK_DBC
-    zoltan_error = Zoltan_LB_Partition( d_zz, 
-					&d_changes,  
-					&d_num_gid_entries,
-					&d_num_lid_entries,
-					&d_num_import,    
-					&d_import_global_ids,
-					&d_import_local_ids, 
-					&d_import_procs,    
-					&d_import_to_part,   
-					&d_num_export,      
-					&d_export_global_ids,
-					&d_export_local_ids, 
-					&d_export_procs,    
-					&d_export_to_part );
+	zoltan_error = Zoltan_RCB_Box( this->d_zz, p, &zoltan_dim,
+				   &part_bounds[6*p], &part_bounds[6*p+1],
+				   &part_bounds[6*p+2], &part_bounds[6*p+3],
+				   &part_bounds[6*p+4], &part_bounds[6*p+5] );
 #else
-    Zoltan_LB_Partition( d_zz, 
-			 &d_changes,  
-			 &d_num_gid_entries,
-			 &d_num_lid_entries,
-			 &d_num_import,    
-			 &d_import_global_ids,
-			 &d_import_local_ids, 
-			 &d_import_procs,    
-			 &d_import_to_part,   
-			 &d_num_export,      
-			 &d_export_global_ids,
-			 &d_export_local_ids, 
-			 &d_export_procs,    
-			 &d_export_to_part );
+	Zoltan_RCB_Box( this->d_zz, p, &zoltan_dim,
+			&part_bounds[6*p], &part_bounds[6*p+1], 
+			&part_bounds[6*p+2], &part_bounds[6*p+3], 
+			&part_bounds[6*p+4], &part_bounds[6*p+5] );
 #endif
-    testInvariant( zoltan_error == ZOLTAN_OK );
+	testInvariant( zoltan_error == ZOLTAN_OK );
+    }
+    d_cut_tree.build( part_bounds, this->d_dimension );
 }
 
 //---------------------------------------------------------------------------//
@@ -173,26 +116,18 @@ void RCB<Mesh>::partition()
  * \brief Get the destination process for a point given its coordinates.
  *
  * \param coords Point coordinates. The dimension of the point must be equal
- * to or less than one.
+ * to the RCB dimension.
  *
  * \return The RCB destination proc for the point.
  */
 template<class Mesh>
-int RCB<Mesh>::getPointDestinationProc( Teuchos::Array<double> coords ) const
+int RCB<Mesh>::getPointDestinationProc( 
+    const Teuchos::Array<double>& coords ) const
 {
     testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
-    testPrecondition( d_dimension == Teuchos::as<int>(coords.size()) );
+    testPrecondition( this->d_dimension == Teuchos::as<int>(coords.size()) );
 
-    int proc = 0;
-    rememberValue( int zoltan_error );
-#if HAVE_DTK_DBC
-    zoltan_error = Zoltan_LB_Point_Assign( d_zz, &coords[0], &proc );
-#else
-    Zoltan_LB_Point_Assign( d_zz, &coords[0], &proc );
-#endif
-    testInvariant( zoltan_error == ZOLTAN_OK );
-
-    return proc;
+    return d_cut_tree.pointDestinationProc( coords.getRawPtr() );
 }
 
 //---------------------------------------------------------------------------//
@@ -208,207 +143,49 @@ template<class Mesh>
 Teuchos::Array<int>
 RCB<Mesh>::getBoxDestinationProcs( const BoundingBox& box ) const
 {
-    Teuchos::Tuple<double,6> box_bounds = box.getBounds();
-
-    int num_procs = 0;
-    Teuchos::Array<int> procs( d_comm->getSize() );
-
-    rememberValue( int zoltan_error );
-#if HAVE_DTK_DBC
-    zoltan_error = Zoltan_LB_Box_Assign( d_zz, 
-					 box_bounds[0], box_bounds[1], 
-					 box_bounds[2], box_bounds[3], 
-					 box_bounds[4], box_bounds[5], 
-					 &procs[0], &num_procs );
-#else
-    Zoltan_LB_Box_Assign( d_zz, 
-			  box_bounds[0], box_bounds[1], box_bounds[2],
-			  box_bounds[3], box_bounds[4], box_bounds[5], 
-			  &procs[0], &num_procs );
-#endif
-    testInvariant( zoltan_error == ZOLTAN_OK );
-
-    procs.resize( num_procs );
-
+    Teuchos::Array<int> procs;
+    d_cut_tree.boxDestinationProcs( box, procs );
     return procs;
 }
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Zoltan callback for getting the number of vertices.
- */
-template<class Mesh>
-int RCB<Mesh>::getNumberOfObjects( void *data, int *ierr )
-{
-    RCP_MeshManager mesh_manager = *static_cast<RCP_MeshManager*>( data );
-    int num_vertices = 0;
-
-    // We'll only count vertices if the mesh manager is not null.
-    if ( !mesh_manager.is_null() )
-    {
-	int num_blocks = mesh_manager->getNumBlocks();
-	Teuchos::ArrayView<short int>::const_iterator active_iterator;
-	for ( int i = 0; i < num_blocks; ++i )
-	{
-	    for ( active_iterator = mesh_manager->getActiveVertices(i).begin();
-		  active_iterator != mesh_manager->getActiveVertices(i).end();
-		  ++active_iterator )
-	    {
-		if ( *active_iterator )
-		{
-		    ++num_vertices;
-		}
-	    }
-	}
-    }
-
-    *ierr = ZOLTAN_OK;
-    return num_vertices;
-}
-
-//---------------------------------------------------------------------------//
-/*!
- * \brief Zoltan callback for getting the local and global vertex ID's.
- */
-template<class Mesh>
-void RCB<Mesh>::getObjectList( 
-    void *data, int sizeGID, int sizeLID,
-    ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
-    int wgt_dim, float *obj_wgts, int *ierr )
-{
-    RCP_MeshManager mesh_manager = *static_cast<RCP_MeshManager*>( data );
-
-    // We'll only build the geometry list is the mesh manager is not null.
-    if ( !mesh_manager.is_null() )
-    {
-	// Note here that the local ID is being set as the vertex array index.
-	Teuchos::ArrayView<short int>::const_iterator active_iterator;
-	typename MT::const_vertex_iterator gid_iterator;
-	zoltan_id_type i = 0;
-	zoltan_id_type j = 0;
-	BlockIterator block_iterator;
-	for ( block_iterator = mesh_manager->blocksBegin();
-	      block_iterator != mesh_manager->blocksEnd();
-	      ++block_iterator )
-	{
-	    int block_id = std::distance( mesh_manager->blocksBegin(),
-					  block_iterator );
-
-	    for ( gid_iterator = MT::verticesBegin( *(*block_iterator) ),
-	       active_iterator = mesh_manager->getActiveVertices( 
-		   block_id ).begin();
-		  gid_iterator != MT::verticesEnd( *(*block_iterator) );
-		  ++gid_iterator, ++active_iterator )
-	    {
-		if ( *active_iterator )
-		{
-		    globalID[i] = static_cast<zoltan_id_type>( *gid_iterator );
-		    localID[i] = j;
-		    ++i;
-		}
-		++j;
-	    }
-	}
-    }
-
-    *ierr = ZOLTAN_OK;
-}
-
-//---------------------------------------------------------------------------//
-/*!
- * \brief Zoltan callback for getting the dimension of the vertices.
+ * \brief Get the destination processes for a blocked list of points.
+ *
+ * \param coords Point coordinates blocked by dimension. The dimension of the
+ * points must be equal to the RCB dimension.
+ *
+ * \param procs The RCB destination proc for each point in the same order as
+ * the points.
  */
 template<class Mesh>
-int RCB<Mesh>::getNumGeometry( void *data, int *ierr )
+void RCB<Mesh>::getPointDestinationProcs( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<int>& procs ) const
 {
-    int dimension = *static_cast<int*>( data );
-    *ierr = ZOLTAN_OK;
-    return dimension;
+    testPrecondition( coords.size() % this->d_dimension == 0 );
+    d_cut_tree.pointDestinationProcs( coords, procs );
 }
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Zoltan callback for getting the vertex coordinates.
+ * \brief Get the destination processes for a list of bounding boxes.
+ *
+ * \param boxes The bounding boxes to get the destinations for.
+ *
+ * \param procs The RCB destination procs for each box in the same order as
+ * the boxes.
  */
 template<class Mesh>
-void RCB<Mesh>::getGeometryList(
-    void *data, int sizeGID, int sizeLID,
-    int num_obj,
-    ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
-    int num_dim, double *geom_vec, int *ierr )
+void RCB<Mesh>::getBoxDestinationProcs( 
+    const Teuchos::Array<BoundingBox>& boxes,
+    Teuchos::Array<Teuchos::Array<int> >& procs ) const
 {
-    RCP_MeshManager mesh_manager = *static_cast<RCP_MeshManager*>( data );
-
-    // We will only supply vertex coordinates when the mesh exists.
-    if ( !mesh_manager.is_null() )
+    procs.resize( boxes.size() );
+    for ( int i = 0; i < Teuchos::as<int>(boxes.size()); ++i )
     {
-	// Get the number of active vertices.
-	int num_active_vertices = 0;
-	int num_blocks = mesh_manager->getNumBlocks();
-	Teuchos::ArrayView<short int>::const_iterator active_iterator;
-	for ( int i = 0; i < num_blocks; ++i )
-	{
-	    for ( active_iterator = mesh_manager->getActiveVertices(i).begin();
-		  active_iterator != mesh_manager->getActiveVertices(i).end();
-		  ++active_iterator )
-	    {
-		if ( *active_iterator )
-		{
-		    ++num_active_vertices;
-		}
-	    }
-	}
-
-	// Check Zoltan for consistency.
-	int vertex_dim = mesh_manager->dim();
-	testInvariant( sizeGID == 1 );
-	testInvariant( sizeLID == 1 );
-	testInvariant( num_dim == Teuchos::as<int>(vertex_dim) );
-	testInvariant( num_obj == Teuchos::as<int>(num_active_vertices) );
-
-	if ( sizeGID != 1 || sizeLID != 1 || 
-	     num_dim != Teuchos::as<int>(vertex_dim) || 
-	     num_obj != Teuchos::as<int>(num_active_vertices) )
-	{
-	    *ierr = ZOLTAN_FATAL;
-	    return;
-	}
-    
-	// Zoltan needs interleaved coordinates.
-	int n = 0;
-	Teuchos::ArrayRCP<const double> mesh_coords;
-	GlobalOrdinal num_vertices;
-	BlockIterator block_iterator;
-	for ( block_iterator = mesh_manager->blocksBegin();
-	      block_iterator != mesh_manager->blocksEnd();
-	      ++block_iterator )
-	{
-	    int block_id = std::distance( mesh_manager->blocksBegin(),
-					  block_iterator );
-	    Teuchos::ArrayView<short int> active_vertices =
-		mesh_manager->getActiveVertices( block_id );
-
-	    mesh_coords = MeshTools<Mesh>::coordsView( *(*block_iterator) );
-	    num_vertices = std::distance( 
-		MT::verticesBegin( *(*block_iterator) ),
-					  
-		MT::verticesEnd( *(*block_iterator) ) );
-	    for ( GlobalOrdinal i = 0; i < num_vertices; ++i )
-	    {
-		if ( active_vertices[i] )
-		{
-		    for ( int d = 0; d < vertex_dim; ++d )
-		    {
-			geom_vec[ vertex_dim*n + d ] = 
-			    mesh_coords[ d*num_vertices + i ];
-		    }
-		    ++n;
-		}
-	    }
-	}
+	d_cut_tree.boxDestinationProcs( boxes[i], procs[i] );
     }
-	  
-    *ierr = ZOLTAN_OK;
 }
 
 //---------------------------------------------------------------------------//
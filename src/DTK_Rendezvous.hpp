@@ -49,6 +49,7 @@
 #include "DTK_MeshContainer.hpp"
 #include "DTK_KDTree.hpp"
 #include "DTK_Partitioner.hpp"
+#include "DTK_PartitionWeights.hpp"
 #include "DTK_BoundingBox.hpp"
 
 #include <Teuchos_RCP.hpp>
@@ -91,6 +92,16 @@ namespace DataTransferKit
  source and target geometries of different dimensions (e.g. a 3 dimensional
  source geometry and a 2 dimensional target geometry cannot be used to
  generate a rendezvous decomposition).
+
+ A rendezvous decomposition may be built once and shared by several maps
+ that use the same source mesh. The partitioning, the migration of the mesh
+ to the rendezvous decomposition, and the kD-tree construction are then only
+ performed once.
+
+ If the mesh moves by a small amount between uses the decomposition can be
+ updated instead of built again. The partitioning is kept and only the new
+ vertex coordinates are sent to the rendezvous decomposition unless an
+ element now belongs to a different set of rendezvous partitions.
  */
 //---------------------------------------------------------------------------//
 template<class Mesh>
@@ -111,6 +122,7 @@ class Rendezvous
     typedef KDTree<GlobalOrdinal>                       KDTreeType;
     typedef Teuchos::RCP<KDTreeType>                    RCP_KDTree;
     typedef Teuchos::RCP<Partitioner>                   RCP_Partitioner;
+    typedef Teuchos::RCP<PartitionWeights>              RCP_PartitionWeights;
     typedef Teuchos::Comm<int>                          CommType;
     typedef Teuchos::RCP<const CommType>                RCP_Comm;
     typedef Tpetra::Map<int,GlobalOrdinal>              TpetraMap;
@@ -119,7 +131,10 @@ class Rendezvous
 
     // Constructor.
     Rendezvous( const RCP_Comm& comm, const int dimension,
-		const BoundingBox& global_box );
+		const BoundingBox& global_box,
+		const RCP_PartitionWeights& weights = Teuchos::null,
+		const DTK_PartitionerType partitioner_type = 
+		DTK_RCB_PARTITIONER );
 
     // Destructor.
     ~Rendezvous();
@@ -127,6 +142,10 @@ class Rendezvous
     // Build the rendezvous decomposition.
     void build( const RCP_MeshManager& mesh_manager );
 
+    // Update the rendezvous decomposition after the mesh vertices have
+    // moved.
+    void update( const RCP_MeshManager& mesh_manager );
+
     // Get the rendezvous destination processes for a blocked list of vertex
     // coordinates that are in the primary decomposition.
     Teuchos::Array<int> 
@@ -145,6 +164,17 @@ class Rendezvous
 	Teuchos::Array<int>& element_src_procs,
 	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() ) const;
 
+    // Get the native mesh elements in the rendezvous decomposition and their
+    // source decomposition procs containing a blocked list of coordinates
+    // along with the coordinates of each point in the reference frame of its
+    // element.
+    void elementsContainingPoints( 
+	const Teuchos::ArrayRCP<double>& coords,
+	Teuchos::Array<GlobalOrdinal>& elements,
+	Teuchos::Array<int>& element_src_procs,
+	Teuchos::Array<double>& reference_coords,
+	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() ) const;
+
     // Get the native elements in the rendezvous decomposition that are in
     // each bounding box in a list.
     void elementsInBoxes(
@@ -171,7 +201,7 @@ class Rendezvous
     //! For a list of elements in the rendezvous decomposition, get their
     //! source procs.
     Teuchos::Array<int> elementSourceProcs( 
-	const Teuchos::Array<GlobalOrdinal>& elements );
+	const Teuchos::Array<GlobalOrdinal>& elements ) const;
 
   private:
 
@@ -183,12 +213,15 @@ class Rendezvous
     MeshManager<MeshContainerType> 
     sendMeshToRendezvous( const RCP_MeshManager& mesh_manager );
 
-    // Setup the import communication patterns.
+    // Get the rendezvous destination procs of the vertices and elements of
+    // a mesh block.
     void setupImportCommunication( 
 	const Teuchos::RCP<Mesh>& mesh,
 	const Teuchos::ArrayView<short int>& elements_in_box,
-	Teuchos::Array<GlobalOrdinal>& rendezvous_vertices,
-	Teuchos::Array<GlobalOrdinal>& rendezvous_elements );
+	Teuchos::Array<GlobalOrdinal>& export_element_indices,
+	Teuchos::Array<int>& export_element_procs,
+	Teuchos::Array<GlobalOrdinal>& export_vertex_indices,
+	Teuchos::Array<int>& export_vertex_procs );
 
   private:
 
@@ -201,12 +234,33 @@ class Rendezvous
     // Bounding box in which to perform the rendezvous.
     BoundingBox d_global_box;
 
+    // Rendezvous partitioning weights.
+    RCP_PartitionWeights d_partition_weights;
+
+    // Rendezvous partitioning algorithm.
+    DTK_PartitionerType d_partitioner_type;
+
     // Rendezvous partitioning.
     RCP_Partitioner d_partitioner;
 
     // Rendezvous mesh element to source proc map.
     std::map<GlobalOrdinal,int> d_element_src_procs_map;
 
+    // Local indices of the elements exported to the rendezvous decomposition
+    // in the last migration. An element has an entry for every destination
+    // proc.
+    Teuchos::Array<GlobalOrdinal> d_export_element_indices;
+
+    // Destination procs of the elements exported in the last migration.
+    Teuchos::Array<int> d_export_element_procs;
+
+    // Global ordinals of the rendezvous mesh vertices in Moab vertex order
+    // (sorted within each block).
+    Teuchos::Array<GlobalOrdinal> d_rendezvous_vertices;
+
+    // Offsets of each block in the rendezvous mesh vertex ordinals.
+    Teuchos::Array<int> d_vertex_block_offsets;
+
     // Rendezvous on-process mesh.
     RCP_RendezvousMesh d_rendezvous_mesh;
 
@@ -41,8 +41,6 @@
 #ifndef DTK_RENDEZVOUSMESH_HPP
 #define DTK_RENDEZVOUSMESH_HPP
 
-#include <map>
-
 #include "DTK_MeshTraits.hpp"
 #include "DTK_MeshManager.hpp"
 #include "DTK_GeometryTraits.hpp"
@@ -52,6 +50,8 @@
 #include <MBInterface.hpp>
 
 #include <Teuchos_RCP.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_Tuple.hpp>
 
 namespace DataTransferKit
 {
@@ -65,6 +65,17 @@ namespace DataTransferKit
  A RendezvousMesh contains and provides access to the Moab database that is
  generated in the rendezvous decomposition. It also maintains the relationship
  between the Moab database and the client mesh.
+
+ When the mesh is constructed the local elements are extracted from Moab once
+ and cached in contiguous tables along with their topologies, axis-aligned
+ bounding boxes, and vertex coordinates. Element queries run on these tables
+ and reject candidates with the bounding boxes before any exact test such
+ that the Moab database is not queried in the search loops.
+
+ Moab hands out element handles in contiguous ranges. The native ordinals are
+ stored in a dense table in cache order and a handle is translated to its
+ cache index with offset arithmetic on the contiguous handle runs (one run
+ per element type in practice) rather than a tree lookup.
  */
 //---------------------------------------------------------------------------//
 template<typename GlobalOrdinal>
@@ -76,11 +87,12 @@ class RendezvousMesh
     //! Typedefs.
     typedef GlobalOrdinal                               global_ordinal_type;
     typedef Teuchos::RCP<moab::Interface>               RCP_Moab;
-    typedef std::map<moab::EntityHandle,GlobalOrdinal>  OrdinalMap;
     //@}
 
     // Constructor.
-    RendezvousMesh( const RCP_Moab& moab, const OrdinalMap& ordinal_map );
+    RendezvousMesh( const RCP_Moab& moab, 
+		    const Teuchos::Array<moab::EntityHandle>& elements,
+		    const Teuchos::Array<GlobalOrdinal>& element_ordinals );
 
     // Destructor.
     ~RendezvousMesh();
@@ -93,7 +105,57 @@ class RendezvousMesh
     // global ordinal.
     GlobalOrdinal 
     getNativeOrdinal( const moab::EntityHandle& moab_ordinal ) const
-    { return d_ordinal_map.find( moab_ordinal )->second; }
+    { return d_element_ordinals[ elementIndex(moab_ordinal) ]; }
+
+    //! Get the mesh dimension.
+    int dim() const
+    { return d_dim; }
+
+    //! Get the number of cached local elements.
+    int numElements() const
+    { return d_elements.size(); }
+
+    //! Get the Moab handle of a cached element.
+    moab::EntityHandle elementHandle( const int element_index ) const
+    { return d_elements[element_index]; }
+
+    // Get the cache index of a Moab element.
+    inline int elementIndex( const moab::EntityHandle element ) const;
+
+    //! Get the native element global ordinal of a cached element.
+    GlobalOrdinal elementOrdinal( const int element_index ) const
+    { return d_element_ordinals[element_index]; }
+
+    //! Get the topology of a cached element.
+    moab::EntityType elementTopology( const int element_index ) const
+    { return d_element_topologies[element_index]; }
+
+    //! Get the number of vertices of a cached element.
+    int numElementVertices( const int element_index ) const
+    { return d_vertex_offsets[element_index+1] - 
+	    d_vertex_offsets[element_index]; }
+
+    //! Get the interleaved vertex coordinates of a cached element ( x_0, y_0,
+    //! z_0, x_1, y_1, z_1, ... ).
+    const double* elementVertexCoords( const int element_index ) const
+    { return &d_vertex_coords[ 3*d_vertex_offsets[element_index] ]; }
+
+    //! Get the bounding box of a cached element ( x_min, y_min, z_min,
+    //! x_max, y_max, z_max ).
+    const double* elementBounds( const int element_index ) const
+    { return &d_element_bounds[ 6*element_index ]; }
+
+    // Determine if a point is in a cached element.
+    bool pointInElement( const double point[3], 
+			 const int element_index,
+			 const double tolerance ) const;
+
+    // Determine if a point is in a cached element and get its reference
+    // coordinates.
+    bool pointInElement( const double point[3], 
+			 const int element_index,
+			 double reference_point[3],
+			 const double tolerance ) const;
 
     // Given a bounding box return the native element ordinals that are in
     // the box.
@@ -107,13 +169,49 @@ class RendezvousMesh
     elementsInGeometry( const Geometry& geometry, const double tolerance, 
 			bool all_vertices_for_inclusion ) const;
 
+    // Set the coordinates of all mesh vertices and update the element cache.
+    void setVertexCoords( const Teuchos::ArrayView<const double>& coords );
+
+  private:
+
+    // Extract the local elements from Moab and cache them.
+    void buildElementCache();
+
+    // Determine if a box overlaps the bounding box of a cached element.
+    inline bool boxOverlapsElementBounds( const Teuchos::Tuple<double,6>& box,
+					  const int element_index ) const;
+
   private:
 
     //! Moab interface implementation.
     RCP_Moab d_moab;
 
-    //! Moab element ordinal to native element ordinal map.
-    OrdinalMap d_ordinal_map;
+    //! Mesh dimension.
+    int d_dim;
+
+    //! Cached element handles in Moab order.
+    Teuchos::Array<moab::EntityHandle> d_elements;
+
+    //! Cached element native ordinals.
+    Teuchos::Array<GlobalOrdinal> d_element_ordinals;
+
+    //! First handle of each contiguous run of cached element handles.
+    Teuchos::Array<moab::EntityHandle> d_run_handles;
+
+    //! Cache index of the first element of each run.
+    Teuchos::Array<int> d_run_offsets;
+
+    //! Cached element topologies.
+    Teuchos::Array<moab::EntityType> d_element_topologies;
+
+    //! Cached element bounding boxes, 6 bounds per element.
+    Teuchos::Array<double> d_element_bounds;
+
+    //! Offsets of each element's vertices in the vertex coordinate table.
+    Teuchos::Array<int> d_vertex_offsets;
+
+    //! Interleaved vertex coordinates of all cached elements.
+    Teuchos::Array<double> d_vertex_coords;
 };
 
 //---------------------------------------------------------------------------//
@@ -42,6 +42,10 @@
 #define DTK_RENDEZVOUSMESH_DEF_HPP
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "DTK_MeshTools.hpp"
 #include "DTK_BoundingBox.hpp"
@@ -50,6 +54,7 @@
 #include "DataTransferKit_config.hpp"
 
 #include <MBCore.hpp>
+#include <MBReadUtilIface.hpp>
 
 #include <Teuchos_Array.hpp>
 #include <Teuchos_ArrayRCP.hpp>
@@ -64,15 +69,32 @@ namespace DataTransferKit
  * 
  * \param moab The Moab interface to build the RendezvousMesh with.
  *
- * \param ordinal_map A map relating the client element global ordinals to the
- * Moab element handles.
+ * \param elements The Moab element handles.
+ *
+ * \param element_ordinals The client element global ordinals of the Moab
+ * elements.
  */
 template<typename GlobalOrdinal>
-RendezvousMesh<GlobalOrdinal>::RendezvousMesh( const RCP_Moab& moab, 
-					       const OrdinalMap& ordinal_map )
+RendezvousMesh<GlobalOrdinal>::RendezvousMesh( 
+    const RCP_Moab& moab, 
+    const Teuchos::Array<moab::EntityHandle>& elements,
+    const Teuchos::Array<GlobalOrdinal>& element_ordinals )
     : d_moab( moab )
-    , d_ordinal_map( ordinal_map )
-{ /* ... */ }
+    , d_dim( 0 )
+{
+    testPrecondition( elements.size() == element_ordinals.size() );
+
+    buildElementCache();
+    testInvariant( elements.size() == d_elements.size() );
+
+    // Scatter the native ordinals into cache order.
+    d_element_ordinals.resize( d_elements.size() );
+    int num_elements = elements.size();
+    for ( int i = 0; i < num_elements; ++i )
+    {
+	d_element_ordinals[ elementIndex(elements[i]) ] = element_ordinals[i];
+    }
+}
 
 //---------------------------------------------------------------------------//
 /*!
@@ -82,6 +104,109 @@ template<typename GlobalOrdinal>
 RendezvousMesh<GlobalOrdinal>::~RendezvousMesh()
 { /* ... */ }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the cache index of a Moab element.
+ *
+ * \param element The Moab element handle.
+ *
+ * \return The index of the element in the cache.
+ */
+template<typename GlobalOrdinal>
+inline int RendezvousMesh<GlobalOrdinal>::elementIndex( 
+    const moab::EntityHandle element ) const
+{
+    testPrecondition( !d_run_handles.empty() );
+    testPrecondition( element >= d_run_handles.front() );
+
+    // Find the handle run containing the element. There is usually only one
+    // run per element type so check the first one before searching.
+    int run = 0;
+    if ( d_run_handles.size() > 1 && element >= d_run_handles[1] )
+    {
+	run = std::distance( 
+	    d_run_handles.begin(),
+	    std::upper_bound( d_run_handles.begin(), d_run_handles.end(), 
+			      element ) ) - 1;
+    }
+
+    int element_index = d_run_offsets[run] + 
+			Teuchos::as<int>( element - d_run_handles[run] );
+    testPostcondition( element_index < d_run_offsets[run+1] );
+    testPostcondition( d_elements[element_index] == element );
+    return element_index;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if a point is in a cached element. The analytic kernels
+ * are used on the cached vertex coordinates if one exists for the
+ * element. Otherwise the query falls back to the Moab database.
+ *
+ * \param point The point coordinates padded to 3 dimensions.
+ *
+ * \param element_index The cache index of the element.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ *
+ * \return Return true if the point is in the element, false if not.
+ */
+template<typename GlobalOrdinal>
+bool RendezvousMesh<GlobalOrdinal>::pointInElement( 
+    const double point[3], 
+    const int element_index,
+    const double tolerance ) const
+{
+    double reference_point[3];
+    return pointInElement( point, element_index, reference_point, tolerance );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if a point is in a cached element and get the
+ * coordinates of the point in the reference frame of the element. The
+ * analytic kernels are used on the cached vertex coordinates if one exists
+ * for the element. Otherwise the query falls back to the Moab database.
+ *
+ * \param point The point coordinates padded to 3 dimensions.
+ *
+ * \param element_index The cache index of the element.
+ *
+ * \param reference_point The point mapped to the reference frame of the
+ * element padded to 3 dimensions. NaN for elements without a reference frame
+ * of their own.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ *
+ * \return Return true if the point is in the element, false if not.
+ */
+template<typename GlobalOrdinal>
+bool RendezvousMesh<GlobalOrdinal>::pointInElement( 
+    const double point[3], 
+    const int element_index,
+    double reference_point[3],
+    const double tolerance ) const
+{
+    testPrecondition( 0 <= element_index && 
+		      element_index < Teuchos::as<int>(d_elements.size()) );
+
+    if ( TopologyTools::hasPointInElementKernel( 
+	     d_element_topologies[element_index],
+	     numElementVertices(element_index), d_dim ) )
+    {
+	return TopologyTools::pointInElement( 
+	    point, d_element_topologies[element_index],
+	    elementVertexCoords(element_index), reference_point, tolerance );
+    }
+
+    Teuchos::Array<double> coords( point, point + d_dim );
+    return TopologyTools::pointInElement( 
+	coords, d_elements[element_index], d_moab, reference_point, 
+	tolerance );
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Given a bounding box return the native element ordinals that are in
@@ -95,36 +220,18 @@ template<typename GlobalOrdinal>
 Teuchos::Array<GlobalOrdinal> 
 RendezvousMesh<GlobalOrdinal>::elementsInBox( const BoundingBox& box ) const
 {
-    // Get the dimension of the mesh.
-    rememberValue( moab::ErrorCode error );
-    int dim = 0;
-#if HAVE_DTK_DBC
-    error = d_moab->get_dimension( dim );
-#else
-    d_moab->get_dimension( dim );
-#endif
-    testInvariant( moab::MB_SUCCESS == error );
-
-    // Get the mesh elements.
-    moab::Range elements;
-#if HAVE_DTK_DBC
-    error = d_moab->get_entities_by_dimension( 0, dim, elements );
-#else
-    d_moab->get_entities_by_dimension( 0, dim, elements );
-#endif
-    testInvariant( moab::MB_SUCCESS == error );
-    
-    // Get the elements that are in the box.
+    // Get the elements that are in the box. Elements whose bounding box does
+    // not overlap the box are rejected first.
+    Teuchos::Tuple<double,6> box_bounds = box.getBounds();
     Teuchos::Array<GlobalOrdinal> elements_in_box;
-    moab::Range::iterator element_iterator;
-    for ( element_iterator = elements.begin();
-	  element_iterator != elements.end();
-	  ++element_iterator )
+    int num_elements = d_elements.size();
+    for ( int i = 0; i < num_elements; ++i )
     {
-	if ( TopologyTools::boxElementOverlap( 
-		 box, *element_iterator, d_moab ) )
+	if ( boxOverlapsElementBounds( box_bounds, i ) &&
+	     TopologyTools::boxElementOverlap( 
+		 box, d_element_topologies[i], elementVertexCoords(i) ) )
 	{
-	    elements_in_box.push_back( getNativeOrdinal( *element_iterator ) );
+	    elements_in_box.push_back( getNativeOrdinal( d_elements[i] ) );
 	}   
     }
 
@@ -157,43 +264,200 @@ Teuchos::Array<GlobalOrdinal>
 RendezvousMesh<GlobalOrdinal>::elementsInGeometry( 
     const Geometry& geometry, const double tolerance,
     bool all_vertices_for_inclusion ) const
+{
+    // Any vertex in the geometry is in its bounding box expanded by the
+    // tolerance. Elements whose bounding box does not overlap it are rejected
+    // first.
+    Teuchos::Tuple<double,6> geometry_bounds = 
+	GeometryTraits<Geometry>::boundingBox( geometry ).getBounds();
+    for ( int d = 0; d < 3; ++d )
+    {
+	geometry_bounds[d] -= tolerance;
+	geometry_bounds[d+3] += tolerance;
+    }
+
+    // Get the elements that are in the geometry.
+    Teuchos::Array<GlobalOrdinal> elements_in_geometry;
+    int num_elements = d_elements.size();
+    for ( int i = 0; i < num_elements; ++i )
+    {
+	if ( boxOverlapsElementBounds( geometry_bounds, i ) &&
+	     TopologyTools::elementInGeometry( geometry, 
+					       elementVertexCoords(i),
+					       numElementVertices(i),
+					       tolerance, 
+					       all_vertices_for_inclusion ) )
+	{
+	    elements_in_geometry.push_back( 
+		getNativeOrdinal( d_elements[i] ) );
+	}   
+    }
+
+    return elements_in_geometry;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the coordinates of all mesh vertices and update the element
+ * cache. The mesh connectivity does not change.
+ *
+ * \param coords The interleaved coordinates of all Moab vertices padded to 3
+ * dimensions ( x_0, y_0, z_0, x_1, y_1, z_1, ... ) in Moab handle order.
+ */
+template<typename GlobalOrdinal>
+void RendezvousMesh<GlobalOrdinal>::setVertexCoords( 
+    const Teuchos::ArrayView<const double>& coords )
+{
+    rememberValue( moab::ErrorCode error );
+    moab::Range vertices;
+#if HAVE_DTK_DBC
+    error = d_moab->get_entities_by_dimension( 0, 0, vertices );
+#else
+    d_moab->get_entities_by_dimension( 0, 0, vertices );
+#endif
+    testInvariant( moab::MB_SUCCESS == error );
+    testPrecondition( 3*vertices.size() == 
+		      Teuchos::as<std::size_t>(coords.size()) );
+
+    if ( !vertices.empty() )
+    {
+#if HAVE_DTK_DBC
+	error = d_moab->set_coords( vertices, coords.getRawPtr() );
+#else
+	d_moab->set_coords( vertices, coords.getRawPtr() );
+#endif
+	testInvariant( moab::MB_SUCCESS == error );
+    }
+
+    // The elements are unchanged so rebuilding the cache only refreshes the
+    // vertex coordinates and element bounds.
+    buildElementCache();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Extract the local elements from Moab and cache their topologies,
+ * bounding boxes, and vertex coordinates.
+ */
+template<typename GlobalOrdinal>
+void RendezvousMesh<GlobalOrdinal>::buildElementCache()
 {
     // Get the dimension of the mesh.
     rememberValue( moab::ErrorCode error );
-    int dim = 0;
 #if HAVE_DTK_DBC
-    error = d_moab->get_dimension( dim );
+    error = d_moab->get_dimension( d_dim );
 #else
-    d_moab->get_dimension( dim );
+    d_moab->get_dimension( d_dim );
 #endif
     testInvariant( moab::MB_SUCCESS == error );
 
     // Get the mesh elements.
     moab::Range elements;
 #if HAVE_DTK_DBC
-    error = d_moab->get_entities_by_dimension( 0, dim, elements );
+    error = d_moab->get_entities_by_dimension( 0, d_dim, elements );
 #else
-    d_moab->get_entities_by_dimension( 0, dim, elements );
+    d_moab->get_entities_by_dimension( 0, d_dim, elements );
 #endif
     testInvariant( moab::MB_SUCCESS == error );
-    
-    // Get the elements that are in the geometry.
-    Teuchos::Array<GlobalOrdinal> elements_in_geometry;
-    moab::Range::iterator element_iterator;
+
+    int num_elements = elements.size();
+    d_elements.resize( num_elements );
+    d_element_topologies.resize( num_elements );
+    d_element_bounds.resize( 6*num_elements );
+    d_vertex_offsets.resize( num_elements + 1 );
+    d_vertex_offsets[0] = 0;
+    d_vertex_coords.clear();
+    d_run_handles.clear();
+    d_run_offsets.clear();
+
+    // Cache the elements and their vertex coordinates.
+    const moab::EntityHandle* element_vertices = 0;
+    int num_element_vertices = 0;
+    int offset = 0;
+    moab::Range::const_iterator element_iterator;
+    int n = 0;
     for ( element_iterator = elements.begin();
 	  element_iterator != elements.end();
-	  ++element_iterator )
+	  ++element_iterator, ++n )
     {
-	if ( TopologyTools::elementInGeometry( geometry, *element_iterator, 
-					       d_moab, tolerance, 
-					       all_vertices_for_inclusion ) )
+	d_elements[n] = *element_iterator;
+	d_element_topologies[n] = d_moab->type_from_handle( *element_iterator );
+
+	// Moab ranges are sorted. Start a new handle run if this handle does
+	// not follow the previous one.
+	if ( 0 == n || d_elements[n] != d_elements[n-1] + 1 )
 	{
-	    elements_in_geometry.push_back( 
-		getNativeOrdinal( *element_iterator ) );
-	}   
+	    d_run_handles.push_back( d_elements[n] );
+	    d_run_offsets.push_back( n );
+	}
+
+	// A vertex element is its own connectivity.
+	if ( moab::MBVERTEX == d_element_topologies[n] )
+	{
+	    element_vertices = &d_elements[n];
+	    num_element_vertices = 1;
+	}
+	else
+	{
+#if HAVE_DTK_DBC
+	    error = d_moab->get_connectivity( *element_iterator,
+					      element_vertices,
+					      num_element_vertices );
+#else
+	    d_moab->get_connectivity( *element_iterator,
+				      element_vertices,
+				      num_element_vertices );
+#endif
+	    testInvariant( moab::MB_SUCCESS == error );
+	}
+
+	offset = d_vertex_offsets[n];
+	d_vertex_offsets[n+1] = offset + num_element_vertices;
+	d_vertex_coords.resize( 3*d_vertex_offsets[n+1] );
+#if HAVE_DTK_DBC
+	error = d_moab->get_coords( element_vertices,
+				    num_element_vertices,
+				    &d_vertex_coords[3*offset] );
+#else
+	d_moab->get_coords( element_vertices,
+			    num_element_vertices,
+			    &d_vertex_coords[3*offset] );
+#endif
+	testInvariant( moab::MB_SUCCESS == error );
+
+	// Compute the element bounding box.
+	for ( int d = 0; d < 3; ++d )
+	{
+	    d_element_bounds[6*n + d] = std::numeric_limits<double>::max();
+	    d_element_bounds[6*n + d + 3] = -std::numeric_limits<double>::max();
+	    for ( int i = offset; i < d_vertex_offsets[n+1]; ++i )
+	    {
+		d_element_bounds[6*n + d] = 
+		    std::min( d_element_bounds[6*n + d], 
+			      d_vertex_coords[3*i + d] );
+		d_element_bounds[6*n + d + 3] = 
+		    std::max( d_element_bounds[6*n + d + 3], 
+			      d_vertex_coords[3*i + d] );
+	    }
+	}
     }
 
-    return elements_in_geometry;
+    // Close the last handle run.
+    d_run_offsets.push_back( num_elements );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if a box overlaps the bounding box of a cached element.
+ */
+template<typename GlobalOrdinal>
+inline bool RendezvousMesh<GlobalOrdinal>::boxOverlapsElementBounds( 
+    const Teuchos::Tuple<double,6>& box, const int element_index ) const
+{
+    const double* bounds = &d_element_bounds[ 6*element_index ];
+    return ( box[0] <= bounds[3] && bounds[0] <= box[3] &&
+	     box[1] <= bounds[4] && bounds[1] <= box[4] &&
+	     box[2] <= bounds[5] && bounds[2] <= box[5] );
 }
 
 //---------------------------------------------------------------------------//
@@ -216,8 +480,20 @@ createRendezvousMeshFromMesh( const MeshManager<Mesh>& mesh_manager )
     typename MT::const_vertex_iterator vertex_iterator;
     typename MT::const_element_iterator element_iterator;
 
-    // Setup an element handle map.
-    std::map<moab::EntityHandle,GlobalOrdinal> element_ordinal_map;
+    // Setup the element handle and native ordinal tables.
+    GlobalOrdinal num_local_elements = 0;
+    typename MeshManager<Mesh>::BlockIterator block_iterator;
+    for ( block_iterator = mesh_manager.blocksBegin();
+	  block_iterator != mesh_manager.blocksEnd();
+	  ++block_iterator )
+    {
+	num_local_elements += 
+	    MeshTools<Mesh>::numElements( *(*block_iterator) );
+    }
+    Teuchos::Array<moab::EntityHandle> element_handles;
+    Teuchos::Array<GlobalOrdinal> element_ordinals;
+    element_handles.reserve( num_local_elements );
+    element_ordinals.reserve( num_local_elements );
 
     // Create a moab interface.
     rememberValue( moab::ErrorCode error );
@@ -233,8 +509,18 @@ createRendezvousMeshFromMesh( const MeshManager<Mesh>& mesh_manager )
 #endif
     testInvariant( moab::MB_SUCCESS == error );
 
+    // Get the bulk creation interface. Each mesh block is allocated in moab
+    // as one vertex sequence and one element sequence.
+    moab::ReadUtilIface* read_util = 0;
+#if HAVE_DTK_DBC
+    error = moab->query_interface( read_util );
+#else
+    moab->query_interface( read_util );
+#endif
+    testInvariant( moab::MB_SUCCESS == error );
+    testInvariant( 0 != read_util );
+
     // Build each mesh block.
-    typename MeshManager<Mesh>::BlockIterator block_iterator;
     for ( block_iterator = mesh_manager.blocksBegin();
 	  block_iterator != mesh_manager.blocksEnd();
 	  ++block_iterator )
@@ -248,36 +534,48 @@ createRendezvousMeshFromMesh( const MeshManager<Mesh>& mesh_manager )
 	testInvariant( num_coords == 
 		       Teuchos::as<GlobalOrdinal>(vertex_dim) * num_vertices );
 
-	// Add the mesh vertices to moab and map the native vertex handles to
-	// the moab vertex handles. This should be in a hash table. We'll need
-	// one that hashes moab handles.
-	double vertex_coords[3];
+	// Allocate the block vertices in moab in a single sequence and copy
+	// the blocked coordinates directly into it.
+	moab::EntityHandle vertex_start = 0;
+	std::vector<double*> moab_coords;
+	if ( num_vertices > 0 )
+	{
+#if HAVE_DTK_DBC
+	    error = read_util->get_node_coords( 3, num_vertices, MB_START_ID,
+						vertex_start, moab_coords );
+#else
+	    read_util->get_node_coords( 3, num_vertices, MB_START_ID,
+					vertex_start, moab_coords );
+#endif
+	    testInvariant( moab::MB_SUCCESS == error );
+	    testInvariant( 3 == moab_coords.size() );
+	}
 	Teuchos::ArrayRCP<const double> mesh_coords = 
 	    MeshTools<Mesh>::coordsView( *(*block_iterator) );
-	std::map<GlobalOrdinal,moab::EntityHandle> vertex_ordinal_map;
+	for ( int d = 0; d < vertex_dim && num_vertices > 0; ++d )
+	{
+	    std::copy( mesh_coords.begin() + d*num_vertices,
+		       mesh_coords.begin() + (d+1)*num_vertices,
+		       moab_coords[d] );
+	}
+	for ( int d = vertex_dim; d < 3 && num_vertices > 0; ++d )
+	{
+	    std::fill( moab_coords[d], moab_coords[d] + num_vertices, 0.0 );
+	}
+
+	// Pair the native vertex handles with the moab vertex handles in a
+	// table sorted by native handle.
+	Teuchos::Array<std::pair<GlobalOrdinal,moab::EntityHandle> > 
+	    vertex_handle_table( num_vertices );
 	GlobalOrdinal n = 0;
 	for ( vertex_iterator = MT::verticesBegin( *(*block_iterator) );
 	      vertex_iterator != MT::verticesEnd( *(*block_iterator) );
 	      ++vertex_iterator, ++n )
 	{
-	    moab::EntityHandle moab_vertex;
-	    for ( int d = 0; d < vertex_dim; ++d )
-	    {
-		vertex_coords[d] = mesh_coords[d*num_vertices + n];
-	    }
-	    for ( int d = vertex_dim; d < 3; ++d )
-	    {
-		vertex_coords[d] = 0.0;
-	    }
-#if HAVE_DTK_DBC
-	    error = moab->create_vertex( vertex_coords, moab_vertex );
-#else
-	    moab->create_vertex( vertex_coords, moab_vertex );
-#endif
-	    testInvariant( moab::MB_SUCCESS == error );
-
-	    vertex_ordinal_map[ *vertex_iterator ] = moab_vertex;
+	    vertex_handle_table[n] = std::make_pair( *vertex_iterator, 
+						     vertex_start + n );
 	}
+	std::sort( vertex_handle_table.begin(), vertex_handle_table.end() );
 
 	// Check the elements and connectivity for consistency.
 	int vertices_per_element = 
@@ -289,63 +587,95 @@ createRendezvousMeshFromMesh( const MeshManager<Mesh>& mesh_manager )
 			   MT::connectivityEnd( *(*block_iterator) ) ) );
 	testInvariant( num_elements == num_connect / vertices_per_element &&
 		       num_connect % vertices_per_element == 0 );
+	if ( 0 == num_elements )
+	{
+	    continue;
+	}
+
+	// Allocate the block elements in moab in a single sequence.
+	int element_topology = MT::elementTopology( *(*block_iterator) );
+	moab::EntityType entity_type = moab_topology_table[ element_topology ];
+	moab::EntityHandle element_start = 0;
+	moab::EntityHandle* moab_connectivity = 0;
+#if HAVE_DTK_DBC
+	error = read_util->get_element_connect( num_elements, 
+						vertices_per_element,
+						entity_type,
+						MB_START_ID,
+						element_start,
+						moab_connectivity );
+#else
+	read_util->get_element_connect( num_elements, 
+					vertices_per_element,
+					entity_type,
+					MB_START_ID,
+					element_start,
+					moab_connectivity );
+#endif
+	testInvariant( moab::MB_SUCCESS == error );
 
-	// Extract the mesh elements and add them to moab.
+	// Write the permuted element connectivity directly into the moab
+	// sequence.
 	Teuchos::ArrayRCP<const GlobalOrdinal> mesh_connectivity = 
 	    MeshTools<Mesh>::connectivityView( *(*block_iterator) );
 	Teuchos::ArrayRCP<const int> permutation_list =
 	    MeshTools<Mesh>::permutationView( *(*block_iterator) );
 	GlobalOrdinal conn_index;
-	Teuchos::Array<moab::EntityHandle> 
-	    element_connectivity( vertices_per_element );
-
+	typename Teuchos::Array<
+	    std::pair<GlobalOrdinal,moab::EntityHandle> >::const_iterator
+	    vertex_handle_it;
 	int canonical_idx;
 	n = 0;
-	int element_topology = MT::elementTopology( *(*block_iterator) );
 	for ( element_iterator = MT::elementsBegin( *(*block_iterator) );
 	      element_iterator != MT::elementsEnd( *(*block_iterator) );
 	      ++element_iterator, ++n )
 	{
-	    // Extract the connecting vertices for this element and apply the
-	    // permutation list.
 	    for ( int i = 0; i < vertices_per_element; ++i )
 	    {
 		canonical_idx = permutation_list[i];
 		conn_index = i*num_elements + n;
-		element_connectivity[ canonical_idx ] =
-		    vertex_ordinal_map.find( 
-			mesh_connectivity[ conn_index ] )->second;
+		vertex_handle_it = std::lower_bound( 
+		    vertex_handle_table.begin(), vertex_handle_table.end(),
+		    std::make_pair( mesh_connectivity[ conn_index ],
+				    moab::EntityHandle(0) ) );
+		testInvariant( vertex_handle_it != vertex_handle_table.end() &&
+			       vertex_handle_it->first == 
+			       mesh_connectivity[ conn_index ] );
+		moab_connectivity[ n*vertices_per_element + canonical_idx ] = 
+		    vertex_handle_it->second;
 	    }
-	    testInvariant( element_connectivity.size()
-			   == Teuchos::as<
-			       Teuchos::Array<moab::EntityHandle>::size_type>(
-				   vertices_per_element) );
-
-	    // Create the element in moab.
-	    moab::EntityType entity_type = 
-		moab_topology_table[ element_topology ];
-	    moab::EntityHandle moab_element;
+
+	    // Pair the moab element handle with the native element handle.
+	    element_handles.push_back( element_start + n );
+	    element_ordinals.push_back( *element_iterator );
+	}
+
+	// Update the vertex adjacencies for the new elements.
 #if HAVE_DTK_DBC
-	    error = moab->create_element( entity_type,
-					  &element_connectivity[0],
-					  element_connectivity.size(),
-					  moab_element );
+	error = read_util->update_adjacencies( element_start, 
+					       num_elements, 
+					       vertices_per_element,
+					       moab_connectivity );
 #else
-	    moab->create_element( entity_type,
-				  &element_connectivity[0],
-				  element_connectivity.size(),
-				  moab_element );
+	read_util->update_adjacencies( element_start, 
+				       num_elements, 
+				       vertices_per_element,
+				       moab_connectivity );
 #endif
-	    testInvariant( moab::MB_SUCCESS == error );
-
-	    // Map the moab element handle to the native element handle.
-	    element_ordinal_map[ moab_element ] = *element_iterator;
-	}
+	testInvariant( moab::MB_SUCCESS == error );
     }
 
+    // Release the bulk creation interface.
+#if HAVE_DTK_DBC
+    error = moab->release_interface( read_util );
+#else
+    moab->release_interface( read_util );
+#endif
+    testInvariant( moab::MB_SUCCESS == error );
+
     // Create and return the mesh.
-    return Teuchos::rcp( 
-	new RendezvousMesh<GlobalOrdinal>( moab, element_ordinal_map ) );
+    return Teuchos::rcp( new RendezvousMesh<GlobalOrdinal>( 
+			     moab, element_handles, element_ordinals ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -365,8 +695,11 @@ Teuchos::RCP< RendezvousMesh<GlobalOrdinal> > createRendezvousMeshFromGeometry(
     // Setup types and iterators as we're outside of the class definition.
     typedef GeometryTraits<Geometry> GT;
 
-    // Setup an element handle map.
-    std::map<moab::EntityHandle,GlobalOrdinal> element_ordinal_map;
+    // Setup the element handle and native ordinal tables.
+    Teuchos::Array<moab::EntityHandle> element_handles;
+    Teuchos::Array<GlobalOrdinal> element_ordinals;
+    element_handles.reserve( geometry_manager.localNumGeometry() );
+    element_ordinals.reserve( geometry_manager.localNumGeometry() );
 
     // Create a moab interface.
     rememberValue( moab::ErrorCode error );
@@ -408,7 +741,6 @@ Teuchos::RCP< RendezvousMesh<GlobalOrdinal> > createRendezvousMeshFromGeometry(
     
     // Extract the geometry bounding boxes from the manager. We will turn
     // these into hexahedrons, squares, or lines.
-    std::map<GlobalOrdinal,moab::EntityHandle> vertex_ordinal_map;
     Teuchos::Tuple<double,6> geom_bounds;
     Teuchos::Array<double> vertex_coords(3*vertices_per_element);
     Teuchos::ArrayRCP<Geometry> geometry = geometry_manager.geometry();
@@ -524,14 +856,15 @@ Teuchos::RCP< RendezvousMesh<GlobalOrdinal> > createRendezvousMeshFromGeometry(
 #endif
 	testInvariant( moab::MB_SUCCESS == error );
 
-	// Map the moab element handle to the local geometry ordinal.
-	element_ordinal_map[ moab_element ] = 
-	    std::distance( geometry_begin, geometry_iterator );
+	// Pair the moab element handle with the local geometry ordinal.
+	element_handles.push_back( moab_element );
+	element_ordinals.push_back( 
+	    std::distance( geometry_begin, geometry_iterator ) );
     }
 
     // Create and return the mesh.
-    return Teuchos::rcp( 
-	new RendezvousMesh<GlobalOrdinal>( moab, element_ordinal_map ) );
+    return Teuchos::rcp( new RendezvousMesh<GlobalOrdinal>( 
+			     moab, element_handles, element_ordinals ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -41,15 +41,17 @@
 #ifndef DTK_RENDEZVOUS_DEF_HPP
 #define DTK_RENDEZVOUS_DEF_HPP
 
-#include <set>
 #include <algorithm>
+#include <iterator>
 #include <limits>
+#include <utility>
 
 #include "DTK_MeshTools.hpp"
 #include "DTK_Assertion.hpp"
 #include "DTK_CommIndexer.hpp"
 #include "DTK_MeshTypes.hpp"
 #include "DTK_PartitionerFactory.hpp"
+#include "DTK_OrdinalIndex.hpp"
 
 #include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_ArrayView.hpp>
@@ -58,8 +60,6 @@
 #include <Teuchos_as.hpp>
 
 #include <Tpetra_Distributor.hpp>
-#include <Tpetra_Export.hpp>
-#include <Tpetra_MultiVector.hpp>
 
 namespace DataTransferKit
 {
@@ -76,14 +76,25 @@ namespace DataTransferKit
  *
  * \param global_box The global bounding box inside of which the rendezvous
  * decomposition will be generated.
+ *
+ * \param weights Optional source vertex weights for the rendezvous
+ * partitioning. If provided, the partitioning will balance the vertex weights
+ * instead of the number of vertices.
+ *
+ * \param partitioner_type The algorithm used to compute the rendezvous
+ * partitioning.
  */
 template<class Mesh>
 Rendezvous<Mesh>::Rendezvous( const RCP_Comm& comm,
 			      const int dimension,
-			      const BoundingBox& global_box )
+			      const BoundingBox& global_box,
+			      const RCP_PartitionWeights& weights,
+			      const DTK_PartitionerType partitioner_type )
     : d_comm( comm )
     , d_dimension( dimension )
     , d_global_box( global_box )
+    , d_partition_weights( weights )
+    , d_partitioner_type( partitioner_type )
 { /* ... */ }
 
 //---------------------------------------------------------------------------//
@@ -118,7 +129,8 @@ void Rendezvous<Mesh>::build( const RCP_MeshManager& mesh_manager )
     // Construct the rendezvous partitioning for the mesh using the
     // vertices that are in the box.
     d_partitioner = PartitionerFactory::createMeshPartitioner( 
-	d_comm, mesh_manager, d_dimension );
+	d_comm, mesh_manager, d_dimension, 
+	d_partition_weights, d_partitioner_type );
     testPostcondition( !d_partitioner.is_null() );
     d_partitioner->partition();
 
@@ -138,6 +150,154 @@ void Rendezvous<Mesh>::build( const RCP_MeshManager& mesh_manager )
     d_kdtree->build();
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Update the rendezvous decomposition after the vertices of the mesh
+ * have moved. The mesh must have the same vertices and elements it had when
+ * the decomposition was built; only the coordinates may change.
+ *
+ * The partitioning and the set of elements in the rendezvous box are kept
+ * from the build. If every element still goes to the same rendezvous
+ * processes, only the new vertex coordinates are sent to the rendezvous
+ * decomposition and the kD-tree is refit. Otherwise the mesh is migrated
+ * again with the existing partitioning and the kD-tree is rebuilt.
+ *
+ * \param mesh_manager The moved mesh. A null argument is valid on processes
+ * that did not have mesh when the decomposition was built.
+ */
+template<class Mesh> 
+void Rendezvous<Mesh>::update( const RCP_MeshManager& mesh_manager )
+{
+    testPrecondition( !d_rendezvous_mesh.is_null() );
+
+    bool mesh_exists = true;
+    if ( mesh_manager.is_null() ) mesh_exists = false;
+
+    // Get the rendezvous destinations of the moved vertices and elements and
+    // pack the vertex coordinates for each destination.
+    int num_mesh_blocks = d_vertex_block_offsets.size() - 1;
+    Teuchos::Array<GlobalOrdinal> element_indices;
+    Teuchos::Array<int> element_procs;
+    Teuchos::Array<int> export_procs;
+    Teuchos::Array<GlobalOrdinal> export_ordinal_packets;
+    Teuchos::Array<double> export_coord_packets;
+    Teuchos::Array<GlobalOrdinal> export_element_indices;
+    Teuchos::Array<int> export_element_procs;
+    Teuchos::Array<GlobalOrdinal> export_vertex_indices;
+    Teuchos::Array<int> export_vertex_procs;
+    Teuchos::RCP<Mesh> current_block;
+    for ( int block_id = 0; block_id < num_mesh_blocks && mesh_exists; 
+	  ++block_id )
+    {
+	current_block = mesh_manager->getBlock( block_id );
+	setupImportCommunication( current_block, 
+				  mesh_manager->getActiveElements( block_id ),
+				  export_element_indices, export_element_procs,
+				  export_vertex_indices, export_vertex_procs );
+	element_indices.insert( element_indices.end(),
+				export_element_indices.begin(),
+				export_element_indices.end() );
+	element_procs.insert( element_procs.end(),
+			      export_element_procs.begin(),
+			      export_element_procs.end() );
+
+	GlobalOrdinal num_vertices = 
+	    MeshTools<Mesh>::numVertices( *current_block );
+	Teuchos::ArrayRCP<const GlobalOrdinal> block_vertices = 
+	    MeshTools<Mesh>::verticesView( *current_block );
+	Teuchos::ArrayRCP<const double> block_coords = 
+	    MeshTools<Mesh>::coordsView( *current_block );
+
+	int num_exports = export_procs.size();
+	int num_vertex_exports = export_vertex_procs.size();
+	export_procs.resize( num_exports + num_vertex_exports );
+	export_ordinal_packets.resize( 2*(num_exports + num_vertex_exports) );
+	export_coord_packets.resize( 
+	    d_dimension*(num_exports + num_vertex_exports) );
+	GlobalOrdinal vertex_index;
+	for ( int n = 0; n < num_vertex_exports; ++n, ++num_exports )
+	{
+	    vertex_index = export_vertex_indices[n];
+	    export_procs[ num_exports ] = export_vertex_procs[n];
+	    export_ordinal_packets[ 2*num_exports ] = block_id;
+	    export_ordinal_packets[ 2*num_exports + 1 ] = 
+		block_vertices[ vertex_index ];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		export_coord_packets[ d_dimension*num_exports + d ] =
+		    block_coords[ d*num_vertices + vertex_index ];
+	    }
+	}
+    }
+    d_comm->barrier();
+
+    // If any element moved into a different set of rendezvous partitions the
+    // rendezvous mesh changes and the mesh is migrated again.
+    int local_changed = ( element_indices != d_export_element_indices ||
+			  element_procs != d_export_element_procs );
+    int global_changed = 0;
+    Teuchos::reduceAll<int,int>( *d_comm, Teuchos::REDUCE_MAX, 1,
+				 &local_changed, &global_changed );
+    if ( global_changed )
+    {
+	MeshManager<MeshContainerType> rendezvous_mesh_manager =
+	    sendMeshToRendezvous( mesh_manager );
+	d_rendezvous_mesh = 
+	    createRendezvousMeshFromMesh( rendezvous_mesh_manager );
+	testPostcondition( !d_rendezvous_mesh.is_null() );
+	d_kdtree = Teuchos::rcp( 
+	    new KDTree<GlobalOrdinal>( d_rendezvous_mesh , d_dimension ) );
+	testPostcondition( !d_kdtree.is_null() );
+	d_kdtree->build();
+	return;
+    }
+
+    // Otherwise only the vertex coordinates are sent. Each rendezvous
+    // process receives the same vertices it received in the build.
+    Tpetra::Distributor distributor( d_comm );
+    Teuchos::ArrayView<const int> export_procs_view = export_procs();
+    int num_imports = distributor.createFromSends( export_procs_view );
+    Teuchos::ArrayView<const GlobalOrdinal> export_ordinal_packets_view =
+	export_ordinal_packets();
+    Teuchos::Array<GlobalOrdinal> import_ordinal_packets( 2*num_imports );
+    distributor.doPostsAndWaits( export_ordinal_packets_view, 2,
+				 import_ordinal_packets() );
+    Teuchos::ArrayView<const double> export_coord_packets_view =
+	export_coord_packets();
+    Teuchos::Array<double> import_coord_packets( d_dimension*num_imports );
+    distributor.doPostsAndWaits( export_coord_packets_view, d_dimension,
+				 import_coord_packets() );
+
+    // Write the new coordinates in Moab vertex order. The vertices of each
+    // block are sorted by global ordinal.
+    Teuchos::Array<double> vertex_coords( 3*d_rendezvous_vertices.size(), 
+					  0.0 );
+    int block_id = 0;
+    typename Teuchos::Array<GlobalOrdinal>::iterator vertex_iterator;
+    int vertex_index = 0;
+    for ( int n = 0; n < num_imports; ++n )
+    {
+	block_id = import_ordinal_packets[ 2*n ];
+	vertex_iterator = std::lower_bound( 
+	    d_rendezvous_vertices.begin() + d_vertex_block_offsets[block_id],
+	    d_rendezvous_vertices.begin() + d_vertex_block_offsets[block_id+1],
+	    import_ordinal_packets[ 2*n + 1 ] );
+	testInvariant( vertex_iterator != d_rendezvous_vertices.begin() + 
+		       d_vertex_block_offsets[block_id+1] );
+	testInvariant( *vertex_iterator == import_ordinal_packets[ 2*n + 1 ] );
+	vertex_index = std::distance( 
+	    d_rendezvous_vertices.begin(), vertex_iterator );
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    vertex_coords[ 3*vertex_index + d ] = 
+		import_coord_packets[ d_dimension*n + d ];
+	}
+    }
+
+    d_rendezvous_mesh->setVertexCoords( vertex_coords() );
+    d_kdtree->refit();
+}
+
 //---------------------------------------------------------------------------//
 /*! 
  * \brief Get the rendezvous destination processes for a blocked list of
@@ -154,18 +314,9 @@ template<class Mesh>
 Teuchos::Array<int> Rendezvous<Mesh>::procsContainingPoints(
     const Teuchos::ArrayRCP<double>& coords ) const
 {
-    Teuchos::Array<double> point( d_dimension );
-    GlobalOrdinal num_points = coords.size() / d_dimension;
-    Teuchos::Array<int> destination_procs( num_points );
-    for ( GlobalOrdinal n = 0; n < num_points; ++n )
-    {
-	for ( int d = 0; d < d_dimension; ++d )
-	{
-	    point[d] = coords[ d*num_points + n ];
-	}
-	destination_procs[n] = d_partitioner->getPointDestinationProc( point );
-    }
-
+    Teuchos::Array<int> destination_procs;
+    d_partitioner->getPointDestinationProcs( coords.getConst()(), 
+					     destination_procs );
     return destination_procs;
 }
 
@@ -184,16 +335,8 @@ template<class Mesh>
 Teuchos::Array<Teuchos::Array<int> > Rendezvous<Mesh>::procsContainingBoxes( 
     const Teuchos::Array<BoundingBox>& boxes ) const
 {
-    Teuchos::Array<Teuchos::Array<int> > box_procs( boxes.size() );
-    Teuchos::Array<Teuchos::Array<int> >::iterator proc_iterator;
-    Teuchos::Array<BoundingBox>::const_iterator box_iterator;
-    for ( box_iterator = boxes.begin(), proc_iterator = box_procs.begin();
-	  box_iterator != boxes.end();
-	  ++box_iterator, ++proc_iterator )
-    {
-	*proc_iterator = d_partitioner->getBoxDestinationProcs( *box_iterator );
-    }
-
+    Teuchos::Array<Teuchos::Array<int> > box_procs;
+    d_partitioner->getBoxDestinationProcs( boxes, box_procs );
     return box_procs;
 }
 
@@ -225,26 +368,58 @@ void Rendezvous<Mesh>::elementsContainingPoints(
     Teuchos::Array<int>& element_src_procs,
     double tolerance ) const
 {
-    Teuchos::Array<double> point( d_dimension );
-    GlobalOrdinal element_ordinal;
+    Teuchos::Array<double> reference_coords;
+    elementsContainingPoints( coords, elements, element_src_procs,
+			      reference_coords, tolerance );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the native mesh elements in the rendezvous decomposition
+ * containing a blocked list of coordinates also in the rendezvous
+ * decomposition along with the coordinates of each point in the reference
+ * frame of the element it was found in.
+ * 
+ * \param coords A blocked list of coordinates to search the mesh with. 
+ *
+ * \param elements An array of the elements the points were found in. An
+ * element will be returned for each point in the order they were provided
+ * in. If a point is not found in an element, return an invalid element
+ * ordinal, std::numeric_limits<GlobalOrdinal>::max(), for that point.
+ *
+ * \param element_src_procs The source procs that own the elements. Once proc
+ * is provided for each element in the order that the elements were
+ * provided. If a point is not found in an element, return an invalid element
+ * source proc, -1, for that point.
+ *
+ * \param reference_coords The blocked reference coordinates of each point in
+ * the element it was found in. Not valid for points that were not found.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ */
+template<class Mesh>
+void Rendezvous<Mesh>::elementsContainingPoints( 
+    const Teuchos::ArrayRCP<double>& coords,
+    Teuchos::Array<GlobalOrdinal>& elements,
+    Teuchos::Array<int>& element_src_procs,
+    Teuchos::Array<double>& reference_coords,
+    double tolerance ) const
+{
     GlobalOrdinal num_points = coords.size() / d_dimension;
-    bool found_point;
-    elements.resize( num_points );
+    Teuchos::Array<short int> points_found;
+    d_kdtree->findPoints( coords.getRawPtr(), num_points, 
+			  elements, points_found, reference_coords, 
+			  tolerance );
+    testInvariant( Teuchos::as<GlobalOrdinal>(elements.size()) == num_points );
+
     element_src_procs.resize( num_points );
     for ( GlobalOrdinal n = 0; n < num_points; ++n )
     {
-	for ( int d = 0; d < d_dimension; ++d )
+	if ( points_found[n] )
 	{
-	    point[d] = coords[ d*num_points + n ];
-	}
-
-	found_point = d_kdtree->findPoint( point, element_ordinal, tolerance );
-
-	if ( found_point )
-	{
-	    elements[n] = element_ordinal;
 	    element_src_procs[n] = 
-		d_element_src_procs_map.find( element_ordinal )->second;
+		d_element_src_procs_map.find( elements[n] )->second;
 	}
 	else
 	{
@@ -339,7 +514,7 @@ void Rendezvous<Mesh>::elementsInGeometry(
  */
 template<class Mesh>
 Teuchos::Array<int> Rendezvous<Mesh>::elementSourceProcs(
-    const Teuchos::Array<GlobalOrdinal>& elements )
+    const Teuchos::Array<GlobalOrdinal>& elements ) const
 {
     Teuchos::Array<int> source_procs( elements.size() );
     Teuchos::Array<int>::iterator source_proc_iterator;
@@ -394,23 +569,12 @@ void Rendezvous<Mesh>::getMeshInBox( const RCP_MeshManager& mesh_manager )
 	int block_id = std::distance( mesh_manager->blocksBegin(), 
 				      block_iterator );
 
-	// Create a map indexed by vertex global ordinal containing the actual
-	// vertex ordinal location in the array. This will give us logarithmic
-	// time access to connectivity. I should write a more general hash
-	// table to improve this access time as I'm using this strategy for
-	// most mesh operations.
+	// Index the vertex global ordinals by their location in the array for
+	// access to connectivity.
 	GlobalOrdinal num_vertices = 
 	    MeshTools<Mesh>::numVertices( *(*block_iterator) );
-	std::map<GlobalOrdinal,GlobalOrdinal> vertex_indices;
-	typename MT::const_vertex_iterator vertex_iterator;
-	GlobalOrdinal array_index = 0;
-	for ( vertex_iterator = MT::verticesBegin( *(*block_iterator) );
-	      vertex_iterator != MT::verticesEnd( *(*block_iterator) );
-	      ++vertex_iterator )
-	{
-	    vertex_indices[ *vertex_iterator ] = array_index;
-	    ++array_index;
-	}
+	OrdinalIndex<GlobalOrdinal> vertex_indices( 
+	    MeshTools<Mesh>::verticesView( *(*block_iterator) )() );
 
 	// Get all of the vertices that are in the box. 
 	Teuchos::Array<double> vertex_coords( d_dimension );
@@ -444,7 +608,7 @@ void Rendezvous<Mesh>::getMeshInBox( const RCP_MeshManager& mesh_manager )
 	    for ( int i = 0; i < vertices_per_element; ++i )
 	    {
 		vertex_ordinal = mesh_connectivity[ i*num_elements + n ];
-		vertex_index = vertex_indices.find( vertex_ordinal )->second;
+		vertex_index = vertex_indices.index( vertex_ordinal );
 		if ( vertices_in_box[ vertex_index ] )
 		{
 		    this_element_in_box = 1;
@@ -465,8 +629,7 @@ void Rendezvous<Mesh>::getMeshInBox( const RCP_MeshManager& mesh_manager )
 		for ( int i = 0; i < vertices_per_element; ++i )
 		{
 		    vertex_ordinal = mesh_connectivity[ i*num_elements + n ];
-		    vertex_index = 
-			vertex_indices.find( vertex_ordinal )->second;
+		    vertex_index = vertex_indices.index( vertex_ordinal );
 		    vertices_in_box[ vertex_index ] = 1;
 		}
 	    }
@@ -481,7 +644,7 @@ void Rendezvous<Mesh>::getMeshInBox( const RCP_MeshManager& mesh_manager )
 //---------------------------------------------------------------------------//
 /*!
  * \brief Send the mesh to the rendezvous decomposition and rebuild the mesh
- * blocks.
+ * blocks. All of the mesh blocks are moved in a single exchange.
  *
  * \param mesh_manager The mesh to send to the rendezvous decomposition.
  */
@@ -494,6 +657,13 @@ Rendezvous<Mesh>::sendMeshToRendezvous(
     bool mesh_exists = true;
     if ( mesh_manager.is_null() ) mesh_exists = false;
 
+    // Clear the record of any previous migration.
+    d_element_src_procs_map.clear();
+    d_export_element_indices.clear();
+    d_export_element_procs.clear();
+    d_rendezvous_vertices.clear();
+    d_vertex_block_offsets.assign( 1, 0 );
+
     // Setup a mesh indexer.
     RCP_Comm mesh_comm;
     if ( mesh_exists )
@@ -512,182 +682,322 @@ Rendezvous<Mesh>::sendMeshToRendezvous(
     d_comm->barrier();
     Teuchos::broadcast<int,int>( *d_comm, mesh_indexer.l2g(0),
 				 Teuchos::Ptr<int>(&num_mesh_blocks) );
-    
-    // Setup an array to store the mesh in the rendezvous decomposition.
-    Teuchos::ArrayRCP<Teuchos::RCP<MeshContainerType> >
-	rendezvous_block_containers( num_mesh_blocks );
 
-    // Loop through the blocks and move them to the rendezvous decomposition.
-    Teuchos::RCP<Mesh> current_block;
-    for ( int block_id = 0; block_id < num_mesh_blocks; ++block_id )
+    // Broadcast the element topology and vertices per element of all blocks
+    // at once.
+    Teuchos::Array<int> block_descriptions( 2*num_mesh_blocks, 0 );
+    if ( mesh_exists )
     {
-	// Get the current mesh block we are operating on.
-	if ( mesh_exists )
+	for ( int block_id = 0; block_id < num_mesh_blocks; ++block_id )
 	{
-	    current_block = mesh_manager->getBlock( block_id );
+	    block_descriptions[ 2*block_id ] = static_cast<int>(
+		MT::elementTopology( *mesh_manager->getBlock(block_id) ) );
+	    block_descriptions[ 2*block_id + 1 ] = 
+		MT::verticesPerElement( *mesh_manager->getBlock(block_id) );
 	}
-	d_comm->barrier();
-
-	// Setup the communication patterns for moving the mesh block to the
-	// rendezvous decomposition. This will also move the vertex and element
-	// global ordinals to the rendezvous decomposition.
-	Teuchos::Array<GlobalOrdinal> rendezvous_vertices;
-	Teuchos::Array<GlobalOrdinal> rendezvous_elements;
-	Teuchos::ArrayView<short int> active_block_elements;
-	if ( mesh_exists )
+    }
+    d_comm->barrier();
+    if ( num_mesh_blocks > 0 )
+    {
+	Teuchos::broadcast<int,int>( *d_comm, mesh_indexer.l2g(0),
+				     2*num_mesh_blocks, 
+				     &block_descriptions[0] );
+    }
+
+    // Broadcast the permutation lists of all blocks at once.
+    Teuchos::Array<int> permutation_offsets( num_mesh_blocks + 1, 0 );
+    int max_vertices_per_element = 0;
+    for ( int block_id = 0; block_id < num_mesh_blocks; ++block_id )
+    {
+	permutation_offsets[ block_id + 1 ] = permutation_offsets[ block_id ] +
+					      block_descriptions[ 2*block_id + 1 ];
+	max_vertices_per_element = std::max( 
+	    max_vertices_per_element, block_descriptions[ 2*block_id + 1 ] );
+    }
+    Teuchos::Array<int> permutation_lists( 
+	permutation_offsets[ num_mesh_blocks ], 0 );
+    if ( mesh_exists )
+    {
+	for ( int block_id = 0; block_id < num_mesh_blocks; ++block_id )
 	{
-	    active_block_elements = mesh_manager->getActiveElements( block_id );
+	    Teuchos::ArrayRCP<const int> block_permutation =
+		MeshTools<Mesh>::permutationView( 
+		    *mesh_manager->getBlock(block_id) );
+	    std::copy( block_permutation.begin(), block_permutation.end(),
+		       permutation_lists.begin() + 
+		       permutation_offsets[ block_id ] );
 	}
-	d_comm->barrier();
-	setupImportCommunication( current_block, active_block_elements,
-				  rendezvous_vertices, rendezvous_elements );
-
-	// Setup export vertex map.
-	GlobalOrdinal num_vertices = 0;
-	Teuchos::ArrayRCP<GlobalOrdinal> export_vertex_arcp(0,0);
-	if ( mesh_exists )
+    }
+    d_comm->barrier();
+    if ( !permutation_lists.empty() )
+    {
+	Teuchos::broadcast<int,int>( *d_comm, mesh_indexer.l2g(0),
+				     permutation_lists.size(), 
+				     &permutation_lists[0] );
+    }
+
+    // Pack the vertices and elements of all blocks that are going to the
+    // rendezvous decomposition into a single export. Every export has an
+    // ordinal packet { entity type, block id, global ordinal, connectivity }
+    // padded to the largest element and a coordinate packet that is only
+    // filled for vertices.
+    int ordinal_packet_size = 3 + max_vertices_per_element;
+    Teuchos::Array<int> export_procs;
+    Teuchos::Array<GlobalOrdinal> export_ordinal_packets;
+    Teuchos::Array<double> export_coord_packets;
+    Teuchos::RCP<Mesh> current_block;
+    Teuchos::Array<GlobalOrdinal> export_element_indices;
+    Teuchos::Array<int> export_element_procs;
+    Teuchos::Array<GlobalOrdinal> export_vertex_indices;
+    Teuchos::Array<int> export_vertex_procs;
+    for ( int block_id = 0; block_id < num_mesh_blocks && mesh_exists; 
+	  ++block_id )
+    {
+	// Get the destination procs of the block vertices and elements.
+	current_block = mesh_manager->getBlock( block_id );
+	setupImportCommunication( current_block, 
+				  mesh_manager->getActiveElements( block_id ),
+				  export_element_indices, export_element_procs,
+				  export_vertex_indices, export_vertex_procs );
+	d_export_element_indices.insert( d_export_element_indices.end(),
+					 export_element_indices.begin(),
+					 export_element_indices.end() );
+	d_export_element_procs.insert( d_export_element_procs.end(),
+				       export_element_procs.begin(),
+				       export_element_procs.end() );
+
+	GlobalOrdinal num_vertices = 
+	    MeshTools<Mesh>::numVertices( *current_block );
+	GlobalOrdinal num_elements = 
+	    MeshTools<Mesh>::numElements( *current_block );
+	int vertices_per_element = block_descriptions[ 2*block_id + 1 ];
+	Teuchos::ArrayRCP<const GlobalOrdinal> block_vertices = 
+	    MeshTools<Mesh>::verticesView( *current_block );
+	Teuchos::ArrayRCP<const double> block_coords = 
+	    MeshTools<Mesh>::coordsView( *current_block );
+	Teuchos::ArrayRCP<const GlobalOrdinal> block_elements = 
+	    MeshTools<Mesh>::elementsView( *current_block );
+	Teuchos::ArrayRCP<const GlobalOrdinal> block_connectivity = 
+	    MeshTools<Mesh>::connectivityView( *current_block );
+
+	int num_exports = export_procs.size();
+	int num_block_exports = 
+	    export_vertex_procs.size() + export_element_procs.size();
+	export_procs.resize( num_exports + num_block_exports );
+	export_ordinal_packets.resize( 
+	    ordinal_packet_size*(num_exports + num_block_exports), 0 );
+	export_coord_packets.resize( 
+	    d_dimension*(num_exports + num_block_exports), 0.0 );
+
+	// Pack the vertices.
+	GlobalOrdinal vertex_index;
+	int num_vertex_exports = export_vertex_procs.size();
+	for ( int n = 0; n < num_vertex_exports; ++n, ++num_exports )
 	{
-	    num_vertices = MeshTools<Mesh>::numVertices( *current_block );
-	    export_vertex_arcp = 
-		MeshTools<Mesh>::verticesNonConstView( *current_block );
+	    vertex_index = export_vertex_indices[n];
+	    export_procs[ num_exports ] = export_vertex_procs[n];
+	    export_ordinal_packets[ ordinal_packet_size*num_exports ] = 0;
+	    export_ordinal_packets[ ordinal_packet_size*num_exports + 1 ] = 
+		block_id;
+	    export_ordinal_packets[ ordinal_packet_size*num_exports + 2 ] = 
+		block_vertices[ vertex_index ];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		export_coord_packets[ d_dimension*num_exports + d ] =
+		    block_coords[ d*num_vertices + vertex_index ];
+	    }
 	}
-	d_comm->barrier();
-	Teuchos::ArrayView<const GlobalOrdinal> export_vertex_view 
-	    = export_vertex_arcp();
-	RCP_TpetraMap export_vertex_map = 
-    Tpetra::createNonContigMap<int,GlobalOrdinal>( 
-		export_vertex_view, d_comm );
-	testInvariant( !export_vertex_map.is_null() );
-
-	// Setup import vertex map.
-	Teuchos::ArrayView<const GlobalOrdinal> rendezvous_vertices_view = 
-	    rendezvous_vertices();
-	RCP_TpetraMap import_vertex_map = 
-    Tpetra::createNonContigMap<int,GlobalOrdinal>(
-		rendezvous_vertices_view, d_comm );
-	testInvariant( !import_vertex_map.is_null() );
-
-	// Setup export element map.
-	GlobalOrdinal num_elements = 0;
-	Teuchos::ArrayRCP<GlobalOrdinal> export_element_arcp(0,0);
-	if ( mesh_exists )
+
+	// Pack the elements.
+	GlobalOrdinal element_index;
+	int num_element_exports = export_element_procs.size();
+	for ( int n = 0; n < num_element_exports; ++n, ++num_exports )
 	{
-	    num_elements = MeshTools<Mesh>::numElements( *current_block );
-	    export_element_arcp =
-		MeshTools<Mesh>::elementsNonConstView( *current_block );
+	    element_index = export_element_indices[n];
+	    export_procs[ num_exports ] = export_element_procs[n];
+	    export_ordinal_packets[ ordinal_packet_size*num_exports ] = 1;
+	    export_ordinal_packets[ ordinal_packet_size*num_exports + 1 ] = 
+		block_id;
+	    export_ordinal_packets[ ordinal_packet_size*num_exports + 2 ] = 
+		block_elements[ element_index ];
+	    for ( int i = 0; i < vertices_per_element; ++i )
+	    {
+		export_ordinal_packets[ 
+		    ordinal_packet_size*num_exports + 3 + i ] =
+		    block_connectivity[ i*num_elements + element_index ];
+	    }
 	}
-	d_comm->barrier();
-	Teuchos::ArrayView<const GlobalOrdinal> export_element_view = 
-	    export_element_arcp();
-	RCP_TpetraMap export_element_map = 
-    Tpetra::createNonContigMap<int,GlobalOrdinal>(
-		export_element_view, d_comm );
-	testInvariant( !export_element_map.is_null() );
-
-	// Setup import element map.
-	Teuchos::ArrayView<const GlobalOrdinal> rendezvous_elements_view =
-	    rendezvous_elements();
-	RCP_TpetraMap import_element_map = 
-    Tpetra::createNonContigMap<int,GlobalOrdinal>(
-		rendezvous_elements_view, d_comm );
-	testInvariant( !import_element_map.is_null() );
-
-	// Setup importers.
-	Tpetra::Import<int,GlobalOrdinal> vertex_importer( export_vertex_map, 
-						       import_vertex_map );
-	Tpetra::Import<int,GlobalOrdinal> element_importer( export_element_map, 
-							import_element_map );
-
-	// Move the vertex coordinates to the rendezvous decomposition.
-	Teuchos::ArrayRCP<double> export_coords_view(0,0);
-	if ( mesh_exists )
+    }
+    d_comm->barrier();
+    export_element_indices.clear();
+    export_element_procs.clear();
+    export_vertex_indices.clear();
+    export_vertex_procs.clear();
+
+    // Move the mesh to the rendezvous decomposition through an inverse
+    // communication operation.
+    Tpetra::Distributor distributor( d_comm );
+    Teuchos::ArrayView<const int> export_procs_view = export_procs();
+    int num_imports = distributor.createFromSends( export_procs_view );
+    Teuchos::ArrayView<const GlobalOrdinal> export_ordinal_packets_view =
+	export_ordinal_packets();
+    Teuchos::Array<GlobalOrdinal> import_ordinal_packets( 
+	ordinal_packet_size*num_imports );
+    distributor.doPostsAndWaits( export_ordinal_packets_view, 
+				 ordinal_packet_size,
+				 import_ordinal_packets() );
+    export_ordinal_packets.clear();
+    Teuchos::ArrayView<const double> export_coord_packets_view =
+	export_coord_packets();
+    Teuchos::Array<double> import_coord_packets( d_dimension*num_imports );
+    distributor.doPostsAndWaits( export_coord_packets_view, 
+				 d_dimension,
+				 import_coord_packets() );
+    export_coord_packets.clear();
+    export_procs.clear();
+
+    // Extract the import source procs from the distributor.
+    Teuchos::ArrayView<const int> from_images = distributor.getImagesFrom();
+    Teuchos::ArrayView<const std::size_t> from_lengths = 
+	distributor.getLengthsFrom();
+    Teuchos::Array<int> import_src_procs;
+    import_src_procs.reserve( num_imports );
+    for ( int i = 0; i < (int) from_images.size(); ++i )
+    {
+	for ( std::size_t j = 0; j < from_lengths[i]; ++j )
 	{
-	    export_coords_view =
-		MeshTools<Mesh>::coordsNonConstView( *current_block );
+	    import_src_procs.push_back( from_images[i] );
 	}
-	d_comm->barrier();
-	Teuchos::RCP< Tpetra::MultiVector<double,int,GlobalOrdinal> > 
-	    export_coords = Tpetra::createMultiVectorFromView( 
-		export_vertex_map, export_coords_view, 
-		num_vertices, d_dimension );
-	Tpetra::MultiVector<double,int,GlobalOrdinal> 
-	    import_coords( import_vertex_map, d_dimension );
-	import_coords.doImport( 
-	    *export_coords, vertex_importer, Tpetra::INSERT );
-
-	// Move the element connectivity to the rendezvous decomposition.
-	int vertices_per_element;
-	if ( mesh_exists )
+    }
+    testInvariant( Teuchos::as<int>(import_src_procs.size()) == num_imports );
+
+    // Sort the imports by block, entity type, and global ordinal. Sorting
+    // with the import position keeps the first copy of each entity that was
+    // received first in each group.
+    typedef std::pair<GlobalOrdinal,int> OrdinalPosition;
+    Teuchos::Array<std::pair<std::pair<int,int>,OrdinalPosition> > 
+	import_keys( num_imports );
+    for ( int n = 0; n < num_imports; ++n )
+    {
+	import_keys[n] = std::make_pair( 
+	    std::make_pair( 
+		Teuchos::as<int>(
+		    import_ordinal_packets[ ordinal_packet_size*n + 1 ]),
+		Teuchos::as<int>(
+		    import_ordinal_packets[ ordinal_packet_size*n ]) ),
+	    OrdinalPosition( 
+		import_ordinal_packets[ ordinal_packet_size*n + 2 ], n ) );
+    }
+    std::sort( import_keys.begin(), import_keys.end() );
+
+    // Build the rendezvous mesh blocks directly from the unique imports.
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshContainerType> >
+	rendezvous_block_containers( num_mesh_blocks );
+    int group_begin = 0;
+    int group_end = 0;
+    for ( int block_id = 0; block_id < num_mesh_blocks; ++block_id )
+    {
+	int vertices_per_element = block_descriptions[ 2*block_id + 1 ];
+
+	// Unpack the unique block vertices and coordinates.
+	group_begin = group_end;
+	int num_vertices = 0;
+	for ( group_end = group_begin;
+	      group_end < num_imports &&
+		  import_keys[group_end].first == std::make_pair(block_id,0);
+	      ++group_end )
 	{
-	    vertices_per_element = MT::verticesPerElement( *current_block );
+	    if ( group_end == group_begin || 
+		 import_keys[group_end].second.first != 
+		 import_keys[group_end-1].second.first )
+	    {
+		++num_vertices;
+	    }
 	}
-	d_comm->barrier();
-	Teuchos::broadcast<int,int>( *d_comm, mesh_indexer.l2g(0),
-				     Teuchos::Ptr<int>(&vertices_per_element) );
-
-	Teuchos::ArrayRCP<GlobalOrdinal> export_conn_view(0,0);
-	if ( mesh_exists ) 
+	Teuchos::ArrayRCP<GlobalOrdinal> rendezvous_vertices( num_vertices );
+	Teuchos::ArrayRCP<double> rendezvous_coords( 
+	    d_dimension*num_vertices );
+	int v = 0;
+	for ( int n = group_begin; n < group_end; ++n )
 	{
-	    export_conn_view =
-		MeshTools<Mesh>::connectivityNonConstView( *current_block );
+	    if ( n == group_begin || 
+		 import_keys[n].second.first != import_keys[n-1].second.first )
+	    {
+		rendezvous_vertices[v] = import_keys[n].second.first;
+		for ( int d = 0; d < d_dimension; ++d )
+		{
+		    rendezvous_coords[ d*num_vertices + v ] = 
+			import_coord_packets[ 
+			    d_dimension*import_keys[n].second.second + d ];
+		}
+		++v;
+	    }
 	}
-	d_comm->barrier();
-	Teuchos::RCP<Tpetra::MultiVector<GlobalOrdinal,int,GlobalOrdinal> > 
-	    export_conn = Tpetra::createMultiVectorFromView( 
-		export_element_map, export_conn_view, 
-		num_elements, vertices_per_element );
-	Tpetra::MultiVector<GlobalOrdinal,int,GlobalOrdinal> import_conn( 
-	    import_element_map, vertices_per_element );
-	import_conn.doImport( *export_conn, element_importer, Tpetra::INSERT );
-
-	// Broadcast the permutation list.
-	Teuchos::ArrayRCP<int> permutation_list(vertices_per_element,0);
-	if ( mesh_exists )
+	d_rendezvous_vertices.insert( d_rendezvous_vertices.end(),
+				      rendezvous_vertices.begin(),
+				      rendezvous_vertices.end() );
+	d_vertex_block_offsets.push_back( d_rendezvous_vertices.size() );
+
+	// Unpack the unique block elements and connectivity and build the
+	// rendezvous mesh element to source proc map.
+	group_begin = group_end;
+	int num_elements = 0;
+	for ( group_end = group_begin;
+	      group_end < num_imports &&
+		  import_keys[group_end].first == std::make_pair(block_id,1);
+	      ++group_end )
 	{
-	    permutation_list = 
-		MeshTools<Mesh>::permutationNonConstView( *current_block );
+	    if ( group_end == group_begin || 
+		 import_keys[group_end].second.first != 
+		 import_keys[group_end-1].second.first )
+	    {
+		++num_elements;
+	    }
 	}
-	d_comm->barrier();
-	Teuchos::broadcast<int,int>( *d_comm, mesh_indexer.l2g(0),
-				     vertices_per_element, 
-				     &permutation_list[0] );
-
-	// broadcast the element topology.
-	int block_topology = 0;
-	if ( mesh_exists )
+	Teuchos::ArrayRCP<GlobalOrdinal> rendezvous_elements( num_elements );
+	Teuchos::ArrayRCP<GlobalOrdinal> rendezvous_connectivity( 
+	    vertices_per_element*num_elements );
+	int e = 0;
+	int position = 0;
+	for ( int n = group_begin; n < group_end; ++n )
 	{
-	    block_topology = 
-		static_cast<int>(MT::elementTopology( *current_block ));
+	    if ( n == group_begin || 
+		 import_keys[n].second.first != import_keys[n-1].second.first )
+	    {
+		position = import_keys[n].second.second;
+		rendezvous_elements[e] = import_keys[n].second.first;
+		for ( int i = 0; i < vertices_per_element; ++i )
+		{
+		    rendezvous_connectivity[ i*num_elements + e ] = 
+			import_ordinal_packets[ 
+			    ordinal_packet_size*position + 3 + i ];
+		}
+		d_element_src_procs_map.insert( 
+		    std::make_pair( rendezvous_elements[e], 
+				    import_src_procs[position] ) );
+		++e;
+	    }
 	}
-	d_comm->barrier();
-	Teuchos::broadcast<int,int>( *d_comm, mesh_indexer.l2g(0),
-				     Teuchos::Ptr<int>(&block_topology) );
 
-	// Construct the mesh block container from the collected data,
+	// Construct the mesh block container from the unpacked data,
 	// effectively wrapping it with mesh traits.
-	Teuchos::ArrayRCP<GlobalOrdinal> 
-	    rendezvous_vertices_array( rendezvous_vertices.size() );
-	std::copy( rendezvous_vertices.begin(), rendezvous_vertices.end(),
-		   rendezvous_vertices_array.begin() );
-	rendezvous_vertices.clear();
-
-	Teuchos::ArrayRCP<GlobalOrdinal> 
-	    rendezvous_elements_array( rendezvous_elements.size() );
-	std::copy( rendezvous_elements.begin(), rendezvous_elements.end(),
-		   rendezvous_elements_array.begin() );
-	rendezvous_elements.clear();
-
+	Teuchos::ArrayRCP<int> permutation_list( vertices_per_element );
+	std::copy( permutation_lists.begin() + permutation_offsets[block_id],
+		   permutation_lists.begin() + permutation_offsets[block_id+1],
+		   permutation_list.begin() );
 	rendezvous_block_containers[ block_id ] = 
 	    Teuchos::rcp( new MeshContainerType( 
 			      d_dimension,
-			      rendezvous_vertices_array,
-			      import_coords.get1dView(),
-			      static_cast<DTK_ElementTopology>(block_topology),
+			      rendezvous_vertices,
+			      rendezvous_coords,
+			      static_cast<DTK_ElementTopology>(
+				  block_descriptions[ 2*block_id ]),
 			      vertices_per_element,
-			      rendezvous_elements_array,
-			      import_conn.get1dView(),
+			      rendezvous_elements,
+			      rendezvous_connectivity,
 			      permutation_list ) );
     }
+    testInvariant( group_end == num_imports );
 
     // Build the rendezvous mesh manager from the rendezvous mesh blocks.
     return MeshManager<MeshContainerType>( rendezvous_block_containers,
@@ -697,95 +1007,75 @@ Rendezvous<Mesh>::sendMeshToRendezvous(
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Setup the import communication patterns for moving mesh from the
- * primary decomposition to the rendezvous decomposition.
+ * \brief Get the destination procs in the rendezvous decomposition of the
+ * vertices and elements of a mesh block.
  *
  * \param mesh The mesh block to setup communication for.
  *
  * \param elements_in_box An array of elements in the rendezvous box. Every
  * element gets an entry, 0 if outside the box, 1 if inside.
  *
- * \param rendezvous_vertices An array of the vertex global ordinals in the
- * rendezvous decomposition.
+ * \param export_element_indices The local indices of the elements to
+ * export. An element has an entry for every destination proc.
+ *
+ * \param export_element_procs The destination procs of the exported
+ * elements.
  *
- * \param rendezvous_elements An array of the element global ordinals in the
- * rendezvous decomposition.
+ * \param export_vertex_indices The local indices of the vertices to
+ * export. A vertex has an entry for every destination proc.
+ *
+ * \param export_vertex_procs The destination procs of the exported
+ * vertices.
  */
 template<class Mesh>
 void Rendezvous<Mesh>::setupImportCommunication( 
     const Teuchos::RCP<Mesh>& mesh,
     const Teuchos::ArrayView<short int>& elements_in_box,
-    Teuchos::Array<GlobalOrdinal>& rendezvous_vertices,
-    Teuchos::Array<GlobalOrdinal>& rendezvous_elements )
+    Teuchos::Array<GlobalOrdinal>& export_element_indices,
+    Teuchos::Array<int>& export_element_procs,
+    Teuchos::Array<GlobalOrdinal>& export_vertex_indices,
+    Teuchos::Array<int>& export_vertex_procs )
 {
-    // Set a value for mesh existence.
-    bool mesh_exists = true;
-    if ( mesh.is_null() ) mesh_exists = false;
+    testPrecondition( !mesh.is_null() );
 
-    // Create a vertex index map for logarithmic time access to connectivity
-    // data. 
-    typename MT::const_vertex_iterator export_vertex_iterator;
-    std::map<GlobalOrdinal,GlobalOrdinal> vertex_indices;
-    GlobalOrdinal array_index = 0;
-    if ( mesh_exists )
-    {
-	for ( export_vertex_iterator = MT::verticesBegin( *mesh );
-	      export_vertex_iterator != MT::verticesEnd( *mesh );
-	      ++export_vertex_iterator )
-	{
-	    vertex_indices[ *export_vertex_iterator ] = array_index;
-	    ++array_index;
-	}
-    }
-    d_comm->barrier();
+    export_element_indices.clear();
+    export_element_procs.clear();
+    export_vertex_indices.clear();
+    export_vertex_procs.clear();
 
-    // Create a element index map for logarithmic time access to connectivity
-    // data. 
-    typename MT::const_element_iterator export_element_iterator;
-    std::map<GlobalOrdinal,GlobalOrdinal> element_indices;
-    array_index = 0;
-    if ( mesh_exists )
-    {
-	for ( export_element_iterator = MT::elementsBegin( *mesh );
-	      export_element_iterator != MT::elementsEnd( *mesh );
-	      ++export_element_iterator )
-	{
-	    element_indices[ *export_element_iterator ] = array_index;
-	    ++array_index;
-	}
-    }
-    d_comm->barrier();
+    // Index the vertex global ordinals by their location in the array for
+    // access to connectivity data.
+    OrdinalIndex<GlobalOrdinal> vertex_indices( 
+	MeshTools<Mesh>::verticesView( *mesh )() );
 
     // Get destination procs for all local elements in the global bounding
     // box. The element will need to be sent to each partition that its
-    // connecting vertices exist in. We'll make a unique destination proc set
-    // for each element.
-    GlobalOrdinal num_vertices = 0;
-    GlobalOrdinal num_elements = 0;
-    int vertices_per_element = 0;
-    if ( mesh_exists )
-    {
-	num_vertices = MeshTools<Mesh>::numVertices( *mesh );
-	num_elements = MeshTools<Mesh>::numElements( *mesh );
-	vertices_per_element = MT::verticesPerElement( *mesh );
-    }
-    d_comm->barrier();
-
-    Teuchos::Array< std::set<int> > export_element_procs_set( num_elements );
+    // connecting vertices exist in. Elements rarely span more than a few
+    // partitions so the unique destination procs of each element are found
+    // by sorting its short list of vertex destinations.
+    GlobalOrdinal num_elements = MeshTools<Mesh>::numElements( *mesh );
+    int vertices_per_element = MT::verticesPerElement( *mesh );
+    Teuchos::ArrayRCP<const double> mesh_coords = 
+	MeshTools<Mesh>::coordsView( *mesh );
+    Teuchos::ArrayRCP<const GlobalOrdinal> mesh_connectivity = 
+	MeshTools<Mesh>::connectivityView( *mesh );
+
+    // Locate all of the vertices in the rendezvous decomposition at once.
+    // Vertices are shared by several elements so this is cheaper than
+    // locating the vertices of each element.
+    Teuchos::Array<int> vertex_procs;
+    d_partitioner->getPointDestinationProcs( mesh_coords(), vertex_procs );
+
+    // The vertices of each element will go to the same destinations so their
+    // destinations are collected at the same time as (vertex index, proc)
+    // pairs.
     GlobalOrdinal vertex_index;
     GlobalOrdinal vertex_ordinal;
-    int destination_proc;
-    Teuchos::Array<double> vertex_coords( d_dimension );
-
-    Teuchos::ArrayRCP<double> mesh_coords(0,0);
-    Teuchos::ArrayRCP<GlobalOrdinal> mesh_connectivity(0,0);
-    if ( mesh_exists )
-    {
-	mesh_coords = MeshTools<Mesh>::coordsNonConstView( *mesh );
-	mesh_connectivity = MeshTools<Mesh>::connectivityNonConstView( *mesh );
-    }
-    d_comm->barrier();
-
+    Teuchos::Array<std::pair<GlobalOrdinal,int> > export_vertex_index_procs;
+    Teuchos::Array<GlobalOrdinal> element_vertex_indices( vertices_per_element );
+    Teuchos::Array<int> element_procs( vertices_per_element );
+    Teuchos::Array<int>::iterator element_procs_end;
+    Teuchos::Array<int>::const_iterator element_procs_iterator;
     for ( GlobalOrdinal n = 0; n < num_elements; ++n )
     {
 	if ( elements_in_box[n] )
@@ -793,187 +1083,57 @@ void Rendezvous<Mesh>::setupImportCommunication(
 	    for ( int i = 0; i < vertices_per_element; ++i )
 	    {
 		vertex_ordinal = mesh_connectivity[ i*num_elements + n ];
-		vertex_index = vertex_indices.find( vertex_ordinal )->second;
-		for ( int d = 0; d < d_dimension; ++d )
-		{
-		    vertex_coords[d] = 
-			mesh_coords[ d*num_vertices + vertex_index ];
-		}
-		destination_proc = 
-		    d_partitioner->getPointDestinationProc( vertex_coords );
-		export_element_procs_set[n].insert( destination_proc );
+		vertex_index = vertex_indices.index( vertex_ordinal );
+		element_vertex_indices[i] = vertex_index;
+		element_procs[i] = vertex_procs[ vertex_index ];
 	    }
-	}
-    }
 
-    // Unroll the vector of sets into two vectors; one containing the element
-    // ordinal and the other containing the corresponding element destination.
-    Teuchos::Array<GlobalOrdinal> export_elements;
-    Teuchos::Array<int> export_element_procs;
-    typename MT::const_element_iterator element_iterator;
-    Teuchos::Array< std::set<int> >::const_iterator element_vec_iterator;
-    std::set<int>::const_iterator element_proc_set_iterator;
-    if ( mesh_exists )
-    {
-	for ( element_vec_iterator = export_element_procs_set.begin(),
-		  element_iterator = MT::elementsBegin( *mesh );
-	      element_vec_iterator != export_element_procs_set.end();
-	      ++element_vec_iterator, ++element_iterator )
-	{
-	    for ( element_proc_set_iterator = element_vec_iterator->begin();
-		  element_proc_set_iterator != element_vec_iterator->end();
-		  ++element_proc_set_iterator )
+	    std::sort( element_procs.begin(), element_procs.end() );
+	    element_procs_end = 
+		std::unique( element_procs.begin(), element_procs.end() );
+	    for ( element_procs_iterator = element_procs.begin();
+		  element_procs_iterator != element_procs_end;
+		  ++element_procs_iterator )
 	    {
-		export_elements.push_back( *element_iterator );
-		export_element_procs.push_back( *element_proc_set_iterator );
+		export_element_indices.push_back( n );
+		export_element_procs.push_back( *element_procs_iterator );
+		for ( int i = 0; i < vertices_per_element; ++i )
+		{
+		    export_vertex_index_procs.push_back( 
+			std::make_pair( element_vertex_indices[i], 
+					*element_procs_iterator ) );
+		}
 	    }
 	}
     }
-    d_comm->barrier();
-
-    export_element_procs_set.clear();
-
-    // Now we know where the elements need to go. Move the elements to the
-    // rendezvous decomposition through an inverse communciation operation.
-    Tpetra::Distributor element_distributor( d_comm );
-    Teuchos::ArrayView<int> export_element_procs_view = export_element_procs();
-    GlobalOrdinal num_import_elements = element_distributor.createFromSends(
-	export_element_procs_view );
-    Teuchos::ArrayView<const GlobalOrdinal> export_elements_view =
-	export_elements();
-    Teuchos::Array<GlobalOrdinal> import_elements( num_import_elements );
-    Teuchos::ArrayView<GlobalOrdinal> import_elements_view = import_elements();
-    element_distributor.doPostsAndWaits( export_elements_view, 1, 
-					 import_elements_view );
-    
-    // Extract the rendezvous element source procs from the distributor.
-    Teuchos::ArrayView<const int> from_images = 
-	element_distributor.getImagesFrom();
-    Teuchos::ArrayView<const std::size_t> from_lengths = 
-	element_distributor.getLengthsFrom();
-    Teuchos::Array<int> element_src_procs;
-    for ( int i = 0; i < (int) from_images.size(); ++i )
-    {
-	for ( std::size_t j = 0; j < from_lengths[i]; ++j )
-	{
-	    element_src_procs.push_back( from_images[i] );
-	}
-    }
-    testInvariant( Teuchos::as<GlobalOrdinal>(element_src_procs.size())
-		   == num_import_elements );
-        
-    // Next, move these into the rendezvous element set so that we have a
-    // unique list of the elements and build the rendezvous mesh element to
-    // source proc map.
-    std::set<GlobalOrdinal> rendezvous_elements_set;
-    for ( GlobalOrdinal n = 0; n < num_import_elements; ++n )
-    {
-	if ( rendezvous_elements_set.insert( import_elements[n] ).second )
-	{
-	    d_element_src_procs_map[ import_elements[n] ] = 
-		element_src_procs[n];
-	}
-    }
-    import_elements.clear();
-    element_src_procs.clear();
-
-    // Finally put the elements in a Teuchos::Array and get rid of the set.
-    rendezvous_elements.resize( rendezvous_elements_set.size() );
-    std::copy( rendezvous_elements_set.begin(), rendezvous_elements_set.end(),
-	       rendezvous_elements.begin() );
-    rendezvous_elements_set.clear();
 
     // Now get the destination procs for all the vertices. This will be the
     // same destination procs as all of their parent elements. Therefore,
     // vertices may then also have to go to multiple procs because of this and
     // these procs may be different than their original rendezvous procs.
-    GlobalOrdinal element_index;
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator 
-	export_elements_iterator;
-    Teuchos::Array<int>::const_iterator export_element_procs_iterator;
-    Teuchos::Array< std::set<int> > export_vertex_procs_set( num_vertices );
-    for ( export_elements_iterator = export_elements.begin(),
-     export_element_procs_iterator = export_element_procs.begin();
-	  export_elements_iterator != export_elements.end();
-	  ++export_elements_iterator, ++export_element_procs_iterator )
-    {
-	element_index = 
-	    element_indices.find( *export_elements_iterator )->second;
-
-	for ( int i = 0; i < vertices_per_element; ++i )
-	{
-	    vertex_ordinal = 
-		mesh_connectivity[ i*num_elements + element_index ];
-	    vertex_index = vertex_indices.find( vertex_ordinal )->second;
-
-	    export_vertex_procs_set[ vertex_index ].insert( 
-		*export_element_procs_iterator );
-	}
-    }
-    export_elements.clear();    
-    export_element_procs.clear();
-    vertex_indices.clear();
-    element_indices.clear();
-
-    // Unroll the vector of sets into two vectors; one containing the vertex
-    // ordinal and the other containing the corresponding vertex destination.
-    Teuchos::Array<GlobalOrdinal> export_vertices;
-    Teuchos::Array<int> export_vertex_procs;
-    Teuchos::Array< std::set<int> >::const_iterator vertex_vec_iterator;
-    std::set<int>::const_iterator vertex_proc_set_iterator;
-    if ( mesh_exists )
+    // Sorting the (vertex index, proc) pairs gives the unique destinations of
+    // each vertex in vertex order.
+    std::sort( export_vertex_index_procs.begin(), 
+	       export_vertex_index_procs.end() );
+    typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::iterator 
+	export_vertex_index_procs_end = 
+	std::unique( export_vertex_index_procs.begin(), 
+		     export_vertex_index_procs.end() );
+
+    // Unroll the pairs into two vectors; one containing the vertex index and
+    // the other containing the corresponding vertex destination.
+    typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::const_iterator 
+	export_vertex_index_procs_iterator;
+    for ( export_vertex_index_procs_iterator = 
+	      export_vertex_index_procs.begin();
+	  export_vertex_index_procs_iterator != export_vertex_index_procs_end;
+	  ++export_vertex_index_procs_iterator )
     {
-	for ( vertex_vec_iterator = export_vertex_procs_set.begin(),
-	   export_vertex_iterator = MT::verticesBegin( *mesh );
-	      vertex_vec_iterator != export_vertex_procs_set.end();
-	      ++vertex_vec_iterator, ++export_vertex_iterator )
-	{
-	    for ( vertex_proc_set_iterator = vertex_vec_iterator->begin();
-		  vertex_proc_set_iterator != vertex_vec_iterator->end();
-		  ++vertex_proc_set_iterator )
-	    {
-		export_vertices.push_back( *export_vertex_iterator );
-		export_vertex_procs.push_back( *vertex_proc_set_iterator );
-	    }
-	}
+	export_vertex_indices.push_back( 
+	    export_vertex_index_procs_iterator->first );
+	export_vertex_procs.push_back( 
+	    export_vertex_index_procs_iterator->second );
     }
-    d_comm->barrier();
-
-    export_vertex_procs_set.clear();
-
-    // Now we know where the vertices need to go. Move the vertices to the
-    // rendezvous decomposition through an inverse communciation operation.
-    Tpetra::Distributor vertex_distributor( d_comm );
-    Teuchos::ArrayView<int> export_vertex_procs_view = export_vertex_procs();
-    GlobalOrdinal num_import_vertices = vertex_distributor.createFromSends(
-	export_vertex_procs_view );
-    Teuchos::ArrayView<const GlobalOrdinal> export_vertices_view = 
-	export_vertices();
-    Teuchos::Array<GlobalOrdinal> import_vertices( num_import_vertices );
-    Teuchos::ArrayView<GlobalOrdinal> import_vertices_view = import_vertices();
-    vertex_distributor.doPostsAndWaits( export_vertices_view, 1, 
-					import_vertices_view );
-    export_vertices.clear();
-    export_vertex_procs.clear();
-
-    // Next move these into the rendezvous vertex set so that we have a unique
-    // list of the vertices.
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator 
-	import_vertex_iterator;
-    std::set<GlobalOrdinal> rendezvous_vertices_set;
-    for ( import_vertex_iterator = import_vertices.begin();
-	  import_vertex_iterator != import_vertices.end();
-	  ++import_vertex_iterator )
-    {
-	rendezvous_vertices_set.insert( *import_vertex_iterator );
-    }
-    import_vertices.clear();
-
-    // Finally put the vertices in a Teuchos::Array and get rid of the set.
-    rendezvous_vertices.resize( rendezvous_vertices_set.size() );
-    std::copy( rendezvous_vertices_set.begin(), rendezvous_vertices_set.end(),
-	       rendezvous_vertices.begin() );
-    rendezvous_vertices_set.clear();
 }
 
 //---------------------------------------------------------------------------//
@@ -45,8 +45,11 @@ namespace DataTransferKit
 //---------------------------------------------------------------------------//
 /*!
  * \brief Constructor.
+ *
+ * \param dimension The dimension of the partitioned space.
  */
-SerialPartitioner::SerialPartitioner()
+SerialPartitioner::SerialPartitioner( const int dimension )
+    : d_dimension( dimension )
 { /* ... */ }
 
 //---------------------------------------------------------------------------//
@@ -68,7 +71,7 @@ void SerialPartitioner::partition()
  * \brief Get the destination process for a point given its coordinates.
  */
 int SerialPartitioner::getPointDestinationProc( 
-    Teuchos::Array<double> coords ) const
+    const Teuchos::Array<double>& coords ) const
 {
     return 0;
 }
@@ -83,6 +86,28 @@ Teuchos::Array<int> SerialPartitioner::getBoxDestinationProcs(
     return Teuchos::Array<int>(1,0);
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a blocked list of points.
+ */
+void SerialPartitioner::getPointDestinationProcs( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<int>& procs ) const
+{
+    procs.assign( coords.size() / d_dimension, 0 );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a list of bounding boxes.
+ */
+void SerialPartitioner::getBoxDestinationProcs( 
+    const Teuchos::Array<BoundingBox>& boxes,
+    Teuchos::Array<Teuchos::Array<int> >& procs ) const
+{
+    procs.assign( boxes.size(), Teuchos::Array<int>(1,0) );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace DataTransferKit
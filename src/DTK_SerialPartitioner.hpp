@@ -45,6 +45,7 @@
 #include "DTK_BoundingBox.hpp"
 
 #include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
 
 namespace DataTransferKit
 {
@@ -60,7 +61,7 @@ class SerialPartitioner : public Partitioner
   public:
     
     // Constructor.
-    SerialPartitioner();
+    explicit SerialPartitioner( const int dimension );
 
     // Destructor.
     ~SerialPartitioner();
@@ -69,10 +70,25 @@ class SerialPartitioner : public Partitioner
     void partition();
 
     // Get the destination process for a point given its coordinates.
-    int getPointDestinationProc( Teuchos::Array<double> coords ) const;
+    int getPointDestinationProc( const Teuchos::Array<double>& coords ) const;
 
     // Get the destination processes for a bounding box.
     Teuchos::Array<int> getBoxDestinationProcs( const BoundingBox& box ) const;
+
+    // Get the destination processes for a blocked list of points.
+    void getPointDestinationProcs( 
+	const Teuchos::ArrayView<const double>& coords,
+	Teuchos::Array<int>& procs ) const;
+
+    // Get the destination processes for a list of bounding boxes.
+    void getBoxDestinationProcs( 
+	const Teuchos::Array<BoundingBox>& boxes,
+	Teuchos::Array<Teuchos::Array<int> >& procs ) const;
+
+  private:
+
+    // The dimension of the partitioned space.
+    int d_dimension;
 };
 
 } // end namespace DataTransferKit
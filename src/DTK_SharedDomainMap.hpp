@@ -50,6 +50,10 @@
 #include "DTK_MeshManager.hpp"
 #include "DTK_BoundingBox.hpp"
 #include "DTK_CommIndexer.hpp"
+#include "DTK_Partitioner.hpp"
+#include "DTK_PartitionWeights.hpp"
+#include "DTK_Rendezvous.hpp"
+#include "DTK_TransferPlan.hpp"
 
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_Comm.hpp>
@@ -57,10 +61,12 @@
 #include <Teuchos_ArrayRCP.hpp>
 #include <Teuchos_ArrayView.hpp>
 #include <Teuchos_ScalarTraits.hpp>
+#include <Teuchos_any.hpp>
 
 #include <Tpetra_Map.hpp>
 #include <Tpetra_Directory.hpp>
 #include <Tpetra_Export.hpp>
+#include <Tpetra_Import.hpp>
 
 namespace DataTransferKit
 {
@@ -94,6 +100,75 @@ namespace DataTransferKit
  not be valid. However, a list of these points in the target decomposition may
  be generated for further processing by the client.
 
+ If the source and target decompositions are aligned, most target points will
+ be found in the source mesh on their own process. With local search enabled,
+ each process first searches its local source mesh blocks for its local target
+ points and only the points that were not found locally go through the
+ rendezvous decomposition. If every point is found locally the rendezvous
+ decomposition is not built at all and the source-to-target communication in
+ apply() is a local copy.
+
+ For moderate process counts with compact source subdomains the rendezvous
+ decomposition may be skipped altogether with direct search. Each source
+ process publishes the bounding box of its local mesh blocks and the target
+ points are sent to every source process whose box contains them where they
+ are searched for in the local mesh. Points found on more than one source
+ process are mapped to the lowest of those processes.
+
+ If the source mesh moves by a small amount, as with an arbitrary
+ Lagrangian-Eulerian mesh, the map can be updated instead of generated
+ again. Target points that are still in the source element they were mapped
+ to keep their mapping and only the others are searched for again. The
+ rendezvous decomposition is updated with the moved mesh and the kD-tree over
+ the local source mesh is refit rather than either being built again.
+
+ Target points may also be added to or removed from a map that has been
+ generated. Only the added points are searched for and removed points are
+ pruned from the source-to-target communication without any search.
+
+ The map may also be applied in two phases. applyBegin() evaluates the source
+ function and posts the communication without waiting for it and applyEnd()
+ waits for the communication and writes the target space. The client may
+ perform independent computation between the two calls and call
+ applyProgress() during that computation to move large messages.
+
+ Both apply() and the two phase apply move the data with a persistent transfer
+ plan compiled in setup(). The plan reuses its buffers and persistent
+ requests over repeated applies.
+
+ The search already knows which target process owns each point it routes to
+ a source process. In directory-free mode the transfer plan is built directly
+ from that routing and the Tpetra maps and exporter, and therefore the global
+ directory lookups that construct them, are not built at all. The map can
+ then only be applied with the persistent transfer plan and can not be
+ updated or have points added or removed.
+
+ The search maps each target point to the reference frame of the source
+ element it is found in. These reference coordinates are kept with the
+ mapped points and are given to FieldEvaluator::evaluateReference() on every
+ apply such that evaluators that override it do not have to locate the
+ points in their elements again.
+
+ If the source field is a linear Lagrange field defined at the source mesh
+ vertices, the map may instead precompute a sparse interpolation operator in
+ setup(). Each row is a mapped point and holds the shape function values of
+ its source element at its reference coordinates in the columns of the
+ element vertices. applyOperator() then multiplies the source vertex data by
+ the operator and communicates the result without a function evaluation.
+
+ Target points on shared or ghost vertices exist on several processes. If
+ the client gives the global ids of the target points, each unique point is
+ searched for and evaluated once on the lowest process that has it and the
+ result is imported into every copy when the map is applied.
+
+ In iterative coupling most target values change little between applies.
+ applyMasked() only evaluates and sends the target points the client asks
+ for and applyDelta() only sends the evaluations that changed by more than a
+ threshold since they were last sent. Both send the selected values with
+ their position in the communication plan and leave all other target values
+ as they are. The values last sent are kept for each field id given by the
+ client such that several fields may take turns being sent with applyDelta().
+
 */
 //---------------------------------------------------------------------------//
 template<class Mesh, class CoordinateField>
@@ -114,12 +189,16 @@ class SharedDomainMap
     typedef typename CFT::size_type                   CoordOrdinal;
     typedef FieldManager<CoordinateField>             CoordFieldManagerType;
     typedef Teuchos::RCP<CoordFieldManagerType>       RCP_CoordFieldManager;
+    typedef Rendezvous<Mesh>                          RendezvousType;
+    typedef Teuchos::RCP<RendezvousType>              RCP_Rendezvous;
     typedef Teuchos::Comm<int>                        CommType;
     typedef Teuchos::RCP<const CommType>              RCP_Comm;
     typedef Tpetra::Map<int,GlobalOrdinal>            TpetraMap;
     typedef Teuchos::RCP<const TpetraMap>             RCP_TpetraMap;
     typedef Tpetra::Export<int,GlobalOrdinal>         ExportType;
     typedef Teuchos::RCP<ExportType>                  RCP_TpetraExport;
+    typedef Tpetra::Import<int,GlobalOrdinal>         ImportType;
+    typedef Teuchos::RCP<ImportType>                  RCP_TpetraImport;
     //!@}
 
     // Constructor.
@@ -129,11 +208,64 @@ class SharedDomainMap
     // Destructor.
     ~SharedDomainMap();
 
+    // Set partition weights for the rendezvous decomposition.
+    void setPartitionWeights( const Teuchos::RCP<PartitionWeights>& weights );
+
+    // Weight the rendezvous decomposition by the density of target points.
+    void setTargetDensityWeights( const int num_bins = 16 );
+
+    // Set the partitioning algorithm for the rendezvous decomposition.
+    void setPartitionerType( const DTK_PartitionerType type );
+
+    // Use a rendezvous decomposition built by the client.
+    void setRendezvous( const RCP_Rendezvous& rendezvous );
+
+    // Search the local source mesh for the local target points before
+    // going to the rendezvous decomposition.
+    void setLocalSearch( const bool local_search );
+
+    // Route the target points directly to the source processes instead of
+    // building a rendezvous decomposition.
+    void setDirectSearch( const bool direct_search );
+
+    // Move the data in apply() with the persistent transfer plan instead of
+    // Tpetra.
+    void setPersistentTransfer( const bool persistent_transfer );
+
+    // Build the persistent transfer plan directly from the search routing
+    // instead of the Tpetra directory.
+    void setDirectoryFree( const bool directory_free );
+
+    // Precompute a sparse interpolation operator from the source mesh
+    // vertices to the mapped points.
+    void setInterpolationOperator( const bool interpolation_operator );
+
+    // Use global ids for the target points such that a point on several
+    // processes is only mapped once.
+    void setTargetGlobalIds( 
+	const Teuchos::ArrayView<const GlobalOrdinal>& target_ids );
+
     // Generate the shared domain map.
     void setup( const RCP_MeshManager& source_mesh_manager, 
 		const RCP_CoordFieldManager& target_coord_manager,
 		double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
 
+    // Update the shared domain map after the source mesh vertices have
+    // moved.
+    void update( const RCP_MeshManager& source_mesh_manager, 
+		 const RCP_CoordFieldManager& target_coord_manager,
+		 double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Add target points to the shared domain map.
+    void addTargetPoints( 
+	const RCP_MeshManager& source_mesh_manager, 
+	const RCP_CoordFieldManager& target_coord_manager,
+	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Remove target points from the shared domain map.
+    void removeTargetPoints( 
+	const Teuchos::ArrayView<const GlobalOrdinal>& local_indices );
+
     // Apply the shared domain map by evaluating a function at target points
     // that were mapped.
     template<class SourceField, class TargetField>
@@ -141,12 +273,64 @@ class SharedDomainMap
 	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
 	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
 
+    // Apply the shared domain map for several fields with a single
+    // communication.
+    template<class SourceField, class TargetField>
+    void apply( 
+	const Teuchos::Array<Teuchos::RCP<
+	    FieldEvaluator<GlobalOrdinal,SourceField> > >& source_evaluators,
+	const Teuchos::Array<Teuchos::RCP<
+	    FieldManager<TargetField> > >& target_space_managers );
+
+    // Begin applying the shared domain map by evaluating a function at the
+    // target points that were mapped and posting the communication.
+    template<class SourceField, class TargetField>
+    void applyBegin( 
+	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
+
+    // Progress the communication posted by applyBegin().
+    bool applyProgress();
+
+    // Finish applying the shared domain map by completing the communication
+    // and writing the function evaluations into the target space.
+    template<class TargetField>
+    void applyEnd( Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
+
+    // Apply the shared domain map by multiplying the source vertex data by
+    // the interpolation operator.
+    template<class SourceField, class TargetField>
+    void applyOperator( 
+	const Teuchos::RCP<FieldManager<SourceField> >& source_dof_manager,
+	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
+
+    // Apply the shared domain map to the requested target points only.
+    template<class SourceField, class TargetField>
+    void applyMasked( 
+	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager,
+	const Teuchos::ArrayView<const int>& target_mask );
+
+    // Apply the shared domain map by sending only the function evaluations
+    // that changed since they were last sent.
+    template<class SourceField, class TargetField>
+    void applyDelta( 
+	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager,
+	const int field_id,
+	const double threshold );
+
     //@{
     // Get the local indices of the target points that were not mapped.
     Teuchos::ArrayView<GlobalOrdinal>       getMissedTargetPoints();
     Teuchos::ArrayView<const GlobalOrdinal> getMissedTargetPoints() const;
     //@}
 
+    // Get the kD-tree over the local source mesh used by local and direct
+    // search.
+    Teuchos::RCP<const KDTree<GlobalOrdinal> > getLocalTree() const
+    { return d_local_tree; }
+
   private:
 
     // Compute globally unique ordinals for the target points.
@@ -154,13 +338,74 @@ class SharedDomainMap
 	const RCP_CoordFieldManager& target_coord_manager,
 	Teuchos::Array<GlobalOrdinal>& target_ordinals );
 
+    // Get the target points owned by this process.
+    void getOwnedTargetPoints( 
+	const Teuchos::Array<GlobalOrdinal>& target_ordinals,
+	const Teuchos::ArrayRCP<double>& target_coords,
+	Teuchos::Array<GlobalOrdinal>& owned_ordinals,
+	Teuchos::ArrayRCP<double>& owned_coords );
+
+    // Search for target points in the source mesh and build the source map.
+    void mapPoints( const RCP_MeshManager& source_mesh_manager, 
+		    const RCP_CoordFieldManager& target_coord_manager,
+		    const int coord_dim,
+		    const Teuchos::Array<GlobalOrdinal>& point_ordinals,
+		    const Teuchos::ArrayRCP<double>& point_coords,
+		    double tolerance,
+		    Teuchos::Array<GlobalOrdinal>& source_points,
+		    Teuchos::Array<double>& source_coords );
+
+    // Search the local source mesh for the local target points.
+    void localSearch( 
+	const RCP_MeshManager& source_mesh_manager,
+	const Teuchos::ArrayRCP<double>& target_coords,
+	const Teuchos::Array<GlobalOrdinal>& target_ordinals,
+	double tolerance,
+	Teuchos::Array<GlobalOrdinal>& local_points,
+	Teuchos::Array<double>& local_coords,
+	Teuchos::Array<GlobalOrdinal>& search_ordinals,
+	Teuchos::ArrayRCP<double>& search_coords );
+
+    // Search for the target points in the source mesh of the processes
+    // whose local bounding box contains them.
+    void directSearch( 
+	const RCP_MeshManager& source_mesh_manager,
+	const Teuchos::ArrayRCP<double>& target_coords,
+	const Teuchos::Array<GlobalOrdinal>& target_ordinals,
+	double tolerance,
+	Teuchos::Array<GlobalOrdinal>& source_points,
+	Teuchos::Array<double>& source_coords );
+
+    // Build the kD-tree over the local source mesh blocks.
+    void buildLocalTree( const RCP_MeshManager& source_mesh_manager );
+
+    // Refit the kD-tree over the local source mesh blocks to the moved
+    // source mesh.
+    void refitLocalTree( const RCP_MeshManager& source_mesh_manager );
+
     // Get the target points that are in the rendezvous decomposition box.
     void getTargetPointsInBox( 
 	const BoundingBox& box,
-	const CoordinateField& target_coords,
+	const Teuchos::ArrayRCP<double>& target_coords,
 	const Teuchos::Array<GlobalOrdinal>& target_ordinals,
 	Teuchos::Array<GlobalOrdinal>& targets_in_box );
 
+    // Build the source map and the source-to-target exporter.
+    void buildSourceMap( const Teuchos::Array<GlobalOrdinal>& source_points );
+
+    // Index the local source mesh vertices and elements by ordinal.
+    void indexSourceMesh( 
+	const RCP_MeshManager& source_mesh_manager,
+	Teuchos::Array<Teuchos::Array<std::pair<GlobalOrdinal,int> > >& 
+	vertex_tables,
+	Teuchos::Array<std::pair<GlobalOrdinal,int> >& element_table,
+	Teuchos::Array<std::pair<int,GlobalOrdinal> >& element_locations ) 
+	const;
+
+    // Build the interpolation operator for the mapped points.
+    void buildInterpolationOperator( 
+	const RCP_MeshManager& source_mesh_manager );
+
   private:
 
     // Communicator.
@@ -172,6 +417,55 @@ class SharedDomainMap
     // Boolean for storing missed points in the mapping.
     bool d_store_missed_points;
 
+    // User partition weights for the rendezvous decomposition.
+    Teuchos::RCP<PartitionWeights> d_partition_weights;
+
+    // Number of target density histogram bins in each dimension. Zero if
+    // target density weights are not used.
+    int d_density_bins;
+
+    // Rendezvous partitioning algorithm.
+    DTK_PartitionerType d_partitioner_type;
+
+    // Client rendezvous decomposition of the source mesh.
+    RCP_Rendezvous d_rendezvous;
+
+    // Rendezvous decomposition built by this map. Kept such that update()
+    // can move it with the source mesh.
+    RCP_Rendezvous d_search_rendezvous;
+
+    // Boolean for searching the local source mesh before the rendezvous.
+    bool d_local_search;
+
+    // Boolean for routing target points directly to the source processes.
+    bool d_direct_search;
+
+    // Local source mesh blocks searched by local and direct search.
+    Teuchos::RCP<RendezvousMesh<GlobalOrdinal> > d_local_mesh;
+
+    // kD-tree over the local source mesh blocks. Built in setup() and refit
+    // by update().
+    Teuchos::RCP<KDTree<GlobalOrdinal> > d_local_tree;
+
+    // Boolean for moving the data in apply() with the persistent transfer
+    // plan.
+    bool d_persistent_transfer;
+
+    // Boolean for building the transfer plan from the search routing.
+    bool d_directory_free;
+
+    // Boolean for precomputing the interpolation operator.
+    bool d_interpolation_operator;
+
+    // Boolean for target points with client global ids.
+    bool d_target_global_ids;
+
+    // Client global ids of the local target points.
+    Teuchos::Array<GlobalOrdinal> d_target_ids;
+
+    // Number of local target points.
+    GlobalOrdinal d_num_target_points;
+
     // Process indexer for the source application.
     CommIndexer d_source_indexer;
 
@@ -193,11 +487,41 @@ class SharedDomainMap
     // Source-to-target exporter.
     RCP_TpetraExport d_source_to_target_exporter;
 
+    // Source-to-target importer for target points with global ids.
+    RCP_TpetraImport d_source_to_target_importer;
+
+    // Split-phase source-to-target communication plan.
+    Teuchos::RCP<TransferPlan> d_transfer_plan;
+
     // Local source elements.
     Teuchos::Array<GlobalOrdinal> d_source_elements;
 
+    // Target process of the point mapped to each local source element.
+    Teuchos::Array<int> d_source_target_procs;
+
     // Local target coords.
     Teuchos::Array<double> d_target_coords;
+
+    // Local target coords in the reference frame of their source elements.
+    Teuchos::Array<double> d_reference_coords;
+
+    // Number of local source vertices in the interpolation operator
+    // columns.
+    int d_num_source_dofs;
+
+    // Interpolation operator row offsets.
+    Teuchos::Array<int> d_operator_offsets;
+
+    // Interpolation operator column indices.
+    Teuchos::Array<int> d_operator_columns;
+
+    // Interpolation operator values.
+    Teuchos::Array<double> d_operator_values;
+
+    // Function values last sent by applyDelta() keyed by the client field
+    // id. Each entry holds an array of the source field value type. Empty if
+    // the target does not hold the values sent by applyDelta().
+    std::map<int,Teuchos::any> d_sent_values;
 };
 
 } // end namespace DataTransferKit
@@ -42,12 +42,21 @@
 #define DTK_SHAREDDOMAINMAP_DEF_HPP
 
 #include <algorithm>
+#include <numeric>
+#include <cmath>
 #include <limits>
+#include <utility>
+#include <typeinfo>
 
 #include "DTK_FieldTools.hpp"
+#include "DTK_FieldTransferTools.hpp"
 #include "DTK_Assertion.hpp"
-#include "DTK_Rendezvous.hpp"
+#include "DTK_RendezvousMesh.hpp"
+#include "DTK_KDTree.hpp"
+#include "DTK_BoxRouter.hpp"
 #include "DTK_MeshTools.hpp"
+#include "DTK_TargetDensityWeights.hpp"
+#include "DTK_TopologyTools.hpp"
 
 #include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_as.hpp>
@@ -80,6 +89,16 @@ SharedDomainMap<Mesh,CoordinateField>::SharedDomainMap(
     : d_comm( comm )
     , d_dimension( dimension )
     , d_store_missed_points( store_missed_points )
+    , d_density_bins( 0 )
+    , d_partitioner_type( DTK_RCB_PARTITIONER )
+    , d_local_search( false )
+    , d_direct_search( false )
+    , d_persistent_transfer( true )
+    , d_directory_free( false )
+    , d_interpolation_operator( false )
+    , d_target_global_ids( false )
+    , d_num_target_points( 0 )
+    , d_num_source_dofs( 0 )
 { /* ... */ }
 
 //---------------------------------------------------------------------------//
@@ -90,6 +109,196 @@ template<class Mesh, class CoordinateField>
 SharedDomainMap<Mesh,CoordinateField>::~SharedDomainMap()
 { /* ... */ }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set partition weights for the rendezvous decomposition. The
+ * rendezvous partitioning will balance the sum of the source vertex weights
+ * on each process instead of the number of source vertices. Must be called
+ * before setup() to take effect.
+ *
+ * \param weights The source vertex weights. A null RCP restores the
+ * unweighted partitioning.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setPartitionWeights( 
+    const Teuchos::RCP<PartitionWeights>& weights )
+{
+    d_partition_weights = weights;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Weight the rendezvous decomposition by the density of target
+ * points. The source vertices will be weighted from a histogram of the target
+ * points in the shared domain such that the rendezvous partitioning balances
+ * the point search work instead of the source mesh storage. This takes
+ * precedence over weights set with setPartitionWeights(). Must be called
+ * before setup() to take effect.
+ *
+ * \param num_bins The number of histogram bins in each dimension. Zero
+ * disables target density weights.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setTargetDensityWeights( 
+    const int num_bins )
+{
+    testPrecondition( 0 <= num_bins );
+    d_density_bins = num_bins;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the partitioning algorithm for the rendezvous decomposition. RCB
+ * is used by default. Must be called before setup() to take effect.
+ *
+ * \param type The rendezvous partitioning algorithm.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setPartitionerType( 
+    const DTK_PartitionerType type )
+{
+    d_partitioner_type = type;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Use a rendezvous decomposition built by the client instead of
+ * building one in setup(). The same rendezvous decomposition may be used by
+ * several maps with the same source mesh such that it is only built
+ * once. The partition weights and partitioner type of this map are not used
+ * with a client rendezvous decomposition. Must be called before setup() to
+ * take effect.
+ *
+ * \param rendezvous A rendezvous decomposition built with the source mesh
+ * over the communicator of this map. Its box should bound the shared domain
+ * of the source and target. A null RCP restores building the rendezvous
+ * decomposition in setup().
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setRendezvous( 
+    const RCP_Rendezvous& rendezvous )
+{
+    testPrecondition( rendezvous.is_null() || 
+		      !rendezvous->getMesh().is_null() );
+    d_rendezvous = rendezvous;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Search the local source mesh for the local target points before
+ * going to the rendezvous decomposition. Only the target points not found in
+ * the source mesh blocks on their own process will be sent to the rendezvous
+ * decomposition. This is beneficial when the source and target
+ * decompositions are aligned. Must be called before setup() to take effect.
+ *
+ * \param local_search Set to true to enable local search. The default is
+ * false.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setLocalSearch( 
+    const bool local_search )
+{
+    d_local_search = local_search;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Route the target points directly to the source processes whose
+ * local mesh bounding box contains them instead of building a rendezvous
+ * decomposition. This avoids moving the source mesh and is beneficial for
+ * moderate process counts with compact source subdomains. If local search is
+ * also enabled only the points not found locally are routed. Must be called
+ * before setup() to take effect.
+ *
+ * \param direct_search Set to true to enable direct search. The default is
+ * false.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setDirectSearch( 
+    const bool direct_search )
+{
+    d_direct_search = direct_search;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move the data in apply() with the persistent transfer plan compiled
+ * in setup() instead of the Tpetra exporter. The transfer plan reuses its
+ * buffers and persistent requests over repeated applies. The Tpetra path is
+ * kept for comparison. May be called at any time between applies.
+ *
+ * \param persistent_transfer Set to false to move the data with Tpetra. The
+ * default is true.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setPersistentTransfer( 
+    const bool persistent_transfer )
+{
+    d_persistent_transfer = persistent_transfer;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the persistent transfer plan directly from the routing of the
+ * target points in the search. Each point found in the source mesh carries
+ * the process of the target point with it to the source process so the
+ * target process of each mapped point is known without the Tpetra
+ * directory. The Tpetra maps and exporter are not built. A map generated in
+ * this mode can only be applied with the persistent transfer plan and can not
+ * be updated or have points added or removed. Must be called before setup().
+ *
+ * \param directory_free Set to true to build the transfer plan from the
+ * search routing. The default is false.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setDirectoryFree( 
+    const bool directory_free )
+{
+    d_directory_free = directory_free;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Precompute a sparse interpolation operator from the source mesh
+ * vertices to the mapped points. The operator is built from the linear
+ * Lagrange shape functions of the source elements at the reference
+ * coordinates of the mapped points whenever the points are mapped. The
+ * source mesh blocks must have shape functions. Must be called before
+ * setup().
+ *
+ * \param interpolation_operator Set to true to build the interpolation
+ * operator. The default is false.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setInterpolationOperator( 
+    const bool interpolation_operator )
+{
+    d_interpolation_operator = interpolation_operator;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Use global ids for the target points. Points with the same global
+ * id on several processes, such as points on shared or ghost mesh vertices,
+ * are the same point. Each unique point is searched for and evaluated once
+ * on the lowest process that has it and the result is imported into every
+ * copy of the point when the map is applied. A map generated with target
+ * global ids can not be directory-free and can not be updated or have points
+ * added or removed. Must be called on all processes before setup().
+ *
+ * \param target_ids The global ids of the local target points in the order
+ * of the target coordinates given to setup(). The ids must be unique on each
+ * process. An empty view is a valid argument on processes without target
+ * points.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::setTargetGlobalIds( 
+    const Teuchos::ArrayView<const GlobalOrdinal>& target_ids )
+{
+    d_target_global_ids = true;
+    d_target_ids.assign( target_ids.begin(), target_ids.end() );
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Generate the shared domain map.
@@ -115,6 +324,8 @@ void SharedDomainMap<Mesh,CoordinateField>::setup(
     const RCP_CoordFieldManager& target_coord_manager,
     double tolerance )
 {
+    testPrecondition( !(d_target_global_ids && d_directory_free) );
+
     // Create existence values for the managers.
     bool source_exists = true;
     if ( source_mesh_manager.is_null() ) source_exists = false;
@@ -151,52 +362,29 @@ void SharedDomainMap<Mesh,CoordinateField>::setup(
     }
     d_comm->barrier();
 
-    // Compute a unique global ordinal for each point in the coordinate field.
+    // Compute a global ordinal for each point in the coordinate field. Copies
+    // of a point with a client global id on other processes have the same
+    // ordinal.
     Teuchos::Array<GlobalOrdinal> target_ordinals;
     computePointOrdinals( target_coord_manager, target_ordinals );
-
-    // Build the data import map from the point global ordinals.
-    Teuchos::ArrayView<const GlobalOrdinal> import_ordinal_view =
-	target_ordinals();
-    d_target_map = Tpetra::createNonContigMap<int,GlobalOrdinal>(
-	import_ordinal_view, d_comm );
-    testPostcondition( !d_target_map.is_null() );
-
-    // Get the global bounding box for the mesh.
-    BoundingBox source_box;
-    if ( source_exists )
-    {
-	source_box = source_mesh_manager->globalBoundingBox();
-    }
-    d_comm->barrier();
-    Teuchos::broadcast<int,BoundingBox>(
-	*d_comm, d_source_indexer.l2g(0), 
-	Teuchos::Ptr<BoundingBox>(&source_box) );
-
-    // Get the global bounding box for the coordinate field.
-    BoundingBox target_box;
-    if ( target_exists )
+    d_num_target_points = target_ordinals.size();
+
+    // Build the data import map from the point global ordinals. The
+    // directory-free transfer plan does not need it.
+    d_target_map = Teuchos::null;
+    d_source_map = Teuchos::null;
+    d_source_to_target_exporter = Teuchos::null;
+    d_source_to_target_importer = Teuchos::null;
+    if ( !d_directory_free )
     {
-	target_box = FieldTools<CoordinateField>::coordGlobalBoundingBox(
-	    *target_coord_manager->field(), target_coord_manager->comm() );
+	Teuchos::ArrayView<const GlobalOrdinal> import_ordinal_view =
+	    target_ordinals();
+	d_target_map = Tpetra::createNonContigMap<int,GlobalOrdinal>(
+	    import_ordinal_view, d_comm );
+	testPostcondition( !d_target_map.is_null() );
     }
-    d_comm->barrier();
-    Teuchos::broadcast<int,BoundingBox>( 
-	*d_comm, d_target_indexer.l2g(0), 
-	Teuchos::Ptr<BoundingBox>(&target_box) );
-
-    // Intersect the boxes to get the shared domain bounding box.
-    BoundingBox shared_domain_box;
-    bool has_intersect = BoundingBox::intersectBoxes( source_box, target_box, 
-						      shared_domain_box );
-    testAssertion( has_intersect );
 
-    // Build a rendezvous decomposition with the source mesh.
-    Rendezvous<Mesh> rendezvous( d_comm, d_dimension, shared_domain_box );
-    rendezvous.build( source_mesh_manager );
-
-    // Determine the rendezvous destination proc of each point in the
-    // coordinate field.
+    // Get a view of the target coordinates.
     Teuchos::ArrayRCP<double> coords_view(0,0.0);
     int coord_dim;
     if ( target_exists )
@@ -209,271 +397,1029 @@ void SharedDomainMap<Mesh,CoordinateField>::setup(
     Teuchos::broadcast<int,int>( 
 	*d_comm, d_target_indexer.l2g(0), Teuchos::Ptr<int>(&coord_dim) );
 
-    Teuchos::Array<int> rendezvous_procs = 
-	rendezvous.procsContainingPoints( coords_view );
-
-    // Get the target points that are in the box in which the rendezvous
-    // decomposition was generated. The rendezvous algorithm will expand the
-    // box slightly based on mesh parameters.
-    Teuchos::Array<GlobalOrdinal> targets_in_box;
-    if ( target_exists )
+    // Search for all of the target points in the source mesh.
+    Teuchos::Array<GlobalOrdinal> source_points;
+    Teuchos::Array<double> source_coords;
+    d_source_elements.clear();
+    d_source_target_procs.clear();
+    d_reference_coords.clear();
+    d_search_rendezvous = Teuchos::null;
+
+    // Build the kD-tree over the local source mesh blocks once. It is
+    // reused by every later search with this map and refit by update().
+    d_local_mesh = Teuchos::null;
+    d_local_tree = Teuchos::null;
+    if ( (d_local_search || d_direct_search) && source_exists )
     {
-	getTargetPointsInBox( rendezvous.getBox(), 
-			      *target_coord_manager->field(),
-			      target_ordinals, targets_in_box );
+	buildLocalTree( source_mesh_manager );
     }
     d_comm->barrier();
 
-    // Extract those target points that are not in the box. We don't want to
-    // send these to the rendezvous decomposition.
-    Teuchos::Array<GlobalOrdinal> not_in_box;
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator in_box_iterator;
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator in_box_begin =
-	targets_in_box.begin();
-    for ( in_box_iterator = targets_in_box.begin();
-	  in_box_iterator != targets_in_box.end();
-	  ++in_box_iterator )
+    if ( d_target_global_ids )
     {
-	if ( *in_box_iterator == std::numeric_limits<GlobalOrdinal>::max() )
+	// Only the copy of each point on its owning process is searched for.
+	Teuchos::Array<GlobalOrdinal> owned_ordinals;
+	Teuchos::ArrayRCP<double> owned_coords;
+	getOwnedTargetPoints( target_ordinals, coords_view, 
+			      owned_ordinals, owned_coords );
+	mapPoints( source_mesh_manager, target_coord_manager, coord_dim,
+		   owned_ordinals, owned_coords, tolerance, 
+		   source_points, source_coords );
+
+	// A point that was not mapped is missed on every process that has
+	// it.
+	if ( d_store_missed_points )
 	{
-	    not_in_box.push_back( 
-		std::distance( in_box_begin, in_box_iterator ) );
+	    Teuchos::ArrayRCP<double> point_mapped( 
+		d_source_elements.size(), 1.0 );
+	    Teuchos::RCP< Tpetra::MultiVector<double,int,GlobalOrdinal> > 
+		source_mapped = Tpetra::createMultiVectorFromView( 
+		    d_source_map, point_mapped, point_mapped.size(), 1 );
+	    Tpetra::MultiVector<double,int,GlobalOrdinal> target_mapped( 
+		d_target_map, 1 );
+	    target_mapped.doImport( *source_mapped, 
+				    *d_source_to_target_importer,
+				    Tpetra::INSERT );
+	    Teuchos::ArrayRCP<const double> target_mapped_view = 
+		target_mapped.get1dView();
+	    d_missed_points.clear();
+	    for ( GlobalOrdinal n = 0; n < d_num_target_points; ++n )
+	    {
+		if ( !target_mapped_view[n] )
+		{
+		    d_missed_points.push_back( n );
+		}
+	    }
 	}
     }
-    std::reverse( not_in_box.begin(), not_in_box.end() );
-
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator not_in_box_iterator;
-    for ( not_in_box_iterator = not_in_box.begin();
-	  not_in_box_iterator != not_in_box.end();
-	  ++not_in_box_iterator )
+    else
     {
-	rendezvous_procs.remove( *not_in_box_iterator );
+	mapPoints( source_mesh_manager, target_coord_manager, coord_dim,
+		   target_ordinals, coords_view, tolerance, 
+		   source_points, source_coords );
     }
-    not_in_box.clear();
-
-    typename Teuchos::Array<GlobalOrdinal>::iterator targets_bound =
-	std::remove( targets_in_box.begin(), targets_in_box.end(), 
-		     std::numeric_limits<GlobalOrdinal>::max() );
-    GlobalOrdinal targets_in_box_size = 
-	std::distance( targets_in_box.begin(), targets_bound );
+    if ( d_interpolation_operator )
+    {
+	buildInterpolationOperator( source_mesh_manager );
+    }
+}
 
-    targets_in_box.resize( targets_in_box_size );
-    rendezvous_procs.resize( targets_in_box_size );
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Update the shared domain map after the source mesh vertices have
+ * moved. The source mesh must have the same vertices and elements and the
+ * target points must be the same as in setup(); only the source mesh
+ * coordinates may change.
+ *
+ * Each target point that was mapped is first checked against the source
+ * element it was mapped to in the moved mesh. Only the points that are no
+ * longer in their element and those that were not mapped are searched for
+ * again. If this map built a rendezvous decomposition, it is updated with the
+ * moved mesh instead of being built again. The kD-tree over the local source
+ * mesh used by local and direct search is refit to the moved vertices. The
+ * source mesh is therefore not rebuilt for any of the searches. A rendezvous
+ * decomposition provided by the client with setRendezvous() must be updated
+ * by the client before this map is updated.
+ *
+ * \param source_mesh_manager The moved source mesh. A null RCP is a valid
+ * argument on processes without source mesh.
+ *
+ * \param target_coord_manager The target coordinates used in setup(). A null
+ * RCP is a valid argument on processes without target points.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::update( 
+    const RCP_MeshManager& source_mesh_manager, 
+    const RCP_CoordFieldManager& target_coord_manager,
+    double tolerance )
+{
+    testPrecondition( !d_directory_free );
+    testPrecondition( !d_target_global_ids );
+    testPrecondition( !d_source_map.is_null() );
 
-    // Via an inverse communication operation, move the global point ordinals
-    // that are in the rendezvous decomposition box to the rendezvous
-    // decomposition.
-    Teuchos::ArrayView<const GlobalOrdinal> targets_in_box_view = 
-	targets_in_box();
-    Tpetra::Distributor target_to_rendezvous_distributor( d_comm );
-    GlobalOrdinal num_rendezvous_points = 
-	target_to_rendezvous_distributor.createFromSends( rendezvous_procs() );
-    Teuchos::Array<GlobalOrdinal> rendezvous_points( num_rendezvous_points );
-    target_to_rendezvous_distributor.doPostsAndWaits( 
-	targets_in_box_view, 1, rendezvous_points() );
+    bool source_exists = true;
+    if ( source_mesh_manager.is_null() ) source_exists = false;
+    bool target_exists = true;
+    if ( target_coord_manager.is_null() ) target_exists = false;
+    d_comm->barrier();
 
-    // Setup target-to-rendezvous communication.
-    Teuchos::ArrayView<const GlobalOrdinal> rendezvous_points_view =
-	rendezvous_points();
-    RCP_TpetraMap rendezvous_coords_map = 
-      Tpetra::createNonContigMap<int,GlobalOrdinal>(
-        rendezvous_points_view, d_comm );
-    Tpetra::Export<int,GlobalOrdinal> 
-      target_to_rendezvous_exporter( d_target_map, rendezvous_coords_map );
+    // Move the rendezvous decomposition built by this map with the source
+    // mesh.
+    if ( !d_search_rendezvous.is_null() )
+    {
+	d_search_rendezvous->update( source_mesh_manager );
+    }
 
-    // Move the target coordinates to the rendezvous decomposition.
-    GlobalOrdinal num_points = target_ordinals.size();
-    Teuchos::RCP< Tpetra::MultiVector<double,int,GlobalOrdinal> > 
-	target_coords =	Tpetra::createMultiVectorFromView( 
-	    d_target_map, coords_view, num_points, coord_dim );
-    Tpetra::MultiVector<double,int,GlobalOrdinal> rendezvous_coords( 
-	rendezvous_coords_map, coord_dim );
-    rendezvous_coords.doExport( *target_coords, target_to_rendezvous_exporter, 
-				Tpetra::INSERT );
+    // Refit the kD-tree over the local source mesh blocks to the moved
+    // vertices.
+    if ( !d_local_tree.is_null() )
+    {
+	refitLocalTree( source_mesh_manager );
+    }
+    d_comm->barrier();
 
-    // Search the rendezvous decomposition with the target points to get the
-    // source elements that contain them.
-    Teuchos::Array<GlobalOrdinal> rendezvous_elements;
-    Teuchos::Array<int> rendezvous_element_src_procs;
-    rendezvous.elementsContainingPoints( rendezvous_coords.get1dViewNonConst(),
-					 rendezvous_elements,
-					 rendezvous_element_src_procs,
-					 tolerance );
-
-    // Get the points that were not in the mesh. If we're keeping track of
-    // missed points, also make a list of those ordinals.
-    GlobalOrdinal target_index;
-    Teuchos::Array<GlobalOrdinal> not_in_mesh;
-    Teuchos::Array<GlobalOrdinal> missed_in_mesh_idx;
-    Teuchos::Array<GlobalOrdinal> missed_in_mesh_ordinal;
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator 
-	rendezvous_elements_iterator;
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator 
-	rendezvous_elements_begin = rendezvous_elements.begin();
-    for ( rendezvous_elements_iterator = rendezvous_elements.begin();
-	  rendezvous_elements_iterator != rendezvous_elements.end();
-	  ++rendezvous_elements_iterator )
-    {
-	if ( *rendezvous_elements_iterator == 
-	     std::numeric_limits<GlobalOrdinal>::max() )
+    // Check the mapped points against the elements they were mapped to in
+    // the moved source mesh. Points that are still in their element keep
+    // their mapping with their reference coordinates in the moved element.
+    GlobalOrdinal num_mapped = d_source_elements.size();
+    Teuchos::ArrayView<const GlobalOrdinal> mapped_points = 
+	d_source_map->getNodeElementList();
+    Teuchos::ArrayRCP<double> point_kept( num_mapped, 0.0 );
+    Teuchos::Array<double> reference_coords( num_mapped*d_dimension );
+    if ( source_exists && num_mapped > 0 )
+    {
+	Teuchos::Array<Teuchos::Array<std::pair<GlobalOrdinal,int> > > 
+	    vertex_tables;
+	Teuchos::Array<std::pair<GlobalOrdinal,int> > element_table;
+	Teuchos::Array<std::pair<int,GlobalOrdinal> > element_locations;
+	indexSourceMesh( source_mesh_manager, vertex_tables, 
+			 element_table, element_locations );
+
+	// Check each point against the moved vertices of its element only.
+	// The vertex coordinates are gathered in canonical order for the
+	// point-in-element kernels. Elements without a kernel are not checked
+	// and their points are searched for again.
+	double point[3];
+	double reference_point[3];
+	double vertex_coords[3*8];
+	MeshBlockIterator block_iterator;
+	typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::const_iterator
+	    element_it;
+	typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::const_iterator
+	    vertex_it;
+	GlobalOrdinal element;
+	GlobalOrdinal vertex;
+	GlobalOrdinal num_block_elements;
+	GlobalOrdinal num_block_vertices;
+	int b;
+	int vertices_per_element;
+	moab::EntityType element_topology;
+	Teuchos::ArrayRCP<const double> block_coords;
+	Teuchos::ArrayRCP<const GlobalOrdinal> block_connectivity;
+	Teuchos::ArrayRCP<const int> block_permutation;
+	for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
 	{
-	    target_index = std::distance( rendezvous_elements_begin, 
-					  rendezvous_elements_iterator );
+	    element_it = std::lower_bound( 
+		element_table.begin(), element_table.end(),
+		std::make_pair( d_source_elements[n], 0 ) );
+	    if ( element_it == element_table.end() ||
+		 element_it->first != d_source_elements[n] )
+	    {
+		continue;
+	    }
+	    b = element_locations[ element_it->second ].first;
+	    element = element_locations[ element_it->second ].second;
+
+	    block_iterator = source_mesh_manager->blocksBegin() + b;
+	    vertices_per_element = MT::verticesPerElement( *(*block_iterator) );
+	    element_topology = moab_topology_table[ 
+		MT::elementTopology( *(*block_iterator) ) ];
+	    if ( !TopologyTools::hasPointInElementKernel( 
+		     element_topology, vertices_per_element, d_dimension ) )
+	    {
+		continue;
+	    }
 
-	    not_in_mesh.push_back( target_index );
+	    block_coords = MeshTools<Mesh>::coordsView( *(*block_iterator) );
+	    block_connectivity = 
+		MeshTools<Mesh>::connectivityView( *(*block_iterator) );
+	    block_permutation = 
+		MeshTools<Mesh>::permutationView( *(*block_iterator) );
+	    num_block_elements = 
+		MeshTools<Mesh>::numElements( *(*block_iterator) );
+	    num_block_vertices = vertex_tables[b].size();
+	    for ( int i = 0; i < vertices_per_element; ++i )
+	    {
+		vertex = block_connectivity[ i*num_block_elements + element ];
+		vertex_it = std::lower_bound( 
+		    vertex_tables[b].begin(), vertex_tables[b].end(),
+		    std::make_pair( vertex, 0 ) );
+		testInvariant( vertex_it != vertex_tables[b].end() &&
+			       vertex_it->first == vertex );
+		for ( int d = 0; d < 3; ++d )
+		{
+		    vertex_coords[ 3*block_permutation[i] + d ] = 
+			( d < d_dimension ) ? block_coords[ 
+			    d*num_block_vertices + vertex_it->second ] : 0.0;
+		}
+	    }
 
-	    if ( d_store_missed_points )
+	    for ( int d = 0; d < 3; ++d )
 	    {
-		missed_in_mesh_idx.push_back( target_index );
-		missed_in_mesh_ordinal.push_back( 
-		    rendezvous_points[target_index] );
+		point[d] = ( d < d_dimension ) ?
+			   d_target_coords[ num_mapped*d + n ] : 0.0;
+	    }
+	    if ( TopologyTools::pointInElement( 
+		     point, element_topology, vertex_coords, 
+		     reference_point, tolerance ) )
+	    {
+		point_kept[n] = 1.0;
+		for ( int d = 0; d < d_dimension; ++d )
+		{
+		    reference_coords[ num_mapped*d + n ] = reference_point[d];
+		}
 	    }
 	}
     }
+    d_comm->barrier();
 
-    // If we're keeping track of missed points, send their global ordinals
-    // back to the target decomposition so that we can add them to the list.
-    if ( d_store_missed_points )
+    // Keep the points that are still in their element.
+    GlobalOrdinal num_kept = 
+	std::count( point_kept.begin(), point_kept.end(), 1.0 );
+    Teuchos::Array<GlobalOrdinal> source_points( num_kept );
+    Teuchos::Array<GlobalOrdinal> source_elements( num_kept );
+    Teuchos::Array<int> source_target_procs( num_kept );
+    Teuchos::Array<double> source_coords( num_kept*d_dimension );
+    Teuchos::Array<double> source_reference_coords( num_kept*d_dimension );
+    GlobalOrdinal kept_index = 0;
+    for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
     {
-	// Extract the missed point target procs from the target-to-rendezvous
-	// distributor.
-	Teuchos::ArrayView<const int> from_images = 
-	    target_to_rendezvous_distributor.getImagesFrom();
-	Teuchos::ArrayView<const std::size_t> from_lengths = 
-	    target_to_rendezvous_distributor.getLengthsFrom();
-	Teuchos::Array<int> point_target_procs;
-	for ( int i = 0; i < (int) from_images.size(); ++i )
+	if ( point_kept[n] )
 	{
-	    for ( std::size_t j = 0; j < from_lengths[i]; ++j )
+	    source_points[kept_index] = mapped_points[n];
+	    source_elements[kept_index] = d_source_elements[n];
+	    source_target_procs[kept_index] = d_source_target_procs[n];
+	    for ( int d = 0; d < d_dimension; ++d )
 	    {
-		point_target_procs.push_back( from_images[i] );
+		source_coords[ num_kept*d + kept_index ] = 
+		    d_target_coords[ num_mapped*d + n ];
+		source_reference_coords[ num_kept*d + kept_index ] = 
+		    reference_coords[ num_mapped*d + n ];
 	    }
+	    ++kept_index;
 	}
-	testInvariant( Teuchos::as<GlobalOrdinal>(point_target_procs.size())
-		       == num_rendezvous_points );
+    }
+    testInvariant( kept_index == num_kept );
+
+    // Tell the target processes which of their points kept their mapping.
+    Teuchos::RCP< Tpetra::MultiVector<double,int,GlobalOrdinal> > 
+	source_kept = Tpetra::createMultiVectorFromView( 
+	    d_source_map, point_kept, num_mapped, 1 );
+    Tpetra::MultiVector<double,int,GlobalOrdinal> target_kept( 
+	d_target_map, 1 );
+    target_kept.doExport( *source_kept, *d_source_to_target_exporter, 
+			  Tpetra::INSERT );
+    Teuchos::ArrayRCP<const double> target_kept_view = 
+	target_kept.get1dView();
+
+    // Get a view of the target coordinates.
+    Teuchos::ArrayRCP<double> coords_view(0,0.0);
+    int coord_dim;
+    if ( target_exists )
+    {
+	coord_dim = CFT::dim( *target_coord_manager->field() );
+	coords_view = FieldTools<CoordinateField>::nonConstView( 
+	    *target_coord_manager->field() );
+    }
+    d_comm->barrier();
+    Teuchos::broadcast<int,int>( 
+	*d_comm, d_target_indexer.l2g(0), Teuchos::Ptr<int>(&coord_dim) );
 
-	// Build a list of target procs for the missed points.
-	Teuchos::Array<int> missed_target_procs( missed_in_mesh_idx.size() );
-	for ( int n = 0; n < (int) missed_in_mesh_idx.size(); ++n )
+    // Gather the target points that must be searched for again.
+    Teuchos::ArrayView<const GlobalOrdinal> target_ordinals = 
+	d_target_map->getNodeElementList();
+    GlobalOrdinal num_points = target_ordinals.size();
+    GlobalOrdinal num_search = 
+	num_points - std::count( target_kept_view.begin(), 
+				 target_kept_view.end(), 1.0 );
+    Teuchos::Array<GlobalOrdinal> search_ordinals( num_search );
+    Teuchos::ArrayRCP<double> search_coords( num_search*d_dimension, 0.0 );
+    GlobalOrdinal search_index = 0;
+    for ( GlobalOrdinal n = 0; n < num_points; ++n )
+    {
+	if ( !target_kept_view[n] )
 	{
-	    missed_target_procs[n] = 
-		point_target_procs[ missed_in_mesh_idx[n] ];
+	    search_ordinals[search_index] = target_ordinals[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		search_coords[ num_search*d + search_index ] = 
+		    coords_view[ num_points*d + n ];
+	    }
+	    ++search_index;
 	}
-	point_target_procs.clear();
+    }
+    testInvariant( search_index == num_search );
 
-	// Send the missed points back to the target decomposition through an
-	// inverse communication operation and add them to the list.
-	Teuchos::ArrayView<const GlobalOrdinal> missed_in_mesh_ordinal_view = 
-	    missed_in_mesh_ordinal();
-	Tpetra::Distributor target_to_rendezvous_distributor( d_comm );
-	GlobalOrdinal num_missed_targets = 
-	    target_to_rendezvous_distributor.createFromSends( 
-		missed_target_procs() );
-	GlobalOrdinal offset = d_missed_points.size();
-	d_missed_points.resize( offset + num_missed_targets );
-	target_to_rendezvous_distributor.doPostsAndWaits( 
-	    missed_in_mesh_ordinal_view, 1, 
-	    d_missed_points.view( offset, num_missed_targets ) );
+    // The kept points have new reference coordinates in the moved mesh.
+    d_reference_coords.swap( source_reference_coords );
 
-	// Convert the missed point global indices to local indices and add
-	// them to the list.
-	for ( GlobalOrdinal n = offset; n < offset+num_missed_targets; ++n )
+    // If every target point kept its mapping the map has not changed. The
+    // interpolation operator must still be built with the new reference
+    // coordinates.
+    GlobalOrdinal global_num_search = 0;
+    Teuchos::reduceAll<int,GlobalOrdinal>( *d_comm,
+					   Teuchos::REDUCE_SUM,
+					   1,
+					   &num_search,
+					   &global_num_search );
+    if ( 0 == global_num_search )
+    {
+	if ( d_interpolation_operator )
 	{
-	    d_missed_points[n] = 
-		d_target_g2l.find( d_missed_points[n] )->second;
+	    buildInterpolationOperator( source_mesh_manager );
 	}
+	return;
     }
-    missed_in_mesh_idx.clear();
-    missed_in_mesh_ordinal.clear();
-
-    // Extract the points we didn't find in any elements in the rendezvous
-    // decomposition and their corresponding elements. We don't want to send
-    // these to the source.
-    std::reverse( not_in_mesh.begin(), not_in_mesh.end() );
-    typename Teuchos::Array<GlobalOrdinal>::const_iterator not_in_mesh_iterator;
-    for ( not_in_mesh_iterator = not_in_mesh.begin();
-	  not_in_mesh_iterator != not_in_mesh.end();
-	  ++not_in_mesh_iterator )
-    {
-	rendezvous_points.remove( *not_in_mesh_iterator );
-    }
-    not_in_mesh.clear();
-
-    typename Teuchos::Array<GlobalOrdinal>::iterator rendezvous_elements_bound =
-	std::remove( rendezvous_elements.begin(), 
-		     rendezvous_elements.end(), 
-		     std::numeric_limits<GlobalOrdinal>::max() );
-    GlobalOrdinal rendezvous_elements_size = 
-	std::distance( rendezvous_elements.begin(), rendezvous_elements_bound );
-
-    typename Teuchos::Array<int>::iterator rendezvous_element_src_procs_bound =
-	std::remove( rendezvous_element_src_procs.begin(), 
-		     rendezvous_element_src_procs.end(), -1 );
-    GlobalOrdinal rendezvous_element_src_procs_size = 
-	std::distance( rendezvous_element_src_procs.begin(), 
-		       rendezvous_element_src_procs_bound );
-    testInvariant( rendezvous_elements_size == 
-		   rendezvous_element_src_procs_size );
-
-    rendezvous_elements.resize( rendezvous_elements_size );
-    rendezvous_element_src_procs.resize( rendezvous_element_src_procs_size );
-    rendezvous_points.resize( rendezvous_elements_size );
-
-    // Setup rendezvous-to-source distributor.
-    Tpetra::Distributor rendezvous_to_src_distributor( d_comm );
-    GlobalOrdinal num_source_elements = 
-	rendezvous_to_src_distributor.createFromSends( 
-	    rendezvous_element_src_procs() );
-
-    // Send the rendezvous elements to the source decomposition via inverse
-    // communication. 
-    Teuchos::ArrayView<const GlobalOrdinal> rendezvous_elements_view =
-	rendezvous_elements();
-    d_source_elements.resize( num_source_elements );
-    rendezvous_to_src_distributor.doPostsAndWaits( rendezvous_elements_view, 1,
-						   d_source_elements() );
-
-    // Send the rendezvous point global ordinals to the source decomposition
-    // via inverse communication.
-    Teuchos::ArrayView<const GlobalOrdinal> reduced_rendezvous_points_view =
-	rendezvous_points();
-    Teuchos::Array<GlobalOrdinal> source_points( num_source_elements );
-    rendezvous_to_src_distributor.doPostsAndWaits( 
-	reduced_rendezvous_points_view, 1, source_points() );
-
-    // Build the source map from the target ordinals.
-    Teuchos::ArrayView<const GlobalOrdinal> source_points_view = 
-	source_points();
-    d_source_map = Tpetra::createNonContigMap<int,GlobalOrdinal>( 
-	source_points_view, d_comm );
-    testPostcondition( !d_source_map.is_null() );
-
-    // Send the rendezvous point coordinates to the source decomposition.
-    Tpetra::Export<int,GlobalOrdinal> rendezvous_to_source_exporter( 
-	rendezvous_coords_map, d_source_map );
-    d_target_coords.resize( num_source_elements*coord_dim );
-    Teuchos::RCP< Tpetra::MultiVector<double,int,GlobalOrdinal> >
-	source_coords = Tpetra::createMultiVectorFromView( 
-	    d_source_map, Teuchos::arcpFromArray( d_target_coords ), 
-	    num_source_elements, coord_dim );
-    source_coords->doExport( rendezvous_coords, rendezvous_to_source_exporter,
-			     Tpetra::INSERT );
 
-    // Build the source-to-target exporter.
-    d_source_to_target_exporter = 
-      Teuchos::rcp( new Tpetra::Export<int,GlobalOrdinal>(
-			  d_source_map, d_target_map ) );
-    testPostcondition( !d_source_to_target_exporter.is_null() );
+    // Search for the remaining points. Points that are missed again will be
+    // added back to the missed point list.
+    d_missed_points.clear();
+    d_source_elements.swap( source_elements );
+    d_source_target_procs.swap( source_target_procs );
+    mapPoints( source_mesh_manager, target_coord_manager, coord_dim,
+	       search_ordinals, search_coords, tolerance, 
+	       source_points, source_coords );
+    if ( d_interpolation_operator )
+    {
+	buildInterpolationOperator( source_mesh_manager );
+    }
 }
 
 //---------------------------------------------------------------------------//
 /*!
- * \brief Get the points missed in the map generation.
+ * \brief Add target points to the shared domain map. Only the new points are
+ * searched for in the source mesh. The rendezvous decomposition used by the
+ * map is reused such that the source mesh is not partitioned or migrated
+ * again.
  *
- * \return If store_missed_points is true, return the local indices of the
- *  points provided by target_coord_manager that were not mapped. An exception
- *  will be thrown if store_missed_points is false. Returns a null view if all
- *  points have been mapped or the map has not yet been generated.
+ * \param source_mesh_manager The source mesh used to generate the map. A
+ * null RCP is a valid argument on processes without source mesh.
+ *
+ * \param target_coord_manager The target coordinates. The points already in
+ * the map must come first in the same order followed by the new points. A
+ * null RCP is a valid argument on processes without target points.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::addTargetPoints( 
+    const RCP_MeshManager& source_mesh_manager, 
+    const RCP_CoordFieldManager& target_coord_manager,
+    double tolerance )
+{
+    testPrecondition( !d_directory_free );
+    testPrecondition( !d_target_global_ids );
+    testPrecondition( !d_target_map.is_null() );
+
+    bool target_exists = true;
+    if ( target_coord_manager.is_null() ) target_exists = false;
+    d_comm->barrier();
+
+    // Get a view of the target coordinates.
+    Teuchos::ArrayRCP<double> coords_view(0,0.0);
+    int coord_dim;
+    if ( target_exists )
+    {
+	coord_dim = CFT::dim( *target_coord_manager->field() );
+	coords_view = FieldTools<CoordinateField>::nonConstView( 
+	    *target_coord_manager->field() );
+    }
+    d_comm->barrier();
+    Teuchos::broadcast<int,int>( 
+	*d_comm, d_target_indexer.l2g(0), Teuchos::Ptr<int>(&coord_dim) );
+
+    // The new points follow the points already in the map.
+    Teuchos::Array<GlobalOrdinal> target_ordinals( 
+	d_target_map->getNodeElementList() );
+    GlobalOrdinal num_old = target_ordinals.size();
+    GlobalOrdinal num_points = coords_view.size() / coord_dim;
+    testPrecondition( num_points >= num_old );
+    GlobalOrdinal num_new = num_points - num_old;
+
+    // Give the new points globally unique ordinals above the ordinals already
+    // in the map.
+    GlobalOrdinal local_max[2] = { 0, num_new };
+    for ( GlobalOrdinal n = 0; n < num_old; ++n )
+    {
+	local_max[0] = std::max( local_max[0], target_ordinals[n] + 1 );
+    }
+    GlobalOrdinal global_max[2] = { 0, 0 };
+    Teuchos::reduceAll<int,GlobalOrdinal>( *d_comm,
+					   Teuchos::REDUCE_MAX,
+					   2,
+					   local_max,
+					   global_max );
+    if ( 0 == global_max[1] )
+    {
+	return;
+    }
+
+    int comm_rank = d_comm->getRank();
+    Teuchos::Array<GlobalOrdinal> new_ordinals( num_new );
+    Teuchos::ArrayRCP<double> new_coords( num_new*d_dimension, 0.0 );
+    for ( GlobalOrdinal n = 0; n < num_new; ++n )
+    {
+	new_ordinals[n] = global_max[0] + comm_rank*global_max[1] + n;
+	target_ordinals.push_back( new_ordinals[n] );
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    new_coords[ num_new*d + n ] = 
+		coords_view[ num_points*d + num_old + n ];
+	}
+	if ( d_store_missed_points )
+	{
+	    d_target_g2l[ new_ordinals[n] ] = num_old + n;
+	}
+    }
+
+    // Rebuild the target map with the new points.
+    d_num_target_points = num_points;
+    Teuchos::ArrayView<const GlobalOrdinal> target_ordinals_view =
+	target_ordinals();
+    d_target_map = Tpetra::createNonContigMap<int,GlobalOrdinal>(
+	target_ordinals_view, d_comm );
+    testPostcondition( !d_target_map.is_null() );
+
+    // Search for the new points. The points already mapped keep their
+    // mapping.
+    Teuchos::Array<GlobalOrdinal> source_points( 
+	d_source_map->getNodeElementList() );
+    Teuchos::Array<double> source_coords( d_target_coords );
+    mapPoints( source_mesh_manager, target_coord_manager, coord_dim,
+	       new_ordinals, new_coords, tolerance, 
+	       source_points, source_coords );
+    if ( d_interpolation_operator )
+    {
+	buildInterpolationOperator( source_mesh_manager );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Remove target points from the shared domain map. The points are
+ * removed from the source and target maps and the source-to-target
+ * communication plan. No search is performed. This is a collective
+ * operation.
+ *
+ * \param local_indices The local indices of the target points to remove.
+ * Target fields applied to after this call must not contain these points and
+ * the remaining points must keep their order.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::removeTargetPoints( 
+    const Teuchos::ArrayView<const GlobalOrdinal>& local_indices )
+{
+    testPrecondition( !d_directory_free );
+    testPrecondition( !d_target_global_ids );
+    testPrecondition( !d_target_map.is_null() );
+
+    // Flag the removed target points.
+    Teuchos::ArrayView<const GlobalOrdinal> target_ordinals = 
+	d_target_map->getNodeElementList();
+    GlobalOrdinal num_points = target_ordinals.size();
+    Teuchos::ArrayRCP<double> point_removed( num_points, 0.0 );
+    typename Teuchos::ArrayView<const GlobalOrdinal>::const_iterator 
+	index_iterator;
+    for ( index_iterator = local_indices.begin();
+	  index_iterator != local_indices.end();
+	  ++index_iterator )
+    {
+	testPrecondition( 0 <= *index_iterator && *index_iterator < num_points );
+	point_removed[ *index_iterator ] = 1.0;
+    }
+
+    // Send the flags to the source processes through the reverse of the
+    // source-to-target communication.
+    Teuchos::RCP< Tpetra::MultiVector<double,int,GlobalOrdinal> > 
+	target_removed = Tpetra::createMultiVectorFromView( 
+	    d_target_map, point_removed, num_points, 1 );
+    Tpetra::MultiVector<double,int,GlobalOrdinal> source_removed( 
+	d_source_map, 1 );
+    source_removed.doImport( *target_removed, *d_source_to_target_exporter,
+			     Tpetra::INSERT );
+    Teuchos::ArrayRCP<const double> source_removed_view = 
+	source_removed.get1dView();
+
+    // Prune the removed points from the source decomposition.
+    Teuchos::ArrayView<const GlobalOrdinal> mapped_points = 
+	d_source_map->getNodeElementList();
+    GlobalOrdinal num_mapped = mapped_points.size();
+    GlobalOrdinal num_kept = 
+	num_mapped - std::count( source_removed_view.begin(),
+				 source_removed_view.end(), 1.0 );
+    Teuchos::Array<GlobalOrdinal> source_points( num_kept );
+    Teuchos::Array<GlobalOrdinal> source_elements( num_kept );
+    Teuchos::Array<int> source_target_procs( num_kept );
+    Teuchos::Array<double> source_coords( num_kept*d_dimension );
+    Teuchos::Array<double> source_reference_coords( num_kept*d_dimension );
+    GlobalOrdinal kept_index = 0;
+    for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+    {
+	if ( !source_removed_view[n] )
+	{
+	    source_points[kept_index] = mapped_points[n];
+	    source_elements[kept_index] = d_source_elements[n];
+	    source_target_procs[kept_index] = d_source_target_procs[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		source_coords[ num_kept*d + kept_index ] = 
+		    d_target_coords[ num_mapped*d + n ];
+		source_reference_coords[ num_kept*d + kept_index ] = 
+		    d_reference_coords[ num_mapped*d + n ];
+	    }
+	    ++kept_index;
+	}
+    }
+    testInvariant( kept_index == num_kept );
+    d_source_elements.swap( source_elements );
+    d_source_target_procs.swap( source_target_procs );
+    d_target_coords.swap( source_coords );
+    d_reference_coords.swap( source_reference_coords );
+
+    // Prune the rows of the removed points from the interpolation operator.
+    if ( d_interpolation_operator )
+    {
+	Teuchos::Array<int> operator_offsets( 1, 0 );
+	Teuchos::Array<int> operator_columns;
+	Teuchos::Array<double> operator_values;
+	for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	{
+	    if ( !source_removed_view[n] )
+	    {
+		operator_columns.insert( 
+		    operator_columns.end(),
+		    d_operator_columns.begin() + d_operator_offsets[n],
+		    d_operator_columns.begin() + d_operator_offsets[n+1] );
+		operator_values.insert( 
+		    operator_values.end(),
+		    d_operator_values.begin() + d_operator_offsets[n],
+		    d_operator_values.begin() + d_operator_offsets[n+1] );
+		operator_offsets.push_back( operator_columns.size() );
+	    }
+	}
+	d_operator_offsets.swap( operator_offsets );
+	d_operator_columns.swap( operator_columns );
+	d_operator_values.swap( operator_values );
+    }
+
+    // Prune the removed points from the target decomposition and compute
+    // the new local index of each remaining point.
+    Teuchos::Array<GlobalOrdinal> remaining_ordinals;
+    Teuchos::Array<GlobalOrdinal> new_indices( num_points, -1 );
+    for ( GlobalOrdinal n = 0; n < num_points; ++n )
+    {
+	if ( !point_removed[n] )
+	{
+	    new_indices[n] = remaining_ordinals.size();
+	    remaining_ordinals.push_back( target_ordinals[n] );
+	}
+    }
+
+    // Renumber the missed points.
+    if ( d_store_missed_points )
+    {
+	Teuchos::Array<GlobalOrdinal> missed_points;
+	typename Teuchos::Array<GlobalOrdinal>::const_iterator missed_iterator;
+	for ( missed_iterator = d_missed_points.begin();
+	      missed_iterator != d_missed_points.end();
+	      ++missed_iterator )
+	{
+	    if ( !point_removed[ *missed_iterator ] )
+	    {
+		missed_points.push_back( new_indices[ *missed_iterator ] );
+	    }
+	}
+	d_missed_points.swap( missed_points );
+
+	d_target_g2l.clear();
+	GlobalOrdinal num_remaining = remaining_ordinals.size();
+	for ( GlobalOrdinal n = 0; n < num_remaining; ++n )
+	{
+	    d_target_g2l[ remaining_ordinals[n] ] = n;
+	}
+    }
+
+    // Rebuild the maps and the source-to-target exporter.
+    d_num_target_points = remaining_ordinals.size();
+    Teuchos::ArrayView<const GlobalOrdinal> remaining_ordinals_view =
+	remaining_ordinals();
+    d_target_map = Tpetra::createNonContigMap<int,GlobalOrdinal>(
+	remaining_ordinals_view, d_comm );
+    testPostcondition( !d_target_map.is_null() );
+    buildSourceMap( source_points );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Search for target points in the source mesh and build the source
+ * map from the points found and the points that were already mapped.
+ *
+ * \param source_mesh_manager The source mesh. May be null on processes
+ * without source mesh.
+ *
+ * \param target_coord_manager The target coordinates. May be null on
+ * processes without target points.
+ *
+ * \param coord_dim The dimension of the target coordinates.
+ *
+ * \param point_ordinals The global ordinals of the target points to search
+ * for.
+ *
+ * \param point_coords The blocked coordinates of the target points to search
+ * for.
+ *
+ * \param tolerance Absolute tolerance for point searching.
+ *
+ * \param source_points The global ordinals of the target points already
+ * mapped to the local source elements. Their elements are in the local
+ * source element list. The points found here are appended to this list.
+ *
+ * \param source_coords The blocked coordinates of the target points already
+ * mapped to the local source elements.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::mapPoints( 
+    const RCP_MeshManager& source_mesh_manager, 
+    const RCP_CoordFieldManager& target_coord_manager,
+    const int coord_dim,
+    const Teuchos::Array<GlobalOrdinal>& point_ordinals,
+    const Teuchos::ArrayRCP<double>& point_coords,
+    double tolerance,
+    Teuchos::Array<GlobalOrdinal>& source_points,
+    Teuchos::Array<double>& source_coords )
+{
+    bool source_exists = true;
+    if ( source_mesh_manager.is_null() ) source_exists = false;
+    bool target_exists = true;
+    if ( target_coord_manager.is_null() ) target_exists = false;
+    d_comm->barrier();
+
+    // If we're doing a local search, search the local source mesh for the
+    // local target points first. Only the points not found locally will be
+    // searched for in the rendezvous decomposition.
+    Teuchos::Array<GlobalOrdinal> search_ordinals( point_ordinals );
+    Teuchos::ArrayRCP<double> search_coords = point_coords;
+    if ( d_local_search && source_exists && target_exists )
+    {
+	localSearch( source_mesh_manager, point_coords, point_ordinals,
+		     tolerance, source_points, source_coords, 
+		     search_ordinals, search_coords );
+    }
+    d_comm->barrier();
+    GlobalOrdinal num_local_found = source_points.size();
+
+    // If all of the points were found locally we don't need the rendezvous
+    // decomposition. The source-to-target communication is then local.
+    if ( d_local_search )
+    {
+	GlobalOrdinal local_num_search = search_ordinals.size();
+	GlobalOrdinal global_num_search = 0;
+	Teuchos::reduceAll<int,GlobalOrdinal>( *d_comm,
+					       Teuchos::REDUCE_SUM,
+					       1,
+					       &local_num_search,
+					       &global_num_search );
+	if ( 0 == global_num_search )
+	{
+	    d_target_coords = source_coords;
+	    buildSourceMap( source_points );
+	    return;
+	}
+    }
+
+    // If we're doing a direct search, route the remaining points to the
+    // source processes and skip the rendezvous decomposition.
+    if ( d_direct_search )
+    {
+	directSearch( source_mesh_manager, search_coords, search_ordinals,
+		      tolerance, source_points, source_coords );
+	d_target_coords = source_coords;
+	buildSourceMap( source_points );
+	return;
+    }
+
+    // Get the global bounding box for the mesh.
+    BoundingBox source_box;
+    if ( source_exists )
+    {
+	source_box = source_mesh_manager->globalBoundingBox();
+    }
+    d_comm->barrier();
+    Teuchos::broadcast<int,BoundingBox>(
+	*d_comm, d_source_indexer.l2g(0), 
+	Teuchos::Ptr<BoundingBox>(&source_box) );
+
+    // Get the global bounding box for the coordinate field.
+    BoundingBox target_box;
+    if ( target_exists )
+    {
+	target_box = FieldTools<CoordinateField>::coordGlobalBoundingBox(
+	    *target_coord_manager->field(), target_coord_manager->comm() );
+    }
+    d_comm->barrier();
+    Teuchos::broadcast<int,BoundingBox>( 
+	*d_comm, d_target_indexer.l2g(0), 
+	Teuchos::Ptr<BoundingBox>(&target_box) );
+
+    // Intersect the boxes to get the shared domain bounding box.
+    BoundingBox shared_domain_box;
+    bool has_intersect = BoundingBox::intersectBoxes( source_box, target_box, 
+						      shared_domain_box );
+    testAssertion( has_intersect );
+
+    // Build the rendezvous partition weights. Target density weights are
+    // histogrammed over the shared domain.
+    Teuchos::RCP<PartitionWeights> partition_weights = d_partition_weights;
+    if ( d_density_bins > 0 && d_rendezvous.is_null() &&
+	 d_search_rendezvous.is_null() )
+    {
+	Teuchos::RCP<TargetDensityWeights> density_weights = Teuchos::rcp(
+	    new TargetDensityWeights( d_comm, shared_domain_box, 
+				      d_dimension, d_density_bins ) );
+
+	if ( source_exists )
+	{
+	    MeshBlockIterator block_iterator;
+	    for ( block_iterator = source_mesh_manager->blocksBegin();
+		  block_iterator != source_mesh_manager->blocksEnd();
+		  ++block_iterator )
+	    {
+		density_weights->addSourcePoints( 
+		    MeshTools<Mesh>::coordsView( *(*block_iterator) )() );
+	    }
+	}
+
+	if ( target_exists )
+	{
+	    density_weights->addTargetPoints( 
+		FieldTools<CoordinateField>::view( 
+		    *target_coord_manager->field() )() );
+	}
+
+	density_weights->reduce();
+	partition_weights = density_weights;
+    }
+
+    // Build a rendezvous decomposition with the source mesh unless the
+    // client provided one or setup() already built one. A decomposition
+    // built here is kept for update().
+    RCP_Rendezvous rendezvous = d_rendezvous;
+    if ( rendezvous.is_null() )
+    {
+	rendezvous = d_search_rendezvous;
+    }
+    if ( rendezvous.is_null() )
+    {
+	rendezvous = Teuchos::rcp( 
+	    new RendezvousType( d_comm, d_dimension, shared_domain_box,
+				partition_weights, d_partitioner_type ) );
+	rendezvous->build( source_mesh_manager );
+	d_search_rendezvous = rendezvous;
+    }
+
+    // Determine the rendezvous destination proc of each point that was not
+    // found locally.
+    Teuchos::Array<int> rendezvous_procs = 
+	rendezvous->procsContainingPoints( search_coords );
+
+    // Get the target points that are in the box in which the rendezvous
+    // decomposition was generated. The rendezvous algorithm will expand the
+    // box slightly based on mesh parameters.
+    Teuchos::Array<GlobalOrdinal> targets_in_box;
+    if ( target_exists )
+    {
+	getTargetPointsInBox( rendezvous->getBox(), search_coords,
+			      search_ordinals, targets_in_box );
+    }
+    d_comm->barrier();
+
+    // Extract those target points that are not in the box. We don't want to
+    // send these to the rendezvous decomposition. The coordinates of the
+    // points in the box are interleaved for sending.
+    GlobalOrdinal num_search = search_ordinals.size();
+    Teuchos::Array<GlobalOrdinal> box_points;
+    Teuchos::Array<int> box_procs;
+    Teuchos::Array<double> box_coords;
+    GlobalOrdinal num_in_box_search = targets_in_box.size();
+    for ( GlobalOrdinal n = 0; n < num_in_box_search; ++n )
+    {
+	if ( targets_in_box[n] != std::numeric_limits<GlobalOrdinal>::max() )
+	{
+	    box_points.push_back( targets_in_box[n] );
+	    box_procs.push_back( rendezvous_procs[n] );
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		box_coords.push_back( search_coords[ num_search*d + n ] );
+	    }
+	}
+    }
+    targets_in_box.clear();
+    rendezvous_procs.clear();
+
+    // Via an inverse communication operation, move the global point ordinals
+    // and coordinates that are in the rendezvous decomposition box to the
+    // rendezvous decomposition.
+    Tpetra::Distributor target_to_rendezvous_distributor( d_comm );
+    GlobalOrdinal num_rendezvous_points = 
+	target_to_rendezvous_distributor.createFromSends( box_procs() );
+
+    Teuchos::ArrayView<const GlobalOrdinal> box_points_view = box_points();
+    Teuchos::Array<GlobalOrdinal> rendezvous_points( num_rendezvous_points );
+    target_to_rendezvous_distributor.doPostsAndWaits( 
+	box_points_view, 1, rendezvous_points() );
+
+    Teuchos::ArrayView<const double> box_coords_view = box_coords();
+    Teuchos::Array<double> rendezvous_point_coords( 
+	num_rendezvous_points*d_dimension );
+    target_to_rendezvous_distributor.doPostsAndWaits( 
+	box_coords_view, d_dimension, rendezvous_point_coords() );
+    box_points.clear();
+    box_procs.clear();
+    box_coords.clear();
+
+    // Get the target process of each rendezvous point from the
+    // target-to-rendezvous distributor.
+    Teuchos::Array<int> point_target_procs;
+    Teuchos::ArrayView<const int> from_images = 
+	target_to_rendezvous_distributor.getImagesFrom();
+    Teuchos::ArrayView<const std::size_t> from_lengths = 
+	target_to_rendezvous_distributor.getLengthsFrom();
+    for ( int i = 0; i < (int) from_images.size(); ++i )
+    {
+	point_target_procs.resize( point_target_procs.size() + from_lengths[i],
+				   from_images[i] );
+    }
+    testInvariant( Teuchos::as<GlobalOrdinal>(point_target_procs.size())
+		   == num_rendezvous_points );
+
+    // Search the rendezvous decomposition with the target points to get the
+    // source elements that contain them.
+    Teuchos::ArrayRCP<double> rendezvous_coords( 
+	num_rendezvous_points*d_dimension, 0.0 );
+    for ( GlobalOrdinal n = 0; n < num_rendezvous_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    rendezvous_coords[ num_rendezvous_points*d + n ] = 
+		rendezvous_point_coords[ d_dimension*n + d ];
+	}
+    }
+    Teuchos::Array<GlobalOrdinal> rendezvous_elements;
+    Teuchos::Array<int> rendezvous_element_src_procs;
+    Teuchos::Array<double> rendezvous_reference_coords;
+    rendezvous->elementsContainingPoints( 
+	rendezvous_coords, rendezvous_elements, 
+	rendezvous_element_src_procs, rendezvous_reference_coords, 
+	tolerance );
+    rendezvous_coords = Teuchos::null;
+
+    // Extract the points we didn't find in any elements in the rendezvous
+    // decomposition. We don't want to send these to the source. If we're
+    // keeping track of missed points, also make a list of those ordinals and
+    // their target processes. The physical and reference coordinates of the
+    // points found are interleaved for sending.
+    Teuchos::Array<GlobalOrdinal> missed_in_mesh_ordinal;
+    Teuchos::Array<int> missed_target_procs;
+    Teuchos::Array<double> found_coords;
+    GlobalOrdinal num_found = 0;
+    for ( GlobalOrdinal n = 0; n < num_rendezvous_points; ++n )
+    {
+	if ( rendezvous_elements[n] == 
+	     std::numeric_limits<GlobalOrdinal>::max() )
+	{
+	    if ( d_store_missed_points )
+	    {
+		missed_in_mesh_ordinal.push_back( rendezvous_points[n] );
+		missed_target_procs.push_back( point_target_procs[n] );
+	    }
+	}
+	else
+	{
+	    testInvariant( rendezvous_element_src_procs[n] != -1 );
+	    rendezvous_points[num_found] = rendezvous_points[n];
+	    rendezvous_elements[num_found] = rendezvous_elements[n];
+	    rendezvous_element_src_procs[num_found] = 
+		rendezvous_element_src_procs[n];
+	    point_target_procs[num_found] = point_target_procs[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		found_coords.push_back( 
+		    rendezvous_point_coords[ d_dimension*n + d ] );
+	    }
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		found_coords.push_back( 
+		    rendezvous_reference_coords[ num_rendezvous_points*d + n ] );
+	    }
+	    ++num_found;
+	}
+    }
+    rendezvous_points.resize( num_found );
+    rendezvous_elements.resize( num_found );
+    rendezvous_element_src_procs.resize( num_found );
+    point_target_procs.resize( num_found );
+    rendezvous_point_coords.clear();
+    rendezvous_reference_coords.clear();
+
+    // If we're keeping track of missed points, send their global ordinals
+    // back to the target decomposition through an inverse communication
+    // operation and add them to the list.
+    if ( d_store_missed_points )
+    {
+	Teuchos::ArrayView<const GlobalOrdinal> missed_in_mesh_ordinal_view = 
+	    missed_in_mesh_ordinal();
+	Tpetra::Distributor rendezvous_to_target_distributor( d_comm );
+	GlobalOrdinal num_missed_targets = 
+	    rendezvous_to_target_distributor.createFromSends( 
+		missed_target_procs() );
+	GlobalOrdinal offset = d_missed_points.size();
+	d_missed_points.resize( offset + num_missed_targets );
+	rendezvous_to_target_distributor.doPostsAndWaits( 
+	    missed_in_mesh_ordinal_view, 1, 
+	    d_missed_points.view( offset, num_missed_targets ) );
+
+	// Convert the missed point global indices to local indices and add
+	// them to the list.
+	for ( GlobalOrdinal n = offset; n < offset+num_missed_targets; ++n )
+	{
+	    d_missed_points[n] = 
+		d_target_g2l.find( d_missed_points[n] )->second;
+	}
+    }
+    missed_in_mesh_ordinal.clear();
+    missed_target_procs.clear();
+
+    // Setup rendezvous-to-source distributor.
+    Tpetra::Distributor rendezvous_to_src_distributor( d_comm );
+    GlobalOrdinal num_source_elements = 
+	rendezvous_to_src_distributor.createFromSends( 
+	    rendezvous_element_src_procs() );
+
+    // Send the rendezvous elements to the source decomposition via inverse
+    // communication. They are appended to the elements found locally.
+    GlobalOrdinal num_mapped = num_local_found + num_source_elements;
+    Teuchos::ArrayView<const GlobalOrdinal> rendezvous_elements_view =
+	rendezvous_elements();
+    d_source_elements.resize( num_mapped );
+    rendezvous_to_src_distributor.doPostsAndWaits( 
+	rendezvous_elements_view, 1, 
+	d_source_elements.view( num_local_found, num_source_elements ) );
+
+    // Send the rendezvous point global ordinals to the source decomposition
+    // via inverse communication.
+    Teuchos::ArrayView<const GlobalOrdinal> reduced_rendezvous_points_view =
+	rendezvous_points();
+    source_points.resize( num_mapped );
+    rendezvous_to_src_distributor.doPostsAndWaits( 
+	reduced_rendezvous_points_view, 1, 
+	source_points.view( num_local_found, num_source_elements ) );
+
+    // Send the target process of each point to the source decomposition.
+    Teuchos::ArrayView<const int> point_target_procs_view = 
+	point_target_procs();
+    d_source_target_procs.resize( num_mapped );
+    rendezvous_to_src_distributor.doPostsAndWaits( 
+	point_target_procs_view, 1, 
+	d_source_target_procs.view( num_local_found, num_source_elements ) );
+
+    // Send the physical and reference coordinates of the rendezvous points
+    // to the source decomposition.
+    Teuchos::ArrayView<const double> found_coords_view = found_coords();
+    Teuchos::Array<double> received_coords( 
+	num_source_elements*2*d_dimension );
+    rendezvous_to_src_distributor.doPostsAndWaits( 
+	found_coords_view, 2*d_dimension, received_coords() );
+
+    // Build the source map from the target ordinals.
+    buildSourceMap( source_points );
+
+    // Copy the coordinates of the points already mapped or found locally
+    // followed by the coordinates of the points found in the rendezvous
+    // decomposition.
+    d_target_coords.resize( num_mapped*coord_dim );
+    Teuchos::Array<double> mapped_reference_coords( num_mapped*d_dimension );
+    for ( int d = 0; d < coord_dim; ++d )
+    {
+	std::copy( source_coords.begin() + d*num_local_found,
+		   source_coords.begin() + (d+1)*num_local_found,
+		   d_target_coords.begin() + d*num_mapped );
+	std::copy( d_reference_coords.begin() + d*num_local_found,
+		   d_reference_coords.begin() + (d+1)*num_local_found,
+		   mapped_reference_coords.begin() + d*num_mapped );
+
+	for ( GlobalOrdinal n = 0; n < num_source_elements; ++n )
+	{
+	    d_target_coords[ d*num_mapped + num_local_found + n ] = 
+		received_coords[ 2*d_dimension*n + d ];
+	    mapped_reference_coords[ d*num_mapped + num_local_found + n ] = 
+		received_coords[ 2*d_dimension*n + d_dimension + d ];
+	}
+    }
+    d_reference_coords.swap( mapped_reference_coords );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the points missed in the map generation.
+ *
+ * \return If store_missed_points is true, return the local indices of the
+ *  points provided by target_coord_manager that were not mapped. An exception
+ *  will be thrown if store_missed_points is false. Returns a null view if all
+ *  points have been mapped or the map has not yet been generated.
 */
 template<class Mesh, class CoordinateField>
 Teuchos::ArrayView<const typename 
@@ -522,6 +1468,16 @@ void SharedDomainMap<Mesh,CoordinateField>::apply(
     const Teuchos::RCP< FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
     Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
 {
+    // Move the data with the persistent transfer plan.
+    if ( d_persistent_transfer )
+    {
+	applyBegin( source_evaluator, target_space_manager );
+	applyEnd( target_space_manager );
+	return;
+    }
+    testPrecondition( !d_directory_free );
+    d_sent_values.clear();
+
     typedef FieldTraits<SourceField> SFT;
     typedef FieldTraits<TargetField> TFT;
 
@@ -539,9 +1495,10 @@ void SharedDomainMap<Mesh,CoordinateField>::apply(
     if ( source_exists )
     {
 	SourceField function_evaluations = 
-	    source_evaluator->evaluate( 
+	    source_evaluator->evaluateReference( 
 		Teuchos::arcpFromArray( d_source_elements ),
-		Teuchos::arcpFromArray( d_target_coords ) );
+		Teuchos::arcpFromArray( d_target_coords ),
+		Teuchos::arcpFromArray( d_reference_coords ) );
 
 	source_dim = SFT::dim( function_evaluations );
 
@@ -597,12 +1554,520 @@ void SharedDomainMap<Mesh,CoordinateField>::apply(
 	FieldTools<TargetField>::putScalar( 
 	    *target_space_manager->field(), 0.0 );
     }
-    d_comm->barrier();
+    d_comm->barrier();
+
+    // Move the data from the source decomposition to the target
+    // decomposition.
+    if ( d_target_global_ids )
+    {
+	target_vector->doImport( *source_vector, 
+				 *d_source_to_target_importer, 
+				 Tpetra::INSERT );
+    }
+    else
+    {
+	target_vector->doExport( *source_vector, 
+				 *d_source_to_target_exporter, 
+				 Tpetra::INSERT );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Apply the shared domain map for several fields at once. All of the
+ * source functions are evaluated at the mapped target points and their
+ * evaluations are packed into the columns of a single multivector such that
+ * all of the fields are moved to the target decomposition in one
+ * communication.
+ *
+ * \param source_evaluators Function evaluators used to apply the mapping,
+ * one for each field. These FieldEvaluators must be valid for the source
+ * used to generate the map. An evaluator may be null on processes without
+ * source.
+ *
+ * \param target_space_managers Target spaces into which the function
+ * evaluations will be written, one for each field in the same order as the
+ * evaluators. Enough space must be allocated to hold evaluations at all
+ * points in all dimensions of each field. A target space may be null on
+ * processes without target points.
+ */
+template<class Mesh, class CoordinateField>
+template<class SourceField, class TargetField>
+void SharedDomainMap<Mesh,CoordinateField>::apply( 
+    const Teuchos::Array<Teuchos::RCP< 
+	FieldEvaluator<GlobalOrdinal,SourceField> > >& source_evaluators,
+    const Teuchos::Array<Teuchos::RCP< 
+	FieldManager<TargetField> > >& target_space_managers )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef FieldTraits<TargetField> TFT;
+
+    testPrecondition( source_evaluators.size() == 
+		      target_space_managers.size() );
+    d_sent_values.clear();
+
+    // Evaluate all of the source functions at the target points and pack
+    // the evaluations into the columns of a single multivector.
+    GlobalOrdinal source_size = d_source_elements.size();
+    Teuchos::ArrayRCP<typename SFT::value_type> source_data;
+    Teuchos::Array<int> field_dims;
+    FieldTransferTools::packFields( 
+	d_comm, d_source_indexer.l2g(0), source_evaluators,
+	Teuchos::arcpFromArray( d_source_elements ),
+	Teuchos::arcpFromArray( d_target_coords ),
+	Teuchos::arcpFromArray( d_reference_coords ),
+	source_size, source_data, field_dims );
+    int num_columns = std::accumulate( field_dims.begin(), 
+				       field_dims.end(), 0 );
+    GlobalOrdinal target_size = d_num_target_points;
+
+    // Move the data for all of the fields from the source decomposition to
+    // the target decomposition. Points that were not mapped get zeros.
+    Teuchos::ArrayRCP<typename TFT::value_type> target_data( 
+	num_columns*target_size, 0 );
+    if ( d_persistent_transfer )
+    {
+	d_transfer_plan->doPosts<typename SFT::value_type>( 
+	    source_data(), num_columns );
+	d_transfer_plan->doWaits<typename TFT::value_type>( target_data() );
+    }
+    else
+    {
+	testPrecondition( !d_directory_free );
+	Teuchos::RCP<Tpetra::MultiVector<typename SFT::value_type, int, GlobalOrdinal> > 
+	    source_vector = Tpetra::createMultiVectorFromView( 
+		d_source_map, source_data, source_size, num_columns );
+	Teuchos::RCP<Tpetra::MultiVector<typename TFT::value_type, int, GlobalOrdinal> > 
+	    target_vector = Tpetra::createMultiVectorFromView( 
+		d_target_map, target_data, target_size, num_columns );
+	if ( d_target_global_ids )
+	{
+	    target_vector->doImport( *source_vector, 
+				     *d_source_to_target_importer, 
+				     Tpetra::INSERT );
+	}
+	else
+	{
+	    target_vector->doExport( *source_vector, 
+				     *d_source_to_target_exporter, 
+				     Tpetra::INSERT );
+	}
+    }
+
+    // Unpack the columns into the target spaces.
+    FieldTransferTools::unpackFields( 
+	d_comm, d_target_indexer.l2g(0), field_dims, 
+	target_data, target_size, target_space_managers );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin applying the shared domain map. The source function is
+ * evaluated at the target points that were mapped and the evaluations are
+ * packed and posted to the target decomposition without waiting for the
+ * communication to complete. The target space is not modified until
+ * applyEnd() is called. This does not synchronize the processes.
+ *
+ * \param source_evaluator Function evaluator used to apply the mapping. This
+ * FieldEvaluator must be valid for the source mesh used to generate the map.
+ *
+ * \param target_space_manager Target space into which the function
+ * evaluations will be written by applyEnd(). Enough space must be allocated
+ * to hold evaluations at all points in all dimensions of the field. The
+ * field must have the same dimension as the function evaluations.
+ */
+template<class Mesh, class CoordinateField>
+template<class SourceField, class TargetField>
+void SharedDomainMap<Mesh,CoordinateField>::applyBegin( 
+    const Teuchos::RCP< FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
+{
+    d_sent_values.clear();
+    FieldTransferTools::postField( 
+	*d_transfer_plan, source_evaluator, 
+	Teuchos::arcpFromArray( d_source_elements ), 
+	Teuchos::arcpFromArray( d_target_coords ),
+	Teuchos::arcpFromArray( d_reference_coords ), 
+	target_space_manager, d_num_target_points );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Progress the communication posted by applyBegin(). This does not
+ * block and may be called any number of times during computation performed
+ * between applyBegin() and applyEnd().
+ *
+ * \return True if the communication for this process has completed.
+ */
+template<class Mesh, class CoordinateField>
+bool SharedDomainMap<Mesh,CoordinateField>::applyProgress()
+{
+    return d_transfer_plan->doProgress();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Finish applying the shared domain map. The communication posted by
+ * applyBegin() is completed and the function evaluations are written into
+ * the target space. Target points that were not mapped get zeros.
+ *
+ * \param target_space_manager The target space given to applyBegin().
+ */
+template<class Mesh, class CoordinateField>
+template<class TargetField>
+void SharedDomainMap<Mesh,CoordinateField>::applyEnd( 
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
+{
+    FieldTransferTools::waitField( *d_transfer_plan, target_space_manager );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Apply the shared domain map by multiplying the source vertex data
+ * by the interpolation operator. No function evaluation is performed. The
+ * map must have been generated with the interpolation operator.
+ *
+ * \param source_dof_manager The source field at the source mesh
+ * vertices. The vertices of each source mesh block follow those of the
+ * previous block in the order given by the mesh manager and the field is
+ * blocked by dimension over all of them. A null RCP is a valid argument on
+ * processes without source mesh.
+ *
+ * \param target_space_manager Target space into which the interpolated
+ * values will be written. Enough space must be allocated to hold the values
+ * at all points in all dimensions of the field. The field must have the same
+ * dimension as the source field. Target points that were not mapped get
+ * zeros.
+ */
+template<class Mesh, class CoordinateField>
+template<class SourceField, class TargetField>
+void SharedDomainMap<Mesh,CoordinateField>::applyOperator( 
+    const Teuchos::RCP< FieldManager<SourceField> >& source_dof_manager,
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef FieldTraits<TargetField> TFT;
+
+    testPrecondition( d_interpolation_operator );
+    testPrecondition( !d_transfer_plan->isPosted() );
+    d_sent_values.clear();
+
+    // Get the dimension of the target space and verify that it has the
+    // proper amount of memory allocated.
+    int num_columns = 0;
+    if ( !target_space_manager.is_null() )
+    {
+	num_columns = TFT::dim( *target_space_manager->field() );
+	testPrecondition( 
+	    Teuchos::as<GlobalOrdinal>( std::distance(
+		TFT::begin( *target_space_manager->field() ),
+		TFT::end( *target_space_manager->field() ) ) ) ==
+	    num_columns*d_num_target_points );
+    }
+
+    // Interpolate the source vertex data at the mapped points and post the
+    // values to the target decomposition. Processes without a source post
+    // the receives for the target space.
+    if ( !source_dof_manager.is_null() )
+    {
+	testPrecondition( target_space_manager.is_null() ||
+			  SFT::dim( *source_dof_manager->field() ) == 
+			  num_columns );
+	num_columns = SFT::dim( *source_dof_manager->field() );
+
+	Teuchos::ArrayRCP<const typename SFT::value_type> source_dofs =
+	    FieldTools<SourceField>::view( *source_dof_manager->field() );
+	testPrecondition( source_dofs.size() == 
+			  num_columns*d_num_source_dofs );
+
+	GlobalOrdinal num_mapped = d_source_elements.size();
+	Teuchos::Array<typename SFT::value_type> source_data( 
+	    num_columns*num_mapped );
+	typename SFT::value_type value;
+	for ( int d = 0; d < num_columns; ++d )
+	{
+	    for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	    {
+		value = 0.0;
+		for ( int k = d_operator_offsets[n]; 
+		      k < d_operator_offsets[n+1]; 
+		      ++k )
+		{
+		    value += d_operator_values[k] * 
+			     source_dofs[ d*d_num_source_dofs + 
+					  d_operator_columns[k] ];
+		}
+		source_data[ d*num_mapped + n ] = value;
+	    }
+	}
+
+	Teuchos::ArrayView<const typename SFT::value_type> source_data_view =
+	    source_data();
+	d_transfer_plan->doPosts( source_data_view, num_columns );
+    }
+    else
+    {
+	d_transfer_plan->doPosts( 
+	    Teuchos::ArrayView<const typename TFT::value_type>(), 
+	    num_columns );
+    }
+
+    // Complete the communication into the target space.
+    applyEnd( target_space_manager );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Apply the shared domain map to the requested target points
+ * only. The target processes send the requested points back to the source
+ * processes that mapped them, the source function is evaluated at those
+ * points only and only their evaluations are sent to the target. All other
+ * target points, including requested points that were not mapped, keep
+ * their values. This is a collective operation.
+ *
+ * \param source_evaluator Function evaluator used to apply the mapping. This
+ * FieldEvaluator must be valid for the source mesh used to generate the map.
+ *
+ * \param target_space_manager Target space into which the function
+ * evaluations will be written. Enough space must be allocated to hold
+ * evaluations at all points in all dimensions of the field.
+ *
+ * \param target_mask A flag for each local target point. The points with a
+ * nonzero flag are applied to.
+ */
+template<class Mesh, class CoordinateField>
+template<class SourceField, class TargetField>
+void SharedDomainMap<Mesh,CoordinateField>::applyMasked( 
+    const Teuchos::RCP< FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager,
+    const Teuchos::ArrayView<const int>& target_mask )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef FieldTraits<TargetField> TFT;
+
+    testPrecondition( !d_transfer_plan->isPosted() );
+    testPrecondition( Teuchos::as<GlobalOrdinal>(target_mask.size()) == 
+		      d_num_target_points );
+    d_sent_values.clear();
+
+    // Get the dimension of the target space and verify that it has the
+    // proper amount of memory allocated.
+    int num_columns = 0;
+    Teuchos::ArrayRCP<typename TFT::value_type> target_field_view(0,0);
+    if ( !target_space_manager.is_null() )
+    {
+	num_columns = TFT::dim( *target_space_manager->field() );
+	testPrecondition( 
+	    Teuchos::as<GlobalOrdinal>( std::distance(
+		TFT::begin( *target_space_manager->field() ),
+		TFT::end( *target_space_manager->field() ) ) ) ==
+	    num_columns*d_num_target_points );
+	target_field_view = FieldTools<TargetField>::nonConstView( 
+	    *target_space_manager->field() );
+    }
+
+    // Flag the mapped points that send to the requested target points.
+    GlobalOrdinal num_mapped = d_source_elements.size();
+    Teuchos::Array<int> source_mask( num_mapped );
+    d_transfer_plan->doReverseFlags( target_mask, source_mask() );
+
+    // Evaluate the source function at the flagged points and put the
+    // evaluations in the rows of those points.
+    Teuchos::Array<typename SFT::value_type> source_data;
+    if ( !source_evaluator.is_null() )
+    {
+	GlobalOrdinal num_masked = 
+	    std::count( source_mask.begin(), source_mask.end(), 1 );
+	Teuchos::Array<GlobalOrdinal> masked_elements( num_masked );
+	Teuchos::Array<double> masked_coords( num_masked*d_dimension );
+	Teuchos::Array<double> masked_reference_coords( 
+	    num_masked*d_dimension );
+	GlobalOrdinal masked_index = 0;
+	for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	{
+	    if ( source_mask[n] )
+	    {
+		masked_elements[masked_index] = d_source_elements[n];
+		for ( int d = 0; d < d_dimension; ++d )
+		{
+		    masked_coords[ num_masked*d + masked_index ] = 
+			d_target_coords[ num_mapped*d + n ];
+		    masked_reference_coords[ num_masked*d + masked_index ] = 
+			d_reference_coords[ num_mapped*d + n ];
+		}
+		++masked_index;
+	    }
+	}
+	testInvariant( masked_index == num_masked );
+
+	SourceField function_evaluations = 
+	    source_evaluator->evaluateReference( 
+		Teuchos::arcpFromArray( masked_elements ),
+		Teuchos::arcpFromArray( masked_coords ),
+		Teuchos::arcpFromArray( masked_reference_coords ) );
+
+	testPrecondition( target_space_manager.is_null() ||
+			  SFT::dim( function_evaluations ) == num_columns );
+	num_columns = SFT::dim( function_evaluations );
+
+	Teuchos::ArrayRCP<const typename SFT::value_type> masked_data =
+	    FieldTools<SourceField>::view( function_evaluations );
+	source_data.resize( num_columns*num_mapped );
+	masked_index = 0;
+	for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	{
+	    if ( source_mask[n] )
+	    {
+		for ( int d = 0; d < num_columns; ++d )
+		{
+		    source_data[ d*num_mapped + n ] = 
+			masked_data[ d*num_masked + masked_index ];
+		}
+		++masked_index;
+	    }
+	}
+    }
+
+    // Send the evaluations of the flagged points to the target.
+    Teuchos::ArrayView<const typename SFT::value_type> source_data_view =
+	source_data();
+    Teuchos::ArrayView<const int> source_mask_view = source_mask();
+    d_transfer_plan->doSparsePostsAndWaits( 
+	source_data_view, num_columns, source_mask_view, target_field_view() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Apply the shared domain map by sending only the function
+ * evaluations that changed since they were last sent. The source function is
+ * evaluated at all of the mapped points and each point with a value that
+ * differs from the value last sent for it by more than the threshold in any
+ * dimension is sent to the target. All other target points keep their
+ * values. Every mapped point is sent by the first delta apply after the map
+ * is generated, changed or applied in any other way. This is a collective
+ * operation.
+ *
+ * The values last sent are kept for each field id given by the client.
+ * Several fields may therefore take turns being sent with delta applies as
+ * long as each field has its own id and is always applied into the same
+ * target space. A target space must not be modified between its delta
+ * applies.
+ *
+ * \param source_evaluator Function evaluator used to apply the mapping. This
+ * FieldEvaluator must be valid for the source mesh used to generate the map.
+ *
+ * \param target_space_manager Target space into which the function
+ * evaluations will be written. Enough space must be allocated to hold
+ * evaluations at all points in all dimensions of the field. This must be the
+ * target space of the previous delta apply with the same field id.
+ *
+ * \param field_id The client id of the field. The values last sent are kept
+ * for this id. It must be the same on all processes.
+ *
+ * \param threshold The absolute change in a value above which it is sent.
+ */
+template<class Mesh, class CoordinateField>
+template<class SourceField, class TargetField>
+void SharedDomainMap<Mesh,CoordinateField>::applyDelta( 
+    const Teuchos::RCP< FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager,
+    const int field_id,
+    const double threshold )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef FieldTraits<TargetField> TFT;
+    typedef Teuchos::Array<typename SFT::value_type> SourceArray;
+
+    testPrecondition( !d_transfer_plan->isPosted() );
+    testPrecondition( 0.0 <= threshold );
+
+    // Get the dimension of the target space and verify that it has the
+    // proper amount of memory allocated.
+    int num_columns = 0;
+    Teuchos::ArrayRCP<typename TFT::value_type> target_field_view(0,0);
+    if ( !target_space_manager.is_null() )
+    {
+	num_columns = TFT::dim( *target_space_manager->field() );
+	testPrecondition( 
+	    Teuchos::as<GlobalOrdinal>( std::distance(
+		TFT::begin( *target_space_manager->field() ),
+		TFT::end( *target_space_manager->field() ) ) ) ==
+	    num_columns*d_num_target_points );
+	target_field_view = FieldTools<TargetField>::nonConstView( 
+	    *target_space_manager->field() );
+    }
+
+    // Evaluate the source function at the mapped points and flag the points
+    // with a value that changed since it was last sent.
+    GlobalOrdinal num_mapped = d_source_elements.size();
+    SourceArray source_data;
+    Teuchos::Array<int> source_flags( num_mapped, 1 );
+    if ( !source_evaluator.is_null() )
+    {
+	SourceField function_evaluations = 
+	    source_evaluator->evaluateReference( 
+		Teuchos::arcpFromArray( d_source_elements ),
+		Teuchos::arcpFromArray( d_target_coords ),
+		Teuchos::arcpFromArray( d_reference_coords ) );
+
+	testPrecondition( target_space_manager.is_null() ||
+			  SFT::dim( function_evaluations ) == num_columns );
+	num_columns = SFT::dim( function_evaluations );
+
+	Teuchos::ArrayRCP<const typename SFT::value_type> evaluations_view =
+	    FieldTools<SourceField>::view( function_evaluations );
+	source_data.assign( evaluations_view.begin(), evaluations_view.end() );
+
+	// Values last sent for this field id with another value type are not
+	// comparable and are dropped.
+	Teuchos::any& sent_entry = d_sent_values[ field_id ];
+	if ( sent_entry.empty() || sent_entry.type() != typeid(SourceArray) )
+	{
+	    sent_entry = SourceArray();
+	}
+	SourceArray& sent_values = Teuchos::any_cast<SourceArray>( sent_entry );
+	if ( sent_values.size() == source_data.size() )
+	{
+	    for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	    {
+		source_flags[n] = 0;
+		for ( int d = 0; d < num_columns; ++d )
+		{
+		    if ( std::abs( source_data[ d*num_mapped + n ] - 
+				   sent_values[ d*num_mapped + n ] ) 
+			 > threshold )
+		    {
+			source_flags[n] = 1;
+		    }
+		}
+	    }
+	}
+	else
+	{
+	    sent_values.resize( source_data.size() );
+	}
+
+	// Keep the values that are sent.
+	for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	{
+	    if ( source_flags[n] )
+	    {
+		for ( int d = 0; d < num_columns; ++d )
+		{
+		    sent_values[ d*num_mapped + n ] = 
+			source_data[ d*num_mapped + n ];
+		}
+	    }
+	}
+    }
 
-    // Move the data from the source decomposition to the target
-    // decomposition.
-    target_vector->doExport( *source_vector, *d_source_to_target_exporter, 
-			     Tpetra::INSERT );
+    // Send the changed evaluations to the target.
+    Teuchos::ArrayView<const typename SFT::value_type> source_data_view =
+	source_data();
+    Teuchos::ArrayView<const int> source_flags_view = source_flags();
+    d_transfer_plan->doSparsePostsAndWaits( 
+	source_data_view, num_columns, source_flags_view, 
+	target_field_view() );
 }
 
 //---------------------------------------------------------------------------//
@@ -637,33 +2102,145 @@ void SharedDomainMap<Mesh,CoordinateField>::computePointOrdinals(
     }
     d_comm->barrier();
 
-    GlobalOrdinal global_max;
-    Teuchos::reduceAll<int,GlobalOrdinal>( *d_comm,
-					   Teuchos::REDUCE_MAX,
-					   1,
-					   &local_size,
-					   &global_max );
-
-    target_ordinals.resize( local_size );
-    for ( GlobalOrdinal n = 0; n < local_size; ++n )
+    // Use the client global ids if we have them. Otherwise number the points
+    // on each process above those of the lower processes.
+    if ( d_target_global_ids )
     {
-	target_ordinals[n] = comm_rank*global_max + n;
+	testPrecondition( Teuchos::as<GlobalOrdinal>(d_target_ids.size()) 
+			  == local_size );
+	target_ordinals = d_target_ids;
+    }
+    else
+    {
+	GlobalOrdinal global_max;
+	Teuchos::reduceAll<int,GlobalOrdinal>( *d_comm,
+					       Teuchos::REDUCE_MAX,
+					       1,
+					       &local_size,
+					       &global_max );
+
+	target_ordinals.resize( local_size );
+	for ( GlobalOrdinal n = 0; n < local_size; ++n )
+	{
+	    target_ordinals[n] = comm_rank*global_max + n;
+	}
+    }
 
-	// If we're keeping track of missed points, we also need to build the
-	// global-to-local ordinal map.
-	if ( d_store_missed_points )
+    // If we're keeping track of missed points, we also need to build the
+    // global-to-local ordinal map. The directory-free transfer plan also
+    // needs it to find the target local index of each mapped point.
+    if ( d_store_missed_points || d_directory_free )
+    {
+	for ( GlobalOrdinal n = 0; n < local_size; ++n )
 	{
 	    d_target_g2l[ target_ordinals[n] ] = n;
 	}
     }
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the target points owned by this process. A target global id
+ * may be on several processes. Each id is sent to the process it hashes to
+ * and that process gives ownership to the lowest process that has the
+ * id. This is a collective operation.
+ *
+ * \param target_ordinals The global ids of the local target points.
+ *
+ * \param target_coords The blocked coordinates of the local target points.
+ *
+ * \param owned_ordinals The global ids of the local target points owned by
+ * this process.
+ *
+ * \param owned_coords The blocked coordinates of the local target points
+ * owned by this process.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::getOwnedTargetPoints(
+    const Teuchos::Array<GlobalOrdinal>& target_ordinals,
+    const Teuchos::ArrayRCP<double>& target_coords,
+    Teuchos::Array<GlobalOrdinal>& owned_ordinals,
+    Teuchos::ArrayRCP<double>& owned_coords )
+{
+    int comm_rank = d_comm->getRank();
+    int comm_size = d_comm->getSize();
+    GlobalOrdinal num_points = target_ordinals.size();
+
+    // Send each global id and the process that has it to the process the id
+    // hashes to.
+    Teuchos::Array<int> hash_procs( num_points );
+    for ( GlobalOrdinal n = 0; n < num_points; ++n )
+    {
+	hash_procs[n] = 
+	    ( target_ordinals[n] % comm_size + comm_size ) % comm_size;
+    }
+    Tpetra::Distributor hash_distributor( d_comm );
+    GlobalOrdinal num_received = 
+	hash_distributor.createFromSends( hash_procs() );
+    Teuchos::ArrayView<const GlobalOrdinal> target_ordinals_view = 
+	target_ordinals();
+    Teuchos::Array<GlobalOrdinal> received_ordinals( num_received );
+    hash_distributor.doPostsAndWaits( 
+	target_ordinals_view, 1, received_ordinals() );
+    Teuchos::Array<int> point_procs( num_points, comm_rank );
+    Teuchos::ArrayView<const int> point_procs_view = point_procs();
+    Teuchos::Array<int> received_procs( num_received );
+    hash_distributor.doPostsAndWaits( 
+	point_procs_view, 1, received_procs() );
+
+    // The lowest process that has an id owns it.
+    Teuchos::Array<std::pair<GlobalOrdinal,int> > id_procs( num_received );
+    for ( GlobalOrdinal n = 0; n < num_received; ++n )
+    {
+	id_procs[n] = std::make_pair( received_ordinals[n], received_procs[n] );
+    }
+    std::sort( id_procs.begin(), id_procs.end() );
+    Teuchos::Array<int> received_owned( num_received );
+    typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::const_iterator
+	id_it;
+    for ( GlobalOrdinal n = 0; n < num_received; ++n )
+    {
+	id_it = std::lower_bound( id_procs.begin(), id_procs.end(),
+				  std::make_pair( received_ordinals[n], 0 ) );
+	received_owned[n] = ( id_it->second == received_procs[n] );
+    }
+
+    // Send the ownership back to the processes that have the ids.
+    Teuchos::ArrayView<const int> received_owned_view = received_owned();
+    Teuchos::Array<int> point_owned( num_points );
+    hash_distributor.doReversePostsAndWaits( 
+	received_owned_view, 1, point_owned() );
+
+    // Extract the owned points.
+    GlobalOrdinal num_owned = 
+	std::count( point_owned.begin(), point_owned.end(), 1 );
+    owned_ordinals.resize( num_owned );
+    owned_coords = Teuchos::ArrayRCP<double>( num_owned*d_dimension, 0.0 );
+    GlobalOrdinal owned_index = 0;
+    for ( GlobalOrdinal n = 0; n < num_points; ++n )
+    {
+	if ( point_owned[n] )
+	{
+	    owned_ordinals[owned_index] = target_ordinals[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		owned_coords[ num_owned*d + owned_index ] = 
+		    target_coords[ num_points*d + n ];
+	    }
+	    ++owned_index;
+	}
+    }
+    testInvariant( owned_index == num_owned );
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Get the target points that are in the rendezvous decomposition box.
  *
- * \param target_coord_manager The manager containing the target coordinates
- * to search the box with.
+ * \param box The box to search.
+ *
+ * \param target_coords The blocked target coordinates to search the box
+ * with.
  *
  * \param target_ordinals The globally unique ordinals for the target
  * coordinates. 
@@ -674,26 +2251,22 @@ void SharedDomainMap<Mesh,CoordinateField>::computePointOrdinals(
  */
 template<class Mesh, class CoordinateField>
 void SharedDomainMap<Mesh,CoordinateField>::getTargetPointsInBox(
-    const BoundingBox& box, const CoordinateField& target_coords,
+    const BoundingBox& box, const Teuchos::ArrayRCP<double>& target_coords,
     const Teuchos::Array<GlobalOrdinal>& target_ordinals,
     Teuchos::Array<GlobalOrdinal>& targets_in_box )
 {
-    Teuchos::ArrayRCP<const double> target_coords_view =
-	FieldTools<CoordinateField>::view( target_coords );
-    GlobalOrdinal dim_size = 
-	FieldTools<CoordinateField>::dimSize( target_coords );
+    GlobalOrdinal dim_size = target_ordinals.size();
 
-    testPrecondition( dim_size == 
-		      Teuchos::as<GlobalOrdinal>(target_ordinals.size()) );
+    testPrecondition( dim_size*d_dimension == 
+		      Teuchos::as<GlobalOrdinal>(target_coords.size()) );
 
     targets_in_box.resize( dim_size );
-    int field_dim = CFT::dim( target_coords );
-    Teuchos::Array<double> target_point( field_dim );
+    Teuchos::Array<double> target_point( d_dimension );
     for ( GlobalOrdinal n = 0; n < dim_size; ++n )
     {
-	for ( int d = 0; d < field_dim; ++d )
+	for ( int d = 0; d < d_dimension; ++d )
 	{
-	    target_point[d] = target_coords_view[ dim_size*d + n ];
+	    target_point[d] = target_coords[ dim_size*d + n ];
 	}
 
 	if ( box.pointInBox( target_point ) )
@@ -710,8 +2283,721 @@ void SharedDomainMap<Mesh,CoordinateField>::getTargetPointsInBox(
 	if ( d_store_missed_points && targets_in_box[n] == 
 	     std::numeric_limits<GlobalOrdinal>::max() )
 	{
-	    d_missed_points.push_back(n);
+	    d_missed_points.push_back( 
+		d_target_g2l.find( target_ordinals[n] )->second );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Search the local source mesh for the local target points.
+ *
+ * \param source_mesh_manager The local source mesh.
+ *
+ * \param target_coords The blocked local target coordinates.
+ *
+ * \param target_ordinals The globally unique ordinals for the target
+ * coordinates.
+ *
+ * \param tolerance Absolute tolerance for point searching.
+ *
+ * \param local_points The global ordinals of the target points mapped to
+ * the local source elements. The points found in the local source mesh are
+ * appended to this list and their elements are appended to the local source
+ * element list.
+ *
+ * \param local_coords The blocked coordinates of the target points mapped to
+ * the local source elements. The coordinates of the points found in the
+ * local source mesh are appended to each block.
+ *
+ * \param search_ordinals The global ordinals of the target points not found
+ * in the local source mesh.
+ *
+ * \param search_coords The blocked coordinates of the target points not found
+ * in the local source mesh.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::localSearch(
+    const RCP_MeshManager& source_mesh_manager,
+    const Teuchos::ArrayRCP<double>& target_coords,
+    const Teuchos::Array<GlobalOrdinal>& target_ordinals,
+    double tolerance,
+    Teuchos::Array<GlobalOrdinal>& local_points,
+    Teuchos::Array<double>& local_coords,
+    Teuchos::Array<GlobalOrdinal>& search_ordinals,
+    Teuchos::ArrayRCP<double>& search_coords )
+{
+    GlobalOrdinal num_points = target_ordinals.size();
+    testPrecondition( num_points*d_dimension == 
+		      Teuchos::as<GlobalOrdinal>(target_coords.size()) );
+
+    testPrecondition( !d_local_tree.is_null() );
+
+    // Search the local tree with the target points.
+    Teuchos::Array<GlobalOrdinal> elements;
+    Teuchos::Array<short int> points_found;
+    Teuchos::Array<double> reference_coords;
+    d_local_tree->findPoints( target_coords.getRawPtr(), num_points, 
+			      elements, points_found, reference_coords, 
+			      tolerance );
+
+    // Split the points into those found locally and those that must be
+    // searched for in the rendezvous decomposition.
+    GlobalOrdinal num_found = 
+	num_points - std::count( points_found.begin(), points_found.end(), 0 );
+    GlobalOrdinal num_search = num_points - num_found;
+    GlobalOrdinal offset = local_points.size();
+    GlobalOrdinal num_mapped = offset + num_found;
+    d_source_elements.resize( num_mapped );
+    d_source_target_procs.resize( num_mapped, d_comm->getRank() );
+    local_points.resize( num_mapped );
+    Teuchos::Array<double> mapped_coords( num_mapped*d_dimension );
+    Teuchos::Array<double> mapped_reference_coords( num_mapped*d_dimension );
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	std::copy( local_coords.begin() + d*offset,
+		   local_coords.begin() + (d+1)*offset,
+		   mapped_coords.begin() + d*num_mapped );
+	std::copy( d_reference_coords.begin() + d*offset,
+		   d_reference_coords.begin() + (d+1)*offset,
+		   mapped_reference_coords.begin() + d*num_mapped );
+    }
+    search_ordinals.resize( num_search );
+    search_coords = Teuchos::ArrayRCP<double>( num_search*d_dimension, 0.0 );
+
+    GlobalOrdinal found_index = offset;
+    GlobalOrdinal search_index = 0;
+    for ( GlobalOrdinal n = 0; n < num_points; ++n )
+    {
+	if ( points_found[n] )
+	{
+	    d_source_elements[found_index] = elements[n];
+	    local_points[found_index] = target_ordinals[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		mapped_coords[ num_mapped*d + found_index ] = 
+		    target_coords[ num_points*d + n ];
+		mapped_reference_coords[ num_mapped*d + found_index ] = 
+		    reference_coords[ num_points*d + n ];
+	    }
+	    ++found_index;
+	}
+	else
+	{
+	    search_ordinals[search_index] = target_ordinals[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		search_coords[ num_search*d + search_index ] = 
+		    target_coords[ num_points*d + n ];
+	    }
+	    ++search_index;
+	}
+    }
+    testPostcondition( found_index == num_mapped );
+    testPostcondition( search_index == num_search );
+
+    local_coords.swap( mapped_coords );
+    d_reference_coords.swap( mapped_reference_coords );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Search for the target points in the source mesh of the processes
+ * whose local bounding box contains them.
+ *
+ * \param source_mesh_manager The local source mesh. May be null on
+ * processes without source mesh.
+ *
+ * \param target_coords The blocked local target coordinates to route.
+ *
+ * \param target_ordinals The globally unique ordinals for the target
+ * coordinates.
+ *
+ * \param tolerance Absolute tolerance for point searching.
+ *
+ * \param source_points The global ordinals of the target points mapped to
+ * the local source elements. The points found in the local source mesh are
+ * appended to this list and their elements are appended to the local source
+ * element list.
+ *
+ * \param source_coords The blocked coordinates of the target points mapped
+ * to the local source elements. The coordinates of the points found in the
+ * local source mesh are appended to each block.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::directSearch(
+    const RCP_MeshManager& source_mesh_manager,
+    const Teuchos::ArrayRCP<double>& target_coords,
+    const Teuchos::Array<GlobalOrdinal>& target_ordinals,
+    double tolerance,
+    Teuchos::Array<GlobalOrdinal>& source_points,
+    Teuchos::Array<double>& source_coords )
+{
+    bool source_exists = true;
+    if ( source_mesh_manager.is_null() ) source_exists = false;
+
+    GlobalOrdinal num_points = target_ordinals.size();
+    testPrecondition( num_points*d_dimension == 
+		      Teuchos::as<GlobalOrdinal>(target_coords.size()) );
+
+    // Get the bounding box of the local source mesh blocks.
+    BoundingBox local_box;
+    bool has_box = false;
+    if ( source_exists )
+    {
+	Teuchos::Tuple<double,6> local_bounds;
+	Teuchos::Tuple<double,6> block_bounds;
+	MeshBlockIterator block_iterator;
+	for ( block_iterator = source_mesh_manager->blocksBegin();
+	      block_iterator != source_mesh_manager->blocksEnd();
+	      ++block_iterator )
+	{
+	    if ( MeshTools<Mesh>::numVertices( *(*block_iterator) ) > 0 )
+	    {
+		block_bounds = 
+		    MeshTools<Mesh>::localBoundingBox( *(*block_iterator) )
+		    .getBounds();
+		if ( !has_box )
+		{
+		    local_bounds = block_bounds;
+		    has_box = true;
+		}
+		for ( int d = 0; d < 3; ++d )
+		{
+		    local_bounds[d] = 
+			std::min( local_bounds[d], block_bounds[d] );
+		    local_bounds[d+3] = 
+			std::max( local_bounds[d+3], block_bounds[d+3] );
+		}
+	    }
+	}
+	if ( has_box )
+	{
+	    local_box = BoundingBox( local_bounds );
+	}
+    }
+    d_comm->barrier();
+
+    // Route the target points to every source process whose box contains
+    // them. The routes are sorted by process such that the search results
+    // come back in the same order.
+    BoxRouter router( d_comm, d_dimension, local_box, has_box, tolerance );
+    Teuchos::Array<int> point_indices;
+    Teuchos::Array<int> point_procs;
+    router.routePoints( target_coords(), point_indices, point_procs );
+
+    int num_routes = point_indices.size();
+    Teuchos::Array<std::pair<int,int> > route_order( num_routes );
+    for ( int r = 0; r < num_routes; ++r )
+    {
+	route_order[r] = std::make_pair( point_procs[r], point_indices[r] );
+    }
+    std::sort( route_order.begin(), route_order.end() );
+
+    Teuchos::Array<int> route_procs( num_routes );
+    Teuchos::Array<GlobalOrdinal> route_ordinals( num_routes );
+    Teuchos::Array<double> route_coords( num_routes*d_dimension );
+    for ( int r = 0; r < num_routes; ++r )
+    {
+	route_procs[r] = route_order[r].first;
+	route_ordinals[r] = target_ordinals[ route_order[r].second ];
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    route_coords[ d_dimension*r + d ] = 
+		target_coords[ num_points*d + route_order[r].second ];
+	}
+    }
+    point_indices.clear();
+    point_procs.clear();
+
+    // Send the target point ordinals and coordinates to the source
+    // processes.
+    Tpetra::Distributor target_to_source_distributor( d_comm );
+    GlobalOrdinal num_received = 
+	target_to_source_distributor.createFromSends( route_procs() );
+
+    Teuchos::ArrayView<const GlobalOrdinal> route_ordinals_view =
+	route_ordinals();
+    Teuchos::Array<GlobalOrdinal> received_ordinals( num_received );
+    target_to_source_distributor.doPostsAndWaits( 
+	route_ordinals_view, 1, received_ordinals() );
+
+    Teuchos::ArrayView<const double> route_coords_view = route_coords();
+    Teuchos::Array<double> received_coords( num_received*d_dimension );
+    target_to_source_distributor.doPostsAndWaits( 
+	route_coords_view, d_dimension, received_coords() );
+
+    // Search the local source mesh with the received points.
+    Teuchos::Array<GlobalOrdinal> elements;
+    Teuchos::Array<short int> points_found;
+    Teuchos::Array<double> reference_coords;
+    Teuchos::Array<int> received_found( num_received, 0 );
+    if ( source_exists && num_received > 0 )
+    {
+	Teuchos::Array<double> blocked_coords( num_received*d_dimension );
+	for ( GlobalOrdinal n = 0; n < num_received; ++n )
+	{
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		blocked_coords[ num_received*d + n ] = 
+		    received_coords[ d_dimension*n + d ];
+	    }
+	}
+
+	testInvariant( !d_local_tree.is_null() );
+	d_local_tree->findPoints( blocked_coords.getRawPtr(), num_received,
+				  elements, points_found, reference_coords,
+				  tolerance );
+
+	for ( GlobalOrdinal n = 0; n < num_received; ++n )
+	{
+	    received_found[n] = points_found[n];
+	}
+    }
+    d_comm->barrier();
+
+    // Send the search results back to the target processes via reverse
+    // communication. Each point is accepted by the lowest source process
+    // that found it.
+    Teuchos::ArrayView<const int> received_found_view = received_found();
+    Teuchos::Array<int> route_found( num_routes );
+    target_to_source_distributor.doReversePostsAndWaits(
+	received_found_view, 1, route_found() );
+
+    Teuchos::Array<short int> point_accepted( num_points, 0 );
+    Teuchos::Array<int> route_accepted( num_routes, 0 );
+    for ( int r = 0; r < num_routes; ++r )
+    {
+	if ( route_found[r] && !point_accepted[route_order[r].second] )
+	{
+	    point_accepted[route_order[r].second] = 1;
+	    route_accepted[r] = 1;
+	}
+    }
+
+    // If we're keeping track of missed points, add the points that were not
+    // found by any source process to the list.
+    if ( d_store_missed_points )
+    {
+	for ( GlobalOrdinal n = 0; n < num_points; ++n )
+	{
+	    if ( !point_accepted[n] )
+	    {
+		d_missed_points.push_back( 
+		    d_target_g2l.find( target_ordinals[n] )->second );
+	    }
+	}
+    }
+
+    // Send the acceptance back to the source processes.
+    Teuchos::ArrayView<const int> route_accepted_view = route_accepted();
+    Teuchos::Array<int> received_accepted( num_received );
+    target_to_source_distributor.doPostsAndWaits( 
+	route_accepted_view, 1, received_accepted() );
+
+    // Get the target process of each received point.
+    Teuchos::Array<int> received_procs;
+    Teuchos::ArrayView<const int> from_images = 
+	target_to_source_distributor.getImagesFrom();
+    Teuchos::ArrayView<const std::size_t> from_lengths = 
+	target_to_source_distributor.getLengthsFrom();
+    for ( int i = 0; i < (int) from_images.size(); ++i )
+    {
+	received_procs.resize( received_procs.size() + from_lengths[i],
+			       from_images[i] );
+    }
+    testInvariant( Teuchos::as<GlobalOrdinal>(received_procs.size()) ==
+		   num_received );
+
+    // Append the accepted points to the local source elements.
+    GlobalOrdinal num_accepted = std::count( received_accepted.begin(),
+					     received_accepted.end(), 1 );
+    GlobalOrdinal offset = source_points.size();
+    GlobalOrdinal num_mapped = offset + num_accepted;
+    Teuchos::Array<double> mapped_coords( num_mapped*d_dimension );
+    Teuchos::Array<double> mapped_reference_coords( num_mapped*d_dimension );
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	std::copy( source_coords.begin() + d*offset,
+		   source_coords.begin() + (d+1)*offset,
+		   mapped_coords.begin() + d*num_mapped );
+	std::copy( d_reference_coords.begin() + d*offset,
+		   d_reference_coords.begin() + (d+1)*offset,
+		   mapped_reference_coords.begin() + d*num_mapped );
+    }
+
+    GlobalOrdinal mapped_index = offset;
+    for ( GlobalOrdinal n = 0; n < num_received; ++n )
+    {
+	if ( received_accepted[n] )
+	{
+	    d_source_elements.push_back( elements[n] );
+	    d_source_target_procs.push_back( received_procs[n] );
+	    source_points.push_back( received_ordinals[n] );
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		mapped_coords[ num_mapped*d + mapped_index ] =
+		    received_coords[ d_dimension*n + d ];
+		mapped_reference_coords[ num_mapped*d + mapped_index ] =
+		    reference_coords[ num_received*d + n ];
+	    }
+	    ++mapped_index;
+	}
+    }
+    testPostcondition( mapped_index == num_mapped );
+
+    source_coords.swap( mapped_coords );
+    d_reference_coords.swap( mapped_reference_coords );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the kD-tree over the local source mesh blocks for local and
+ * direct search.
+ *
+ * \param source_mesh_manager The local source mesh.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::buildLocalTree(
+    const RCP_MeshManager& source_mesh_manager )
+{
+    testPrecondition( !source_mesh_manager.is_null() );
+
+    d_local_mesh = createRendezvousMeshFromMesh( *source_mesh_manager );
+    testPostcondition( !d_local_mesh.is_null() );
+    d_local_tree = Teuchos::rcp( 
+	new KDTree<GlobalOrdinal>( d_local_mesh, d_dimension ) );
+    testPostcondition( !d_local_tree.is_null() );
+    d_local_tree->build();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Refit the kD-tree over the local source mesh blocks to the moved
+ * source mesh. The source mesh must have the same blocks, vertices, and
+ * elements as when the tree was built.
+ *
+ * \param source_mesh_manager The moved local source mesh.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::refitLocalTree(
+    const RCP_MeshManager& source_mesh_manager )
+{
+    testPrecondition( !source_mesh_manager.is_null() );
+    testPrecondition( !d_local_tree.is_null() );
+
+    // Count the local source vertices.
+    GlobalOrdinal num_vertices = 0;
+    MeshBlockIterator block_iterator;
+    for ( block_iterator = source_mesh_manager->blocksBegin();
+	  block_iterator != source_mesh_manager->blocksEnd();
+	  ++block_iterator )
+    {
+	num_vertices += MeshTools<Mesh>::numVertices( *(*block_iterator) );
+    }
+
+    // Write the moved coordinates in Moab vertex order. The vertices of each
+    // block are one sequence in the local mesh in the order of the block
+    // coordinates.
+    Teuchos::Array<double> vertex_coords( 3*num_vertices, 0.0 );
+    GlobalOrdinal offset = 0;
+    GlobalOrdinal num_block_vertices = 0;
+    Teuchos::ArrayRCP<const double> block_coords;
+    for ( block_iterator = source_mesh_manager->blocksBegin();
+	  block_iterator != source_mesh_manager->blocksEnd();
+	  ++block_iterator )
+    {
+	num_block_vertices = 
+	    MeshTools<Mesh>::numVertices( *(*block_iterator) );
+	block_coords = MeshTools<Mesh>::coordsView( *(*block_iterator) );
+	for ( GlobalOrdinal n = 0; n < num_block_vertices; ++n )
+	{
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		vertex_coords[ 3*(offset + n) + d ] = 
+		    block_coords[ d*num_block_vertices + n ];
+	    }
+	}
+	offset += num_block_vertices;
+    }
+
+    d_local_mesh->setVertexCoords( vertex_coords() );
+    d_local_tree->refit();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the source map and the source-to-target exporter. In
+ * directory-free mode the transfer plan is built directly from the target
+ * process of each mapped point instead.
+ *
+ * \param source_points The global ordinals of the target points mapped to
+ * the local source elements.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::buildSourceMap(
+    const Teuchos::Array<GlobalOrdinal>& source_points )
+{
+    // The values sent by applyDelta() are for the old mapped points.
+    d_sent_values.clear();
+
+    if ( d_directory_free )
+    {
+	testPrecondition( source_points.size() == 
+			  d_source_target_procs.size() );
+
+	// Points mapped on their own target process are permuted locally and
+	// all others are sent to their target process.
+	int comm_rank = d_comm->getRank();
+	GlobalOrdinal num_mapped = source_points.size();
+	Teuchos::Array<int> permute_from;
+	Teuchos::Array<int> permute_to;
+	Teuchos::Array<int> export_lids;
+	Teuchos::Array<int> export_procs;
+	Teuchos::Array<GlobalOrdinal> export_ordinals;
+	for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+	{
+	    if ( comm_rank == d_source_target_procs[n] )
+	    {
+		permute_from.push_back( n );
+		permute_to.push_back( 
+		    d_target_g2l.find( source_points[n] )->second );
+	    }
+	    else
+	    {
+		export_lids.push_back( n );
+		export_procs.push_back( d_source_target_procs[n] );
+		export_ordinals.push_back( source_points[n] );
+	    }
+	}
+
+	// Send the point ordinals to the target processes to get the target
+	// local index of the data each process will receive.
+	Tpetra::Distributor source_to_target_distributor( d_comm );
+	GlobalOrdinal num_remote = 
+	    source_to_target_distributor.createFromSends( export_procs() );
+	Teuchos::ArrayView<const GlobalOrdinal> export_ordinals_view =
+	    export_ordinals();
+	Teuchos::Array<GlobalOrdinal> remote_ordinals( num_remote );
+	source_to_target_distributor.doPostsAndWaits( 
+	    export_ordinals_view, 1, remote_ordinals() );
+	Teuchos::Array<int> remote_lids( num_remote );
+	for ( GlobalOrdinal n = 0; n < num_remote; ++n )
+	{
+	    remote_lids[n] = d_target_g2l.find( remote_ordinals[n] )->second;
+	}
+
+	d_transfer_plan = Teuchos::rcp( 
+	    new TransferPlan( d_comm, source_to_target_distributor,
+			      export_lids(), export_procs(), remote_lids(),
+			      permute_from(), permute_to() ) );
+	testPostcondition( !d_transfer_plan.is_null() );
+	return;
+    }
+
+    // Build the source map from the target ordinals.
+    Teuchos::ArrayView<const GlobalOrdinal> source_points_view = 
+	source_points();
+    d_source_map = Tpetra::createNonContigMap<int,GlobalOrdinal>( 
+	source_points_view, d_comm );
+    testPostcondition( !d_source_map.is_null() );
+
+    // If the target points have global ids, build the source-to-target
+    // importer. A point mapped once is imported into each of its copies.
+    if ( d_target_global_ids )
+    {
+	d_source_to_target_importer = 
+	  Teuchos::rcp( new Tpetra::Import<int,GlobalOrdinal>(
+			      d_source_map, d_target_map ) );
+	testPostcondition( !d_source_to_target_importer.is_null() );
+
+	// Compile the split-phase communication plan from the importer.
+	d_transfer_plan = Teuchos::rcp( 
+	    new TransferPlan( d_comm, *d_source_to_target_importer ) );
+	testPostcondition( !d_transfer_plan.is_null() );
+	return;
+    }
+
+    // Build the source-to-target exporter.
+    d_source_to_target_exporter = 
+      Teuchos::rcp( new Tpetra::Export<int,GlobalOrdinal>(
+			  d_source_map, d_target_map ) );
+    testPostcondition( !d_source_to_target_exporter.is_null() );
+
+    // Compile the split-phase communication plan from the exporter.
+    d_transfer_plan = Teuchos::rcp( 
+	new TransferPlan( d_comm, *d_source_to_target_exporter ) );
+    testPostcondition( !d_transfer_plan.is_null() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Index the local source mesh vertices and elements by ordinal.
+ *
+ * \param source_mesh_manager The local source mesh.
+ *
+ * \param vertex_tables The vertex ordinals of each block paired with their
+ * index in the block, sorted by ordinal.
+ *
+ * \param element_table The element ordinals of all blocks paired with their
+ * index in element_locations, sorted by ordinal.
+ *
+ * \param element_locations The block and the index in the block of each
+ * element.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::indexSourceMesh(
+    const RCP_MeshManager& source_mesh_manager,
+    Teuchos::Array<Teuchos::Array<std::pair<GlobalOrdinal,int> > >& 
+    vertex_tables,
+    Teuchos::Array<std::pair<GlobalOrdinal,int> >& element_table,
+    Teuchos::Array<std::pair<int,GlobalOrdinal> >& element_locations ) const
+{
+    testPrecondition( !source_mesh_manager.is_null() );
+
+    int num_blocks = source_mesh_manager->getNumBlocks();
+    vertex_tables.resize( num_blocks );
+    element_table.clear();
+    element_locations.clear();
+    MeshBlockIterator block_iterator;
+    int b = 0;
+    for ( block_iterator = source_mesh_manager->blocksBegin();
+	  block_iterator != source_mesh_manager->blocksEnd();
+	  ++block_iterator, ++b )
+    {
+	Teuchos::ArrayRCP<const GlobalOrdinal> vertices =
+	    MeshTools<Mesh>::verticesView( *(*block_iterator) );
+	GlobalOrdinal num_vertices = vertices.size();
+	vertex_tables[b].resize( num_vertices );
+	for ( GlobalOrdinal i = 0; i < num_vertices; ++i )
+	{
+	    vertex_tables[b][i] = std::make_pair( vertices[i], i );
+	}
+	std::sort( vertex_tables[b].begin(), vertex_tables[b].end() );
+
+	Teuchos::ArrayRCP<const GlobalOrdinal> elements =
+	    MeshTools<Mesh>::elementsView( *(*block_iterator) );
+	GlobalOrdinal num_elements = elements.size();
+	for ( GlobalOrdinal i = 0; i < num_elements; ++i )
+	{
+	    element_table.push_back( 
+		std::make_pair( elements[i], element_locations.size() ) );
+	    element_locations.push_back( std::make_pair( b, i ) );
+	}
+    }
+    std::sort( element_table.begin(), element_table.end() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the interpolation operator for the mapped points. Each row
+ * holds the shape function values of the source element of a mapped point
+ * at its reference coordinates. The columns are the local source vertices
+ * with the vertices of each block following those of the previous block.
+ *
+ * \param source_mesh_manager The source mesh used to map the points. A null
+ * RCP is a valid argument on processes without source mesh.
+ */
+template<class Mesh, class CoordinateField>
+void SharedDomainMap<Mesh,CoordinateField>::buildInterpolationOperator(
+    const RCP_MeshManager& source_mesh_manager )
+{
+    GlobalOrdinal num_mapped = d_source_elements.size();
+    d_num_source_dofs = 0;
+    d_operator_offsets.assign( 1, 0 );
+    d_operator_columns.clear();
+    d_operator_values.clear();
+    if ( source_mesh_manager.is_null() )
+    {
+	testInvariant( 0 == num_mapped );
+	return;
+    }
+
+    // Index the vertices and elements of each block by ordinal and get
+    // views of the block connectivity.
+    Teuchos::Array<Teuchos::Array<std::pair<GlobalOrdinal,int> > > 
+	vertex_tables;
+    Teuchos::Array<std::pair<GlobalOrdinal,int> > element_table;
+    Teuchos::Array<std::pair<int,GlobalOrdinal> > element_locations;
+    indexSourceMesh( source_mesh_manager, vertex_tables, 
+		     element_table, element_locations );
+
+    int num_blocks = source_mesh_manager->getNumBlocks();
+    Teuchos::Array<int> vertex_offsets( num_blocks );
+    Teuchos::Array<GlobalOrdinal> block_num_elements( num_blocks );
+    Teuchos::Array<Teuchos::ArrayRCP<const GlobalOrdinal> > 
+	block_connectivity( num_blocks );
+    Teuchos::Array<Teuchos::ArrayRCP<const int> > 
+	block_permutation( num_blocks );
+    MeshBlockIterator block_iterator;
+    int b = 0;
+    for ( block_iterator = source_mesh_manager->blocksBegin();
+	  block_iterator != source_mesh_manager->blocksEnd();
+	  ++block_iterator, ++b )
+    {
+	vertex_offsets[b] = d_num_source_dofs;
+	d_num_source_dofs += vertex_tables[b].size();
+	block_num_elements[b] = 
+	    MeshTools<Mesh>::numElements( *(*block_iterator) );
+	block_connectivity[b] = 
+	    MeshTools<Mesh>::connectivityView( *(*block_iterator) );
+	block_permutation[b] = 
+	    MeshTools<Mesh>::permutationView( *(*block_iterator) );
+    }
+
+    // Add a row for each mapped point with the shape function values of its
+    // element in the columns of the element vertices. The shape functions
+    // are in canonical vertex order.
+    d_operator_offsets.reserve( num_mapped + 1 );
+    double reference_point[3];
+    double shape_values[8];
+    typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::const_iterator
+	element_it;
+    typename Teuchos::Array<std::pair<GlobalOrdinal,int> >::const_iterator
+	vertex_it;
+    GlobalOrdinal element;
+    GlobalOrdinal vertex;
+    for ( GlobalOrdinal n = 0; n < num_mapped; ++n )
+    {
+	element_it = std::lower_bound( 
+	    element_table.begin(), element_table.end(),
+	    std::make_pair( d_source_elements[n], 0 ) );
+	testInvariant( element_it != element_table.end() &&
+		       element_it->first == d_source_elements[n] );
+	b = element_locations[ element_it->second ].first;
+	element = element_locations[ element_it->second ].second;
+
+	block_iterator = source_mesh_manager->blocksBegin() + b;
+	int vertices_per_element = MT::verticesPerElement( *(*block_iterator) );
+	moab::EntityType element_topology = moab_topology_table[ 
+	    MT::elementTopology( *(*block_iterator) ) ];
+	testPrecondition( TopologyTools::hasShapeFunctions( 
+			      element_topology, vertices_per_element,
+			      d_dimension ) );
+
+	for ( int d = 0; d < 3; ++d )
+	{
+	    reference_point[d] = ( d < d_dimension ) ?
+				 d_reference_coords[ num_mapped*d + n ] : 0.0;
+	}
+	TopologyTools::shapeFunctions( 
+	    element_topology, reference_point, shape_values );
+
+	for ( int i = 0; i < vertices_per_element; ++i )
+	{
+	    vertex = block_connectivity[b][ 
+		i*block_num_elements[b] + element ];
+	    vertex_it = std::lower_bound( 
+		vertex_tables[b].begin(), vertex_tables[b].end(),
+		std::make_pair( vertex, 0 ) );
+	    testInvariant( vertex_it != vertex_tables[b].end() &&
+			   vertex_it->first == vertex );
+	    d_operator_columns.push_back( vertex_offsets[b] + vertex_it->second );
+	    d_operator_values.push_back( 
+		shape_values[ block_permutation[b][i] ] );
 	}
+	d_operator_offsets.push_back( d_operator_columns.size() );
     }
 }
 
@@ -0,0 +1,231 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_TargetDensityWeights.cpp
+ * \author Stuart R. Slattery
+ * \brief TargetDensityWeights definition.
+ */
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <cmath>
+
+#include "DTK_TargetDensityWeights.hpp"
+#include "DTK_Assertion.hpp"
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_Tuple.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor.
+ *
+ * \param comm The communicator over which the histograms are summed.
+ *
+ * \param box The box over which the histogram bins are defined.
+ *
+ * \param dimension The dimension of the points.
+ *
+ * \param num_bins The number of histogram bins in each dimension.
+ */
+TargetDensityWeights::TargetDensityWeights( const RCP_Comm& comm,
+					    const BoundingBox& box,
+					    const int dimension,
+					    const int num_bins )
+    : d_comm( comm )
+    , d_dimension( dimension )
+    , d_num_bins( num_bins )
+{
+    testPrecondition( 0 < dimension && dimension <= 3 );
+    testPrecondition( 0 < num_bins );
+
+    Teuchos::Tuple<double,6> bounds = box.getBounds();
+    int num_total_bins = 1;
+    for ( int d = 0; d < 3; ++d )
+    {
+	d_lower[d] = bounds[d];
+	d_inv_width[d] = 0.0;
+	if ( d < d_dimension )
+	{
+	    if ( bounds[d+3] > bounds[d] )
+	    {
+		d_inv_width[d] = d_num_bins / ( bounds[d+3] - bounds[d] );
+	    }
+	    num_total_bins *= d_num_bins;
+	}
+    }
+
+    d_source_counts.assign( num_total_bins, 0.0 );
+    d_target_counts.assign( num_total_bins, 0.0 );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor.
+ */
+TargetDensityWeights::~TargetDensityWeights()
+{ /* ... */ }
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a blocked list of local source vertex coordinates to the
+ * histogram. 
+ *
+ * \param coords The vertex coordinates blocked by dimension.
+ */
+void TargetDensityWeights::addSourcePoints( 
+    const Teuchos::ArrayView<const double>& coords )
+{
+    addPoints( coords, d_source_counts );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a blocked list of local target point coordinates to the
+ * histogram. 
+ *
+ * \param coords The point coordinates blocked by dimension.
+ */
+void TargetDensityWeights::addTargetPoints( 
+    const Teuchos::ArrayView<const double>& coords )
+{
+    addPoints( coords, d_target_counts );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Sum the local histograms over the communicator. This is a
+ * collective operation and must be called after all local points have been
+ * added and before any weights are computed.
+ */
+void TargetDensityWeights::reduce()
+{
+    int num_total_bins = d_source_counts.size();
+
+    Teuchos::Array<double> global_counts( num_total_bins );
+    Teuchos::reduceAll<int,double>( *d_comm, Teuchos::REDUCE_SUM,
+				    num_total_bins,
+				    d_source_counts.getRawPtr(),
+				    global_counts.getRawPtr() );
+    d_source_counts.swap( global_counts );
+
+    global_counts.assign( num_total_bins, 0.0 );
+    Teuchos::reduceAll<int,double>( *d_comm, Teuchos::REDUCE_SUM,
+				    num_total_bins,
+				    d_target_counts.getRawPtr(),
+				    global_counts.getRawPtr() );
+    d_target_counts.swap( global_counts );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the weights of a blocked list of points.
+ *
+ * \param coords The point coordinates blocked by dimension.
+ *
+ * \param weights The weight of each point.
+ */
+void TargetDensityWeights::pointWeights( 
+    const Teuchos::ArrayView<const double>& coords,
+    const Teuchos::ArrayView<float>& weights ) const
+{
+    testPrecondition( coords.size() % d_dimension == 0 );
+    testPrecondition( weights.size() == coords.size() / d_dimension );
+
+    int num_points = coords.size() / d_dimension;
+    double point[3];
+    int bin = 0;
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	bin = binIndex( point );
+	weights[n] = 1.0 + d_target_counts[bin] / 
+		     std::max( d_source_counts[bin], 1.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the histogram bin of a point. Points outside of the histogram
+ * box are in the nearest bin.
+ */
+int TargetDensityWeights::binIndex( const double point[] ) const
+{
+    int bin = 0;
+    int stride = 1;
+    double index = 0.0;
+    for ( int d = 0; d < d_dimension; ++d )
+    {
+	index = std::floor( (point[d] - d_lower[d]) * d_inv_width[d] );
+	index = std::max( 0.0, std::min( index, d_num_bins - 1.0 ) );
+	bin += stride * static_cast<int>( index );
+	stride *= d_num_bins;
+    }
+    return bin;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Add a blocked list of points to a histogram.
+ */
+void TargetDensityWeights::addPoints( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<double>& counts ) const
+{
+    testPrecondition( coords.size() % d_dimension == 0 );
+
+    int num_points = coords.size() / d_dimension;
+    double point[3];
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	counts[ binIndex( point ) ] += 1.0;
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// end DTK_TargetDensityWeights.cpp
+//---------------------------------------------------------------------------//
@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_TargetDensityWeights.hpp
+ * \author Stuart R. Slattery
+ * \brief TargetDensityWeights declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_TARGETDENSITYWEIGHTS_HPP
+#define DTK_TARGETDENSITYWEIGHTS_HPP
+
+#include "DTK_PartitionWeights.hpp"
+#include "DTK_BoundingBox.hpp"
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class TargetDensityWeights
+ * \brief Partition weights from the density of target points.
+
+ The rendezvous search work of a process is proportional to the number of
+ target points that land in its partition, not the number of source vertices
+ it stores. These weights are built from global histograms of the source
+ vertices and target points over a uniform grid of bins in a bounding
+ box. Each source vertex carries its own storage cost of one plus its share of
+ the target points in its bin:
+
+ \f[
+   w = 1 + \frac{T_b}{S_b}
+ \f]
+
+ where \f$T_b\f$ and \f$S_b\f$ are the number of target points and source
+ vertices in bin \f$b\f$. The total weight of a partition is then its number
+ of source vertices plus approximately the number of target points it will
+ search. Points outside of the box are counted in the nearest bin.
+ */
+//---------------------------------------------------------------------------//
+class TargetDensityWeights : public PartitionWeights
+{
+  public:
+
+    //@{
+    //! Typedefs.
+    typedef Teuchos::Comm<int>                  CommType;
+    typedef Teuchos::RCP<const CommType>        RCP_Comm;
+    //@}
+
+    // Constructor.
+    TargetDensityWeights( const RCP_Comm& comm,
+			  const BoundingBox& box,
+			  const int dimension,
+			  const int num_bins = 16 );
+
+    // Destructor.
+    ~TargetDensityWeights();
+
+    // Add a blocked list of local source vertex coordinates to the
+    // histogram.
+    void addSourcePoints( const Teuchos::ArrayView<const double>& coords );
+
+    // Add a blocked list of local target point coordinates to the
+    // histogram.
+    void addTargetPoints( const Teuchos::ArrayView<const double>& coords );
+
+    // Sum the local histograms over the communicator.
+    void reduce();
+
+    // Compute the weights of a blocked list of points.
+    void pointWeights( const Teuchos::ArrayView<const double>& coords,
+		       const Teuchos::ArrayView<float>& weights ) const;
+
+  private:
+
+    // Get the histogram bin of a point.
+    int binIndex( const double point[] ) const;
+
+    // Add a blocked list of points to a histogram.
+    void addPoints( const Teuchos::ArrayView<const double>& coords,
+		    Teuchos::Array<double>& counts ) const;
+
+  private:
+
+    // Communicator over which the histograms are summed.
+    RCP_Comm d_comm;
+
+    // Histogram dimension.
+    int d_dimension;
+
+    // Number of bins in each dimension.
+    int d_num_bins;
+
+    // Lower bound of the histogram in each dimension.
+    double d_lower[3];
+
+    // Inverse bin width in each dimension.
+    double d_inv_width[3];
+
+    // Source vertex histogram.
+    Teuchos::Array<double> d_source_counts;
+
+    // Target point histogram.
+    Teuchos::Array<double> d_target_counts;
+};
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_TARGETDENSITYWEIGHTS_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_TargetDensityWeights.hpp
+//---------------------------------------------------------------------------//
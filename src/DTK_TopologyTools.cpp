@@ -39,6 +39,8 @@
 //---------------------------------------------------------------------------//
 
 #include <vector>
+#include <algorithm>
+#include <limits>
 
 #include "DTK_CellTopologyFactory.hpp"
 #include "DTK_TopologyTools.hpp"
@@ -75,27 +77,95 @@ namespace DataTransferKit
  *
  * \return Return true if the point is in the element, false if not.
  */
-bool TopologyTools::pointInElement( Teuchos::Array<double> coords,
+bool TopologyTools::pointInElement( const Teuchos::Array<double>& coords,
 				    const moab::EntityHandle element,
 				    const Teuchos::RCP<moab::Interface>& moab,
 				    double epsilon )
 {
-    // Wrap the point in a field container.
+    double reference_point[3];
+    return pointInElement( coords, element, moab, reference_point, epsilon );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Point in element query that also returns the coordinates of the
+ * point in the reference frame of the element. Pyramids are resolved with
+ * two tetrahedrons and have no reference frame of their own. Their
+ * reference coordinates are NaN.
+ *
+ * \param coords The coords to search the element with. The coordinates must
+ * have a dimension less than or equal to 3.
+ *
+ * \param element The Moab mesh element to check for point inclusion.
+ *
+ * \param moab The Moab interface owning the element.
+ *
+ * \param reference_point The point mapped to the reference frame of the
+ * element padded to 3 dimensions with zeros. Valid whether or not the point
+ * is in the element.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ *
+ * \return Return true if the point is in the element, false if not.
+ */
+bool TopologyTools::pointInElement( const Teuchos::Array<double>& coords,
+				    const moab::EntityHandle element,
+				    const Teuchos::RCP<moab::Interface>& moab,
+				    double reference_point[3],
+				    double epsilon )
+{
     int vertex_dim = coords.size();
     testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
 
+    // Get the element topology.
+    moab::EntityType element_topology = moab->type_from_handle( element );
+
+    // Get the element connectivity.
+    rememberValue( moab::ErrorCode error );
+    const moab::EntityHandle* connectivity = 0;
+    int num_connectivity = 0;
+#if HAVE_DTK_DBC
+    error = moab->get_connectivity( element, connectivity, num_connectivity );
+#else
+    moab->get_connectivity( element, connectivity, num_connectivity );
+#endif
+    testInvariant( error == moab::MB_SUCCESS );
+
+    // Use the analytic kernel for the element if there is one. Everything
+    // here lives on the stack.
+    if ( hasPointInElementKernel( 
+	     element_topology, num_connectivity, vertex_dim ) )
+    {
+	double kernel_vertex_coords[24];
+#if HAVE_DTK_DBC
+	error = moab->get_coords( 
+	    connectivity, num_connectivity, kernel_vertex_coords );
+#else
+	moab->get_coords( connectivity, num_connectivity, kernel_vertex_coords );
+#endif
+	testInvariant( error == moab::MB_SUCCESS );
+
+	double kernel_point[3] = { 0.0, 0.0, 0.0 };
+	for ( int d = 0; d < vertex_dim; ++d )
+	{
+	    kernel_point[d] = coords[d];
+	}
+	return pointInElement( kernel_point, element_topology, 
+			       kernel_vertex_coords, reference_point, epsilon );
+    }
+
+    // Otherwise fall back to Intrepid. Wrap the point in a field container.
     Teuchos::Tuple<int,2> point_dimensions;
     point_dimensions[0] = 1;
     point_dimensions[1] = vertex_dim;
-    Teuchos::ArrayRCP<double> coords_view = Teuchos::arcpFromArray( coords );
+    Teuchos::Array<double> point_coords( coords );
+    Teuchos::ArrayRCP<double> coords_view = 
+	Teuchos::arcpFromArray( point_coords );
     Intrepid::FieldContainer<double> point(
 	Teuchos::Array<int>(point_dimensions), coords_view );
 
-    // Get the element topology.
-    moab::EntityType element_topology = moab->type_from_handle( element );
-
     // Get the element vertices.
-    rememberValue( moab::ErrorCode error );
     std::vector<moab::EntityHandle> element_vertices;
 #if HAVE_DTK_DBC
     error = moab->get_adjacencies( &element,
@@ -154,16 +224,21 @@ bool TopologyTools::pointInElement( Teuchos::Array<double> coords,
 	    Teuchos::arcpFromArray( cell_vertex_coords ) );
 
 	// Map the point to the reference frame of the cell.
-	Intrepid::FieldContainer<double> reference_point( 1, vertex_dim );
-	Intrepid::CellTools<double>::mapToReferenceFrame( reference_point,
+	Intrepid::FieldContainer<double> cell_reference_point( 1, vertex_dim );
+	Intrepid::CellTools<double>::mapToReferenceFrame( cell_reference_point,
 							  point,
 							  cell_vertices,
 							  *cell_topo,
 							  0 );
+	for ( int d = 0; d < 3; ++d )
+	{
+	    reference_point[d] = 
+		( d < vertex_dim ) ? cell_reference_point(0,d) : 0.0;
+	}
 
 	// Check for reference point inclusion in the reference cell.
 	return Intrepid::CellTools<double>::checkPointsetInclusion( 
-	    reference_point, *cell_topo, epsilon );
+	    cell_reference_point, *cell_topo, epsilon );
     }
 
     // We have to handle pyramids differently because Intrepid doesn't
@@ -172,6 +247,9 @@ bool TopologyTools::pointInElement( Teuchos::Array<double> coords,
     // instead.
     else
     {
+	std::fill( reference_point, reference_point + 3,
+		   std::numeric_limits<double>::quiet_NaN() );
+
 	// Create the Shards topology for the linear tetrahedrons.
 	Teuchos::RCP<shards::CellTopology> cell_topo = 
 	    CellTopologyFactory::create( moab::MBTET, 4 );
@@ -256,6 +334,244 @@ bool TopologyTools::pointInElement( Teuchos::Array<double> coords,
     }
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if an analytic point-in-element kernel exists for an
+ * element. Kernels exist for linear line segments, triangles,
+ * quadrilaterals, tetrahedrons, pyramids, wedges, and hexahedrons with a
+ * point of the same dimension as the element.
+ *
+ * \param element_topology The element topology.
+ *
+ * \param num_element_vertices The number of vertices in the element.
+ *
+ * \param dim The dimension of the point to search the element with.
+ *
+ * \return Return true if a kernel exists for the element, false if not.
+ */
+bool TopologyTools::hasPointInElementKernel( 
+    const moab::EntityType element_topology,
+    const int num_element_vertices,
+    const int dim )
+{
+    switch ( element_topology )
+    {
+	case moab::MBEDGE:
+	    return ( PointInElementKernel<moab::MBEDGE>::num_vertices == 
+		     num_element_vertices &&
+		     PointInElementKernel<moab::MBEDGE>::dim == dim );
+	case moab::MBTRI:
+	    return ( PointInElementKernel<moab::MBTRI>::num_vertices == 
+		     num_element_vertices &&
+		     PointInElementKernel<moab::MBTRI>::dim == dim );
+	case moab::MBQUAD:
+	    return ( PointInElementKernel<moab::MBQUAD>::num_vertices == 
+		     num_element_vertices &&
+		     PointInElementKernel<moab::MBQUAD>::dim == dim );
+	case moab::MBTET:
+	    return ( PointInElementKernel<moab::MBTET>::num_vertices == 
+		     num_element_vertices &&
+		     PointInElementKernel<moab::MBTET>::dim == dim );
+	case moab::MBPYRAMID:
+	    return ( 5 == num_element_vertices && 3 == dim );
+	case moab::MBPRISM:
+	    return ( PointInElementKernel<moab::MBPRISM>::num_vertices == 
+		     num_element_vertices &&
+		     PointInElementKernel<moab::MBPRISM>::dim == dim );
+	case moab::MBHEX:
+	    return ( PointInElementKernel<moab::MBHEX>::num_vertices == 
+		     num_element_vertices &&
+		     PointInElementKernel<moab::MBHEX>::dim == dim );
+	default:
+	    return false;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Analytic point-in-element query on element vertex coordinates. A
+ * kernel must exist for the element.
+ *
+ * \param point The point to search the element with padded to 3 dimensions.
+ *
+ * \param element_topology The element topology.
+ *
+ * \param element_vertex_coords The interleaved element vertex coordinates (
+ * x_0, y_0, z_0, x_1, y_1, z_1, ... ).
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ *
+ * \return Return true if the point is in the element, false if not.
+ */
+bool TopologyTools::pointInElement( const double point[3],
+				    const moab::EntityType element_topology,
+				    const double* element_vertex_coords,
+				    double tolerance )
+{
+    double reference_point[3];
+    return pointInElement( point, element_topology, element_vertex_coords,
+			   reference_point, tolerance );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Analytic point-in-element query on element vertex coordinates that
+ * also returns the coordinates of the point in the reference frame of the
+ * element. A kernel must exist for the element. Pyramids are resolved with
+ * two tetrahedrons and have no reference frame of their own. Their
+ * reference coordinates are NaN.
+ *
+ * \param point The point to search the element with padded to 3 dimensions.
+ *
+ * \param element_topology The element topology.
+ *
+ * \param element_vertex_coords The interleaved element vertex coordinates (
+ * x_0, y_0, z_0, x_1, y_1, z_1, ... ).
+ *
+ * \param reference_point The point mapped to the reference frame of the
+ * element padded to 3 dimensions with zeros.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ *
+ * \return Return true if the point is in the element, false if not.
+ */
+bool TopologyTools::pointInElement( const double point[3],
+				    const moab::EntityType element_topology,
+				    const double* element_vertex_coords,
+				    double reference_point[3],
+				    double tolerance )
+{
+    switch ( element_topology )
+    {
+	case moab::MBEDGE:
+	    return kernelPointInElement<PointInElementKernel<moab::MBEDGE> >(
+		point, element_vertex_coords, reference_point, tolerance );
+	case moab::MBTRI:
+	    return kernelPointInElement<PointInElementKernel<moab::MBTRI> >(
+		point, element_vertex_coords, reference_point, tolerance );
+	case moab::MBQUAD:
+	    return kernelPointInElement<PointInElementKernel<moab::MBQUAD> >(
+		point, element_vertex_coords, reference_point, tolerance );
+	case moab::MBTET:
+	    return kernelPointInElement<PointInElementKernel<moab::MBTET> >(
+		point, element_vertex_coords, reference_point, tolerance );
+	case moab::MBPRISM:
+	    return kernelPointInElement<PointInElementKernel<moab::MBPRISM> >(
+		point, element_vertex_coords, reference_point, tolerance );
+	case moab::MBHEX:
+	    return kernelPointInElement<PointInElementKernel<moab::MBHEX> >(
+		point, element_vertex_coords, reference_point, tolerance );
+
+	// Pyramids are resolved with two linear tetrahedrons as in the
+	// Intrepid path.
+	case moab::MBPYRAMID:
+	{
+	    static const int tets[2][4] = { {0, 1, 2, 4}, {0, 2, 3, 4} };
+	    double tet_vertex_coords[12];
+	    double tet_reference_point[3];
+	    std::fill( reference_point, reference_point + 3,
+		       std::numeric_limits<double>::quiet_NaN() );
+	    for ( int t = 0; t < 2; ++t )
+	    {
+		for ( int i = 0; i < 4; ++i )
+		{
+		    for ( int d = 0; d < 3; ++d )
+		    {
+			tet_vertex_coords[3*i+d] = 
+			    element_vertex_coords[ 3*tets[t][i] + d ];
+		    }
+		}
+		if ( kernelPointInElement<PointInElementKernel<moab::MBTET> >(
+			 point, tet_vertex_coords, tet_reference_point, 
+			 tolerance ) )
+		{
+		    return true;
+		}
+	    }
+	    return false;
+	}
+
+	default:
+	    testPrecondition( false );
+	    return false;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Determine if linear Lagrange shape functions exist for an
+ * element. They exist for every element with an analytic point-in-element
+ * kernel except pyramids, which have no reference frame of their own.
+ *
+ * \param element_topology The element topology.
+ *
+ * \param num_element_vertices The number of vertices in the element.
+ *
+ * \param dim The dimension of the element.
+ *
+ * \return Return true if shape functions exist for the element, false if
+ * not.
+ */
+bool TopologyTools::hasShapeFunctions( 
+    const moab::EntityType element_topology,
+    const int num_element_vertices,
+    const int dim )
+{
+    return ( moab::MBPYRAMID != element_topology &&
+	     hasPointInElementKernel( 
+		 element_topology, num_element_vertices, dim ) );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Linear Lagrange shape function values at a reference point. Shape
+ * functions must exist for the element.
+ *
+ * \param element_topology The element topology.
+ *
+ * \param reference_point The point in the reference frame of the element
+ * padded to 3 dimensions.
+ *
+ * \param values The value of the shape function of each element vertex in
+ * canonical vertex order. Must hold a value for each element vertex.
+ */
+void TopologyTools::shapeFunctions( const moab::EntityType element_topology,
+				    const double reference_point[3],
+				    double* values )
+{
+    switch ( element_topology )
+    {
+	case moab::MBEDGE:
+	    PointInElementKernel<moab::MBEDGE>::shapeFunctions( 
+		reference_point, values );
+	    break;
+	case moab::MBTRI:
+	    PointInElementKernel<moab::MBTRI>::shapeFunctions( 
+		reference_point, values );
+	    break;
+	case moab::MBQUAD:
+	    PointInElementKernel<moab::MBQUAD>::shapeFunctions( 
+		reference_point, values );
+	    break;
+	case moab::MBTET:
+	    PointInElementKernel<moab::MBTET>::shapeFunctions( 
+		reference_point, values );
+	    break;
+	case moab::MBPRISM:
+	    PointInElementKernel<moab::MBPRISM>::shapeFunctions( 
+		reference_point, values );
+	    break;
+	case moab::MBHEX:
+	    PointInElementKernel<moab::MBHEX>::shapeFunctions( 
+		reference_point, values );
+	    break;
+	default:
+	    testPrecondition( false );
+    }
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Box-element overlap query.
@@ -308,6 +624,28 @@ bool TopologyTools::boxElementOverlap(
 #endif
     testInvariant( error == moab::MB_SUCCESS );
 
+    return boxElementOverlap( box, element_topology, 
+			      &element_vertex_coords[0] );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Box-element overlap query on element vertex coordinates.
+ *
+ * \param box The box to check overlap with.
+ *
+ * \param element_topology The element topology.
+ *
+ * \param element_vertex_coords The interleaved element vertex coordinates (
+ * x_0, y_0, z_0, x_1, y_1, z_1, ... ).
+ *
+ * \return Return true if the box and element overlap, false if not.
+ */
+bool TopologyTools::boxElementOverlap( 
+    const BoundingBox& box,
+    const moab::EntityType element_topology,
+    const double* element_vertex_coords )
+{
     // Extract box values.
     Teuchos::Tuple<double,6> bounds = box.getBounds();
     double half_dims[3] = { (bounds[3]-bounds[0])/2,
@@ -319,7 +657,7 @@ bool TopologyTools::boxElementOverlap(
 
     // Check for overlap.
     return moab::GeomUtil::box_elem_overlap( 
-	(moab::CartVect*) &element_vertex_coords[0],
+	(const moab::CartVect*) element_vertex_coords,
 	element_topology,
 	(moab::CartVect) center,
 	(moab::CartVect) half_dims );
@@ -72,16 +72,62 @@ class TopologyTools
 
     // Point-in-element query.
     static bool pointInElement( 
-	Teuchos::Array<double> coords,
+	const Teuchos::Array<double>& coords,
 	const moab::EntityHandle element,
 	const Teuchos::RCP<moab::Interface>& moab,
 	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
 
+    // Point-in-element query that also returns the reference coordinates.
+    static bool pointInElement( 
+	const Teuchos::Array<double>& coords,
+	const moab::EntityHandle element,
+	const Teuchos::RCP<moab::Interface>& moab,
+	double reference_point[3],
+	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Determine if an analytic point-in-element kernel exists for an element.
+    static bool hasPointInElementKernel( 
+	const moab::EntityType element_topology,
+	const int num_element_vertices,
+	const int dim );
+
+    // Analytic point-in-element query on element vertex coordinates.
+    static bool pointInElement( 
+	const double point[3],
+	const moab::EntityType element_topology,
+	const double* element_vertex_coords,
+	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Analytic point-in-element query that also returns the reference
+    // coordinates.
+    static bool pointInElement( 
+	const double point[3],
+	const moab::EntityType element_topology,
+	const double* element_vertex_coords,
+	double reference_point[3],
+	double tolerance = 10*Teuchos::ScalarTraits<double>::eps() );
+
+    // Determine if linear Lagrange shape functions exist for an element.
+    static bool hasShapeFunctions( 
+	const moab::EntityType element_topology,
+	const int num_element_vertices,
+	const int dim );
+
+    // Linear Lagrange shape function values at a reference point.
+    static void shapeFunctions( const moab::EntityType element_topology,
+				const double reference_point[3],
+				double* values );
+
     // Box-element overlap query.
     static bool boxElementOverlap( const BoundingBox& box,
 				   const moab::EntityHandle element,
 				   const Teuchos::RCP<moab::Interface>& moab );
 
+    // Box-element overlap query on element vertex coordinates.
+    static bool boxElementOverlap( const BoundingBox& box,
+				   const moab::EntityType element_topology,
+				   const double* element_vertex_coords );
+
     // Element-in-geometry query.
     template<class Geometry>
     static bool elementInGeometry( const Geometry& geometry,
@@ -89,6 +135,24 @@ class TopologyTools
 				   const Teuchos::RCP<moab::Interface>& moab,
 				   const double tolerance,
 				   bool all_vertices_for_inclusion );
+
+    // Element-in-geometry query on element vertex coordinates.
+    template<class Geometry>
+    static bool elementInGeometry( const Geometry& geometry,
+				   const double* element_vertex_coords,
+				   const int num_element_vertices,
+				   const double tolerance,
+				   bool all_vertices_for_inclusion );
+
+  private:
+
+    // Point-in-element query with a kernel.
+    template<class Kernel>
+    static inline bool kernelPointInElement( 
+	const double point[3],
+	const double* element_vertex_coords,
+	double reference_point[3],
+	double tolerance );
 };
 
 } // end namepsace DataTransferKit
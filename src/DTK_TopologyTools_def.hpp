@@ -42,6 +42,7 @@
 #define DTK_TOPOLOGYTOOLS_DEF_HPP
 
 #include "DTK_GeometryTraits.hpp"
+#include "DTK_PointInElementKernels.hpp"
 #include "DTK_Assertion.hpp"
 #include "DataTransferKit_config.hpp"
 
@@ -113,6 +114,44 @@ bool TopologyTools::elementInGeometry(
 #endif
     testInvariant( error == moab::MB_SUCCESS );
 
+    return elementInGeometry( geometry, &element_vertex_coords[0], 
+			      num_element_vertices, tolerance,
+			      all_vertices_for_inclusion );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Element-in-geometry query on element vertex coordinates.
+ *
+ * \param geometry The geometry.
+ *
+ * \param element_vertex_coords The interleaved element vertex coordinates (
+ * x_0, y_0, z_0, x_1, y_1, z_1, ... ).
+ *
+ * \param num_element_vertices The number of element vertices.
+ *
+ * \param tolerance Tolerance used for element vertex-in-geometry
+ * checks.
+ *
+ * \param all_vertices_for_inclusion Flag for element-in-geometry
+ * inclusion. If set to true, all of an element's vertices are required to
+ * reside within a geometry within the geometric tolerance in order to be
+ * considered a member of that geometry's conformal mesh. If set to false,
+ * only one of an element's vertices must be contained within the geometric
+ * tolerance of the geometry in order to be considered a member of that
+ * geometry's conformal mesh.
+ *
+ * \return Return true if any of the element's vertices are in the
+ * geometry. This is based on the conformal mesh/geometry assumption.
+ */
+template<class Geometry>
+bool TopologyTools::elementInGeometry( 
+    const Geometry& geometry,
+    const double* element_vertex_coords,
+    const int num_element_vertices,
+    const double tolerance,
+    bool all_vertices_for_inclusion )
+{
     // Check the vertex coordinates for inclusion in the geometry. 
     Teuchos::Array<double> vertex_coords(3);
     int verts_in_geometry = 0;
@@ -149,6 +188,37 @@ bool TopologyTools::elementInGeometry(
     }
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Point-in-element query with a kernel.
+ *
+ * \param point The point to search the element with padded to 3 dimensions.
+ *
+ * \param element_vertex_coords The interleaved element vertex coordinates.
+ *
+ * \param reference_point The point mapped to the reference frame of the
+ * element padded to 3 dimensions with zeros.
+ *
+ * \param tolerance Absolute tolerance for point searching. Will be used when
+ * checking the reference cell ( and is therefore absolute ).
+ *
+ * \return Return true if the point is in the element, false if not.
+ */
+template<class Kernel>
+inline bool TopologyTools::kernelPointInElement( 
+    const double point[3],
+    const double* element_vertex_coords,
+    double reference_point[3],
+    double tolerance )
+{
+    reference_point[0] = 0.0;
+    reference_point[1] = 0.0;
+    reference_point[2] = 0.0;
+    return ( Kernel::mapToReferenceFrame( 
+		 point, element_vertex_coords, reference_point ) &&
+	     Kernel::pointInReferenceElement( reference_point, tolerance ) );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namepsace DataTransferKit
@@ -0,0 +1,510 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+ * \file DTK_TransferPlan.cpp
+ * \author Stuart R. Slattery
+ * \brief TransferPlan definition.
+ */
+//---------------------------------------------------------------------------//
+
+#include <algorithm>
+#include <utility>
+#include <cstring>
+
+#include "DTK_TransferPlan.hpp"
+#include "DTK_Assertion.hpp"
+
+#include <Teuchos_as.hpp>
+
+#ifdef HAVE_DTK_MPI
+#include <Teuchos_DefaultMpiComm.hpp>
+#endif
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Distributor constructor. This is a collective operation over the
+ * communicator.
+ *
+ * \param comm The communicator over which the distributor was built.
+ *
+ * \param distributor A distributor built from the destination processes of
+ * the exported source data. The plan does not keep a reference to the
+ * distributor.
+ *
+ * \param export_lids The source local indices to send in the order given to
+ * the distributor.
+ *
+ * \param export_procs The destination process of each source local index to
+ * send. Data that stays on this process must be given as permutes instead.
+ *
+ * \param remote_lids The target local indices of the received data in the
+ * order the distributor receives it.
+ *
+ * \param permute_from The source local indices of the data that stays on
+ * this process.
+ *
+ * \param permute_to The target local indices of the data that stays on this
+ * process.
+ */
+TransferPlan::TransferPlan( const RCP_Comm& comm,
+			    const Tpetra::Distributor& distributor,
+			    const Teuchos::ArrayView<const int>& export_lids,
+			    const Teuchos::ArrayView<const int>& export_procs,
+			    const Teuchos::ArrayView<const int>& remote_lids,
+			    const Teuchos::ArrayView<const int>& permute_from,
+			    const Teuchos::ArrayView<const int>& permute_to )
+    : d_comm( comm )
+    , d_num_same( 0 )
+    , d_permute_from( permute_from.begin(), permute_from.end() )
+    , d_permute_to( permute_to.begin(), permute_to.end() )
+    , d_remote_lids( remote_lids.begin(), remote_lids.end() )
+    , d_num_columns( 0 )
+    , d_scalar_size( 0 )
+    , d_posted( false )
+{
+    testPrecondition( d_permute_from.size() == d_permute_to.size() );
+    testPrecondition( !distributor.hasSelfMessage() );
+
+    buildMessages( distributor, export_lids, export_procs );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor. Messages that are still posted are completed.
+ */
+TransferPlan::~TransferPlan()
+{
+    if ( d_posted )
+    {
+	waitMessages();
+    }
+    freeRequests();
+
+#ifdef HAVE_DTK_MPI
+    if ( d_raw_comm != MPI_COMM_NULL )
+    {
+	MPI_Comm_free( &d_raw_comm );
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Progress the posted messages. This does not block and may be called
+ * any number of times between doPosts() and doWaits().
+ *
+ * \return True if all of the posted messages have completed.
+ */
+bool TransferPlan::doProgress()
+{
+    if ( !d_posted )
+    {
+	return true;
+    }
+
+    int complete = 1;
+#ifdef HAVE_DTK_MPI
+    if ( d_requests.size() > 0 )
+    {
+	MPI_Testall( d_requests.size(), d_requests.getRawPtr(), 
+		     &complete, MPI_STATUSES_IGNORE );
+    }
+#endif
+
+    return complete;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Build the message lists from the distributor. The export indices are
+ * grouped by destination process in the order of the distributor's messages
+ * and the order of the indices sent to a process is kept.
+ *
+ * \param distributor The distributor for the exported data.
+ *
+ * \param export_lids The source local indices to send.
+ *
+ * \param export_procs The destination process of each source local index.
+ */
+void TransferPlan::buildMessages( 
+    const Tpetra::Distributor& distributor,
+    const Teuchos::ArrayView<const int>& export_lids,
+    const Teuchos::ArrayView<const int>& export_procs )
+{
+    testPrecondition( export_lids.size() == export_procs.size() );
+
+    // Get the destination processes and the number of entries sent to each.
+    Teuchos::ArrayView<const int> images_to = distributor.getImagesTo();
+    Teuchos::ArrayView<const std::size_t> lengths_to = 
+	distributor.getLengthsTo();
+    d_images_to.assign( images_to.begin(), images_to.end() );
+    d_send_offsets.assign( d_images_to.size() + 1, 0 );
+    for ( int i = 0; i < d_images_to.size(); ++i )
+    {
+	d_send_offsets[i+1] = 
+	    d_send_offsets[i] + Teuchos::as<int>( lengths_to[i] );
+    }
+    testPrecondition( export_lids.size() == d_send_offsets.back() );
+
+    // Group the export indices by destination process.
+    Teuchos::Array<std::pair<int,int> > message_procs( d_images_to.size() );
+    for ( int i = 0; i < d_images_to.size(); ++i )
+    {
+	message_procs[i] = std::make_pair( d_images_to[i], i );
+    }
+    std::sort( message_procs.begin(), message_procs.end() );
+    Teuchos::Array<int> fill_offsets( d_send_offsets.begin(), 
+				      d_send_offsets.end() - 1 );
+    d_export_lids.resize( export_lids.size() );
+    Teuchos::Array<std::pair<int,int> >::const_iterator message;
+    for ( int n = 0; n < export_lids.size(); ++n )
+    {
+	message = std::lower_bound( 
+	    message_procs.begin(), message_procs.end(),
+	    std::make_pair( export_procs[n], 0 ) );
+	testInvariant( message != message_procs.end() );
+	testInvariant( message->first == export_procs[n] );
+	d_export_lids[ fill_offsets[message->second]++ ] = export_lids[n];
+    }
+
+    // Get the source processes and the number of entries received from
+    // each. The remote indices are ordered by the distributor's messages.
+    Teuchos::ArrayView<const int> images_from = distributor.getImagesFrom();
+    Teuchos::ArrayView<const std::size_t> lengths_from = 
+	distributor.getLengthsFrom();
+    d_images_from.assign( images_from.begin(), images_from.end() );
+    d_receive_offsets.assign( d_images_from.size() + 1, 0 );
+    for ( int i = 0; i < d_images_from.size(); ++i )
+    {
+	d_receive_offsets[i+1] = 
+	    d_receive_offsets[i] + Teuchos::as<int>( lengths_from[i] );
+    }
+    testPostcondition( d_remote_lids.size() == d_receive_offsets.back() );
+
+    setupMessages();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Duplicate the communicator. This is a collective operation.
+ */
+void TransferPlan::setupMessages()
+{
+#ifdef HAVE_DTK_MPI
+    d_raw_comm = MPI_COMM_NULL;
+    Teuchos::RCP< const Teuchos::MpiComm<int> > mpi_comm = 
+	Teuchos::rcp_dynamic_cast< const Teuchos::MpiComm<int> >( d_comm );
+    if ( !mpi_comm.is_null() )
+    {
+	Teuchos::RCP< const Teuchos::OpaqueWrapper<MPI_Comm> > opaque_comm = 
+	    mpi_comm->getRawMpiComm();
+	MPI_Comm_dup( (*opaque_comm)(), &d_raw_comm );
+    }
+
+    // Without an MPI communicator there are no other processes.
+    testPostcondition( d_raw_comm != MPI_COMM_NULL ||
+		       (d_images_from.size() == 0 && d_images_to.size() == 0) );
+#else
+    testPostcondition( d_images_from.size() == 0 && d_images_to.size() == 0 );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Allocate the buffers and persistent requests for a data layout. The
+ * persistent requests for the previous layout are freed.
+ *
+ * \param num_columns The number of columns in the data.
+ *
+ * \param scalar_size The size in bytes of a scalar in the data.
+ */
+void TransferPlan::setupBuffers( const int num_columns, 
+				 const std::size_t scalar_size )
+{
+    testPrecondition( !d_posted );
+
+    freeRequests();
+
+    d_num_columns = num_columns;
+    d_scalar_size = scalar_size;
+    int item_size = d_num_columns*d_scalar_size;
+
+    d_local_buffer.resize( 
+	(d_num_same + d_permute_from.size())*item_size );
+    d_send_buffer.resize( d_export_lids.size()*item_size );
+    d_receive_buffer.resize( d_remote_lids.size()*item_size );
+
+#ifdef HAVE_DTK_MPI
+    int tag = 0;
+    d_requests.resize( d_images_from.size() + d_images_to.size() );
+    int request = 0;
+
+    for ( int i = 0; i < d_images_from.size(); ++i )
+    {
+	MPI_Recv_init( d_receive_buffer.getRawPtr() + 
+		       d_receive_offsets[i]*item_size,
+		       (d_receive_offsets[i+1] - d_receive_offsets[i])*item_size,
+		       MPI_BYTE, d_images_from[i], tag, d_raw_comm, 
+		       &d_requests[request++] );
+    }
+
+    for ( int i = 0; i < d_images_to.size(); ++i )
+    {
+	MPI_Send_init( d_send_buffer.getRawPtr() + 
+		       d_send_offsets[i]*item_size,
+		       (d_send_offsets[i+1] - d_send_offsets[i])*item_size,
+		       MPI_BYTE, d_images_to[i], tag, d_raw_comm, 
+		       &d_requests[request++] );
+    }
+
+    testPostcondition( request == d_requests.size() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Free the persistent requests.
+ */
+void TransferPlan::freeRequests()
+{
+#ifdef HAVE_DTK_MPI
+    Teuchos::Array<MPI_Request>::iterator request_it;
+    for ( request_it = d_requests.begin(); 
+	  request_it != d_requests.end();
+	  ++request_it )
+    {
+	MPI_Request_free( &(*request_it) );
+    }
+    d_requests.clear();
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Start the persistent receives and sends for the packed data. All
+ * receives are started before the sends.
+ */
+void TransferPlan::startMessages()
+{
+#ifdef HAVE_DTK_MPI
+    if ( d_requests.size() > 0 )
+    {
+	MPI_Startall( d_requests.size(), d_requests.getRawPtr() );
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Complete the started messages. The persistent requests stay
+ * allocated.
+ */
+void TransferPlan::waitMessages()
+{
+#ifdef HAVE_DTK_MPI
+    if ( d_requests.size() > 0 )
+    {
+	MPI_Waitall( d_requests.size(), d_requests.getRawPtr(), 
+		     MPI_STATUSES_IGNORE );
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Flag the source entries that send to the flagged target
+ * entries. Only the positions of the flagged target entries in the messages
+ * are sent back to the source processes. This is a collective operation and
+ * messages may not be posted.
+ *
+ * \param target_flags A flag for each target entry.
+ *
+ * \param source_flags A flag for each source entry. Set to 1 for the entries
+ * that send to a target entry with a nonzero flag and 0 for all others.
+ */
+void TransferPlan::doReverseFlags( 
+    const Teuchos::ArrayView<const int>& target_flags,
+    const Teuchos::ArrayView<int>& source_flags )
+{
+    testPrecondition( !d_posted );
+
+    std::fill( source_flags.begin(), source_flags.end(), 0 );
+
+    // Flag the source entries of the data that stays on this process.
+    for ( int n = 0; n < d_num_same; ++n )
+    {
+	if ( target_flags[n] )
+	{
+	    source_flags[n] = 1;
+	}
+    }
+    for ( int n = 0; n < d_permute_to.size(); ++n )
+    {
+	if ( target_flags[ d_permute_to[n] ] )
+	{
+	    source_flags[ d_permute_from[n] ] = 1;
+	}
+    }
+
+    // Pack the message positions of the flagged received entries in the
+    // reverse of the messages that received them.
+    int record_size = sizeof(int);
+    int num_sends = d_images_from.size();
+    Teuchos::Array<int> send_counts( num_sends, 0 );
+    d_sparse_send_buffer.resize( d_remote_lids.size()*record_size );
+    char* record;
+    int position;
+    for ( int i = 0; i < num_sends; ++i )
+    {
+	record = d_sparse_send_buffer.getRawPtr() + 
+		 d_receive_offsets[i]*record_size;
+	for ( int n = d_receive_offsets[i]; n < d_receive_offsets[i+1]; ++n )
+	{
+	    if ( target_flags[ d_remote_lids[n] ] )
+	    {
+		position = n - d_receive_offsets[i];
+		std::memcpy( record, &position, sizeof(int) );
+		record += record_size;
+		++send_counts[i];
+	    }
+	}
+    }
+
+    // Exchange the positions.
+    int num_receives = d_images_to.size();
+    Teuchos::Array<int> receive_counts( num_receives, 0 );
+    d_sparse_receive_buffer.resize( d_export_lids.size()*record_size );
+    exchangeSparseMessages( true, record_size, send_counts(), 
+			    receive_counts() );
+
+    // Flag the source entries sent to the received positions.
+    const char* received_record;
+    for ( int i = 0; i < num_receives; ++i )
+    {
+	received_record = d_sparse_receive_buffer.getRawPtr() + 
+			  d_send_offsets[i]*record_size;
+	for ( int k = 0; k < receive_counts[i]; ++k )
+	{
+	    std::memcpy( &position, received_record, sizeof(int) );
+	    source_flags[ d_export_lids[d_send_offsets[i] + position] ] = 1;
+	    received_record += record_size;
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Exchange the packed records of a sparse transfer. The records sent
+ * to each process are in the send buffer at the offset of the dense data of
+ * that message and are received into the receive buffer in the same
+ * way. The receives are posted with the size of the dense message and the
+ * number of records received is taken from the message size.
+ *
+ * \param reverse Set to true to send from the target processes to the source
+ * processes.
+ *
+ * \param record_size The size in bytes of a record.
+ *
+ * \param send_counts The number of records sent in each message.
+ *
+ * \param receive_counts The number of records received in each message.
+ */
+void TransferPlan::exchangeSparseMessages( 
+    const bool reverse,
+    const int record_size,
+    const Teuchos::ArrayView<const int>& send_counts,
+    const Teuchos::ArrayView<int>& receive_counts )
+{
+    testPrecondition( send_counts.size() == 
+		      (reverse ? d_images_from : d_images_to).size() );
+    testPrecondition( receive_counts.size() == 
+		      (reverse ? d_images_to : d_images_from).size() );
+
+#ifdef HAVE_DTK_MPI
+    const Teuchos::Array<int>& send_procs = 
+	reverse ? d_images_from : d_images_to;
+    const Teuchos::Array<int>& send_offsets = 
+	reverse ? d_receive_offsets : d_send_offsets;
+    const Teuchos::Array<int>& receive_procs = 
+	reverse ? d_images_to : d_images_from;
+    const Teuchos::Array<int>& receive_offsets = 
+	reverse ? d_send_offsets : d_receive_offsets;
+
+    int tag = 1;
+    int num_receives = receive_procs.size();
+    int num_sends = send_procs.size();
+    Teuchos::Array<MPI_Request> requests( num_receives + num_sends );
+
+    for ( int i = 0; i < num_receives; ++i )
+    {
+	MPI_Irecv( d_sparse_receive_buffer.getRawPtr() + 
+		   receive_offsets[i]*record_size,
+		   (receive_offsets[i+1] - receive_offsets[i])*record_size,
+		   MPI_BYTE, receive_procs[i], tag, d_raw_comm, 
+		   &requests[i] );
+    }
+
+    for ( int i = 0; i < num_sends; ++i )
+    {
+	MPI_Isend( d_sparse_send_buffer.getRawPtr() + 
+		   send_offsets[i]*record_size,
+		   send_counts[i]*record_size,
+		   MPI_BYTE, send_procs[i], tag, d_raw_comm, 
+		   &requests[num_receives + i] );
+    }
+
+    Teuchos::Array<MPI_Status> statuses( requests.size() );
+    if ( requests.size() > 0 )
+    {
+	MPI_Waitall( requests.size(), requests.getRawPtr(), 
+		     statuses.getRawPtr() );
+    }
+
+    int num_bytes;
+    for ( int i = 0; i < num_receives; ++i )
+    {
+	MPI_Get_count( &statuses[i], MPI_BYTE, &num_bytes );
+	receive_counts[i] = num_bytes / record_size;
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// end DTK_TransferPlan.cpp
+//---------------------------------------------------------------------------//
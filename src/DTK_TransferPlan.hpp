@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+ * \file DTK_TransferPlan.hpp
+ * \author Stuart R. Slattery
+ * \brief TransferPlan declaration.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_TRANSFERPLAN_HPP
+#define DTK_TRANSFERPLAN_HPP
+
+#include <cstddef>
+
+#include "DataTransferKit_config.hpp"
+
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_ArrayView.hpp>
+
+#include <Tpetra_Distributor.hpp>
+
+#ifdef HAVE_DTK_MPI
+#include <mpi.h>
+#endif
+
+namespace DataTransferKit
+{
+
+//---------------------------------------------------------------------------//
+/*!
+ * \class TransferPlan
+ * \brief Split-phase communication plan for moving data from a source
+ * decomposition to a target decomposition.
+
+ The plan is compiled from the local indices and process lists of a
+ Tpetra::Export or Tpetra::Import or directly from the local indices and a
+ Tpetra::Distributor that has already been built for the transfer. Moving
+ data is split into doPosts(), which packs the source data and posts
+ nonblocking receives and sends, and doWaits(), which completes the messages
+ and unpacks the data into the target. Local computation may be performed
+ between the two calls. Calling doProgress() during that computation lets the
+ MPI library move large messages that would otherwise only move once
+ doWaits() is called.
+
+ Data is column-blocked as in a field. Only the target entries that receive
+ data are written in doWaits().
+
+ The plan communicates over a duplicate of the given communicator such that
+ its messages never match messages posted by the client in between the two
+ phases.
+
+ The messages are persistent. The buffers and persistent requests are
+ allocated the first time data is posted and are reused as long as the number
+ of columns and the scalar type do not change such that moving data again
+ only packs, starts, waits and unpacks.
+
+ A subset of the data may also be moved with doSparsePostsAndWaits(). Only
+ the flagged source entries are packed with their position in the message
+ and the target entries that do not receive data are not written. Flags on
+ the target entries may be moved back to the source entries that send to
+ them with doReverseFlags().
+ */
+//---------------------------------------------------------------------------//
+class TransferPlan
+{
+  public:
+
+    //@{
+    //! Typedefs.
+    typedef Teuchos::Comm<int>                   CommType;
+    typedef Teuchos::RCP<const CommType>         RCP_Comm;
+    //@}
+
+    // Transfer constructor.
+    template<class Transfer>
+    TransferPlan( const RCP_Comm& comm, const Transfer& transfer );
+
+    // Distributor constructor.
+    TransferPlan( const RCP_Comm& comm,
+		  const Tpetra::Distributor& distributor,
+		  const Teuchos::ArrayView<const int>& export_lids,
+		  const Teuchos::ArrayView<const int>& export_procs,
+		  const Teuchos::ArrayView<const int>& remote_lids,
+		  const Teuchos::ArrayView<const int>& permute_from,
+		  const Teuchos::ArrayView<const int>& permute_to );
+
+    // Destructor.
+    ~TransferPlan();
+
+    // Pack the source data and post the messages.
+    template<class Scalar>
+    void doPosts( const Teuchos::ArrayView<const Scalar>& source_data,
+		  const int num_columns );
+
+    // Progress the posted messages.
+    bool doProgress();
+
+    // Complete the posted messages and unpack the data into the target.
+    template<class Scalar>
+    void doWaits( const Teuchos::ArrayView<Scalar>& target_data );
+
+    // Move the flagged source data and unpack it into the target.
+    template<class Scalar>
+    void doSparsePostsAndWaits( 
+	const Teuchos::ArrayView<const Scalar>& source_data,
+	const int num_columns,
+	const Teuchos::ArrayView<const int>& source_flags,
+	const Teuchos::ArrayView<Scalar>& target_data );
+
+    // Flag the source entries that send to the flagged target entries.
+    void doReverseFlags( const Teuchos::ArrayView<const int>& target_flags,
+			 const Teuchos::ArrayView<int>& source_flags );
+
+    //! Return if messages have been posted and not yet completed.
+    bool isPosted() const
+    { return d_posted; }
+
+  private:
+
+    // Build the message lists from the distributor.
+    void buildMessages( const Tpetra::Distributor& distributor,
+			const Teuchos::ArrayView<const int>& export_lids,
+			const Teuchos::ArrayView<const int>& export_procs );
+
+    // Duplicate the communicator.
+    void setupMessages();
+
+    // Allocate the buffers and persistent requests for a data layout.
+    void setupBuffers( const int num_columns, const std::size_t scalar_size );
+
+    // Free the persistent requests.
+    void freeRequests();
+
+    // Start the persistent receives and sends for the packed data.
+    void startMessages();
+
+    // Complete the started messages.
+    void waitMessages();
+
+    // Exchange the packed records of a sparse transfer.
+    void exchangeSparseMessages( 
+	const bool reverse,
+	const int record_size,
+	const Teuchos::ArrayView<const int>& send_counts,
+	const Teuchos::ArrayView<int>& receive_counts );
+
+  private:
+
+    // Communicator.
+    RCP_Comm d_comm;
+
+#ifdef HAVE_DTK_MPI
+    // Duplicate of the raw communicator for the plan's messages.
+    MPI_Comm d_raw_comm;
+
+    // Persistent requests for the receives followed by the sends.
+    Teuchos::Array<MPI_Request> d_requests;
+#endif
+
+    // Number of leading local indices that are the same in the source and
+    // target.
+    int d_num_same;
+
+    // Source local indices of the permuted local data.
+    Teuchos::Array<int> d_permute_from;
+
+    // Target local indices of the permuted local data.
+    Teuchos::Array<int> d_permute_to;
+
+    // Source local indices to send grouped by destination process.
+    Teuchos::Array<int> d_export_lids;
+
+    // Destination processes.
+    Teuchos::Array<int> d_images_to;
+
+    // Offsets of each destination process into the export indices.
+    Teuchos::Array<int> d_send_offsets;
+
+    // Source processes.
+    Teuchos::Array<int> d_images_from;
+
+    // Offsets of each source process into the remote indices.
+    Teuchos::Array<int> d_receive_offsets;
+
+    // Target local indices of the received data.
+    Teuchos::Array<int> d_remote_lids;
+
+    // Number of columns of the data the buffers are allocated for.
+    int d_num_columns;
+
+    // Size in bytes of a scalar of the data the buffers are allocated for.
+    std::size_t d_scalar_size;
+
+    // Packed local data.
+    Teuchos::Array<char> d_local_buffer;
+
+    // Packed send data.
+    Teuchos::Array<char> d_send_buffer;
+
+    // Packed receive data.
+    Teuchos::Array<char> d_receive_buffer;
+
+    // Packed records of a sparse send.
+    Teuchos::Array<char> d_sparse_send_buffer;
+
+    // Packed records of a sparse receive.
+    Teuchos::Array<char> d_sparse_receive_buffer;
+
+    // Boolean for posted messages.
+    bool d_posted;
+};
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// Template includes.
+//---------------------------------------------------------------------------//
+
+#include "DTK_TransferPlan_def.hpp"
+
+//---------------------------------------------------------------------------//
+
+#endif // end DTK_TRANSFERPLAN_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_TransferPlan.hpp
+//---------------------------------------------------------------------------//
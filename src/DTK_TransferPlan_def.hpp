@@ -0,0 +1,320 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/*!
+ * \file DTK_TransferPlan_def.hpp
+ * \author Stuart R. Slattery
+ * \brief TransferPlan template definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_TRANSFERPLAN_DEF_HPP
+#define DTK_TRANSFERPLAN_DEF_HPP
+
+#include <cstring>
+
+#include "DTK_Assertion.hpp"
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Transfer constructor. This is a collective operation over the
+ * communicator.
+ *
+ * \param comm The communicator over which the transfer was built.
+ *
+ * \param transfer The Tpetra::Export or Tpetra::Import from the source
+ * decomposition to the target decomposition. The plan does not keep a
+ * reference to the transfer.
+ */
+template<class Transfer>
+TransferPlan::TransferPlan( const RCP_Comm& comm, const Transfer& transfer )
+    : d_comm( comm )
+    , d_num_same( transfer.getNumSameIDs() )
+    , d_permute_from( transfer.getPermuteFromLIDs().begin(),
+		      transfer.getPermuteFromLIDs().end() )
+    , d_permute_to( transfer.getPermuteToLIDs().begin(),
+		    transfer.getPermuteToLIDs().end() )
+    , d_remote_lids( transfer.getRemoteLIDs().begin(),
+		     transfer.getRemoteLIDs().end() )
+    , d_num_columns( 0 )
+    , d_scalar_size( 0 )
+    , d_posted( false )
+{
+    testPrecondition( d_permute_from.size() == d_permute_to.size() );
+
+    buildMessages( transfer.getDistributor(), transfer.getExportLIDs(), 
+		   transfer.getExportImageIDs() );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Pack the source data and post the messages. Local data is packed
+ * such that the source data need not persist until doWaits() is called. No
+ * memory is allocated unless the number of columns or the scalar type differ
+ * from the last call.
+ *
+ * \param source_data The column-blocked source data.
+ *
+ * \param num_columns The number of columns in the data. Processes without
+ * source data must provide the number of columns they will receive.
+ */
+template<class Scalar>
+void TransferPlan::doPosts( const Teuchos::ArrayView<const Scalar>& source_data,
+			    const int num_columns )
+{
+    testPrecondition( !d_posted );
+    testPrecondition( 0 <= num_columns );
+
+    // Allocate the buffers and requests if the data layout has changed.
+    if ( num_columns != d_num_columns || sizeof(Scalar) != d_scalar_size )
+    {
+	setupBuffers( num_columns, sizeof(Scalar) );
+    }
+
+    int source_size = 
+	(num_columns > 0) ? source_data.size() / num_columns : 0;
+    testPrecondition( source_size*num_columns == source_data.size() );
+
+    // Pack the data that stays on this process.
+    int num_permutes = d_permute_from.size();
+    Scalar* local_data = 
+	reinterpret_cast<Scalar*>( d_local_buffer.getRawPtr() );
+    for ( int c = 0; c < num_columns; ++c )
+    {
+	for ( int n = 0; n < d_num_same; ++n )
+	{
+	    local_data[n*num_columns + c] = source_data[c*source_size + n];
+	}
+	for ( int n = 0; n < num_permutes; ++n )
+	{
+	    local_data[(d_num_same + n)*num_columns + c] = 
+		source_data[c*source_size + d_permute_from[n]];
+	}
+    }
+
+    // Pack the data that is sent to other processes.
+    int num_exports = d_export_lids.size();
+    Scalar* send_data = 
+	reinterpret_cast<Scalar*>( d_send_buffer.getRawPtr() );
+    for ( int n = 0; n < num_exports; ++n )
+    {
+	for ( int c = 0; c < num_columns; ++c )
+	{
+	    send_data[n*num_columns + c] = 
+		source_data[c*source_size + d_export_lids[n]];
+	}
+    }
+
+    // Start the messages.
+    startMessages();
+    d_posted = true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Complete the posted messages and unpack the data into the target.
+ *
+ * \param target_data The column-blocked target data. Only the entries that
+ * receive data are written.
+ */
+template<class Scalar>
+void TransferPlan::doWaits( const Teuchos::ArrayView<Scalar>& target_data )
+{
+    testPrecondition( d_posted );
+    testPrecondition( sizeof(Scalar) == d_scalar_size );
+
+    waitMessages();
+    d_posted = false;
+
+    int target_size = 
+	(d_num_columns > 0) ? target_data.size() / d_num_columns : 0;
+    testPrecondition( target_size*d_num_columns == target_data.size() );
+
+    // Unpack the data that stayed on this process.
+    int num_permutes = d_permute_to.size();
+    const Scalar* local_data = 
+	reinterpret_cast<const Scalar*>( d_local_buffer.getRawPtr() );
+    for ( int c = 0; c < d_num_columns; ++c )
+    {
+	for ( int n = 0; n < d_num_same; ++n )
+	{
+	    target_data[c*target_size + n] = local_data[n*d_num_columns + c];
+	}
+	for ( int n = 0; n < num_permutes; ++n )
+	{
+	    target_data[c*target_size + d_permute_to[n]] = 
+		local_data[(d_num_same + n)*d_num_columns + c];
+	}
+    }
+
+    // Unpack the data that was received from other processes.
+    int num_remotes = d_remote_lids.size();
+    const Scalar* receive_data = 
+	reinterpret_cast<const Scalar*>( d_receive_buffer.getRawPtr() );
+    for ( int n = 0; n < num_remotes; ++n )
+    {
+	for ( int c = 0; c < d_num_columns; ++c )
+	{
+	    target_data[c*target_size + d_remote_lids[n]] = 
+		receive_data[n*d_num_columns + c];
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move the flagged source data and unpack it into the target. Each
+ * flagged entry sent to another process is packed with its position in the
+ * message such that the messages only hold the flagged entries. Target
+ * entries that do not receive data are not written. This is a collective
+ * operation and messages may not be posted.
+ *
+ * \param source_data The column-blocked source data.
+ *
+ * \param num_columns The number of columns in the data. Processes without
+ * source data must provide the number of columns they will receive.
+ *
+ * \param source_flags A flag for each source entry. Entries with a nonzero
+ * flag are moved.
+ *
+ * \param target_data The column-blocked target data. Only the entries that
+ * receive data are written.
+ */
+template<class Scalar>
+void TransferPlan::doSparsePostsAndWaits(
+    const Teuchos::ArrayView<const Scalar>& source_data,
+    const int num_columns,
+    const Teuchos::ArrayView<const int>& source_flags,
+    const Teuchos::ArrayView<Scalar>& target_data )
+{
+    testPrecondition( !d_posted );
+    testPrecondition( 0 <= num_columns );
+    testPrecondition( source_flags.size()*num_columns == source_data.size() );
+
+    int source_size = source_flags.size();
+    int target_size = 
+	(num_columns > 0) ? target_data.size() / num_columns : 0;
+    testPrecondition( target_size*num_columns == target_data.size() );
+
+    // Copy the flagged data that stays on this process.
+    int num_permutes = d_permute_from.size();
+    for ( int c = 0; c < num_columns; ++c )
+    {
+	for ( int n = 0; n < d_num_same; ++n )
+	{
+	    if ( source_flags[n] )
+	    {
+		target_data[c*target_size + n] = 
+		    source_data[c*source_size + n];
+	    }
+	}
+	for ( int n = 0; n < num_permutes; ++n )
+	{
+	    if ( source_flags[ d_permute_from[n] ] )
+	    {
+		target_data[c*target_size + d_permute_to[n]] = 
+		    source_data[c*source_size + d_permute_from[n]];
+	    }
+	}
+    }
+
+    // Pack a record with the message position and the data of each flagged
+    // entry sent to other processes. The records of each message start where
+    // its dense data would.
+    int record_size = sizeof(int) + num_columns*sizeof(Scalar);
+    int num_sends = d_images_to.size();
+    Teuchos::Array<int> send_counts( num_sends, 0 );
+    d_sparse_send_buffer.resize( d_export_lids.size()*record_size );
+    char* record;
+    int position;
+    for ( int i = 0; i < num_sends; ++i )
+    {
+	record = d_sparse_send_buffer.getRawPtr() + 
+		 d_send_offsets[i]*record_size;
+	for ( int n = d_send_offsets[i]; n < d_send_offsets[i+1]; ++n )
+	{
+	    if ( source_flags[ d_export_lids[n] ] )
+	    {
+		position = n - d_send_offsets[i];
+		std::memcpy( record, &position, sizeof(int) );
+		for ( int c = 0; c < num_columns; ++c )
+		{
+		    std::memcpy( record + sizeof(int) + c*sizeof(Scalar),
+				 &source_data[c*source_size + d_export_lids[n]],
+				 sizeof(Scalar) );
+		}
+		record += record_size;
+		++send_counts[i];
+	    }
+	}
+    }
+
+    // Exchange the records.
+    int num_receives = d_images_from.size();
+    Teuchos::Array<int> receive_counts( num_receives, 0 );
+    d_sparse_receive_buffer.resize( d_remote_lids.size()*record_size );
+    exchangeSparseMessages( false, record_size, send_counts(), 
+			    receive_counts() );
+
+    // Unpack the received records.
+    const char* received_record;
+    int lid;
+    for ( int i = 0; i < num_receives; ++i )
+    {
+	received_record = d_sparse_receive_buffer.getRawPtr() + 
+			  d_receive_offsets[i]*record_size;
+	for ( int k = 0; k < receive_counts[i]; ++k )
+	{
+	    std::memcpy( &position, received_record, sizeof(int) );
+	    lid = d_remote_lids[ d_receive_offsets[i] + position ];
+	    for ( int c = 0; c < num_columns; ++c )
+	    {
+		std::memcpy( &target_data[c*target_size + lid],
+			     received_record + sizeof(int) + c*sizeof(Scalar),
+			     sizeof(Scalar) );
+	    }
+	    received_record += record_size;
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+#endif // end DTK_TRANSFERPLAN_DEF_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_TransferPlan_def.hpp
+//---------------------------------------------------------------------------//
@@ -49,6 +49,8 @@
 #include "DTK_FieldEvaluator.hpp"
 #include "DTK_FieldManager.hpp"
 #include "DTK_CommIndexer.hpp"
+#include "DTK_Partitioner.hpp"
+#include "DTK_TransferPlan.hpp"
 
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_Comm.hpp>
@@ -77,6 +79,20 @@ namespace DataTransferKit
  * way, simply moving the volume data, doing a zero order evaluation for the
  * volume to volume case, or a higher order functional evaluation for the
  * quadrature point case.
+ *
+ * For moderate process counts with compact source subdomains the rendezvous
+ * decomposition may be skipped with direct search. The target points are
+ * then sent to every source process whose local geometry bounding box
+ * contains them and are searched for in the local source geometry.
+ *
+ * The map may also be applied in two phases such that the client may perform
+ * independent computation while the function evaluations are moved to the
+ * target decomposition. applyBegin() posts the communication and applyEnd()
+ * completes it.
+ *
+ * Both apply() and the two phase apply move the data with a persistent
+ * transfer plan compiled in setup() that reuses its buffers and persistent
+ * requests over repeated applies.
  */
 //---------------------------------------------------------------------------//
 template<class Geometry, class GlobalOrdinal, class CoordinateField>
@@ -112,6 +128,17 @@ class VolumeSourceMap
     // Destructor.
     ~VolumeSourceMap();
 
+    // Set the partitioning algorithm for the rendezvous decomposition.
+    void setPartitionerType( const DTK_PartitionerType type );
+
+    // Route the target points directly to the source processes instead of
+    // building a rendezvous decomposition.
+    void setDirectSearch( const bool direct_search );
+
+    // Move the data in apply() with the persistent transfer plan instead of
+    // Tpetra.
+    void setPersistentTransfer( const bool persistent_transfer );
+
     // Generate the volume source map.
     void setup( const RCP_GeometryManager& source_geometry_manager, 
 		const RCP_CoordFieldManager& target_coord_manager );
@@ -129,6 +156,30 @@ class VolumeSourceMap
 	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
 	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
 
+    // Apply the volume source map for several fields with a single
+    // communication.
+    template<class SourceField, class TargetField>
+    void apply( 
+	const Teuchos::Array<Teuchos::RCP<
+	    FieldEvaluator<GlobalOrdinal,SourceField> > >& source_evaluators,
+	const Teuchos::Array<Teuchos::RCP<
+	    FieldManager<TargetField> > >& target_space_managers );
+
+    // Begin applying the volume source map by evaluating a function at the
+    // target points that were mapped and posting the communication.
+    template<class SourceField, class TargetField>
+    void applyBegin( 
+	const Teuchos::RCP<FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+	Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
+
+    // Progress the communication posted by applyBegin().
+    bool applyProgress();
+
+    // Finish applying the volume source map by completing the communication
+    // and writing the function evaluations into the target space.
+    template<class TargetField>
+    void applyEnd( Teuchos::RCP<FieldManager<TargetField> >& target_space_manager );
+
   private:
 
     // Compute globally unique ordinals for the target points.
@@ -136,6 +187,13 @@ class VolumeSourceMap
 	const RCP_CoordFieldManager& target_coord_manager,
 	Teuchos::Array<GlobalOrdinal>& target_ordinals );
 
+    // Search for the target points in the source geometry of the processes
+    // whose local bounding box contains them.
+    void directSearch( 
+	const RCP_GeometryManager& source_geometry_manager,
+	const Teuchos::ArrayRCP<double>& target_coords,
+	const Teuchos::Array<GlobalOrdinal>& target_ordinals );
+
     // Get the target points that are in the rendezvous decomposition box.
     void getTargetPointsInBox( 
 	const BoundingBox& box,
@@ -157,6 +215,16 @@ class VolumeSourceMap
     // Geometric tolerance.
     double d_geometric_tolerance;
 
+    // Rendezvous partitioning algorithm.
+    DTK_PartitionerType d_partitioner_type;
+
+    // Boolean for routing target points directly to the source processes.
+    bool d_direct_search;
+
+    // Boolean for moving the data in apply() with the persistent transfer
+    // plan.
+    bool d_persistent_transfer;
+
     // Process indexer for the source application.
     CommIndexer d_source_indexer;
 
@@ -178,6 +246,9 @@ class VolumeSourceMap
     // Source-to-target importer.
     RCP_TpetraImport d_source_to_target_importer;
 
+    // Split-phase source-to-target communication plan.
+    Teuchos::RCP<TransferPlan> d_transfer_plan;
+
     // Local source geometries.
     Teuchos::Array<GlobalOrdinal> d_source_geometry;
 
@@ -42,14 +42,18 @@
 #define DTK_VOLUMESOURCEMAP_DEF_HPP
 
 #include <algorithm>
+#include <numeric>
 #include <limits>
 #include <set>
+#include <utility>
 
 #include "DTK_FieldTools.hpp"
+#include "DTK_FieldTransferTools.hpp"
 #include "DTK_FieldTraits.hpp"
 #include "DTK_Assertion.hpp"
 #include "DTK_GeometryRendezvous.hpp"
 #include "DTK_BoundingBox.hpp"
+#include "DTK_BoxRouter.hpp"
 
 #include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_as.hpp>
@@ -91,6 +95,9 @@ VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::VolumeSourceMap(
     , d_dimension( dimension )
     , d_store_missed_points( store_missed_points )
     , d_geometric_tolerance( geometric_tolerance )
+    , d_partitioner_type( DTK_RCB_PARTITIONER )
+    , d_direct_search( false )
+    , d_persistent_transfer( true )
 { /* ... */ }
 
 //---------------------------------------------------------------------------//
@@ -101,6 +108,57 @@ template<class Geometry, class GlobalOrdinal, class CoordinateField>
 VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::~VolumeSourceMap()
 { /* ... */ }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Set the partitioning algorithm for the rendezvous decomposition. RCB
+ * is used by default. Geometry may be partitioned with RCB or the Hilbert
+ * partitioner and other types use RCB. Must be called before setup() to take
+ * effect.
+ *
+ * \param type The rendezvous partitioning algorithm.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::setPartitionerType( 
+    const DTK_PartitionerType type )
+{
+    d_partitioner_type = type;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Route the target points directly to the source processes whose
+ * local geometry bounding box contains them instead of building a rendezvous
+ * decomposition. Points found in the geometry of more than one source process
+ * are mapped to the lowest of those processes. Must be called before setup()
+ * to take effect.
+ *
+ * \param direct_search Set to true to enable direct search. The default is
+ * false.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::setDirectSearch( 
+    const bool direct_search )
+{
+    d_direct_search = direct_search;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Move the data in apply() with the persistent transfer plan compiled
+ * in setup() instead of the Tpetra importer. The transfer plan reuses its
+ * buffers and persistent requests over repeated applies. The Tpetra path is
+ * kept for comparison. May be called at any time between applies.
+ *
+ * \param persistent_transfer Set to false to move the data with Tpetra. The
+ * default is true.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::setPersistentTransfer( 
+    const bool persistent_transfer )
+{
+    d_persistent_transfer = persistent_transfer;
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Generate the volume source map.
@@ -170,6 +228,27 @@ void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::setup(
 	import_ordinal_view, d_comm );
     testPostcondition( !d_target_map.is_null() );
 
+    // Get a view of the target coordinates.
+    Teuchos::ArrayRCP<double> coords_view(0,0.0);
+    int coord_dim;
+    if ( target_exists )
+    {
+	coord_dim = CFT::dim( *target_coord_manager->field() );
+	coords_view = FieldTools<CoordinateField>::nonConstView( 
+	    *target_coord_manager->field() );
+    }
+    d_comm->barrier();
+    Teuchos::broadcast<int,int>( 
+	*d_comm, d_target_indexer.l2g(0), Teuchos::Ptr<int>(&coord_dim) );
+
+    // If we're doing a direct search, route the target points to the source
+    // processes and skip the rendezvous decomposition.
+    if ( d_direct_search )
+    {
+	directSearch( source_geometry_manager, coords_view, target_ordinals );
+	return;
+    }
+
     // Get the global bounding box for the geometry.
     BoundingBox source_box;
     if ( source_exists )
@@ -201,23 +280,11 @@ void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::setup(
 
     // Build a rendezvous decomposition with the source geometry.
     GeometryRendezvous<Geometry,GlobalOrdinal> rendezvous( 
-	d_comm, d_dimension, shared_domain_box );
+	d_comm, d_dimension, shared_domain_box, d_partitioner_type );
     rendezvous.build( source_geometry_manager );
 
     // Determine the rendezvous destination proc of each point in the
     // coordinate field.
-    Teuchos::ArrayRCP<double> coords_view(0,0.0);
-    int coord_dim;
-    if ( target_exists )
-    {
-	coord_dim = CFT::dim( *target_coord_manager->field() );
-	coords_view = FieldTools<CoordinateField>::nonConstView( 
-	    *target_coord_manager->field() );
-    }
-    d_comm->barrier();
-    Teuchos::broadcast<int,int>( 
-	*d_comm, d_target_indexer.l2g(0), Teuchos::Ptr<int>(&coord_dim) );
-
     Teuchos::Array<int> rendezvous_procs = 
 	rendezvous.procsContainingPoints( coords_view );
 
@@ -472,6 +539,11 @@ void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::setup(
       Teuchos::rcp( new Tpetra::Import<int,GlobalOrdinal>(
           d_source_map, d_target_map ) );
     testPostcondition( !d_source_to_target_importer.is_null() );
+
+    // Compile the split-phase communication plan from the importer.
+    d_transfer_plan = Teuchos::rcp( 
+	new TransferPlan( d_comm, *d_source_to_target_importer ) );
+    testPostcondition( !d_transfer_plan.is_null() );
 }
 
 //---------------------------------------------------------------------------//
@@ -493,6 +565,14 @@ void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::apply(
     const Teuchos::RCP< FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
     Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
 {
+    // Move the data with the persistent transfer plan.
+    if ( d_persistent_transfer )
+    {
+	applyBegin( source_evaluator, target_space_manager );
+	applyEnd( target_space_manager );
+	return;
+    }
+
     typedef FieldTraits<SourceField> SFT;
     typedef FieldTraits<TargetField> TFT;
 
@@ -576,6 +656,144 @@ void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::apply(
 			     Tpetra::INSERT );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Apply the volume source map for several fields at once. All of the
+ * source functions are evaluated at the mapped target points and their
+ * evaluations are packed into the columns of a single multivector such that
+ * all of the fields are moved to the target decomposition in one
+ * communication.
+ *
+ * \param source_evaluators Function evaluators used to apply the mapping,
+ * one for each field. These FieldEvaluators must be valid for the source
+ * used to generate the map. An evaluator may be null on processes without
+ * source.
+ *
+ * \param target_space_managers Target spaces into which the function
+ * evaluations will be written, one for each field in the same order as the
+ * evaluators. Enough space must be allocated to hold evaluations at all
+ * points in all dimensions of each field. A target space may be null on
+ * processes without target points.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+template<class SourceField, class TargetField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::apply( 
+    const Teuchos::Array<Teuchos::RCP< 
+	FieldEvaluator<GlobalOrdinal,SourceField> > >& source_evaluators,
+    const Teuchos::Array<Teuchos::RCP< 
+	FieldManager<TargetField> > >& target_space_managers )
+{
+    typedef FieldTraits<SourceField> SFT;
+    typedef FieldTraits<TargetField> TFT;
+
+    testPrecondition( source_evaluators.size() == 
+		      target_space_managers.size() );
+
+    // Evaluate all of the source functions at the target points and pack
+    // the evaluations into the columns of a single multivector.
+    GlobalOrdinal source_size = d_source_map->getNodeNumElements();
+    Teuchos::ArrayRCP<typename SFT::value_type> source_data;
+    Teuchos::Array<int> field_dims;
+    FieldTransferTools::packFields( 
+	d_comm, d_source_indexer.l2g(0), source_evaluators,
+	Teuchos::arcpFromArray( d_source_geometry ),
+	Teuchos::arcpFromArray( d_target_coords ),
+	Teuchos::ArrayRCP<double>(),
+	source_size, source_data, field_dims );
+    int num_columns = std::accumulate( field_dims.begin(), 
+				       field_dims.end(), 0 );
+    GlobalOrdinal target_size = d_target_map->getNodeNumElements();
+
+    // Move the data for all of the fields from the source decomposition to
+    // the target decomposition. Points that were not mapped get zeros.
+    Teuchos::ArrayRCP<typename TFT::value_type> target_data( 
+	num_columns*target_size, 0 );
+    if ( d_persistent_transfer )
+    {
+	d_transfer_plan->doPosts<typename SFT::value_type>( 
+	    source_data(), num_columns );
+	d_transfer_plan->doWaits<typename TFT::value_type>( target_data() );
+    }
+    else
+    {
+	Teuchos::RCP<Tpetra::MultiVector<typename SFT::value_type, int, GlobalOrdinal> > 
+	    source_vector = Tpetra::createMultiVectorFromView( 
+		d_source_map, source_data, source_size, num_columns );
+	Teuchos::RCP<Tpetra::MultiVector<typename TFT::value_type, int, GlobalOrdinal> > 
+	    target_vector = Tpetra::createMultiVectorFromView( 
+		d_target_map, target_data, target_size, num_columns );
+	target_vector->doImport( *source_vector, *d_source_to_target_importer, 
+			   Tpetra::INSERT );
+    }
+
+    // Unpack the columns into the target spaces.
+    FieldTransferTools::unpackFields( 
+	d_comm, d_target_indexer.l2g(0), field_dims, 
+	target_data, target_size, target_space_managers );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Begin applying the volume source map. The source function is
+ * evaluated at the target points that were mapped and the evaluations are
+ * packed and posted to the target decomposition without waiting for the
+ * communication to complete. The target space is not modified until
+ * applyEnd() is called. This does not synchronize the processes.
+ *
+ * \param source_evaluator Function evaluator used to apply the mapping. This
+ * FieldEvaluator must be valid for the source geometry used to generate the
+ * map.
+ *
+ * \param target_space_manager Target space into which the function
+ * evaluations will be written by applyEnd(). Enough space must be allocated
+ * to hold evaluations at all points in all dimensions of the field. The
+ * field must have the same dimension as the function evaluations.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+template<class SourceField, class TargetField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::applyBegin( 
+    const Teuchos::RCP< FieldEvaluator<GlobalOrdinal,SourceField> >& source_evaluator,
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
+{
+    GlobalOrdinal target_size = d_target_map->getNodeNumElements();
+    FieldTransferTools::postField( 
+	*d_transfer_plan, source_evaluator, 
+	Teuchos::arcpFromArray( d_source_geometry ), 
+	Teuchos::arcpFromArray( d_target_coords ),
+	Teuchos::ArrayRCP<double>(), 
+	target_space_manager, target_size );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Progress the communication posted by applyBegin(). This does not
+ * block and may be called any number of times during computation performed
+ * between applyBegin() and applyEnd().
+ *
+ * \return True if the communication for this process has completed.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+bool VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::applyProgress()
+{
+    return d_transfer_plan->doProgress();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Finish applying the volume source map. The communication posted by
+ * applyBegin() is completed and the function evaluations are written into
+ * the target space. Target points that were not mapped get zeros.
+ *
+ * \param target_space_manager The target space given to applyBegin().
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+template<class TargetField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::applyEnd( 
+    Teuchos::RCP< FieldManager<TargetField> >& target_space_manager )
+{
+    FieldTransferTools::waitField( *d_transfer_plan, target_space_manager );
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Get the points missed in the map generation.
@@ -733,6 +951,204 @@ void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::getTargetPointsInB
     }
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Search for the target points in the source geometry of the
+ * processes whose local bounding box contains them. This builds the source
+ * map and the source-to-target importer.
+ *
+ * \param source_geometry_manager The local source geometry. May be null on
+ * processes without source geometry.
+ *
+ * \param target_coords The blocked local target coordinates.
+ *
+ * \param target_ordinals The globally unique ordinals for the target
+ * coordinates.
+ */
+template<class Geometry, class GlobalOrdinal, class CoordinateField>
+void VolumeSourceMap<Geometry,GlobalOrdinal,CoordinateField>::directSearch(
+    const RCP_GeometryManager& source_geometry_manager,
+    const Teuchos::ArrayRCP<double>& target_coords,
+    const Teuchos::Array<GlobalOrdinal>& target_ordinals )
+{
+    bool source_exists = true;
+    if ( source_geometry_manager.is_null() ) source_exists = false;
+
+    GlobalOrdinal num_points = target_ordinals.size();
+    testPrecondition( num_points*d_dimension == 
+		      Teuchos::as<GlobalOrdinal>(target_coords.size()) );
+
+    // Get the bounding box of the local source geometry.
+    BoundingBox local_box;
+    bool has_box = false;
+    if ( source_exists && source_geometry_manager->localNumGeometry() > 0 )
+    {
+	local_box = source_geometry_manager->localBoundingBox();
+	has_box = true;
+    }
+    d_comm->barrier();
+
+    // Route the target points to every source process whose box contains
+    // them. The routes are sorted by process such that the search results
+    // come back in the same order.
+    BoxRouter router( d_comm, d_dimension, local_box, has_box, 
+		      d_geometric_tolerance );
+    Teuchos::Array<int> point_indices;
+    Teuchos::Array<int> point_procs;
+    router.routePoints( target_coords(), point_indices, point_procs );
+
+    int num_routes = point_indices.size();
+    Teuchos::Array<std::pair<int,int> > route_order( num_routes );
+    for ( int r = 0; r < num_routes; ++r )
+    {
+	route_order[r] = std::make_pair( point_procs[r], point_indices[r] );
+    }
+    std::sort( route_order.begin(), route_order.end() );
+
+    Teuchos::Array<int> route_procs( num_routes );
+    Teuchos::Array<GlobalOrdinal> route_ordinals( num_routes );
+    Teuchos::Array<double> route_coords( num_routes*d_dimension );
+    for ( int r = 0; r < num_routes; ++r )
+    {
+	route_procs[r] = route_order[r].first;
+	route_ordinals[r] = target_ordinals[ route_order[r].second ];
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    route_coords[ d_dimension*r + d ] = 
+		target_coords[ num_points*d + route_order[r].second ];
+	}
+    }
+    point_indices.clear();
+    point_procs.clear();
+
+    // Send the target point ordinals and coordinates to the source
+    // processes.
+    Tpetra::Distributor target_to_source_distributor( d_comm );
+    GlobalOrdinal num_received = 
+	target_to_source_distributor.createFromSends( route_procs() );
+
+    Teuchos::ArrayView<const GlobalOrdinal> route_ordinals_view =
+	route_ordinals();
+    Teuchos::Array<GlobalOrdinal> received_ordinals( num_received );
+    target_to_source_distributor.doPostsAndWaits( 
+	route_ordinals_view, 1, received_ordinals() );
+
+    Teuchos::ArrayView<const double> route_coords_view = route_coords();
+    Teuchos::Array<double> received_coords( num_received*d_dimension );
+    target_to_source_distributor.doPostsAndWaits( 
+	route_coords_view, d_dimension, received_coords() );
+
+    // Search the local source geometry with the received points.
+    Teuchos::Array<GlobalOrdinal> received_geometry( 
+	num_received, std::numeric_limits<GlobalOrdinal>::max() );
+    Teuchos::Array<int> received_found( num_received, 0 );
+    if ( source_exists )
+    {
+	const Teuchos::ArrayRCP<Geometry>& geometry = 
+	    source_geometry_manager->geometry();
+	const Teuchos::ArrayRCP<GlobalOrdinal>& gids =
+	    source_geometry_manager->gids();
+	Teuchos::Array<double> point( d_dimension );
+	for ( GlobalOrdinal n = 0; n < num_received; ++n )
+	{
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		point[d] = received_coords[ d_dimension*n + d ];
+	    }
+
+	    for ( int g = 0; g < geometry.size() && !received_found[n]; ++g )
+	    {
+		if ( GT::pointInGeometry(geometry[g], point, 
+					 d_geometric_tolerance) )
+		{
+		    received_found[n] = 1;
+		    received_geometry[n] = gids[g];
+		}
+	    }
+	}
+    }
+    d_comm->barrier();
+
+    // Send the search results back to the target processes via reverse
+    // communication. Each point is accepted by the lowest source process
+    // that found it.
+    Teuchos::ArrayView<const int> received_found_view = received_found();
+    Teuchos::Array<int> route_found( num_routes );
+    target_to_source_distributor.doReversePostsAndWaits(
+	received_found_view, 1, route_found() );
+
+    Teuchos::Array<short int> point_accepted( num_points, 0 );
+    Teuchos::Array<int> route_accepted( num_routes, 0 );
+    for ( int r = 0; r < num_routes; ++r )
+    {
+	if ( route_found[r] && !point_accepted[route_order[r].second] )
+	{
+	    point_accepted[route_order[r].second] = 1;
+	    route_accepted[r] = 1;
+	}
+    }
+
+    // If we're keeping track of missed points, add the points that were not
+    // found by any source process to the list.
+    if ( d_store_missed_points )
+    {
+	for ( GlobalOrdinal n = 0; n < num_points; ++n )
+	{
+	    if ( !point_accepted[n] )
+	    {
+		d_missed_points.push_back(n);
+	    }
+	}
+    }
+
+    // Send the acceptance back to the source processes.
+    Teuchos::ArrayView<const int> route_accepted_view = route_accepted();
+    Teuchos::Array<int> received_accepted( num_received );
+    target_to_source_distributor.doPostsAndWaits( 
+	route_accepted_view, 1, received_accepted() );
+
+    // Extract the accepted points and their source geometry.
+    GlobalOrdinal num_source_geometry = std::count( 
+	received_accepted.begin(), received_accepted.end(), 1 );
+    Teuchos::Array<GlobalOrdinal> source_points( num_source_geometry );
+    d_source_geometry.resize( num_source_geometry );
+    d_target_coords.resize( num_source_geometry*d_dimension );
+    GlobalOrdinal source_index = 0;
+    for ( GlobalOrdinal n = 0; n < num_received; ++n )
+    {
+	if ( received_accepted[n] )
+	{
+	    d_source_geometry[source_index] = received_geometry[n];
+	    source_points[source_index] = received_ordinals[n];
+	    for ( int d = 0; d < d_dimension; ++d )
+	    {
+		d_target_coords[ num_source_geometry*d + source_index ] =
+		    received_coords[ d_dimension*n + d ];
+	    }
+	    ++source_index;
+	}
+    }
+    testPostcondition( source_index == num_source_geometry );
+
+    // Build the source map from the target ordinals.
+    Teuchos::ArrayView<const GlobalOrdinal> source_points_view = 
+	source_points();
+    d_source_map = Tpetra::createNonContigMap<int,GlobalOrdinal>( 
+	source_points_view, d_comm );
+    testPostcondition( !d_source_map.is_null() );
+
+    // Build the source-to-target importer.
+    d_source_to_target_importer = 
+      Teuchos::rcp( new Tpetra::Import<int,GlobalOrdinal>(
+	  d_source_map, d_target_map ) );
+    testPostcondition( !d_source_to_target_importer.is_null() );
+
+    // Compile the split-phase communication plan from the importer.
+    d_transfer_plan = Teuchos::rcp( 
+	new TransferPlan( d_comm, *d_source_to_target_importer ) );
+    testPostcondition( !d_transfer_plan.is_null() );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace DataTransferKit
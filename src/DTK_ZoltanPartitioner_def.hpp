@@ -0,0 +1,618 @@
+//---------------------------------------------------------------------------//
+/*
+  Copyright (c) 2012, Stuart R. Slattery
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are
+  met:
+
+  *: Redistributions of source code must retain the above copyright
+  notice, this list of conditions and the following disclaimer.
+
+  *: Redistributions in binary form must reproduce the above copyright
+  notice, this list of conditions and the following disclaimer in the
+  documentation and/or other materials provided with the distribution.
+
+  *: Neither the name of the University of Wisconsin - Madison nor the
+  names of its contributors may be used to endorse or promote products
+  derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//---------------------------------------------------------------------------//
+/*!
+ * \file DTK_ZoltanPartitioner_def.hpp
+ * \author Stuart R. Slattery
+ * \brief Wrapper definition for Zoltan geometric partitioning.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_ZOLTANPARTITIONER_DEF_HPP
+#define DTK_ZOLTANPARTITIONER_DEF_HPP
+
+#include <algorithm>
+
+#include "DTK_MeshTools.hpp"
+#include "DTK_Assertion.hpp"
+#include "DTK_CommIndexer.hpp"
+#include "DataTransferKit_config.hpp"
+
+#include <mpi.h>
+
+#include <Teuchos_DefaultMpiComm.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_Tuple.hpp>
+#include <Teuchos_as.hpp>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Constructor.
+ *
+ * \param comm The communicator over which to build the partitioning.
+ *
+ * \param mesh_manager The mesh to be partitioned. A null RCP is valid here as
+ * the mesh may or may not exist on all of the processes we want to
+ * repartition it to.
+ *
+ * \param dimension The dimension of the partitioning space.
+ *
+ * \param type The Zoltan partitioning method. Must be RCB, RIB, or HSFC.
+ *
+ * \param weights Optional vertex weights. If provided, the partitioning will
+ * balance the sum of the vertex weights on each process instead of the number
+ * of vertices. Vertices on processes without weights have unit weight.
+ */
+template<class Mesh>
+ZoltanPartitioner<Mesh>::ZoltanPartitioner( 
+    const RCP_Comm& comm, 
+    const RCP_MeshManager& mesh_manager, 
+    const int dimension, 
+    const DTK_PartitionerType type,
+    const RCP_PartitionWeights& weights )
+    : d_comm( comm )
+    , d_mesh_manager( mesh_manager )
+    , d_weights( weights )
+    , d_dimension( dimension )
+    , d_num_import( 0 )
+    , d_import_global_ids( 0 )
+    , d_import_local_ids( 0 )
+    , d_import_procs( 0 )
+    , d_import_to_part( 0 )
+    , d_num_export( 0 )
+    , d_export_global_ids( 0 )
+    , d_export_local_ids( 0 )
+    , d_export_procs( 0 )
+    , d_export_to_part( 0 )
+{
+    testPrecondition( type == DTK_RCB_PARTITIONER ||
+		      type == DTK_RIB_PARTITIONER ||
+		      type == DTK_HSFC_PARTITIONER );
+
+    // Determine if any process has weights.
+    int local_weighted = !d_weights.is_null();
+    int weighted = 0;
+    Teuchos::reduceAll<int,int>( *d_comm, Teuchos::REDUCE_MAX,
+				 local_weighted, Teuchos::Ptr<int>(&weighted) );
+
+    // Get the raw MPI communicator.
+    Teuchos::RCP< const Teuchos::MpiComm<int> > mpi_comm = 
+	Teuchos::rcp_dynamic_cast< const Teuchos::MpiComm<int> >( comm );
+    Teuchos::RCP< const Teuchos::OpaqueWrapper<MPI_Comm> > opaque_comm = 
+	mpi_comm->getRawMpiComm();
+    MPI_Comm raw_comm = (*opaque_comm)();
+
+    // Create the Zoltan object.
+    d_zz = Zoltan_Create( raw_comm );
+
+    // General parameters.
+    Zoltan_Set_Param( d_zz, "DEBUG_LEVEL", "0" );
+    if ( type == DTK_RIB_PARTITIONER )
+    {
+	Zoltan_Set_Param( d_zz, "LB_METHOD", "RIB" );
+    }
+    else if ( type == DTK_HSFC_PARTITIONER )
+    {
+	Zoltan_Set_Param( d_zz, "LB_METHOD", "HSFC" );
+    }
+    else
+    {
+	Zoltan_Set_Param( d_zz, "LB_METHOD", "RCB" );
+    }
+    Zoltan_Set_Param( d_zz, "NUM_GID_ENTRIES", "1" ); 
+    Zoltan_Set_Param( d_zz, "NUM_LID_ENTRIES", "1" );
+    Zoltan_Set_Param( d_zz, "DEBUG_PROCESSOR", "0" );
+    if ( weighted )
+    {
+	Zoltan_Set_Param( d_zz, "OBJ_WEIGHT_DIM", "1" );
+    }
+    else
+    {
+	Zoltan_Set_Param( d_zz, "OBJ_WEIGHT_DIM", "0" );
+    }
+    Zoltan_Set_Param( d_zz, "EDGE_WEIGHT_DIM", "0" );
+    Zoltan_Set_Param( d_zz, "RETURN_LISTS", "ALL" );
+
+    // Keep the partitioning for point and box assignment.
+    Zoltan_Set_Param( d_zz, "KEEP_CUTS", "1" );
+
+    // Method parameters.
+    if ( type == DTK_RCB_PARTITIONER )
+    {
+	Zoltan_Set_Param( d_zz, "RCB_OUTPUT_LEVEL", "0" );
+	Zoltan_Set_Param( d_zz, "RCB_RECTILINEAR_BLOCKS", "0" );
+	Zoltan_Set_Param( d_zz, "AVERAGE_CUTS", "1" );
+	Zoltan_Set_Param( d_zz, "RCB_LOCK_DIRECTIONS", "1" );
+	Zoltan_Set_Param( d_zz, "RCB_SET_DIRECTIONS", "1" );
+    }
+    else if ( type == DTK_RIB_PARTITIONER )
+    {
+	Zoltan_Set_Param( d_zz, "RIB_OUTPUT_LEVEL", "0" );
+	Zoltan_Set_Param( d_zz, "AVERAGE_CUTS", "1" );
+    }
+
+    // Register static functions.
+    Zoltan_Set_Num_Obj_Fn( d_zz, getNumberOfObjects, &d_mesh_manager );
+    Zoltan_Set_Obj_List_Fn( d_zz, getObjectList, this );
+    Zoltan_Set_Num_Geom_Fn( d_zz, getNumGeometry, &d_dimension );
+    Zoltan_Set_Geom_Multi_Fn( d_zz, getGeometryList, &d_mesh_manager );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Destructor. Zoltan memory deallocation happens here and only here.
+ */
+template<class Mesh>
+ZoltanPartitioner<Mesh>::~ZoltanPartitioner()
+{
+    Zoltan_LB_Free_Part( &d_import_global_ids, &d_import_local_ids, 
+			 &d_import_procs, &d_import_to_part );
+    Zoltan_LB_Free_Part( &d_export_global_ids, &d_export_local_ids, 
+			 &d_export_procs, &d_export_to_part );
+    Zoltan_Destroy( &d_zz );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the partitioning of the mesh.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::partition()
+{
+    rememberValue( int zoltan_error );
+#if HAVE_DTK_DBC
+    zoltan_error = Zoltan_LB_Partition( d_zz, 
+					&d_changes,  
+					&d_num_gid_entries,
+					&d_num_lid_entries,
+					&d_num_import,    
+					&d_import_global_ids,
+					&d_import_local_ids, 
+					&d_import_procs,    
+					&d_import_to_part,   
+					&d_num_export,      
+					&d_export_global_ids,
+					&d_export_local_ids, 
+					&d_export_procs,    
+					&d_export_to_part );
+#else
+    Zoltan_LB_Partition( d_zz, 
+			 &d_changes,  
+			 &d_num_gid_entries,
+			 &d_num_lid_entries,
+			 &d_num_import,    
+			 &d_import_global_ids,
+			 &d_import_local_ids, 
+			 &d_import_procs,    
+			 &d_import_to_part,   
+			 &d_num_export,      
+			 &d_export_global_ids,
+			 &d_export_local_ids, 
+			 &d_export_procs,    
+			 &d_export_to_part );
+#endif
+    testInvariant( zoltan_error == ZOLTAN_OK );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination process for a point given its coordinates.
+ *
+ * \param coords Point coordinates. The dimension of the point must be equal
+ * to the partitioning dimension.
+ *
+ * \return The destination proc for the point.
+ */
+template<class Mesh>
+int ZoltanPartitioner<Mesh>::getPointDestinationProc( 
+    const Teuchos::Array<double>& coords ) const
+{
+    testPrecondition( 0 <= coords.size() && coords.size() <= 3 );
+    testPrecondition( d_dimension == Teuchos::as<int>(coords.size()) );
+
+    double point[3];
+    std::copy( coords.begin(), coords.end(), &point[0] );
+    return pointAssign( point );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a bounding box. This includes all
+ * process domains that the box intersects.
+ *
+ * \param box The bounding box to get the destinations for.
+ *
+ * \return The destination procs for the box.
+ */
+template<class Mesh>
+Teuchos::Array<int>
+ZoltanPartitioner<Mesh>::getBoxDestinationProcs( const BoundingBox& box ) const
+{
+    Teuchos::Array<int> procs;
+    Teuchos::Array<int> proc_buffer( d_comm->getSize() );
+    boxAssign( box, proc_buffer, procs );
+    return procs;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a blocked list of points.
+ *
+ * \param coords Point coordinates blocked by dimension. The dimension of the
+ * points must be equal to the partitioning dimension.
+ *
+ * \param procs The destination proc for each point in the same order as the
+ * points.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::getPointDestinationProcs( 
+    const Teuchos::ArrayView<const double>& coords,
+    Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( coords.size() % d_dimension == 0 );
+
+    int num_points = coords.size() / d_dimension;
+    procs.resize( num_points );
+    double point[3];
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < d_dimension; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	procs[n] = pointAssign( point );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the destination processes for a list of bounding boxes.
+ *
+ * \param boxes The bounding boxes to get the destinations for.
+ *
+ * \param procs The destination procs for each box in the same order as the
+ * boxes.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::getBoxDestinationProcs( 
+    const Teuchos::Array<BoundingBox>& boxes,
+    Teuchos::Array<Teuchos::Array<int> >& procs ) const
+{
+    procs.resize( boxes.size() );
+    Teuchos::Array<int> proc_buffer( d_comm->getSize() );
+    for ( int i = 0; i < Teuchos::as<int>(boxes.size()); ++i )
+    {
+	boxAssign( boxes[i], proc_buffer, procs[i] );
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Assign a point to a partition with Zoltan.
+ */
+template<class Mesh>
+int ZoltanPartitioner<Mesh>::pointAssign( double point[] ) const
+{
+    int proc = 0;
+    rememberValue( int zoltan_error );
+#if HAVE_DTK_DBC
+    zoltan_error = Zoltan_LB_Point_Assign( d_zz, point, &proc );
+#else
+    Zoltan_LB_Point_Assign( d_zz, point, &proc );
+#endif
+    testInvariant( zoltan_error == ZOLTAN_OK );
+
+    return proc;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Assign a box to the partitions it intersects with Zoltan. The
+ * buffer must be of the communicator size.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::boxAssign( const BoundingBox& box,
+					 Teuchos::Array<int>& proc_buffer,
+					 Teuchos::Array<int>& procs ) const
+{
+    testPrecondition( proc_buffer.size() == d_comm->getSize() );
+
+    Teuchos::Tuple<double,6> box_bounds = box.getBounds();
+    int num_procs = 0;
+
+    rememberValue( int zoltan_error );
+#if HAVE_DTK_DBC
+    zoltan_error = Zoltan_LB_Box_Assign( d_zz, 
+					 box_bounds[0], box_bounds[1], 
+					 box_bounds[2], box_bounds[3], 
+					 box_bounds[4], box_bounds[5], 
+					 proc_buffer.getRawPtr(), &num_procs );
+#else
+    Zoltan_LB_Box_Assign( d_zz, 
+			  box_bounds[0], box_bounds[1], box_bounds[2],
+			  box_bounds[3], box_bounds[4], box_bounds[5], 
+			  proc_buffer.getRawPtr(), &num_procs );
+#endif
+    testInvariant( zoltan_error == ZOLTAN_OK );
+
+    procs.assign( proc_buffer.begin(), proc_buffer.begin() + num_procs );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Zoltan callback for getting the number of vertices.
+ */
+template<class Mesh>
+int ZoltanPartitioner<Mesh>::getNumberOfObjects( void *data, int *ierr )
+{
+    RCP_MeshManager mesh_manager = *static_cast<RCP_MeshManager*>( data );
+    int num_vertices = 0;
+
+    // We'll only count vertices if the mesh manager is not null.
+    if ( !mesh_manager.is_null() )
+    {
+	int num_blocks = mesh_manager->getNumBlocks();
+	Teuchos::ArrayView<short int>::const_iterator active_iterator;
+	for ( int i = 0; i < num_blocks; ++i )
+	{
+	    for ( active_iterator = mesh_manager->getActiveVertices(i).begin();
+		  active_iterator != mesh_manager->getActiveVertices(i).end();
+		  ++active_iterator )
+	    {
+		if ( *active_iterator )
+		{
+		    ++num_vertices;
+		}
+	    }
+	}
+    }
+
+    *ierr = ZOLTAN_OK;
+    return num_vertices;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Zoltan callback for getting the local and global vertex ID's.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::getObjectList( 
+    void *data, int sizeGID, int sizeLID,
+    ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
+    int wgt_dim, float *obj_wgts, int *ierr )
+{
+    ZoltanPartitioner<Mesh>* rcb = static_cast<ZoltanPartitioner<Mesh>*>( data );
+    RCP_MeshManager mesh_manager = rcb->d_mesh_manager;
+
+    // We'll only build the geometry list is the mesh manager is not null.
+    if ( !mesh_manager.is_null() )
+    {
+	// Note here that the local ID is being set as the vertex array index.
+	Teuchos::ArrayView<short int>::const_iterator active_iterator;
+	typename MT::const_vertex_iterator gid_iterator;
+	zoltan_id_type i = 0;
+	zoltan_id_type j = 0;
+	zoltan_id_type block_begin = 0;
+	BlockIterator block_iterator;
+	for ( block_iterator = mesh_manager->blocksBegin();
+	      block_iterator != mesh_manager->blocksEnd();
+	      ++block_iterator )
+	{
+	    int block_id = std::distance( mesh_manager->blocksBegin(),
+					  block_iterator );
+
+	    block_begin = i;
+	    for ( gid_iterator = MT::verticesBegin( *(*block_iterator) ),
+	       active_iterator = mesh_manager->getActiveVertices( 
+		   block_id ).begin();
+		  gid_iterator != MT::verticesEnd( *(*block_iterator) );
+		  ++gid_iterator, ++active_iterator )
+	    {
+		if ( *active_iterator )
+		{
+		    globalID[i] = static_cast<zoltan_id_type>( *gid_iterator );
+		    localID[i] = j;
+		    ++i;
+		}
+		++j;
+	    }
+
+	    // Weight the active vertices of the block.
+	    if ( wgt_dim > 0 )
+	    {
+		rcb->computeBlockWeights( 
+		    *(*block_iterator), 
+		    mesh_manager->getActiveVertices( block_id ),
+		    Teuchos::ArrayView<float>( obj_wgts + block_begin, 
+					       i - block_begin ) );
+	    }
+	}
+    }
+
+    *ierr = ZOLTAN_OK;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Compute the weights of the active vertices of a mesh block. Vertices
+ * have unit weight if no weights were provided.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::computeBlockWeights( 
+    const Mesh& mesh, 
+    const Teuchos::ArrayView<short int>& active_vertices,
+    const Teuchos::ArrayView<float>& weights ) const
+{
+    if ( d_weights.is_null() )
+    {
+	std::fill( weights.begin(), weights.end(), 1.0 );
+	return;
+    }
+
+    // Extract the coordinates of the active vertices.
+    Teuchos::ArrayRCP<const double> mesh_coords = 
+	MeshTools<Mesh>::coordsView( mesh );
+    GlobalOrdinal num_vertices = MeshTools<Mesh>::numVertices( mesh );
+    GlobalOrdinal num_active = weights.size();
+    int vertex_dim = MT::vertexDim( mesh );
+    Teuchos::Array<double> active_coords( vertex_dim*num_active );
+    GlobalOrdinal n = 0;
+    for ( GlobalOrdinal i = 0; i < num_vertices; ++i )
+    {
+	if ( active_vertices[i] )
+	{
+	    for ( int d = 0; d < vertex_dim; ++d )
+	    {
+		active_coords[ d*num_active + n ] = 
+		    mesh_coords[ d*num_vertices + i ];
+	    }
+	    ++n;
+	}
+    }
+    testInvariant( n == num_active );
+
+    d_weights->pointWeights( active_coords(), weights );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Zoltan callback for getting the dimension of the vertices.
+ */
+template<class Mesh>
+int ZoltanPartitioner<Mesh>::getNumGeometry( void *data, int *ierr )
+{
+    int dimension = *static_cast<int*>( data );
+    *ierr = ZOLTAN_OK;
+    return dimension;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Zoltan callback for getting the vertex coordinates.
+ */
+template<class Mesh>
+void ZoltanPartitioner<Mesh>::getGeometryList(
+    void *data, int sizeGID, int sizeLID,
+    int num_obj,
+    ZOLTAN_ID_PTR globalID, ZOLTAN_ID_PTR localID,
+    int num_dim, double *geom_vec, int *ierr )
+{
+    RCP_MeshManager mesh_manager = *static_cast<RCP_MeshManager*>( data );
+
+    // We will only supply vertex coordinates when the mesh exists.
+    if ( !mesh_manager.is_null() )
+    {
+	// Get the number of active vertices.
+	int num_active_vertices = 0;
+	int num_blocks = mesh_manager->getNumBlocks();
+	Teuchos::ArrayView<short int>::const_iterator active_iterator;
+	for ( int i = 0; i < num_blocks; ++i )
+	{
+	    for ( active_iterator = mesh_manager->getActiveVertices(i).begin();
+		  active_iterator != mesh_manager->getActiveVertices(i).end();
+		  ++active_iterator )
+	    {
+		if ( *active_iterator )
+		{
+		    ++num_active_vertices;
+		}
+	    }
+	}
+
+	// Check Zoltan for consistency.
+	int vertex_dim = mesh_manager->dim();
+	testInvariant( sizeGID == 1 );
+	testInvariant( sizeLID == 1 );
+	testInvariant( num_dim == Teuchos::as<int>(vertex_dim) );
+	testInvariant( num_obj == Teuchos::as<int>(num_active_vertices) );
+
+	if ( sizeGID != 1 || sizeLID != 1 || 
+	     num_dim != Teuchos::as<int>(vertex_dim) || 
+	     num_obj != Teuchos::as<int>(num_active_vertices) )
+	{
+	    *ierr = ZOLTAN_FATAL;
+	    return;
+	}
+    
+	// Zoltan needs interleaved coordinates.
+	int n = 0;
+	Teuchos::ArrayRCP<const double> mesh_coords;
+	GlobalOrdinal num_vertices;
+	BlockIterator block_iterator;
+	for ( block_iterator = mesh_manager->blocksBegin();
+	      block_iterator != mesh_manager->blocksEnd();
+	      ++block_iterator )
+	{
+	    int block_id = std::distance( mesh_manager->blocksBegin(),
+					  block_iterator );
+	    Teuchos::ArrayView<short int> active_vertices =
+		mesh_manager->getActiveVertices( block_id );
+
+	    mesh_coords = MeshTools<Mesh>::coordsView( *(*block_iterator) );
+	    num_vertices = std::distance( 
+		MT::verticesBegin( *(*block_iterator) ),
+					  
+		MT::verticesEnd( *(*block_iterator) ) );
+	    for ( GlobalOrdinal i = 0; i < num_vertices; ++i )
+	    {
+		if ( active_vertices[i] )
+		{
+		    for ( int d = 0; d < vertex_dim; ++d )
+		    {
+			geom_vec[ vertex_dim*n + d ] = 
+			    mesh_coords[ d*num_vertices + i ];
+		    }
+		    ++n;
+		}
+	    }
+	}
+    }
+	  
+    *ierr = ZOLTAN_OK;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+
+#endif // end DTK_ZOLTANPARTITIONER_DEF_HPP
+
+//---------------------------------------------------------------------------//
+// end DTK_ZoltanPartitioner_def.hpp
+//---------------------------------------------------------------------------//
+
@@ -14,6 +14,7 @@
 #include <cassert>
 
 #include <DTK_SharedDomainMap.hpp>
+#include <DTK_Rendezvous.hpp>
 #include <DTK_FieldTraits.hpp>
 #include <DTK_FieldEvaluator.hpp>
 #include <DTK_FieldManager.hpp>
@@ -23,6 +24,7 @@
 
 #include <Teuchos_UnitTestHarness.hpp>
 #include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_ArrayRCP.hpp>
 #include <Teuchos_OpaqueWrapper.hpp>
@@ -307,6 +309,87 @@ class MyEvaluator :
     Teuchos::RCP< const Teuchos::Comm<int> > d_comm;
 };
 
+//---------------------------------------------------------------------------//
+// Field evaluator that checks the reference coordinates given by the map.
+//---------------------------------------------------------------------------//
+class MyReferenceEvaluator : public MyEvaluator
+{
+  public:
+
+    MyReferenceEvaluator( const MyMesh& mesh, 
+			  const Teuchos::RCP< const Teuchos::Comm<int> >& comm )
+	: MyEvaluator( mesh, comm )
+	, d_num_calls( 0 )
+	, d_max_reference( 0.0 )
+    { /* ... */ }
+
+    ~MyReferenceEvaluator()
+    { /* ... */ }
+
+    // The target points are all at quadrilateral centers such that their
+    // reference coordinates are zero.
+    MyField evaluateReference( 
+	const Teuchos::ArrayRCP<MyMesh::global_ordinal_type>& elements,
+	const Teuchos::ArrayRCP<double>& coords,
+	const Teuchos::ArrayRCP<double>& reference_coords )
+    {
+	++d_num_calls;
+	if ( reference_coords.size() != coords.size() )
+	{
+	    d_max_reference = 1.0;
+	}
+	for ( int i = 0; i < reference_coords.size(); ++i )
+	{
+	    d_max_reference = 
+		std::max( d_max_reference, std::abs(reference_coords[i]) );
+	}
+	return evaluate( elements, coords );
+    }
+
+    int numCalls() const
+    { return d_num_calls; }
+
+    double maxReference() const
+    { return d_max_reference; }
+
+  private:
+
+    int d_num_calls;
+    double d_max_reference;
+};
+
+//---------------------------------------------------------------------------//
+// Field evaluator that counts the points it evaluates.
+//---------------------------------------------------------------------------//
+class MyCountingEvaluator : public MyEvaluator
+{
+  public:
+
+    MyCountingEvaluator( const MyMesh& mesh, 
+			 const Teuchos::RCP< const Teuchos::Comm<int> >& comm )
+	: MyEvaluator( mesh, comm )
+	, d_num_points( 0 )
+    { /* ... */ }
+
+    ~MyCountingEvaluator()
+    { /* ... */ }
+
+    MyField evaluate( 
+	const Teuchos::ArrayRCP<MyMesh::global_ordinal_type>& elements,
+	const Teuchos::ArrayRCP<double>& coords )
+    {
+	d_num_points += elements.size();
+	return MyEvaluator::evaluate( elements, coords );
+    }
+
+    int numPoints() const
+    { return d_num_points; }
+
+  private:
+
+    int d_num_points;
+};
+
 //---------------------------------------------------------------------------//
 // Mesh create function.
 //---------------------------------------------------------------------------//
@@ -331,8 +414,9 @@ class MyEvaluator :
   |       |       |       |       |
   *-------*-------*-------*-------*
 
+  The mesh may be shifted in x to move it.
  */
-Teuchos::RCP<MyMesh> buildMyMesh()
+Teuchos::RCP<MyMesh> buildMyMesh( const double shift = 0.0 )
 {
     int my_rank = getDefaultComm<int>()->getRank();
 
@@ -348,12 +432,12 @@ Teuchos::RCP<MyMesh> buildMyMesh()
     }
     for ( int i = 0; i < num_vertices / 2; ++i )
     {
-	coords[ i ] = my_rank;
+	coords[ i ] = my_rank + shift;
 	coords[ num_vertices + i ] = i;
     }
     for ( int i = num_vertices / 2; i < num_vertices; ++i )
     {
-	coords[ i ] = my_rank + 1;
+	coords[ i ] = my_rank + 1 + shift;
 	coords[ num_vertices + i ] = i - num_vertices/2;
     }
     
@@ -424,6 +508,78 @@ Teuchos::RCP<MyField> buildCoordinateField()
     return coordinate_field;
 }
 
+//---------------------------------------------------------------------------//
+// Aligned coordinate field create function.
+//---------------------------------------------------------------------------//
+/*
+  Make the following coordinate field partitioned on 4 processors such that
+  each processor's points are in its own column of the source mesh.
+
+   ------- ------- ------- ------- 
+  |       |       |       |       |
+  |   *   |   *   |   *   |   *   |
+  |   0   |   1   |   2   |   3   |
+   ------- ------- ------- ------- 
+  |       |       |       |       |
+  |   *   |   *   |   *   |   *   |
+  |   0   |   1   |   2   |   3   |
+   ------- ------- ------- ------- 
+  |       |       |       |       |
+  |   *   |   *   |   *   |   *   |
+  |   0   |   1   |   2   |   3   |
+   ------- ------- ------- ------- 
+  |       |       |       |       |
+  |   *   |   *   |   *   |   *   |
+  |   0   |   1   |   2   |   3   |
+   ------- ------- ------- ------- 
+
+ */
+Teuchos::RCP<MyField> buildAlignedCoordinateField()
+{
+    int num_points = 4;
+    int point_dim = 2;
+    Teuchos::RCP<MyField> coordinate_field = 
+	Teuchos::rcp( new MyField( num_points*point_dim, point_dim ) );
+
+    for ( int i = 0; i < num_points; ++i )
+    {
+	*(coordinate_field->begin() + i) = 
+	    getDefaultComm<int>()->getRank() + 0.5;
+	*(coordinate_field->begin() + num_points + i ) = i + 0.5;
+    }
+
+    return coordinate_field;
+}
+
+//---------------------------------------------------------------------------//
+// Shared coordinate field create function.
+//---------------------------------------------------------------------------//
+/*
+  Make the coordinate field of buildCoordinateField() followed by a copy of
+  the row of points of the next processor. The rows wrap around such that
+  the second row of processor 3 is a copy of row 0 and every row is on
+  exactly two processors. The points have global ids numbered by row.
+ */
+Teuchos::RCP<MyField> buildSharedCoordinateField( Teuchos::Array<int>& ids )
+{
+    int my_rank = getDefaultComm<int>()->getRank();
+    int num_points = 8;
+    int point_dim = 2;
+    Teuchos::RCP<MyField> coordinate_field = 
+	Teuchos::rcp( new MyField( num_points*point_dim, point_dim ) );
+    ids.resize( num_points );
+
+    for ( int i = 0; i < num_points; ++i )
+    {
+	int row = ( my_rank + i / 4 ) % 4;
+	*(coordinate_field->begin() + i) = i % 4 + 0.5;
+	*(coordinate_field->begin() + num_points + i ) = row + 0.5;
+	ids[i] = 4*row + i % 4;
+    }
+
+    return coordinate_field;
+}
+
 //---------------------------------------------------------------------------//
 // Unit tests
 //---------------------------------------------------------------------------//
@@ -479,6 +635,1128 @@ TEUCHOS_UNIT_TEST( SharedDomainMap, shared_domain_map_test )
     }
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, weighted_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup and apply the evaluation to the field with a rendezvous
+	// decomposition weighted by the target point density.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim() );
+	shared_domain_map.setTargetDensityWeights( 8 );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	// Check the data transfer.
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, local_search_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup and apply the evaluation to the field with a local search
+	// of the source mesh. Only one point on each process
+	// is found locally.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim(), true );
+	shared_domain_map.setLocalSearch( true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	// Check the data transfer.
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, aligned_local_search_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildAlignedCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup and apply the evaluation to the field with a local search
+	// of the source mesh. All of the points are found
+	// locally.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim(), true );
+	shared_domain_map.setLocalSearch( true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	// Check the data transfer.
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == my_rank + 1 );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, direct_search_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup and apply the evaluation to the field by routing the target
+	// points directly to the source processes.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim(), true );
+	shared_domain_map.setDirectSearch( true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	// Check the data transfer.
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 0 );
+
+	// Move the mesh past the points. The points are routed to the local
+	// tree built in setup() which is refit instead of built again.
+	Teuchos::RCP<const KDTree<MyMesh::global_ordinal_type> > local_tree =
+	    shared_domain_map.getLocalTree();
+	TEST_ASSERT( !local_tree.is_null() );
+	*mesh_blocks[0] = *buildMyMesh( 0.6 );
+	shared_domain_map.update( source_mesh_manager, target_coord_manager );
+	TEST_ASSERT( shared_domain_map.getLocalTree().get() == 
+		     local_tree.get() );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) == n );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 1 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints()[0] == 0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, shared_rendezvous_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Build one rendezvous decomposition for the source mesh.
+	Teuchos::RCP< Rendezvous<MyMesh> > rendezvous = Teuchos::rcp(
+	    new Rendezvous<MyMesh>( comm, source_mesh_manager->dim(),
+				    source_mesh_manager->globalBoundingBox() ) );
+	rendezvous->build( source_mesh_manager );
+
+	// Setup two target coordinate field managers.
+	Teuchos::RCP< FieldManager<MyField> > row_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+	Teuchos::RCP< FieldManager<MyField> > column_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildAlignedCoordinateField(), comm ) );
+
+	// Create data target managers.
+	Teuchos::RCP< FieldManager<MyField> > row_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+	Teuchos::RCP< FieldManager<MyField> > column_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+
+	// Setup and apply a map for each target with the same rendezvous
+	// decomposition.
+	SharedDomainMap<MyMesh,MyField> row_map( 
+	    comm, source_mesh_manager->dim() );
+	row_map.setRendezvous( rendezvous );
+	row_map.setup( source_mesh_manager, row_coord_manager );
+	row_map.apply( source_evaluator, row_space_manager );
+
+	SharedDomainMap<MyMesh,MyField> column_map( 
+	    comm, source_mesh_manager->dim() );
+	column_map.setRendezvous( rendezvous );
+	column_map.setup( source_mesh_manager, column_coord_manager );
+	column_map.apply( source_evaluator, column_space_manager );
+
+	// Check the data transfer.
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(row_space_manager->field()->begin()+n) == n + 1 );
+	    TEST_ASSERT( *(column_space_manager->field()->begin()+n) 
+			 == my_rank + 1 );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, moving_mesh_update_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+
+	// Setup and apply the evaluation to the field.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim(), true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+
+	// Move the mesh a little. Every point stays in its element.
+	*mesh_blocks[0] = *buildMyMesh( 0.2 );
+	shared_domain_map.update( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 0 );
+
+	// Move the mesh past the points. Each point is now in the column to
+	// its left and the points in the first column are outside the mesh.
+	*mesh_blocks[0] = *buildMyMesh( 0.6 );
+	shared_domain_map.update( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) == n );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 1 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints()[0] == 0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, local_search_update_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+
+	// Setup and apply the evaluation to the field with local search.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim(), true );
+	shared_domain_map.setLocalSearch( true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	Teuchos::RCP<const KDTree<MyMesh::global_ordinal_type> > local_tree =
+	    shared_domain_map.getLocalTree();
+	TEST_ASSERT( !local_tree.is_null() );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+
+	// Move the mesh past the points. The local tree is refit instead of
+	// built again and finds the points in their new elements.
+	*mesh_blocks[0] = *buildMyMesh( 0.6 );
+	shared_domain_map.update( source_mesh_manager, target_coord_manager );
+	TEST_ASSERT( shared_domain_map.getLocalTree().get() == 
+		     local_tree.get() );
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) == n );
+	}
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 1 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints()[0] == 0 );
+
+	// Setting up the map again builds a new local tree.
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	TEST_ASSERT( shared_domain_map.getLocalTree().get() != 
+		     local_tree.get() );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, add_remove_target_points_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Setup the map.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim(), true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+
+	// Add a point in the last column and a point outside of the mesh
+	// after the existing points.
+	int num_points = 6;
+	Teuchos::RCP<MyField> added_coords = 
+	    Teuchos::rcp( new MyField( 2*num_points, 2 ) );
+	for ( int i = 0; i < 4; ++i )
+	{
+	    *(added_coords->begin() + i) = i + 0.5;
+	}
+	*(added_coords->begin() + 4) = 3.5;
+	*(added_coords->begin() + 5) = 10.0;
+	for ( int i = 0; i < num_points; ++i )
+	{
+	    *(added_coords->begin() + num_points + i) = my_rank + 0.5;
+	}
+	Teuchos::RCP< FieldManager<MyField> > added_coord_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( added_coords, comm ) );
+	shared_domain_map.addTargetPoints( source_mesh_manager, 
+					   added_coord_manager );
+
+	Teuchos::RCP< FieldManager<MyField> > added_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( num_points, 1 ) ), 
+			      comm ) );
+	shared_domain_map.apply( source_evaluator, added_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( *(added_space_manager->field()->begin()+n) == n + 1 );
+	}
+	TEST_ASSERT( *(added_space_manager->field()->begin()+4) == 4 );
+	TEST_ASSERT( *(added_space_manager->field()->begin()+5) == 0 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 1 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints()[0] == 5 );
+
+	// Remove the second point.
+	Teuchos::Array<int> removed( 1, 1 );
+	shared_domain_map.removeTargetPoints( removed() );
+
+	Teuchos::RCP< FieldManager<MyField> > removed_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( num_points-1, 1 ) ), 
+			      comm ) );
+	shared_domain_map.apply( source_evaluator, removed_space_manager );
+	TEST_ASSERT( *(removed_space_manager->field()->begin()+0) == 1 );
+	TEST_ASSERT( *(removed_space_manager->field()->begin()+1) == 3 );
+	TEST_ASSERT( *(removed_space_manager->field()->begin()+2) == 4 );
+	TEST_ASSERT( *(removed_space_manager->field()->begin()+3) == 4 );
+	TEST_ASSERT( *(removed_space_manager->field()->begin()+4) == 0 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 1 );
+	TEST_ASSERT( shared_domain_map.getMissedTargetPoints()[0] == 4 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, multi_field_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create a field evaluator and target space for each field.
+	int num_fields = 3;
+	Teuchos::Array<Teuchos::RCP< 
+	    FieldEvaluator<MyMesh::global_ordinal_type,MyField> > >
+	    source_evaluators( num_fields );
+	Teuchos::Array<Teuchos::RCP< FieldManager<MyField> > > 
+	    target_space_managers( num_fields );
+	for ( int f = 0; f < num_fields; ++f )
+	{
+	    source_evaluators[f] = 
+		Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+	    target_space_managers[f] = Teuchos::rcp( 
+		new FieldManager<MyField>( 
+		    Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+	}
+
+	// Setup the map and apply it to all of the fields at once.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim() );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.apply( source_evaluators, target_space_managers );
+
+	// Check the data transfer.
+	for ( int f = 0; f < num_fields; ++f )
+	{
+	    for ( int n = 0; n < 4; ++n )
+	    {
+		TEST_ASSERT( *(target_space_managers[f]->field()->begin()+n)
+			     == n + 1 );
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, split_phase_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+	FieldTools<MyField>::putScalar( *target_field, -1.0 );
+
+	// Setup the map and begin the evaluation.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim() );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.applyBegin( source_evaluator, target_space_manager );
+
+	// The target space is not written until the apply is finished.
+	int num_progress = 0;
+	while ( !shared_domain_map.applyProgress() && num_progress < 100 )
+	{
+	    ++num_progress;
+	}
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) == -1.0 );
+	}
+
+	// Finish the evaluation.
+	shared_domain_map.applyEnd( target_space_manager );
+
+	// Check the data transfer.
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+
+	// The map may be applied again.
+	shared_domain_map.applyBegin( source_evaluator, target_space_manager );
+	shared_domain_map.applyEnd( target_space_manager );
+	for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	{
+	    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			 == n + 1 );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, persistent_transfer_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup the map.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim() );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+
+	// Apply the map several times with the persistent transfer plan and
+	// then with Tpetra.
+	for ( int i = 0; i < 4; ++i )
+	{
+	    shared_domain_map.setPersistentTransfer( i < 3 );
+	    FieldTools<MyField>::putScalar( *target_field, -1.0 );
+	    shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	    for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	    {
+		TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			     == n + 1 );
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, directory_free_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create field evaluator.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = 
+	    Teuchos::rcp( new MyEvaluator( *mesh_blocks[0], comm ) );
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup the map without the directory through the rendezvous
+	// decomposition and then with local search such that some of the
+	// points are permuted on their own process.
+	for ( int i = 0; i < 2; ++i )
+	{
+	    SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+		comm, source_mesh_manager->dim() );
+	    shared_domain_map.setDirectoryFree( true );
+	    shared_domain_map.setLocalSearch( 1 == i );
+	    shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+
+	    // Apply the map twice to reuse the transfer plan.
+	    for ( int j = 0; j < 2; ++j )
+	    {
+		FieldTools<MyField>::putScalar( *target_field, -1.0 );
+		shared_domain_map.apply( source_evaluator, 
+					 target_space_manager );
+
+		for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+		{
+		    TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+				 == n + 1 );
+		}
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, reference_coords_shared_domain_map_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create a field evaluator that checks the reference coordinates.
+	Teuchos::RCP<MyReferenceEvaluator> reference_evaluator = 
+	    Teuchos::rcp( new MyReferenceEvaluator( *mesh_blocks[0], comm ) );
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = reference_evaluator;
+
+	// Create data target manager
+	int field_size = target_coord_manager->field()->size() 
+			 / target_coord_manager->field()->dim();
+	Teuchos::RCP<MyField> target_field = 
+	    Teuchos::rcp( new MyField( field_size, 1 ) );
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( target_field, comm ) );
+
+	// Setup the map through the rendezvous decomposition and then with
+	// local search and apply it.
+	for ( int i = 0; i < 2; ++i )
+	{
+	    SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+		comm, source_mesh_manager->dim() );
+	    shared_domain_map.setLocalSearch( 1 == i );
+	    shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	    shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	    for ( int n = 0; n < target_space_manager->field()->size(); ++n )
+	    {
+		TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			     == n + 1 );
+	    }
+	}
+
+	// Check that the evaluator was given the reference coordinates.
+	TEST_EQUALITY( reference_evaluator->numCalls(), 2 );
+	TEST_ASSERT( reference_evaluator->maxReference() < 1.0e-12 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, target_global_ids_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager with every point on two
+	// processors.
+	Teuchos::Array<int> target_ids;
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      buildSharedCoordinateField( target_ids ), comm ) );
+
+	// Create a field evaluator that counts the evaluated points.
+	Teuchos::RCP<MyCountingEvaluator> counting_evaluator = 
+	    Teuchos::rcp( new MyCountingEvaluator( *mesh_blocks[0], comm ) );
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = counting_evaluator;
+
+	// Create data target manager
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 8, 1 ) ), comm ) );
+
+	// Setup the map with the target global ids and apply it with Tpetra
+	// and then with the persistent transfer plan.
+	for ( int i = 0; i < 2; ++i )
+	{
+	    SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+		comm, source_mesh_manager->dim(), true );
+	    shared_domain_map.setTargetGlobalIds( target_ids() );
+	    shared_domain_map.setPersistentTransfer( 1 == i );
+	    shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	    shared_domain_map.apply( source_evaluator, target_space_manager );
+
+	    for ( int n = 0; n < 8; ++n )
+	    {
+		TEST_ASSERT( *(target_space_manager->field()->begin()+n) 
+			     == n % 4 + 1 );
+	    }
+	    TEST_ASSERT( shared_domain_map.getMissedTargetPoints().size() == 0 );
+	}
+
+	// Check that each of the 16 unique points was evaluated once in each
+	// apply.
+	int local_num_points = counting_evaluator->numPoints();
+	int global_num_points = 0;
+	Teuchos::reduceAll<int,int>( *comm, Teuchos::REDUCE_SUM, 1,
+				     &local_num_points, &global_num_points );
+	TEST_EQUALITY( global_num_points, 32 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, masked_delta_apply_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create a field evaluator that counts the evaluated points.
+	Teuchos::RCP<MyCountingEvaluator> counting_evaluator = 
+	    Teuchos::rcp( new MyCountingEvaluator( *mesh_blocks[0], comm ) );
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    source_evaluator = counting_evaluator;
+
+	// Create data target manager
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+	MyField::iterator target_begin = target_space_manager->field()->begin();
+
+	// Setup the map.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim() );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+
+	// Apply to the even points only. The odd points keep their values.
+	std::fill( target_begin, target_begin + 4, -1.0 );
+	Teuchos::Array<int> target_mask( 4, 0 );
+	target_mask[0] = 1;
+	target_mask[2] = 1;
+	shared_domain_map.applyMasked( source_evaluator, target_space_manager,
+				       target_mask() );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( *(target_begin+n), (n % 2) ? -1.0 : n + 1.0 );
+	}
+
+	// Only the requested points were evaluated.
+	int local_num_points = counting_evaluator->numPoints();
+	int global_num_points = 0;
+	Teuchos::reduceAll<int,int>( *comm, Teuchos::REDUCE_SUM, 1,
+				     &local_num_points, &global_num_points );
+	TEST_EQUALITY( global_num_points, 8 );
+
+	// The first delta apply sends every point.
+	shared_domain_map.applyDelta( source_evaluator, target_space_manager,
+				      0, 0.0 );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( *(target_begin+n), n + 1.0 );
+	}
+
+	// The source function has not changed so the next delta apply sends
+	// nothing.
+	std::fill( target_begin, target_begin + 4, -1.0 );
+	shared_domain_map.applyDelta( source_evaluator, target_space_manager,
+				      0, 0.0 );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( *(target_begin+n), -1.0 );
+	}
+
+	// A full apply resets the values sent by the delta apply.
+	shared_domain_map.apply( source_evaluator, target_space_manager );
+	std::fill( target_begin, target_begin + 4, -1.0 );
+	shared_domain_map.applyDelta( source_evaluator, target_space_manager,
+				      0, 0.0 );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( *(target_begin+n), n + 1.0 );
+	}
+
+	// A second field with its own id and target space takes turns with
+	// the first. Its first delta apply sends every point and leaves the
+	// values last sent for the first field as they are.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    second_evaluator = 
+	    Teuchos::rcp( new MyCountingEvaluator( *mesh_blocks[0], comm ) );
+	Teuchos::RCP< FieldManager<MyField> > second_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+	MyField::iterator second_begin = second_space_manager->field()->begin();
+	std::fill( second_begin, second_begin + 4, -1.0 );
+	shared_domain_map.applyDelta( second_evaluator, second_space_manager,
+				      1, 0.0 );
+	std::fill( target_begin, target_begin + 4, -1.0 );
+	shared_domain_map.applyDelta( source_evaluator, target_space_manager,
+				      0, 0.0 );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( *(second_begin+n), n + 1.0 );
+	    TEST_EQUALITY( *(target_begin+n), -1.0 );
+	}
+
+	// The values last sent are kept for the field id and not for the
+	// evaluator. A new evaluator for the first field sends nothing.
+	Teuchos::RCP< FieldEvaluator<MyMesh::global_ordinal_type,MyField> > 
+	    new_evaluator = 
+	    Teuchos::rcp( new MyCountingEvaluator( *mesh_blocks[0], comm ) );
+	shared_domain_map.applyDelta( new_evaluator, target_space_manager,
+				      0, 0.0 );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( *(target_begin+n), -1.0 );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Build a linear function of the vertex coordinates of a mesh block.
+Teuchos::RCP<MyField> buildVertexField( const MyMesh& mesh )
+{
+    int num_vertices = std::distance( mesh.verticesBegin(), 
+				      mesh.verticesEnd() );
+    Teuchos::RCP<MyField> vertex_field = 
+	Teuchos::rcp( new MyField( num_vertices, 1 ) );
+    for ( int i = 0; i < num_vertices; ++i )
+    {
+	*(vertex_field->begin() + i) = 
+	    *(mesh.coordsBegin() + i) + 
+	    2.0 * *(mesh.coordsBegin() + num_vertices + i);
+    }
+    return vertex_field;
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( SharedDomainMap, interpolation_operator_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    // This is a 4 processor test.
+    if ( my_size == 4 )
+    {
+	// Setup source mesh manager.
+	Teuchos::ArrayRCP<Teuchos::RCP<MyMesh> > mesh_blocks( 1 );
+	mesh_blocks[0] = buildMyMesh();
+	Teuchos::RCP< MeshManager<MyMesh> > source_mesh_manager = Teuchos::rcp(
+	    new MeshManager<MyMesh>( mesh_blocks, comm, 2 ) );
+
+	// Setup target coordinate field manager
+	Teuchos::RCP< FieldManager<MyField> > target_coord_manager = 
+	    Teuchos::rcp( 
+		new FieldManager<MyField>( buildCoordinateField(), comm ) );
+
+	// Create a linear source field at the mesh vertices. The bilinear
+	// interpolation of the quads is exact for it.
+	Teuchos::RCP< FieldManager<MyField> > source_dof_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      buildVertexField( *mesh_blocks[0] ), comm ) );
+
+	// Create data target manager
+	Teuchos::RCP< FieldManager<MyField> > target_space_manager = 
+	    Teuchos::rcp( new FieldManager<MyField>( 
+			      Teuchos::rcp( new MyField( 4, 1 ) ), comm ) );
+
+	// Setup the map with the interpolation operator and apply it.
+	SharedDomainMap<MyMesh,MyField> shared_domain_map( 
+	    comm, source_mesh_manager->dim() );
+	shared_domain_map.setInterpolationOperator( true );
+	shared_domain_map.setup( source_mesh_manager, target_coord_manager );
+	shared_domain_map.applyOperator( source_dof_manager, 
+					 target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( std::abs( *(target_space_manager->field()->begin()+n) 
+				   - (n + 2*my_rank + 1.5) ) < 1.0e-12 );
+	}
+
+	// Move the mesh a little and move the source field with it. Every
+	// point stays in its element and the operator is built again with the
+	// new reference coordinates.
+	*mesh_blocks[0] = *buildMyMesh( 0.2 );
+	source_dof_manager = Teuchos::rcp( new FieldManager<MyField>( 
+			      buildVertexField( *mesh_blocks[0] ), comm ) );
+	shared_domain_map.update( source_mesh_manager, target_coord_manager );
+	shared_domain_map.applyOperator( source_dof_manager, 
+					 target_space_manager );
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_ASSERT( std::abs( *(target_space_manager->field()->begin()+n) 
+				   - (n + 2*my_rank + 1.5) ) < 1.0e-12 );
+	}
+    }
+}
+
 //---------------------------------------------------------------------------//
 // end tstSharedDomainMap1.cpp
 //---------------------------------------------------------------------------//
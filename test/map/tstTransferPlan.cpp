@@ -0,0 +1,210 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file tstTransferPlan.cpp
+ * \author Stuart R. Slattery
+ * \brief TransferPlan unit tests.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+
+#include <DTK_TransferPlan.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_ArrayView.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_DefaultComm.hpp>
+
+#include <Tpetra_Map.hpp>
+#include <Tpetra_Export.hpp>
+#include <Tpetra_Import.hpp>
+
+//---------------------------------------------------------------------------//
+// MPI Setup
+//---------------------------------------------------------------------------//
+
+template<class Ordinal>
+Teuchos::RCP<const Teuchos::Comm<Ordinal> > getDefaultComm()
+{
+#ifdef HAVE_MPI
+    return Teuchos::DefaultComm<Ordinal>::getComm();
+#else
+    return Teuchos::rcp(new Teuchos::SerialComm<Ordinal>() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Helper functions.
+//---------------------------------------------------------------------------//
+
+// Build a source map with 4 ordinals on each process and a target map with
+// the source ordinals of the mirrored process in reverse order.
+void buildMaps( const Teuchos::RCP<const Teuchos::Comm<int> >& comm,
+		Teuchos::RCP<const Tpetra::Map<int,int> >& source_map,
+		Teuchos::RCP<const Tpetra::Map<int,int> >& target_map )
+{
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    Teuchos::Array<int> source_ids( 4 ), target_ids( 4 );
+    for ( int n = 0; n < 4; ++n )
+    {
+	source_ids[n] = my_rank*4 + n;
+	target_ids[n] = (my_size - my_rank - 1)*4 + 3 - n;
+    }
+
+    source_map = Tpetra::createNonContigMap<int,int>( source_ids(), comm );
+    target_map = Tpetra::createNonContigMap<int,int>( target_ids(), comm );
+}
+
+//---------------------------------------------------------------------------//
+// Tests
+//---------------------------------------------------------------------------//
+
+TEUCHOS_UNIT_TEST( TransferPlan, export_test )
+{
+    using namespace DataTransferKit;
+
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    Teuchos::RCP<const Tpetra::Map<int,int> > source_map, target_map;
+    buildMaps( comm, source_map, target_map );
+    Tpetra::Export<int,int> exporter( source_map, target_map );
+    TransferPlan plan( comm, exporter );
+
+    // Fill 2 columns of source data with the ordinals.
+    Teuchos::Array<double> source_data( 8 );
+    for ( int n = 0; n < 4; ++n )
+    {
+	source_data[n] = my_rank*4 + n;
+	source_data[4 + n] = -(my_rank*4 + n);
+    }
+
+    // Move the data.
+    Teuchos::Array<double> target_data( 8, 0.0 );
+    TEST_ASSERT( !plan.isPosted() );
+    plan.doPosts( Teuchos::ArrayView<const double>(source_data), 2 );
+    TEST_ASSERT( plan.isPosted() );
+    while ( !plan.doProgress() ) {}
+    plan.doWaits( target_data() );
+    TEST_ASSERT( !plan.isPosted() );
+
+    // Check the data.
+    for ( int n = 0; n < 4; ++n )
+    {
+	int ordinal = (my_size - my_rank - 1)*4 + 3 - n;
+	TEST_EQUALITY( target_data[n], ordinal );
+	TEST_EQUALITY( target_data[4 + n], -ordinal );
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( TransferPlan, import_test )
+{
+    using namespace DataTransferKit;
+
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    Teuchos::RCP<const Tpetra::Map<int,int> > source_map, target_map;
+    buildMaps( comm, source_map, target_map );
+    Tpetra::Import<int,int> importer( source_map, target_map );
+    TransferPlan plan( comm, importer );
+
+    // Move the data twice to check that the plan may be reused.
+    Teuchos::Array<int> source_data( 4 );
+    Teuchos::Array<int> target_data( 4 );
+    for ( int i = 0; i < 2; ++i )
+    {
+	for ( int n = 0; n < 4; ++n )
+	{
+	    source_data[n] = (my_rank*4 + n)*(i + 1);
+	}
+	plan.doPosts( Teuchos::ArrayView<const int>(source_data), 1 );
+	plan.doWaits( target_data() );
+
+	for ( int n = 0; n < 4; ++n )
+	{
+	    TEST_EQUALITY( target_data[n], 
+			   ((my_size - my_rank - 1)*4 + 3 - n)*(i + 1) );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( TransferPlan, sparse_test )
+{
+    using namespace DataTransferKit;
+
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    Teuchos::RCP<const Tpetra::Map<int,int> > source_map, target_map;
+    buildMaps( comm, source_map, target_map );
+    Tpetra::Export<int,int> exporter( source_map, target_map );
+    TransferPlan plan( comm, exporter );
+
+    // Fill 2 columns of source data with the ordinals and flag the even
+    // ordinals.
+    Teuchos::Array<double> source_data( 8 );
+    Teuchos::Array<int> source_flags( 4 );
+    for ( int n = 0; n < 4; ++n )
+    {
+	source_data[n] = my_rank*4 + n;
+	source_data[4 + n] = -(my_rank*4 + n);
+	source_flags[n] = ( 0 == n % 2 );
+    }
+
+    // Move the flagged data. The other target entries are not written.
+    Teuchos::Array<double> target_data( 8, 1.0 );
+    plan.doSparsePostsAndWaits( Teuchos::ArrayView<const double>(source_data),
+				2, Teuchos::ArrayView<const int>(source_flags),
+				target_data() );
+    TEST_ASSERT( !plan.isPosted() );
+    for ( int n = 0; n < 4; ++n )
+    {
+	int ordinal = (my_size - my_rank - 1)*4 + 3 - n;
+	if ( 0 == ordinal % 2 )
+	{
+	    TEST_EQUALITY( target_data[n], ordinal );
+	    TEST_EQUALITY( target_data[4 + n], -ordinal );
+	}
+	else
+	{
+	    TEST_EQUALITY( target_data[n], 1.0 );
+	    TEST_EQUALITY( target_data[4 + n], 1.0 );
+	}
+    }
+
+    // Flag the first target entry and move the flag back to its source
+    // entry. The first target entry receives the last source entry of the
+    // mirrored process.
+    Teuchos::Array<int> target_flags( 4, 0 );
+    target_flags[0] = 1;
+    plan.doReverseFlags( Teuchos::ArrayView<const int>(target_flags),
+			 source_flags() );
+    for ( int n = 0; n < 4; ++n )
+    {
+	TEST_EQUALITY( source_flags[n], ( 3 == n ) );
+    }
+
+    // The dense transfer still works after a sparse transfer.
+    plan.doPosts( Teuchos::ArrayView<const double>(source_data), 2 );
+    plan.doWaits( target_data() );
+    for ( int n = 0; n < 4; ++n )
+    {
+	int ordinal = (my_size - my_rank - 1)*4 + 3 - n;
+	TEST_EQUALITY( target_data[n], ordinal );
+	TEST_EQUALITY( target_data[4 + n], -ordinal );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end tstTransferPlan.cpp
+//---------------------------------------------------------------------------//
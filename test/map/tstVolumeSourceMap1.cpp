@@ -453,6 +453,282 @@ TEUCHOS_UNIT_TEST( VolumeSourceMap, box_test )
 		 global_num_missed + global_num_in_box );
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( VolumeSourceMap, direct_search_box_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+    Teuchos::Array<int> geom_ranks(1,0);
+    Teuchos::RCP<const Teuchos::Comm<int> > geom_comm = 
+	comm->createSubcommunicator( geom_ranks() );
+
+    // Setup source geometry.
+    double edge_size = 1.0;
+    int geom_dim = 3;
+    Teuchos::ArrayRCP<Box> geometry(0);
+    Teuchos::ArrayRCP<int> geom_gids(0);
+    Teuchos::RCP<FieldEvaluator<int,MyField> > source_evaluator;
+    Teuchos::RCP<GeometryManager<Box,int> > source_geometry_manager;
+    if ( my_rank == 0 )
+    {
+	buildBoxGeometry( my_size, edge_size, geometry, geom_gids );
+    	source_evaluator = Teuchos::rcp( new MyEvaluator( geom_gids, geom_comm ) );
+	source_geometry_manager =
+	    Teuchos::rcp( new GeometryManager<Box,int>( 
+			      geometry, geom_gids, geom_comm, geom_dim ) );
+    }    
+    comm->barrier();
+
+    // Setup target.
+    int target_dim = 1;
+    int num_target_points = 100;    
+    Teuchos::RCP<MyField> target_coords = 
+	Teuchos::rcp( new MyField( num_target_points, geom_dim ) );
+    Teuchos::RCP<MyField> target_field = 
+	Teuchos::rcp( new MyField( num_target_points, target_dim ) );
+
+    buildCoordinateField( my_rank, my_size, num_target_points, edge_size,
+			  target_coords );
+
+    Teuchos::RCP<FieldManager<MyField> > target_coord_manager = Teuchos::rcp( 
+	new FieldManager<MyField>( target_coords, comm ) );
+
+    Teuchos::RCP<FieldManager<MyField> > target_space_manager = Teuchos::rcp( 
+	new FieldManager<MyField>( target_field, comm ) );
+
+    // Setup and apply the volume source mapping by routing the target points
+    // directly to the source processes.
+    VolumeSourceMap<Box,int,MyField> volume_source_map( 
+	comm, geom_dim, true, 1.0e-6 );
+    volume_source_map.setDirectSearch( true );
+    volume_source_map.setup( source_geometry_manager, target_coord_manager );
+    volume_source_map.apply( source_evaluator, target_space_manager );
+
+    // Check the evaluation.
+    Box global_box;
+    if ( my_rank == 0 )
+    {
+	global_box = geometry[0];
+    }
+    comm->barrier();
+    Teuchos::broadcast( *comm, 0, Teuchos::Ptr<Box>(&global_box) );
+
+    Teuchos::ArrayRCP<const double> coords = 
+	FieldTools<MyField>::view( *target_coords );
+
+    Teuchos::ArrayRCP<const double> target_data = 
+	FieldTools<MyField>::view( *target_field );
+
+    Teuchos::Array<double> vertex(3);
+    double tol = 1.0e-6;
+    int num_in_box = 0;
+    for ( int i = 0; i < num_target_points; ++i )
+    {
+	vertex[0] = coords[i];
+	vertex[1] = coords[i + num_target_points];
+	vertex[2] = coords[i + 2*num_target_points];
+
+	if ( global_box.pointInBox( vertex, tol ) )
+	{
+	    ++num_in_box;
+	    
+	    TEST_ASSERT( target_data[i] == 1.0 );
+	}
+	else
+	{
+	    TEST_ASSERT( target_data[i] == 0.0 );
+	}
+    }
+    comm->barrier();
+
+    int global_num_in_box = 0;
+    Teuchos::reduceAll( *comm, Teuchos::REDUCE_SUM, 
+			num_in_box, Teuchos::Ptr<int>(&global_num_in_box) );
+
+    int num_missed = volume_source_map.getMissedTargetPoints().size();
+    int global_num_missed = 0;
+    Teuchos::reduceAll( *comm, Teuchos::REDUCE_SUM,
+			num_missed, Teuchos::Ptr<int>(&global_num_missed) );
+    
+    TEST_ASSERT( num_target_points*my_size == 
+		 global_num_missed + global_num_in_box );
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( VolumeSourceMap, multi_field_box_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+    Teuchos::Array<int> geom_ranks(1,0);
+    Teuchos::RCP<const Teuchos::Comm<int> > geom_comm = 
+	comm->createSubcommunicator( geom_ranks() );
+
+    // Setup source geometry.
+    double edge_size = 1.0;
+    int geom_dim = 3;
+    Teuchos::ArrayRCP<Box> geometry(0);
+    Teuchos::ArrayRCP<int> geom_gids(0);
+    Teuchos::RCP<FieldEvaluator<int,MyField> > source_evaluator;
+    Teuchos::RCP<GeometryManager<Box,int> > source_geometry_manager;
+    if ( my_rank == 0 )
+    {
+	buildBoxGeometry( my_size, edge_size, geometry, geom_gids );
+	source_evaluator = Teuchos::rcp( new MyEvaluator( geom_gids, geom_comm ) );
+	source_geometry_manager =
+	    Teuchos::rcp( new GeometryManager<Box,int>( 
+			      geometry, geom_gids, geom_comm, geom_dim ) );
+    }    
+    comm->barrier();
+
+    // Setup target.
+    int target_dim = 1;
+    int num_target_points = 100;    
+    Teuchos::RCP<MyField> target_coords = 
+	Teuchos::rcp( new MyField( num_target_points, geom_dim ) );
+    buildCoordinateField( my_rank, my_size, num_target_points, edge_size,
+			  target_coords );
+    Teuchos::RCP<FieldManager<MyField> > target_coord_manager = Teuchos::rcp( 
+	new FieldManager<MyField>( target_coords, comm ) );
+
+    // Setup three target fields that are moved together.
+    int num_fields = 3;
+    Teuchos::Array<Teuchos::RCP<FieldEvaluator<int,MyField> > > 
+	source_evaluators( num_fields, source_evaluator );
+    Teuchos::Array<Teuchos::RCP<FieldManager<MyField> > > 
+	target_space_managers( num_fields );
+    for ( int f = 0; f < num_fields; ++f )
+    {
+	target_space_managers[f] = Teuchos::rcp( 
+	    new FieldManager<MyField>( 
+		Teuchos::rcp( new MyField( num_target_points, target_dim ) ),
+		comm ) );
+    }
+
+    // Setup the volume source mapping and apply it to all of the fields
+    // at once.
+    VolumeSourceMap<Box,int,MyField> volume_source_map( 
+	comm, geom_dim, false, 1.0e-6 );
+    volume_source_map.setup( source_geometry_manager, target_coord_manager );
+    volume_source_map.apply( source_evaluators, target_space_managers );
+
+    // Check the evaluation.
+    Box global_box;
+    if ( my_rank == 0 )
+    {
+	global_box = geometry[0];
+    }
+    comm->barrier();
+    Teuchos::broadcast( *comm, 0, Teuchos::Ptr<Box>(&global_box) );
+
+    Teuchos::ArrayRCP<const double> coords = 
+	FieldTools<MyField>::view( *target_coords );
+
+    Teuchos::Array<double> vertex(3);
+    double tol = 1.0e-6;
+    for ( int f = 0; f < num_fields; ++f )
+    {
+	Teuchos::ArrayRCP<const double> target_data = 
+	    FieldTools<MyField>::view( *target_space_managers[f]->field() );
+	for ( int i = 0; i < num_target_points; ++i )
+	{
+	    vertex[0] = coords[i];
+	    vertex[1] = coords[i + num_target_points];
+	    vertex[2] = coords[i + 2*num_target_points];
+
+	    if ( global_box.pointInBox( vertex, tol ) )
+	    {
+		TEST_ASSERT( target_data[i] == 1.0 );
+	    }
+	    else
+	    {
+		TEST_ASSERT( target_data[i] == 0.0 );
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST( VolumeSourceMap, split_phase_box_test )
+{
+    using namespace DataTransferKit;
+
+    // Setup communication.
+    Teuchos::RCP<const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+    Teuchos::Array<int> geom_ranks(1,0);
+    Teuchos::RCP<const Teuchos::Comm<int> > geom_comm = 
+	comm->createSubcommunicator( geom_ranks() );
+
+    // Setup source geometry.
+    double edge_size = 1.0;
+    int geom_dim = 3;
+    Teuchos::ArrayRCP<Box> geometry(0);
+    Teuchos::ArrayRCP<int> geom_gids(0);
+    Teuchos::RCP<FieldEvaluator<int,MyField> > source_evaluator;
+    Teuchos::RCP<GeometryManager<Box,int> > source_geometry_manager;
+    if ( my_rank == 0 )
+    {
+	buildBoxGeometry( my_size, edge_size, geometry, geom_gids );
+	source_evaluator = Teuchos::rcp( new MyEvaluator( geom_gids, geom_comm ) );
+	source_geometry_manager =
+	    Teuchos::rcp( new GeometryManager<Box,int>( 
+			      geometry, geom_gids, geom_comm, geom_dim ) );
+    }    
+    comm->barrier();
+
+    // Setup target.
+    int target_dim = 1;
+    int num_target_points = 100;    
+    Teuchos::RCP<MyField> target_coords = 
+	Teuchos::rcp( new MyField( num_target_points, geom_dim ) );
+    Teuchos::RCP<MyField> target_field = 
+	Teuchos::rcp( new MyField( num_target_points, target_dim ) );
+    Teuchos::RCP<MyField> split_target_field = 
+	Teuchos::rcp( new MyField( num_target_points, target_dim ) );
+
+    buildCoordinateField( my_rank, my_size, num_target_points, edge_size,
+			  target_coords );
+
+    Teuchos::RCP<FieldManager<MyField> > target_coord_manager = Teuchos::rcp( 
+	new FieldManager<MyField>( target_coords, comm ) );
+
+    Teuchos::RCP<FieldManager<MyField> > target_space_manager = Teuchos::rcp( 
+	new FieldManager<MyField>( target_field, comm ) );
+
+    Teuchos::RCP<FieldManager<MyField> > split_target_space_manager = 
+	Teuchos::rcp( new FieldManager<MyField>( split_target_field, comm ) );
+
+    // Setup the volume source mapping and apply it in one phase and in two
+    // phases.
+    VolumeSourceMap<Box,int,MyField> volume_source_map( 
+	comm, geom_dim, true, 1.0e-6 );
+    volume_source_map.setup( source_geometry_manager, target_coord_manager );
+    volume_source_map.apply( source_evaluator, target_space_manager );
+    volume_source_map.applyBegin( source_evaluator, 
+				  split_target_space_manager );
+    volume_source_map.applyProgress();
+    volume_source_map.applyEnd( split_target_space_manager );
+
+    // Check that the evaluations are the same.
+    Teuchos::ArrayRCP<const double> target_data = 
+	FieldTools<MyField>::view( *target_field );
+    Teuchos::ArrayRCP<const double> split_target_data = 
+	FieldTools<MyField>::view( *split_target_field );
+    for ( int i = 0; i < num_target_points; ++i )
+    {
+	TEST_EQUALITY( target_data[i], split_target_data[i] );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // end tstVolumeSourceMap1.cpp
 //---------------------------------------------------------------------------//
@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file tstBoxRouter.cpp
+ * \author Stuart R. Slattery
+ * \brief BoxRouter unit tests.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+
+#include <DTK_BoxRouter.hpp>
+#include <DTK_BoundingBox.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_TypeTraits.hpp>
+
+//---------------------------------------------------------------------------//
+// MPI Setup
+//---------------------------------------------------------------------------//
+
+template<class Ordinal>
+Teuchos::RCP<const Teuchos::Comm<Ordinal> > getDefaultComm()
+{
+#ifdef HAVE_MPI
+    return Teuchos::DefaultComm<Ordinal>::getComm();
+#else
+    return Teuchos::rcp(new Teuchos::SerialComm<Ordinal>() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Tests
+//---------------------------------------------------------------------------//
+// Each process owns a unit box in a row of boxes.
+TEUCHOS_UNIT_TEST( BoxRouter, row_test )
+{
+    using namespace DataTransferKit;
+
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    BoundingBox local_box( my_rank, 0.0, 0.0, my_rank + 1.0, 1.0, 0.0 );
+    BoxRouter router( comm, 2, local_box, true );
+    TEST_ASSERT( router.numBoxes() == my_size );
+
+    // Route a point in the center of each box, a point on the face between
+    // each pair of boxes, and a point outside of all of the boxes.
+    int num_points = 2*my_size + 1;
+    Teuchos::Array<double> coords( 2*num_points, 0.5 );
+    for ( int p = 0; p < my_size; ++p )
+    {
+	coords[2*p] = p + 0.5;
+	coords[2*p + 1] = p + 1.0;
+    }
+    coords[2*my_size] = -1.0;
+
+    Teuchos::Array<int> point_indices;
+    Teuchos::Array<int> procs;
+    router.routePoints( coords(), point_indices, procs );
+
+    // The last face point is only in the last box.
+    TEST_ASSERT( point_indices.size() == 3*my_size - 1 );
+    TEST_ASSERT( procs.size() == point_indices.size() );
+    int r = 0;
+    for ( int p = 0; p < my_size; ++p )
+    {
+	TEST_ASSERT( point_indices[r] == 2*p );
+	TEST_ASSERT( procs[r] == p );
+	++r;
+
+	TEST_ASSERT( point_indices[r] == 2*p + 1 );
+	TEST_ASSERT( procs[r] == p );
+	++r;
+
+	if ( p < my_size - 1 )
+	{
+	    TEST_ASSERT( point_indices[r] == 2*p + 1 );
+	    TEST_ASSERT( procs[r] == p + 1 );
+	    ++r;
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Only the even processes own a box.
+TEUCHOS_UNIT_TEST( BoxRouter, partial_test )
+{
+    using namespace DataTransferKit;
+
+    Teuchos::RCP< const Teuchos::Comm<int> > comm = getDefaultComm<int>();
+    int my_rank = comm->getRank();
+    int my_size = comm->getSize();
+
+    BoundingBox local_box( my_rank, 0.0, 0.0, my_rank + 0.5, 1.0, 1.0 );
+    double tolerance = 0.1;
+    BoxRouter router( comm, 3, local_box, (0 == my_rank % 2), tolerance );
+    TEST_ASSERT( router.numBoxes() == (my_size + 1) / 2 );
+
+    // Route a point just outside of each process box. Only the points of the
+    // even processes are within the tolerance.
+    Teuchos::Array<double> coords( 3*my_size, 0.5 );
+    for ( int p = 0; p < my_size; ++p )
+    {
+	coords[p] = p + 0.55;
+    }
+
+    Teuchos::Array<int> point_indices;
+    Teuchos::Array<int> procs;
+    router.routePoints( coords(), point_indices, procs );
+
+    TEST_ASSERT( point_indices.size() == (my_size + 1) / 2 );
+    for ( int r = 0; r < point_indices.size(); ++r )
+    {
+	TEST_ASSERT( point_indices[r] == 2*r );
+	TEST_ASSERT( procs[r] == 2*r );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end tstBoxRouter.cpp
+//---------------------------------------------------------------------------//
@@ -0,0 +1,206 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file tstHilbertPartitioner.cpp
+ * \author Stuart R. Slattery
+ * \brief HilbertPartitioner unit tests.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+
+#include <DTK_HilbertPartitioner.hpp>
+#include <DTK_BoundingBox.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_TypeTraits.hpp>
+
+//---------------------------------------------------------------------------//
+// MPI Setup
+//---------------------------------------------------------------------------//
+
+template<class Ordinal>
+Teuchos::RCP<const Teuchos::Comm<Ordinal> > getDefaultComm()
+{
+#ifdef HAVE_MPI
+    return Teuchos::DefaultComm<Ordinal>::getComm();
+#else
+    return Teuchos::rcp(new Teuchos::SerialComm<Ordinal>() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Helper functions.
+//---------------------------------------------------------------------------//
+// Check the point and box destinations of a blocked list of points and
+// compute the global sum of the point weights on each process.
+bool checkPoints( const DataTransferKit::HilbertPartitioner& partitioner,
+		  const Teuchos::Array<double>& coords,
+		  const Teuchos::Array<float>& weights,
+		  const int dim,
+		  Teuchos::Array<double>& global_loads )
+{
+    using namespace DataTransferKit;
+
+    int my_size = getDefaultComm<int>()->getSize();
+    int num_points = weights.size();
+    bool passed = true;
+
+    // Check the single point and blocked point searches against each other.
+    Teuchos::Array<int> procs;
+    partitioner.getPointDestinationProcs( coords(), procs );
+    passed = passed && ( procs.size() == num_points );
+    Teuchos::Array<double> local_loads( my_size, 0.0 );
+    Teuchos::Array<double> point( dim );
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < dim; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	passed = passed && 
+		 ( partitioner.getPointDestinationProc( point ) == procs[n] );
+	passed = passed && ( 0 <= procs[n] && procs[n] < my_size );
+	local_loads[ procs[n] ] += weights[n];
+
+	// A box around the point includes its destination.
+	if ( n % 20 == 0 )
+	{
+	    Teuchos::Array<int> box_procs = 
+		partitioner.getBoxDestinationProcs( 
+		    BoundingBox( point[0] - 0.05, point[1] - 0.05, 
+				 (dim == 3) ? point[2] - 0.05 : 0.0,
+				 point[0] + 0.05, point[1] + 0.05, 
+				 (dim == 3) ? point[2] + 0.05 : 0.0 ) );
+	    passed = passed && 
+		     ( std::find( box_procs.begin(), box_procs.end(),
+				  procs[n] ) != box_procs.end() );
+	}
+    }
+
+    global_loads.assign( my_size, 0.0 );
+    Teuchos::reduceAll<int,double>( *getDefaultComm<int>(), 
+				    Teuchos::REDUCE_SUM, my_size,
+				    local_loads.getRawPtr(),
+				    global_loads.getRawPtr() );
+    return passed;
+}
+
+//---------------------------------------------------------------------------//
+// Tests
+//---------------------------------------------------------------------------//
+// 2d uniform points test.
+TEUCHOS_UNIT_TEST( HilbertPartitioner, 2d_uniform_test )
+{
+    using namespace DataTransferKit;
+
+    int my_rank = getDefaultComm<int>()->getRank();
+    int my_size = getDefaultComm<int>()->getSize();
+
+    // Make some random points in the unit square.
+    int dim = 2;
+    int num_points = 1000;
+    std::srand( my_rank + 1 );
+    Teuchos::Array<double> coords( dim*num_points );
+    for ( int i = 0; i < dim*num_points; ++i )
+    {
+	coords[i] = (double) std::rand() / RAND_MAX;
+    }
+    Teuchos::Array<float> weights( num_points, 1.0 );
+
+    // Partition the points.
+    HilbertPartitioner partitioner( getDefaultComm<int>(), dim );
+    partitioner.setPoints( coords(), Teuchos::ArrayView<const float>() );
+    partitioner.partition();
+
+    Teuchos::Array<HilbertPartitioner::key_type> splitters = 
+	partitioner.getSplitters();
+    TEST_ASSERT( splitters.size() == my_size - 1 );
+    for ( int i = 1; i < splitters.size(); ++i )
+    {
+	TEST_ASSERT( splitters[i-1] <= splitters[i] );
+    }
+
+    // Every process gets an equal share of the points.
+    Teuchos::Array<double> loads;
+    TEST_ASSERT( checkPoints( partitioner, coords, weights, dim, loads ) );
+    for ( int p = 0; p < my_size; ++p )
+    {
+	TEST_ASSERT( std::abs( loads[p] - num_points ) <= 1.0 );
+    }
+
+    // A box around all of the points is on every process. A box outside of
+    // the points is on the process owning the nearest corner.
+    Teuchos::Array<int> box_procs = partitioner.getBoxDestinationProcs(
+	BoundingBox( 0.0, 0.0, 0.0, 1.0, 1.0, 0.0 ) );
+    TEST_ASSERT( box_procs.size() == my_size );
+
+    Teuchos::Array<double> corner( dim, -1.0 );
+    box_procs = partitioner.getBoxDestinationProcs(
+	BoundingBox( -2.0, -2.0, 0.0, -1.0, -1.0, 0.0 ) );
+    TEST_ASSERT( box_procs.size() == 1 );
+    TEST_ASSERT( box_procs[0] == partitioner.getPointDestinationProc( corner ) );
+}
+
+//---------------------------------------------------------------------------//
+// 3d weighted points test.
+TEUCHOS_UNIT_TEST( HilbertPartitioner, 3d_weighted_test )
+{
+    using namespace DataTransferKit;
+
+    int my_rank = getDefaultComm<int>()->getRank();
+    int my_size = getDefaultComm<int>()->getSize();
+
+    // Make some random points in the unit cube. Points with x < 0.25 are
+    // four times as heavy as the others.
+    int dim = 3;
+    int num_points = 1000;
+    std::srand( my_rank + 1 );
+    Teuchos::Array<double> coords( dim*num_points );
+    for ( int i = 0; i < dim*num_points; ++i )
+    {
+	coords[i] = (double) std::rand() / RAND_MAX;
+    }
+    Teuchos::Array<float> weights( num_points, 1.0 );
+    double local_weight = 0.0;
+    for ( int n = 0; n < num_points; ++n )
+    {
+	if ( coords[n] < 0.25 )
+	{
+	    weights[n] = 4.0;
+	}
+	local_weight += weights[n];
+    }
+    double total_weight = 0.0;
+    Teuchos::reduceAll<int,double>( *getDefaultComm<int>(), 
+				    Teuchos::REDUCE_SUM, local_weight,
+				    Teuchos::Ptr<double>(&total_weight) );
+
+    // Partition the points.
+    HilbertPartitioner partitioner( getDefaultComm<int>(), dim );
+    partitioner.setPoints( coords(), weights() );
+    partitioner.partition();
+    TEST_ASSERT( partitioner.getSplitters().size() == my_size - 1 );
+
+    // Every process gets an equal share of the weight to within one point.
+    Teuchos::Array<double> loads;
+    TEST_ASSERT( checkPoints( partitioner, coords, weights, dim, loads ) );
+    for ( int p = 0; p < my_size; ++p )
+    {
+	TEST_ASSERT( std::abs( loads[p] - total_weight / my_size ) <= 4.0 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end tstHilbertPartitioner.cpp
+//---------------------------------------------------------------------------//
@@ -21,6 +21,7 @@
 #include <DTK_MeshManager.hpp>
 #include <DTK_MeshTools.hpp>
 #include <DTK_MeshContainer.hpp>
+#include <DTK_TopologyTools.hpp>
 
 #include <Teuchos_UnitTestHarness.hpp>
 #include <Teuchos_DefaultComm.hpp>
@@ -920,6 +921,174 @@ Teuchos::RCP<DataTransferKit::MeshContainer<int> > buildWedgeContainer()
 				permutation_list ) );
 }
 
+//---------------------------------------------------------------------------//
+// Structured hex grid over the unit cube with num_cells hexahedra in each
+// direction. Element (i,j,k) has handle i + j*num_cells + k*num_cells^2.
+Teuchos::RCP<DataTransferKit::MeshContainer<int> > 
+buildGridHexContainer( const int num_cells )
+{
+    using namespace DataTransferKit;
+
+    int vertex_dim = 3;
+    int num_nodes = num_cells + 1;
+    int num_vertices = num_nodes*num_nodes*num_nodes;
+    int num_hexes = num_cells*num_cells*num_cells;
+    double width = 1.0 / num_cells;
+
+    // Make the vertices.
+    Teuchos::ArrayRCP<int> vertex_handle_array( num_vertices );
+    Teuchos::ArrayRCP<double> coords_array( vertex_dim*num_vertices );
+    int n = 0;
+    for ( int k = 0; k < num_nodes; ++k )
+    {
+	for ( int j = 0; j < num_nodes; ++j )
+	{
+	    for ( int i = 0; i < num_nodes; ++i, ++n )
+	    {
+		vertex_handle_array[n] = n;
+		coords_array[n] = i*width;
+		coords_array[num_vertices + n] = j*width;
+		coords_array[2*num_vertices + n] = k*width;
+	    }
+	}
+    }
+
+    // Make the hexahedra.
+    int vertices_per_hex = 8;
+    Teuchos::ArrayRCP<int> hex_handle_array( num_hexes );
+    Teuchos::ArrayRCP<int> connectivity_array( vertices_per_hex*num_hexes );
+    int v0 = 0;
+    n = 0;
+    for ( int k = 0; k < num_cells; ++k )
+    {
+	for ( int j = 0; j < num_cells; ++j )
+	{
+	    for ( int i = 0; i < num_cells; ++i, ++n )
+	    {
+		hex_handle_array[n] = n;
+		v0 = i + j*num_nodes + k*num_nodes*num_nodes;
+		connectivity_array[n] = v0;
+		connectivity_array[num_hexes + n] = v0 + 1;
+		connectivity_array[2*num_hexes + n] = v0 + num_nodes + 1;
+		connectivity_array[3*num_hexes + n] = v0 + num_nodes;
+		v0 += num_nodes*num_nodes;
+		connectivity_array[4*num_hexes + n] = v0;
+		connectivity_array[5*num_hexes + n] = v0 + 1;
+		connectivity_array[6*num_hexes + n] = v0 + num_nodes + 1;
+		connectivity_array[7*num_hexes + n] = v0 + num_nodes;
+	    }
+	}
+    }
+
+    Teuchos::ArrayRCP<int> permutation_list( vertices_per_hex );
+    for ( int i = 0; i < permutation_list.size(); ++i )
+    {
+	permutation_list[i] = i;
+    }
+
+    return Teuchos::rcp(
+	new MeshContainer<int>( vertex_dim, vertex_handle_array, coords_array,
+				DTK_HEXAHEDRON, vertices_per_hex,
+				hex_handle_array, connectivity_array,
+				permutation_list ) );
+}
+
+//---------------------------------------------------------------------------//
+// Unit cube split into 5 tetrahedra. The corner tetrahedra have handles 20 to
+// 23 and the center tetrahedron has handle 24.
+Teuchos::RCP<DataTransferKit::MeshContainer<int> > buildCubeTetContainer()
+{
+    using namespace DataTransferKit;
+
+    // Make the cube vertices. Vertex i + 2*j + 4*k is at (i,j,k).
+    int vertex_dim = 3;
+    int num_vertices = 8;
+    Teuchos::ArrayRCP<int> vertex_handle_array( num_vertices );
+    Teuchos::ArrayRCP<double> coords_array( vertex_dim*num_vertices );
+    for ( int n = 0; n < num_vertices; ++n )
+    {
+	vertex_handle_array[n] = n;
+	coords_array[n] = n % 2;
+	coords_array[num_vertices + n] = (n / 2) % 2;
+	coords_array[2*num_vertices + n] = n / 4;
+    }
+
+    // Make the tetrahedra.
+    int num_tets = 5;
+    int vertices_per_tet = 4;
+    int tet_vertices[5][4] = { {0,1,2,4}, {3,2,1,7}, {5,1,4,7}, 
+			       {6,4,2,7}, {1,2,4,7} };
+    Teuchos::ArrayRCP<int> tet_handle_array( num_tets );
+    Teuchos::ArrayRCP<int> connectivity_array( vertices_per_tet*num_tets );
+    for ( int n = 0; n < num_tets; ++n )
+    {
+	tet_handle_array[n] = 20 + n;
+	for ( int v = 0; v < vertices_per_tet; ++v )
+	{
+	    connectivity_array[v*num_tets + n] = tet_vertices[n][v];
+	}
+    }
+
+    Teuchos::ArrayRCP<int> permutation_list( vertices_per_tet );
+    for ( int i = 0; i < permutation_list.size(); ++i )
+    {
+	permutation_list[i] = i;
+    }
+
+    return Teuchos::rcp(
+	new MeshContainer<int>( vertex_dim, vertex_handle_array, coords_array,
+				DTK_TETRAHEDRON, vertices_per_tet,
+				tet_handle_array, connectivity_array,
+				permutation_list ) );
+}
+
+//---------------------------------------------------------------------------//
+// Two unit hexahedra that share faces with the tetrahedra of the unit
+// cube. Hex 30 is below the cube and hex 31 is in +x of the cube.
+Teuchos::RCP<DataTransferKit::MeshContainer<int> > buildCubeHexContainer()
+{
+    using namespace DataTransferKit;
+
+    // Make the vertices of each hex in canonical order.
+    int vertex_dim = 3;
+    int num_hexes = 2;
+    int vertices_per_hex = 8;
+    int num_vertices = vertices_per_hex*num_hexes;
+    double offsets[2][3] = { {0.0, 0.0, -1.0}, {1.0, 0.0, 0.0} };
+    int corners[8][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+			  {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1} };
+    Teuchos::ArrayRCP<int> vertex_handle_array( num_vertices );
+    Teuchos::ArrayRCP<double> coords_array( vertex_dim*num_vertices );
+    Teuchos::ArrayRCP<int> hex_handle_array( num_hexes );
+    Teuchos::ArrayRCP<int> connectivity_array( vertices_per_hex*num_hexes );
+    int n = 0;
+    for ( int h = 0; h < num_hexes; ++h )
+    {
+	hex_handle_array[h] = 30 + h;
+	for ( int v = 0; v < vertices_per_hex; ++v, ++n )
+	{
+	    vertex_handle_array[n] = n;
+	    for ( int d = 0; d < vertex_dim; ++d )
+	    {
+		coords_array[d*num_vertices + n] = offsets[h][d] + corners[v][d];
+	    }
+	    connectivity_array[v*num_hexes + h] = n;
+	}
+    }
+
+    Teuchos::ArrayRCP<int> permutation_list( vertices_per_hex );
+    for ( int i = 0; i < permutation_list.size(); ++i )
+    {
+	permutation_list[i] = i;
+    }
+
+    return Teuchos::rcp(
+	new MeshContainer<int>( vertex_dim, vertex_handle_array, coords_array,
+				DTK_HEXAHEDRON, vertices_per_hex,
+				hex_handle_array, connectivity_array,
+				permutation_list ) );
+}
+
 //---------------------------------------------------------------------------//
 // Tests
 //---------------------------------------------------------------------------//
@@ -1027,6 +1196,68 @@ TEUCHOS_UNIT_TEST( MeshContainer, tri_kd_tree_test )
     }
 }
 
+//---------------------------------------------------------------------------//
+// Tri mesh refit. Moving the vertices and refitting the tree must give the
+// same search results as a tree over the moved mesh.
+TEUCHOS_UNIT_TEST( MeshContainer, tri_kd_tree_refit_test )
+{
+    using namespace DataTransferKit;
+
+    // Create a mesh container.
+    typedef MeshContainer<int> MeshType;
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 1 );
+    mesh_blocks[0] = buildTriContainer();
+
+    // Create a mesh manager.
+    MeshManager<MeshType> mesh_manager( mesh_blocks, getDefaultComm<int>(), 2 );
+
+    // Create a rendezvous mesh.
+    Teuchos::RCP< RendezvousMesh<MeshType::global_ordinal_type> > 
+	rendezvous_mesh = createRendezvousMeshFromMesh( mesh_manager );
+
+    // Create a kD-tree.
+    KDTree<MeshType::global_ordinal_type> kd_tree( rendezvous_mesh, 
+						   mesh_manager.dim() );
+
+    // Build the tree.
+    kd_tree.build();
+
+    // Move the vertices by 0.5 in x and stretch the triangle by 2 in y.
+    Teuchos::Array<double> moved_coords( 9, 0.0 );
+    moved_coords[0] = 0.5;
+    moved_coords[1] = 0.0;
+    moved_coords[3] = 1.5;
+    moved_coords[4] = 0.0;
+    moved_coords[6] = 1.5;
+    moved_coords[7] = 2.0;
+    rendezvous_mesh->setVertexCoords( moved_coords() );
+
+    // Refit the tree.
+    kd_tree.refit();
+
+    // Search the tree for some random points.
+    int num_points = 1000;
+    Teuchos::Array<double> point(2);
+    int ordinal = 0;
+    for ( int i = 0; i < num_points; ++i )
+    {
+	ordinal = 0;
+	point[0] = 3.0 * (double) std::rand() / RAND_MAX - 0.5;
+	point[1] = 3.0 * (double) std::rand() / RAND_MAX - 0.5;
+
+	if ( 0.5 <= point[0] && point[0] <= 1.5 &&
+	     0.0 <= point[1] && point[1] <= 2.0*(point[0] - 0.5) )
+	{
+	    TEST_ASSERT( kd_tree.findPoint( point, ordinal ) );
+	    TEST_ASSERT( ordinal == 12 );
+	}
+	else
+	{
+	    TEST_ASSERT( !kd_tree.findPoint( point, ordinal ) );
+	}
+    }
+}
+
 //---------------------------------------------------------------------------//
 // Quad mesh.
 TEUCHOS_UNIT_TEST( MeshContainer, quad_kd_tree_test )
@@ -1525,6 +1756,357 @@ TEUCHOS_UNIT_TEST( MeshContainer, 3d_hybrid_kd_tree_test )
     }
 }
 
+//---------------------------------------------------------------------------//
+// Structured hex grid test. The grid has enough elements to build a tree with
+// many levels.
+TEUCHOS_UNIT_TEST( MeshContainer, grid_hex_kd_tree_test )
+{
+    using namespace DataTransferKit;
+
+    // Create a mesh container.
+    typedef MeshContainer<int> MeshType;
+    int num_cells = 10;
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 1 );
+    mesh_blocks[0] = buildGridHexContainer( num_cells );
+
+    // Create a mesh manager.
+    MeshManager<MeshType> mesh_manager( mesh_blocks, getDefaultComm<int>(), 3 );
+
+    // Create a rendezvous mesh.
+    Teuchos::RCP< RendezvousMesh<MeshType::global_ordinal_type> > 
+	rendezvous_mesh = createRendezvousMeshFromMesh( mesh_manager );
+
+    // Create a kD-tree.
+    KDTree<MeshType::global_ordinal_type> kd_tree( rendezvous_mesh, 
+						   mesh_manager.dim() );
+
+    // Build the tree.
+    kd_tree.build();
+
+    // Search the tree for some random points. Points in the grid must be
+    // found in the element that contains them.
+    double tol = 1.0e-8;
+    double width = 1.0 / num_cells;
+    int num_points = 1000;
+    Teuchos::Array<double> point(3);
+    Teuchos::Array<MeshType::global_ordinal_type> leaf_ordinals;
+    int ordinal = 0;
+    int ijk[3];
+    for ( int i = 0; i < num_points; ++i )
+    {
+	ordinal = 0;
+	point[0] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+	point[1] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+	point[2] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+
+	if ( 0.0 <= point[0] && point[0] <= 1.0 &&
+	     0.0 <= point[1] && point[1] <= 1.0 &&
+	     0.0 <= point[2] && point[2] <= 1.0 )
+	{
+	    TEST_ASSERT( kd_tree.findPoint( point, ordinal ) );
+	    ijk[0] = ordinal % num_cells;
+	    ijk[1] = (ordinal / num_cells) % num_cells;
+	    ijk[2] = ordinal / (num_cells*num_cells);
+	    for ( int d = 0; d < 3; ++d )
+	    {
+		TEST_ASSERT( ijk[d]*width - tol <= point[d] );
+		TEST_ASSERT( point[d] <= (ijk[d]+1)*width + tol );
+	    }
+	    kd_tree.findLeaf( point, leaf_ordinals );
+	    TEST_ASSERT( std::find( leaf_ordinals.begin(), leaf_ordinals.end(),
+				    ordinal ) != leaf_ordinals.end() );
+	    TEST_ASSERT( leaf_ordinals.size() < num_cells*num_cells*num_cells );
+	}
+	else
+	{
+	    TEST_ASSERT( !kd_tree.findPoint( point, ordinal ) );
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Structured hex grid batched search test. The batched search must give the
+// same result as searching for the points one at a time.
+TEUCHOS_UNIT_TEST( MeshContainer, grid_hex_kd_tree_batch_test )
+{
+    using namespace DataTransferKit;
+
+    // Create a mesh container.
+    typedef MeshContainer<int> MeshType;
+    int num_cells = 10;
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 1 );
+    mesh_blocks[0] = buildGridHexContainer( num_cells );
+
+    // Create a mesh manager.
+    MeshManager<MeshType> mesh_manager( mesh_blocks, getDefaultComm<int>(), 3 );
+
+    // Create a rendezvous mesh.
+    Teuchos::RCP< RendezvousMesh<MeshType::global_ordinal_type> > 
+	rendezvous_mesh = createRendezvousMeshFromMesh( mesh_manager );
+
+    // Create a kD-tree.
+    KDTree<MeshType::global_ordinal_type> kd_tree( rendezvous_mesh, 
+						   mesh_manager.dim() );
+
+    // Build the tree.
+    kd_tree.build();
+
+    // Make some random points in blocked format.
+    int num_points = 1000;
+    Teuchos::Array<double> coords( 3*num_points );
+    for ( int i = 0; i < 3*num_points; ++i )
+    {
+	coords[i] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+    }
+
+    // Search the tree for all of the points at once.
+    Teuchos::Array<MeshType::global_ordinal_type> elements;
+    Teuchos::Array<short int> points_found;
+    kd_tree.findPoints( coords.getRawPtr(), num_points, 
+			elements, points_found );
+    TEST_ASSERT( (int) elements.size() == num_points );
+    TEST_ASSERT( (int) points_found.size() == num_points );
+
+    // Check the results against the single point search.
+    double tol = 1.0e-8;
+    double width = 1.0 / num_cells;
+    Teuchos::Array<double> point(3);
+    int ordinal = 0;
+    int ijk[3];
+    for ( int n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < 3; ++d )
+	{
+	    point[d] = coords[ d*num_points + n ];
+	}
+	TEST_ASSERT( kd_tree.findPoint(point, ordinal) == 
+		     (bool) points_found[n] );
+
+	if ( points_found[n] )
+	{
+	    ijk[0] = elements[n] % num_cells;
+	    ijk[1] = (elements[n] / num_cells) % num_cells;
+	    ijk[2] = elements[n] / (num_cells*num_cells);
+	    for ( int d = 0; d < 3; ++d )
+	    {
+		TEST_ASSERT( ijk[d]*width - tol <= point[d] );
+		TEST_ASSERT( point[d] <= (ijk[d]+1)*width + tol );
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Reference coordinates returned by the batch search.
+TEUCHOS_UNIT_TEST( MeshContainer, reference_coords_kd_tree_test )
+{
+    using namespace DataTransferKit;
+
+    // The tetrahedron is the reference tetrahedron and the hexahedron is the
+    // unit cube such that the reference coordinates of a point are known.
+    typedef MeshContainer<int> MeshType;
+    for ( int m = 0; m < 2; ++m )
+    {
+	Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 1 );
+	mesh_blocks[0] = ( 0 == m ) ? buildTetContainer() : buildHexContainer();
+	MeshManager<MeshType> mesh_manager( 
+	    mesh_blocks, getDefaultComm<int>(), 3 );
+	Teuchos::RCP< RendezvousMesh<MeshType::global_ordinal_type> > 
+	    rendezvous_mesh = createRendezvousMeshFromMesh( mesh_manager );
+	KDTree<MeshType::global_ordinal_type> kd_tree( rendezvous_mesh, 
+						       mesh_manager.dim() );
+	kd_tree.build();
+
+	// Make some random points in blocked format.
+	int num_points = 1000;
+	Teuchos::Array<double> coords( 3*num_points );
+	for ( int i = 0; i < 3*num_points; ++i )
+	{
+	    coords[i] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+	}
+
+	// Search the tree for all of the points at once.
+	Teuchos::Array<MeshType::global_ordinal_type> elements;
+	Teuchos::Array<short int> points_found;
+	Teuchos::Array<double> reference_coords;
+	kd_tree.findPoints( coords.getRawPtr(), num_points, 
+			    elements, points_found, reference_coords );
+	TEST_ASSERT( (int) reference_coords.size() == 3*num_points );
+
+	// Check the reference coordinates of the points found.
+	double tol = 1.0e-8;
+	double reference = 0.0;
+	for ( int n = 0; n < num_points; ++n )
+	{
+	    if ( points_found[n] )
+	    {
+		for ( int d = 0; d < 3; ++d )
+		{
+		    reference = ( 0 == m ) ? coords[ d*num_points + n ] :
+				2.0*coords[ d*num_points + n ] - 1.0;
+		    TEST_FLOATING_EQUALITY( 
+			reference_coords[ d*num_points + n ] + 2.0, 
+			reference + 2.0, tol );
+		}
+	    }
+	}
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Mixed affine test. The tetrahedra and hexahedra fit in a single leaf such
+// that the affine tetrahedra are checked all at once (with the SIMD kernels
+// if enabled) and the hexahedra one at a time. The elements and reference
+// coordinates found must agree with the scalar point-in-element kernels,
+// including for points on shared faces and points just outside of the mesh.
+TEUCHOS_UNIT_TEST( MeshContainer, mixed_affine_kd_tree_test )
+{
+    using namespace DataTransferKit;
+
+    // Create the mesh.
+    typedef MeshContainer<int> MeshType;
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 2 );
+    mesh_blocks[0] = buildCubeTetContainer();
+    mesh_blocks[1] = buildCubeHexContainer();
+    MeshManager<MeshType> mesh_manager( mesh_blocks, getDefaultComm<int>(), 3 );
+    Teuchos::RCP< RendezvousMesh<MeshType::global_ordinal_type> > 
+	rendezvous_mesh = createRendezvousMeshFromMesh( mesh_manager );
+    int num_elements = rendezvous_mesh->numElements();
+    TEST_EQUALITY( num_elements, 7 );
+
+    // Build the tree. The elements fit in a single leaf.
+    KDTree<MeshType::global_ordinal_type> kd_tree( rendezvous_mesh, 
+						   mesh_manager.dim() );
+    kd_tree.build();
+
+    // Make points in blocked format. Random points are mixed with points on
+    // the faces shared by the tetrahedra, points on the faces shared by the
+    // tetrahedra and the hexahedra, and points just outside of the mesh.
+    int num_random = 500;
+    int num_face = 100;
+    int num_points = num_random + 6*num_face;
+    Teuchos::Array<double> points( 3*num_points );
+    double offset = 1.0e-4;
+    double a = 0.0;
+    double b = 0.0;
+    double c = 0.0;
+    int n = 0;
+    for ( ; n < num_random; ++n )
+    {
+	points[n] = 3.0 * (double) std::rand() / RAND_MAX - 0.5;
+	points[num_points + n] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+	points[2*num_points + n] = 3.0 * (double) std::rand() / RAND_MAX - 1.5;
+    }
+    for ( int i = 0; i < num_face; ++i )
+    {
+	a = (double) std::rand() / RAND_MAX;
+	b = (double) std::rand() / RAND_MAX;
+	c = (double) std::rand() / RAND_MAX;
+
+	// Corner/center tetrahedron face x + y + z = 1.
+	points[n] = a * (1.0 - b);
+	points[num_points + n] = (1.0 - a) * (1.0 - b);
+	points[2*num_points + n] = b;
+	++n;
+
+	// Tetrahedra/hex face z = 0.
+	points[n] = a;
+	points[num_points + n] = b;
+	points[2*num_points + n] = 0.0;
+	++n;
+
+	// Tetrahedra/hex face x = 1.
+	points[n] = 1.0;
+	points[num_points + n] = a;
+	points[2*num_points + n] = b;
+	++n;
+
+	// Just outside of the tetrahedra in +z.
+	points[n] = a;
+	points[num_points + n] = b;
+	points[2*num_points + n] = 1.0 + offset;
+	++n;
+
+	// Just outside of the tetrahedra in -y.
+	points[n] = a;
+	points[num_points + n] = -offset;
+	points[2*num_points + n] = c;
+	++n;
+
+	// Just outside of the hexahedra in +x and -z.
+	points[n] = ( c < 0.5 ) ? 2.0 + offset : a;
+	points[num_points + n] = b;
+	points[2*num_points + n] = ( c < 0.5 ) ? c : -1.0 - offset;
+	++n;
+    }
+
+    // Search the tree for all of the points at once.
+    double tol = 1.0e-8;
+    Teuchos::Array<MeshType::global_ordinal_type> elements;
+    Teuchos::Array<short int> points_found;
+    Teuchos::Array<double> reference_coords;
+    kd_tree.findPoints( points.getRawPtr(), num_points, 
+			elements, points_found, reference_coords, tol );
+    TEST_ASSERT( (int) points_found.size() == num_points );
+
+    // Check each point against the scalar kernels on every element.
+    double point[3];
+    double reference[3];
+    int num_containing = 0;
+    int containing = -1;
+    int found = -1;
+    for ( n = 0; n < num_points; ++n )
+    {
+	for ( int d = 0; d < 3; ++d )
+	{
+	    point[d] = points[ d*num_points + n ];
+	}
+
+	num_containing = 0;
+	containing = -1;
+	found = -1;
+	for ( int e = 0; e < num_elements; ++e )
+	{
+	    if ( TopologyTools::pointInElement( 
+		     point, rendezvous_mesh->elementTopology(e),
+		     rendezvous_mesh->elementVertexCoords(e), reference, tol ) )
+	    {
+		++num_containing;
+		containing = e;
+	    }
+	    if ( points_found[n] && 
+		 rendezvous_mesh->elementOrdinal(e) == elements[n] )
+	    {
+		found = e;
+	    }
+	}
+	TEST_EQUALITY( (bool) points_found[n], num_containing > 0 );
+	TEST_ASSERT( !points_found[n] || found >= 0 );
+	if ( found < 0 )
+	{
+	    continue;
+	}
+
+	// Points in a single element must be found in that element.
+	if ( 1 == num_containing )
+	{
+	    TEST_EQUALITY( found, containing );
+	}
+
+	// The element found must contain the point with the same reference
+	// coordinates as the scalar kernel.
+	TEST_ASSERT( TopologyTools::pointInElement( 
+			 point, rendezvous_mesh->elementTopology(found),
+			 rendezvous_mesh->elementVertexCoords(found),
+			 reference, tol ) );
+	for ( int d = 0; d < 3; ++d )
+	{
+	    TEST_FLOATING_EQUALITY( reference_coords[ d*num_points + n ] + 2.0, 
+				    reference[d] + 2.0, tol );
+	}
+    }
+}
+
 //---------------------------------------------------------------------------//
 // end tstKDTree.cpp
 //---------------------------------------------------------------------------//
@@ -0,0 +1,103 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file tstOrdinalIndex.cpp
+ * \author Stuart R. Slattery
+ * \brief OrdinalIndex unit tests.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+
+#include <DTK_OrdinalIndex.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_TypeTraits.hpp>
+
+//---------------------------------------------------------------------------//
+// MPI Setup
+//---------------------------------------------------------------------------//
+
+template<class Ordinal>
+Teuchos::RCP<const Teuchos::Comm<Ordinal> > getDefaultComm()
+{
+#ifdef HAVE_MPI
+    return Teuchos::DefaultComm<Ordinal>::getComm();
+#else
+    return Teuchos::rcp(new Teuchos::SerialComm<Ordinal>() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Tests
+//---------------------------------------------------------------------------//
+// Contiguous ordinal test.
+TEUCHOS_UNIT_TEST( OrdinalIndex, contiguous_test )
+{
+    using namespace DataTransferKit;
+
+    // Make a shuffled contiguous range of ordinals.
+    int num_ordinals = 100;
+    Teuchos::Array<int> ordinals( num_ordinals );
+    for ( int i = 0; i < num_ordinals; ++i )
+    {
+	ordinals[i] = 7 + (37*i) % num_ordinals;
+    }
+
+    // Index them.
+    OrdinalIndex<int> ordinal_index( ordinals() );
+    TEST_ASSERT( ordinal_index.size() == num_ordinals );
+    TEST_ASSERT( ordinal_index.isContiguous() );
+
+    // Check the indices.
+    for ( int i = 0; i < num_ordinals; ++i )
+    {
+	TEST_ASSERT( ordinal_index.contains( ordinals[i] ) );
+	TEST_ASSERT( ordinal_index.index( ordinals[i] ) == i );
+    }
+    TEST_ASSERT( !ordinal_index.contains( 6 ) );
+    TEST_ASSERT( !ordinal_index.contains( 7 + num_ordinals ) );
+}
+
+//---------------------------------------------------------------------------//
+// Sparse ordinal test.
+TEUCHOS_UNIT_TEST( OrdinalIndex, sparse_test )
+{
+    using namespace DataTransferKit;
+
+    // Make a set of sparse ordinals.
+    int num_ordinals = 100;
+    Teuchos::Array<int> ordinals( num_ordinals );
+    for ( int i = 0; i < num_ordinals; ++i )
+    {
+	ordinals[i] = 3 * ( (37*i) % num_ordinals );
+    }
+
+    // Index them.
+    OrdinalIndex<int> ordinal_index;
+    TEST_ASSERT( ordinal_index.size() == 0 );
+    TEST_ASSERT( !ordinal_index.contains( 0 ) );
+    ordinal_index.build( ordinals() );
+    TEST_ASSERT( ordinal_index.size() == num_ordinals );
+    TEST_ASSERT( !ordinal_index.isContiguous() );
+
+    // Check the indices.
+    for ( int i = 0; i < num_ordinals; ++i )
+    {
+	TEST_ASSERT( ordinal_index.contains( ordinals[i] ) );
+	TEST_ASSERT( ordinal_index.index( ordinals[i] ) == i );
+	TEST_ASSERT( !ordinal_index.contains( ordinals[i] + 1 ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end tstOrdinalIndex.cpp
+//---------------------------------------------------------------------------//
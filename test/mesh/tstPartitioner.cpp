@@ -27,6 +27,7 @@
 #include <Teuchos_RCP.hpp>
 #include <Teuchos_ArrayRCP.hpp>
 #include <Teuchos_Array.hpp>
+#include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_OpaqueWrapper.hpp>
 #include <Teuchos_TypeTraits.hpp>
 
@@ -312,6 +313,84 @@ TEUCHOS_UNIT_TEST( Partitioner, 2d_rcb_test )
     TEST_ASSERT( partitioner->getPointDestinationProc( point_3 ) == my_size-1 );
 }
 
+//---------------------------------------------------------------------------//
+// 2d mesh with each of the other partitioner types.
+TEUCHOS_UNIT_TEST( Partitioner, 2d_partitioner_types_test )
+{
+    using namespace DataTransferKit;
+
+    // create a mesh.
+    typedef MeshContainer<int> MeshType;
+    typedef MeshTools< MeshType > Tools;
+    Teuchos::ArrayRCP<Teuchos::RCP<MeshType> > mesh_blocks( 1 );
+    mesh_blocks[0] = build2dContainer();
+
+    // All of the vertices will be partitioned.
+    int mesh_dim = 2;
+    int num_vertices = Tools::numVertices( *mesh_blocks[0] );
+    Teuchos::Array<short int> active_vertices( num_vertices, 1 );
+
+    // Create a mesh manager.
+    Teuchos::RCP< MeshManager<MeshType> > mesh_manager = Teuchos::rcp( 
+	new MeshManager<MeshType>( 
+	    mesh_blocks, getDefaultComm<int>(), mesh_dim ) );
+    mesh_manager->setActiveVertices( active_vertices, 0 );
+
+    // Get MPI parameters.
+    int my_size = getDefaultComm<int>()->getSize();
+
+    Teuchos::ArrayRCP<const double> coords = 
+	Tools::coordsView( *mesh_blocks[0] );
+    DTK_PartitionerType types[3] = { DTK_RIB_PARTITIONER,
+				     DTK_HSFC_PARTITIONER,
+				     DTK_HILBERT_PARTITIONER };
+    for ( int t = 0; t < 3; ++t )
+    {
+	// Create a partitioner and do the partitioning.
+	Teuchos::RCP<Partitioner> partitioner = 
+	    PartitionerFactory::createMeshPartitioner( 
+		getDefaultComm<int>(), mesh_manager, 2, 
+		Teuchos::null, types[t] );
+	partitioner->partition();
+
+	// Every vertex has a destination and every process gets vertices.
+	Teuchos::Array<int> procs;
+	partitioner->getPointDestinationProcs( coords(), procs );
+	TEST_ASSERT( procs.size() == num_vertices );
+	Teuchos::Array<int> local_counts( my_size, 0 );
+	for ( int i = 0; i < num_vertices; ++i )
+	{
+	    TEST_ASSERT( 0 <= procs[i] && procs[i] < my_size );
+	    ++local_counts[ procs[i] ];
+	}
+	Teuchos::Array<int> global_counts( my_size, 0 );
+	Teuchos::reduceAll<int,int>( *getDefaultComm<int>(), 
+				     Teuchos::REDUCE_SUM, my_size,
+				     local_counts.getRawPtr(),
+				     global_counts.getRawPtr() );
+	for ( int p = 0; p < my_size; ++p )
+	{
+	    TEST_ASSERT( global_counts[p] > 0 );
+	}
+
+	// A box around the whole mesh is on every process.
+	Teuchos::Array<int> box_procs = partitioner->getBoxDestinationProcs(
+	    BoundingBox( 0.0, 0.0, 0.0, 1.0, 1.0, 0.0 ) );
+	TEST_ASSERT( box_procs.size() == my_size );
+
+	// A box around a vertex includes the vertex destination.
+	for ( int i = 0; i < num_vertices; i += 10 )
+	{
+	    box_procs = partitioner->getBoxDestinationProcs(
+		BoundingBox( coords[i] - 0.01, coords[num_vertices+i] - 0.01,
+			     0.0, coords[i] + 0.01, 
+			     coords[num_vertices+i] + 0.01, 0.0 ) );
+	    TEST_ASSERT( std::find( box_procs.begin(), box_procs.end(),
+				    procs[i] ) != box_procs.end() );
+	}
+    }
+}
+
 //---------------------------------------------------------------------------//
 // 3d mesh
 TEUCHOS_UNIT_TEST( Partitioner, 3d_rcb_test )
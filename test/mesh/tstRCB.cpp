@@ -290,6 +290,33 @@ TEUCHOS_UNIT_TEST( RCB, 1d_rcb_test )
     Teuchos::Array<double> point_3(1);
     point_3[0] = 0.8;
     TEST_ASSERT( rcb.getPointDestinationProc( point_3 ) == my_size-1 );
+
+    // Check the blocked destination proc point search.
+    Teuchos::Array<double> points(4);
+    points[0] = 2.0;
+    points[1] = -2.0;
+    points[2] = 0.2;
+    points[3] = 0.8;
+    Teuchos::Array<int> point_procs;
+    rcb.getPointDestinationProcs( points(), point_procs );
+    TEST_ASSERT( point_procs.size() == 4 );
+    TEST_ASSERT( point_procs[0] == my_size-1 );
+    TEST_ASSERT( point_procs[1] == 0 );
+    TEST_ASSERT( point_procs[2] == 0 );
+    TEST_ASSERT( point_procs[3] == my_size-1 );
+
+    // Check the destination proc box search. A box over the whole domain
+    // spans all procs.
+    Teuchos::Array<BoundingBox> boxes(2);
+    boxes[0] = BoundingBox( -2.0, 0.0, 0.0, 2.0, 0.0, 0.0 );
+    boxes[1] = BoundingBox( -2.0, 0.0, 0.0, -1.0, 0.0, 0.0 );
+    Teuchos::Array<Teuchos::Array<int> > box_procs;
+    rcb.getBoxDestinationProcs( boxes, box_procs );
+    TEST_ASSERT( box_procs.size() == 2 );
+    TEST_ASSERT( box_procs[0].size() == my_size );
+    TEST_ASSERT( box_procs[1].size() == 1 );
+    TEST_ASSERT( box_procs[1][0] == 0 );
+    TEST_ASSERT( rcb.getBoxDestinationProcs( boxes[0] ) == box_procs[0] );
 }
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file tstRCBCutTree.cpp
+ * \author Stuart R. Slattery
+ * \brief RCBCutTree unit tests.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include <DTK_RCBCutTree.hpp>
+#include <DTK_BoundingBox.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_TypeTraits.hpp>
+
+//---------------------------------------------------------------------------//
+// MPI Setup
+//---------------------------------------------------------------------------//
+
+template<class Ordinal>
+Teuchos::RCP<const Teuchos::Comm<Ordinal> > getDefaultComm()
+{
+#ifdef HAVE_MPI
+    return Teuchos::DefaultComm<Ordinal>::getComm();
+#else
+    return Teuchos::rcp(new Teuchos::SerialComm<Ordinal>() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Tests
+//---------------------------------------------------------------------------//
+// Quadrant partitioning test.
+TEUCHOS_UNIT_TEST( RCBCutTree, quadrant_test )
+{
+    using namespace DataTransferKit;
+
+    // Partition the plane into quadrants.
+    double inf = std::numeric_limits<double>::max();
+    Teuchos::Array<double> part_bounds( 24, 0.0 );
+    double quadrants[4][4] = { { -inf, -inf, 0.0, 0.0 },
+			       { 0.0, -inf, inf, 0.0 },
+			       { -inf, 0.0, 0.0, inf },
+			       { 0.0, 0.0, inf, inf } };
+    for ( int p = 0; p < 4; ++p )
+    {
+	part_bounds[6*p] = quadrants[p][0];
+	part_bounds[6*p+1] = quadrants[p][1];
+	part_bounds[6*p+3] = quadrants[p][2];
+	part_bounds[6*p+4] = quadrants[p][3];
+    }
+
+    RCBCutTree cut_tree;
+    cut_tree.build( part_bounds, 2 );
+    TEST_ASSERT( cut_tree.numNodes() == 7 );
+
+    // Check the point search. Points on a cut go to the lower partition.
+    double point_0[2] = { -1.0, -1.0 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_0 ) == 0 );
+    double point_1[2] = { 1.0, -1.0 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_1 ) == 1 );
+    double point_2[2] = { -1.0, 1.0 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_2 ) == 2 );
+    double point_3[2] = { 1.0, 1.0 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_3 ) == 3 );
+    double point_4[2] = { 0.0, 0.0 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_4 ) == 0 );
+
+    // Check the blocked point search.
+    Teuchos::Array<double> points( 8 );
+    points[0] = -1.0;
+    points[1] = 1.0;
+    points[2] = -1.0;
+    points[3] = 1.0;
+    points[4] = -1.0;
+    points[5] = -1.0;
+    points[6] = 1.0;
+    points[7] = 1.0;
+    Teuchos::Array<int> procs;
+    cut_tree.pointDestinationProcs( points(), procs );
+    TEST_ASSERT( procs.size() == 4 );
+    for ( int i = 0; i < 4; ++i )
+    {
+	TEST_ASSERT( procs[i] == i );
+    }
+
+    // Check the box search. Boxes touching a cut go to both sides.
+    cut_tree.boxDestinationProcs( 
+	BoundingBox( -1.0, -1.0, 0.0, 1.0, 1.0, 0.0 ), procs );
+    std::sort( procs.begin(), procs.end() );
+    TEST_ASSERT( procs.size() == 4 );
+    for ( int i = 0; i < 4; ++i )
+    {
+	TEST_ASSERT( procs[i] == i );
+    }
+
+    cut_tree.boxDestinationProcs( 
+	BoundingBox( 0.5, 0.5, 0.0, 1.0, 1.0, 0.0 ), procs );
+    TEST_ASSERT( procs.size() == 1 );
+    TEST_ASSERT( procs[0] == 3 );
+
+    cut_tree.boxDestinationProcs( 
+	BoundingBox( -1.0, 0.5, 0.0, 0.0, 1.0, 0.0 ), procs );
+    std::sort( procs.begin(), procs.end() );
+    TEST_ASSERT( procs.size() == 2 );
+    TEST_ASSERT( procs[0] == 2 );
+    TEST_ASSERT( procs[1] == 3 );
+}
+
+//---------------------------------------------------------------------------//
+// Uneven slab partitioning test.
+TEUCHOS_UNIT_TEST( RCBCutTree, slab_test )
+{
+    using namespace DataTransferKit;
+
+    // Partition space into three slabs along z.
+    double inf = std::numeric_limits<double>::max();
+    Teuchos::Array<double> part_bounds( 18 );
+    double slabs[3][2] = { { 2.0, inf }, { -inf, -1.0 }, { -1.0, 2.0 } };
+    for ( int p = 0; p < 3; ++p )
+    {
+	part_bounds[6*p] = -inf;
+	part_bounds[6*p+1] = -inf;
+	part_bounds[6*p+2] = slabs[p][0];
+	part_bounds[6*p+3] = inf;
+	part_bounds[6*p+4] = inf;
+	part_bounds[6*p+5] = slabs[p][1];
+    }
+
+    RCBCutTree cut_tree;
+    cut_tree.build( part_bounds, 3 );
+    TEST_ASSERT( cut_tree.numNodes() == 5 );
+
+    double point_0[3] = { 4.0, -3.0, 2.5 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_0 ) == 0 );
+    double point_1[3] = { 4.0, -3.0, -1.5 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_1 ) == 1 );
+    double point_2[3] = { 4.0, -3.0, 0.5 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_2 ) == 2 );
+    double point_3[3] = { 4.0, -3.0, -1.0 };
+    TEST_ASSERT( cut_tree.pointDestinationProc( point_3 ) == 1 );
+
+    Teuchos::Array<int> procs;
+    cut_tree.boxDestinationProcs( 
+	BoundingBox( 0.0, 0.0, -2.0, 1.0, 1.0, 3.0 ), procs );
+    std::sort( procs.begin(), procs.end() );
+    TEST_ASSERT( procs.size() == 3 );
+    for ( int i = 0; i < 3; ++i )
+    {
+	TEST_ASSERT( procs[i] == i );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// end tstRCBCutTree.cpp
+//---------------------------------------------------------------------------//
@@ -1020,6 +1020,26 @@ TEUCHOS_UNIT_TEST( MeshContainer, hex_rendezvous_mesh_test )
 	    TEST_ASSERT( coords_view[vertices.size()*d + i] == mb_coords[3*i+d] ); 
 	}
     }
+
+    // Element cache.
+    TEST_ASSERT( mesh->dim() == 3 );
+    TEST_ASSERT( mesh->numElements() == (int) mesh_elements.size() );
+    for ( int i = 0; i < mesh->numElements(); ++i )
+    {
+	TEST_ASSERT( mesh->elementHandle(i) == mesh_elements[i] );
+	TEST_ASSERT( mesh->elementIndex( mesh_elements[i] ) == i );
+	TEST_ASSERT( mesh->elementTopology(i) == moab::MBHEX );
+	TEST_ASSERT( mesh->numElementVertices(i) == 8 );
+	for ( int d = 0; d < 3; ++d )
+	{
+	    TEST_ASSERT( mesh->elementBounds(i)[d] == 0.0 );
+	    TEST_ASSERT( mesh->elementBounds(i)[d+3] == 1.0 );
+	}
+    }
+    double inside_point[3] = { 0.5, 0.25, 0.75 };
+    double outside_point[3] = { 0.5, 1.25, 0.75 };
+    TEST_ASSERT( mesh->pointInElement( inside_point, 0, 1.0e-8 ) );
+    TEST_ASSERT( !mesh->pointInElement( outside_point, 0, 1.0e-8 ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -1311,6 +1331,14 @@ TEUCHOS_UNIT_TEST( MeshContainer, 2d_hybrid_rendezvous_mesh_test )
 	    }
 	}
     }
+
+    // Handle translation over the element type handle runs.
+    for ( int i = 0; i < (int) mesh_elements.size(); ++i )
+    {
+	TEST_ASSERT( mesh->elementIndex( mesh_elements[i] ) == i );
+	TEST_ASSERT( mesh->elementOrdinal(i) == 12 );
+	TEST_ASSERT( mesh->getNativeOrdinal( mesh_elements[i] ) == 12 );
+    }
 }
 
 //---------------------------------------------------------------------------//
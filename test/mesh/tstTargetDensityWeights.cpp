@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------//
+/*!
+ * \file tstTargetDensityWeights.cpp
+ * \author Stuart R. Slattery
+ * \brief TargetDensityWeights unit tests.
+ */
+//---------------------------------------------------------------------------//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+
+#include <DTK_TargetDensityWeights.hpp>
+#include <DTK_BoundingBox.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_Array.hpp>
+#include <Teuchos_OpaqueWrapper.hpp>
+#include <Teuchos_TypeTraits.hpp>
+
+//---------------------------------------------------------------------------//
+// MPI Setup
+//---------------------------------------------------------------------------//
+
+template<class Ordinal>
+Teuchos::RCP<const Teuchos::Comm<Ordinal> > getDefaultComm()
+{
+#ifdef HAVE_MPI
+    return Teuchos::DefaultComm<Ordinal>::getComm();
+#else
+    return Teuchos::rcp(new Teuchos::SerialComm<Ordinal>() );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// Tests
+//---------------------------------------------------------------------------//
+// Clustered target test.
+TEUCHOS_UNIT_TEST( TargetDensityWeights, clustered_target_test )
+{
+    using namespace DataTransferKit;
+
+    // Histogram the unit square with 2 bins in each dimension.
+    TargetDensityWeights weights( 
+	getDefaultComm<int>(), BoundingBox( 0.0, 0.0, 0.0, 1.0, 1.0, 0.0 ), 
+	2, 2 );
+
+    // Put one source vertex in each bin.
+    Teuchos::Array<double> source_coords( 8 );
+    source_coords[0] = 0.25;
+    source_coords[1] = 0.75;
+    source_coords[2] = 0.25;
+    source_coords[3] = 0.75;
+    source_coords[4] = 0.25;
+    source_coords[5] = 0.25;
+    source_coords[6] = 0.75;
+    source_coords[7] = 0.75;
+    weights.addSourcePoints( source_coords() );
+
+    // Cluster all of the target points in the lower left bin.
+    int num_targets = 6;
+    Teuchos::Array<double> target_coords( 2*num_targets );
+    for ( int n = 0; n < num_targets; ++n )
+    {
+	target_coords[n] = 0.1 + 0.05*n;
+	target_coords[num_targets + n] = 0.4 - 0.05*n;
+    }
+    weights.addTargetPoints( target_coords() );
+
+    // The histograms are summed over all processes so the weights do not
+    // depend on the number of processes.
+    weights.reduce();
+
+    // Check the source vertex weights. Each vertex carries its share of the
+    // targets in its bin.
+    Teuchos::Array<float> source_weights( 4 );
+    weights.pointWeights( source_coords(), source_weights() );
+    TEST_ASSERT( source_weights[0] == 1.0 + num_targets );
+    TEST_ASSERT( source_weights[1] == 1.0 );
+    TEST_ASSERT( source_weights[2] == 1.0 );
+    TEST_ASSERT( source_weights[3] == 1.0 );
+
+    // Points outside of the box are weighted with the nearest bin.
+    Teuchos::Array<double> outside_coords( 4 );
+    outside_coords[0] = -1.0;
+    outside_coords[1] = 2.0;
+    outside_coords[2] = -1.0;
+    outside_coords[3] = 2.0;
+    Teuchos::Array<float> outside_weights( 2 );
+    weights.pointWeights( outside_coords(), outside_weights() );
+    TEST_ASSERT( outside_weights[0] == 1.0 + num_targets );
+    TEST_ASSERT( outside_weights[1] == 1.0 );
+}
+
+//---------------------------------------------------------------------------//
+// end tstTargetDensityWeights.cpp
+//---------------------------------------------------------------------------//
@@ -12,6 +12,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
 
 #include <DTK_TopologyTools.hpp>
 #include <DTK_MeshTypes.hpp>
@@ -467,6 +468,64 @@ TEUCHOS_UNIT_TEST( TopologyTools, hexahedron_test )
     TEST_ASSERT( TopologyTools::pointInElement( point_5, hexahedron, moab ) );
 }
 
+//---------------------------------------------------------------------------//
+// Analytic kernel point inclusion test on element vertex coordinates.
+TEUCHOS_UNIT_TEST( TopologyTools, kernel_coords_test )
+{
+    using namespace DataTransferKit;
+
+    // Kernels exist for linear elements with a point of the same dimension.
+    TEST_ASSERT( TopologyTools::hasPointInElementKernel( moab::MBEDGE, 2, 1 ) );
+    TEST_ASSERT( TopologyTools::hasPointInElementKernel( moab::MBTRI, 3, 2 ) );
+    TEST_ASSERT( TopologyTools::hasPointInElementKernel( moab::MBQUAD, 4, 2 ) );
+    TEST_ASSERT( TopologyTools::hasPointInElementKernel( moab::MBTET, 4, 3 ) );
+    TEST_ASSERT( 
+	TopologyTools::hasPointInElementKernel( moab::MBPYRAMID, 5, 3 ) );
+    TEST_ASSERT( TopologyTools::hasPointInElementKernel( moab::MBPRISM, 6, 3 ) );
+    TEST_ASSERT( TopologyTools::hasPointInElementKernel( moab::MBHEX, 8, 3 ) );
+    TEST_ASSERT( !TopologyTools::hasPointInElementKernel( moab::MBHEX, 27, 3 ) );
+    TEST_ASSERT( !TopologyTools::hasPointInElementKernel( moab::MBTRI, 3, 3 ) );
+
+    // Unit hexahedron, wedge, and tetrahedron.
+    double hex_coords[24] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 
+			      1.0, 1.0, 0.0, 0.0, 1.0, 0.0,
+			      0.0, 0.0, 1.0, 1.0, 0.0, 1.0, 
+			      1.0, 1.0, 1.0, 0.0, 1.0, 1.0 };
+    double wedge_coords[18] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 
+				1.0, 1.0, 0.0, 0.0, 0.0, 1.0,
+				1.0, 0.0, 1.0, 1.0, 1.0, 1.0 };
+    double tet_coords[12] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 
+			      0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+
+    // Check random points against the exact element volumes.
+    int num_points = 1000;
+    double point[3];
+    bool in_element = false;
+    for ( int i = 0; i < num_points; ++i )
+    {
+	point[0] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+	point[1] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+	point[2] = 2.0 * (double) std::rand() / RAND_MAX - 0.5;
+
+	in_element = ( 0.0 <= point[0] && point[0] <= 1.0 &&
+		       0.0 <= point[1] && point[1] <= 1.0 &&
+		       0.0 <= point[2] && point[2] <= 1.0 );
+	TEST_ASSERT( in_element == TopologyTools::pointInElement( 
+			 point, moab::MBHEX, hex_coords ) );
+
+	in_element = ( 0.0 <= point[1] && point[1] <= point[0] &&
+		       point[0] <= 1.0 &&
+		       0.0 <= point[2] && point[2] <= 1.0 );
+	TEST_ASSERT( in_element == TopologyTools::pointInElement( 
+			 point, moab::MBPRISM, wedge_coords ) );
+
+	in_element = ( 0.0 <= point[0] && 0.0 <= point[1] && 0.0 <= point[2] &&
+		       point[0] + point[1] + point[2] <= 1.0 );
+	TEST_ASSERT( in_element == TopologyTools::pointInElement( 
+			 point, moab::MBTET, tet_coords ) );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // end tstTopologyTools.cpp
 //---------------------------------------------------------------------------//